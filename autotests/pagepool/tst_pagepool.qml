@@ -36,9 +36,15 @@ TestCase {
         id: pool
     }
 
+    Kirigami.PagePool {
+        id: asyncPool
+        asynchronous: true
+    }
+
     function init() {
         mainWindow.pageStack.clear()
         pool.clear()
+        asyncPool.clear()
     }
 
     // Queries added to page URLs ensure the PagePool can
@@ -176,4 +182,54 @@ TestCase {
         }
         compare(pool.urls.length, 0, "all urls have been deleted")
     }
+
+    function test_preload () {
+        const page = "TestPage.qml?action=preload"
+        pool.preload(page)
+        tryVerify(() => pool.contains(page), 1000, "pool contains preloaded page")
+        compare(pool.lastLoadedItem, null, "preloading does not load the page")
+        const item = pool.pageForUrl(page)
+        compare(pool.loadPage(page), item, "loadPage returns the preloaded page")
+        compare(pool.lastLoadedItem, item)
+    }
+
+    function test_preloadThenLoadImmediately () {
+        const page = "TestPage.qml?action=preloadThenLoadImmediately"
+        pool.preload(page, {title: "PRELOADED"})
+        const item = pool.loadPage(page)
+        verify(item !== null, "valid item returned from loadPage")
+        compare(pool.items.length, 1, "the page is only created once")
+    }
+
+    function test_asynchronousLoadPage () {
+        const page = "TestPage.qml?action=asynchronousLoadPage"
+        let loadedItem = null
+        compare(asyncPool.loadPage(page, item => loadedItem = item), null)
+        tryVerify(() => loadedItem !== null, 1000, "callback called with the page")
+        verify(asyncPool.contains(page), "pool contains page")
+        compare(asyncPool.lastLoadedItem, loadedItem)
+        compare(asyncPool.loadPage(page), loadedItem, "the page is only created once")
+    }
+
+    function test_maximumCachedPages () {
+        pool.maximumCachedPages = 2
+        for (let i = 1; i <= 3; ++i) {
+            pool.loadPage("TestPage.qml?action=maximumCachedPages&page=" + i)
+        }
+        compare(pool.items.length, 2, "pool only keeps 2 pages")
+        verify(!pool.contains("TestPage.qml?action=maximumCachedPages&page=1"), "least recently loaded page was evicted")
+        verify(pool.contains("TestPage.qml?action=maximumCachedPages&page=3"))
+        pool.maximumCachedPages = 0
+    }
+
+    function test_hibernatePage () {
+        const page = "TestPage.qml?action=hibernatePage"
+        pool.loadPageWithProperties(page, {title: "Hibernated"})
+        verify(pool.hibernatePage(page), "a page that is not shown can be hibernated")
+        verify(!pool.contains(page))
+        verify(pool.isHibernated(page))
+        const item = pool.loadPage(page)
+        compare(item.title, "Hibernated", "the page is recreated with its properties")
+        verify(!pool.isHibernated(page))
+    }
 }
@@ -0,0 +1,181 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include <QMutex>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QSemaphore>
+#include <QTest>
+
+#include <atomic>
+#include <memory>
+
+#include <platform/spellchecker.h>
+
+using namespace Qt::StringLiterals;
+
+using Kirigami::Platform::SpellChecker;
+using Kirigami::Platform::SpellCheckerFactory;
+
+// The misspellings are exposed as "start:length" pairs, and every value they
+// had is appended to the history.
+static const QByteArray textAreaSource = R"(
+import QtQuick
+import QtQuick.Templates as T
+import org.kde.kirigami as Kirigami
+
+T.TextArea {
+    readonly property string ranges: Kirigami.SpellCheck.misspellings.map(range => range.start + ":" + range.length).join(",")
+    property string history
+
+    Kirigami.SpellCheck.enabled: true
+    Kirigami.SpellCheck.language: "en_US"
+
+    onRangesChanged: history += ranges + ";"
+}
+)";
+
+/**
+ * Knows a handful of correct words, and records which words it is asked
+ * about. Checking "slow" blocks until the test releases it.
+ */
+class FakeSpellChecker : public SpellChecker
+{
+public:
+    bool isCorrect(QStringView word) override
+    {
+        {
+            QMutexLocker locker(&s_mutex);
+            s_checkedWords.append(word.toString());
+        }
+
+        if (word == u"slow") {
+            s_blocked = true;
+            s_release.acquire();
+        }
+
+        return word == u"good" || word == u"text" || word == u"slow";
+    }
+
+    static qsizetype timesChecked(const QString &word)
+    {
+        QMutexLocker locker(&s_mutex);
+        return s_checkedWords.count(word);
+    }
+
+    inline static QMutex s_mutex;
+    inline static QStringList s_checkedWords;
+    inline static std::atomic_bool s_blocked = false;
+    inline static QSemaphore s_release;
+};
+
+class FakeSpellCheckerFactory : public SpellCheckerFactory
+{
+public:
+    std::unique_ptr<SpellChecker> createSpellChecker(const QString &language) override
+    {
+        QMutexLocker locker(&m_mutex);
+        m_loads.append(language);
+        return std::make_unique<FakeSpellChecker>();
+    }
+
+    qsizetype loads(const QString &language)
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_loads.count(language);
+    }
+
+private:
+    QMutex m_mutex;
+    QStringList m_loads;
+};
+
+class SpellCheckTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        // The spell checking service picks the factory up when it is first used.
+        SpellCheckerFactory::setInstance(&m_factory);
+
+        m_component = std::make_unique<QQmlComponent>(&m_engine);
+        m_component->setData(textAreaSource, QUrl());
+        QVERIFY2(m_component->isReady(), qPrintable(m_component->errorString()));
+    }
+
+    void cleanupTestCase()
+    {
+        m_component.reset();
+    }
+
+    void testRanges()
+    {
+        auto area = createTextArea(u"good wrd text bda"_s);
+        QVERIFY(area);
+
+        QTRY_COMPARE(area->property("ranges").toString(), u"5:3,14:3"_s);
+    }
+
+    void testDictionaryLoadedOnce()
+    {
+        auto first = createTextArea(u"good first"_s);
+        auto second = createTextArea(u"good second"_s);
+        QVERIFY(first && second);
+
+        QTRY_COMPARE(first->property("ranges").toString(), u"5:5"_s);
+        QTRY_COMPARE(second->property("ranges").toString(), u"5:6"_s);
+        QCOMPARE(m_factory.loads(u"en_US"_s), 1);
+    }
+
+    void testWordCache()
+    {
+        auto area = createTextArea(u"good cached"_s);
+        QVERIFY(area);
+        QTRY_COMPARE(area->property("ranges").toString(), u"5:6"_s);
+
+        area->setProperty("text", u"cached good"_s);
+        QTRY_COMPARE(area->property("ranges").toString(), u"0:6"_s);
+        QCOMPARE(FakeSpellChecker::timesChecked(u"cached"_s), 1);
+    }
+
+    void testOutdatedCheckDropped()
+    {
+        auto area = createTextArea(u"slow outdated"_s);
+        QVERIFY(area);
+
+        // The worker is now busy checking the first word of the text.
+        QTRY_VERIFY(FakeSpellChecker::s_blocked.load());
+
+        area->setProperty("text", u"good current"_s);
+        FakeSpellChecker::s_release.release();
+
+        QTRY_COMPARE(area->property("ranges").toString(), u"5:7"_s);
+        // The outdated check stopped before getting to its second word, and
+        // its result never shows up.
+        QCOMPARE(FakeSpellChecker::timesChecked(u"outdated"_s), 0);
+        QCOMPARE(area->property("history").toString(), u"5:7;"_s);
+    }
+
+private:
+    std::unique_ptr<QObject> createTextArea(const QString &text)
+    {
+        std::unique_ptr<QObject> area(m_component->createWithInitialProperties({{u"text"_s, text}}));
+        if (!area) {
+            qWarning() << m_component->errorString();
+        }
+        return area;
+    }
+
+    FakeSpellCheckerFactory m_factory;
+    QQmlEngine m_engine;
+    std::unique_ptr<QQmlComponent> m_component;
+};
+
+QTEST_MAIN(SpellCheckTest)
+
+#include "spellchecktest.moc"
@@ -109,6 +109,50 @@ TestCase {
         compare(imageColors.palette[0], item.swatch);
     }
 
+    function test_extractColorsMedianCut(): void {
+        const item = createTemporaryObject(colorsComponent, testCase);
+        const { colorArea, imageColors, paletteChangedSpy } = item;
+
+        imageColors.algorithm = Kirigami.ImageColors.MedianCut;
+        colorArea.color = Qt.rgba(0, 0, 1);
+        imageColors.update();
+        paletteChangedSpy.wait();
+        compare(imageColors.dominant, colorArea.color);
+
+        compare(imageColors.palette.length, 1);
+        compare(imageColors.palette[0].ratio, 1.0);
+        compare(imageColors.palette[0].color, colorArea.color);
+    }
+
+    Component {
+        id: fileColorsComponent
+        Kirigami.ImageColors {
+            id: fileColors
+            readonly property SignalSpy paletteChangedSpy: SignalSpy {
+                target: fileColors
+                signalName: "paletteChanged"
+            }
+        }
+    }
+
+    function test_smallImageNotScaled(): void {
+        // 300x30 pixels of red, green and blue stripes, 151, 89 and 60 pixels
+        // wide. Scaling it down would blend the colors where the stripes meet.
+        const imageColors = createTemporaryObject(fileColorsComponent, testCase);
+        const spy = imageColors.paletteChangedSpy;
+        imageColors.source = Qt.resolvedUrl("stripes.png");
+        spy.wait();
+
+        compare(imageColors.palette.length, 3);
+        compare(imageColors.palette[0].color, Qt.rgba(1, 0, 0));
+        fuzzyCompare(imageColors.palette[0].ratio, 151 / 300, 0.0001);
+        compare(imageColors.palette[1].color, Qt.rgba(0, 1, 0));
+        fuzzyCompare(imageColors.palette[1].ratio, 89 / 300, 0.0001);
+        compare(imageColors.palette[2].color, Qt.rgba(0, 0, 1));
+        fuzzyCompare(imageColors.palette[2].ratio, 60 / 300, 0.0001);
+        compare(imageColors.dominant, Qt.rgba(1, 0, 0));
+    }
+
     function test_invisibleWindow(): void {
         // Do not attempt to grabToImage on an item whose window is invisible.
         failOnWarning(/.?/);
@@ -0,0 +1,94 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+import QtQuick
+import QtTest
+import org.kde.kirigami as Kirigami
+
+TestCase {
+    id: testCase
+
+    name: "CardsLayoutTests"
+    when: windowShown
+
+    width: 500
+    height: 500
+    visible: true
+
+    Component {
+        id: layoutComponent
+        Kirigami.CardsLayout {
+            maximumColumnWidth: 200
+            minimumColumnWidth: 100
+            rowSpacing: 10
+            columnSpacing: 10
+
+            Rectangle {
+                implicitHeight: 50
+            }
+            Rectangle {
+                implicitHeight: 70
+            }
+            Rectangle {
+                implicitHeight: 30
+            }
+        }
+    }
+
+    function test_columns() {
+        const layout = createTemporaryObject(layoutComponent, testCase, { width: 410 });
+        verify(layout);
+        compare(layout.columns, 2);
+
+        layout.forceLayout();
+        const [first, second, third] = layout.children;
+        compare(first.x, 0);
+        compare(first.width, 200);
+        compare(second.x, 210);
+        compare(second.width, 200);
+        compare(third.x, 0);
+        compare(third.y, 80);
+
+        // Cards are as tall as the tallest card of their row.
+        compare(first.height, 70);
+        compare(second.height, 70);
+        compare(third.height, 30);
+        compare(layout.implicitHeight, 110);
+
+        layout.width = 150;
+        compare(layout.columns, 1);
+        layout.forceLayout();
+        compare(second.x, 0);
+        compare(second.y, 60);
+        compare(second.width, 150);
+        compare(third.y, 140);
+        compare(layout.implicitHeight, 170);
+    }
+
+    function test_implicitHeightChange() {
+        const layout = createTemporaryObject(layoutComponent, testCase, { width: 410 });
+        verify(layout);
+        layout.forceLayout();
+
+        const [first, second, third] = layout.children;
+        first.implicitHeight = 100;
+        layout.forceLayout();
+        compare(second.height, 100);
+        compare(third.y, 110);
+        compare(layout.implicitHeight, 140);
+    }
+
+    function test_implicitWidth() {
+        const layout = createTemporaryObject(layoutComponent, testCase);
+        verify(layout);
+        // Two columns fit in the test case.
+        compare(layout.implicitWidth, 410);
+
+        layout.maximumColumns = 1;
+        layout.forceLayout();
+        compare(layout.implicitWidth, 200);
+    }
+}
@@ -37,5 +37,48 @@ TestCase {
         fuzzyCompare(result.b, expected.b, 0.001, "Colors are not the same, Actual: " + result + " Expected: " + expected + ", component is blue")
         fuzzyCompare(result.a, expected.a, 0.001, "Colors are not the same, Actual: " + result + " Expected: " + expected + ", component is alpha")
     }
-}
 
+    function test_linear_interpolations() {
+        const data = test_linear_interpolation_data()
+        for (const row of data) {
+            const results = Kirigami.ColorUtils.linearInterpolations(row.from, row.to, [0.0, row.amount, 1.0])
+            compare(results.length, 3, row.tag)
+
+            const expected = [Kirigami.ColorUtils.linearInterpolation(row.from, row.to, 0.0), row.expected, Kirigami.ColorUtils.linearInterpolation(row.from, row.to, 1.0)]
+            for (let i = 0; i < 3; ++i) {
+                fuzzyCompare(results[i].r, expected[i].r, 0.001, row.tag + ", red of color " + i)
+                fuzzyCompare(results[i].g, expected[i].g, 0.001, row.tag + ", green of color " + i)
+                fuzzyCompare(results[i].b, expected[i].b, 0.001, row.tag + ", blue of color " + i)
+                fuzzyCompare(results[i].a, expected[i].a, 0.001, row.tag + ", alpha of color " + i)
+            }
+        }
+    }
+
+    function test_gray_for_colors() {
+        const colors = [Qt.color("black"), Qt.color("white"), Qt.color("pink")]
+        const grays = Kirigami.ColorUtils.grayForColors(colors)
+        compare(grays.length, colors.length)
+        for (let i = 0; i < colors.length; ++i) {
+            fuzzyCompare(grays[i], Kirigami.ColorUtils.grayForColor(colors[i]), 0.0001)
+        }
+    }
+
+    function test_adjust_color() {
+        const color = Qt.rgba(0.5, 0.5, 0.5, 1.0)
+        let result = Kirigami.ColorUtils.adjustColor(color, {red: 20, alpha: -55})
+        compare(Math.round(result.r * 255), 148)
+        compare(Math.round(result.g * 255), 128)
+        compare(Math.round(result.a * 255), 200)
+
+        // The same arguments again, which are answered from the cache.
+        result = Kirigami.ColorUtils.adjustColor(color, {red: 20, alpha: -55})
+        compare(Math.round(result.r * 255), 148)
+
+        // Different adjustments must not be answered from the cache.
+        result = Kirigami.ColorUtils.adjustColor(color, {red: 30, alpha: -55})
+        compare(Math.round(result.r * 255), 158)
+
+        result = Kirigami.ColorUtils.scaleColor(color, {red: 20, alpha: -55})
+        verify(Math.round(result.r * 255) > 128)
+    }
+}
@@ -360,4 +360,38 @@ TestCase {
         mouseClick(layout, 50);
         compare(columnView.currentIndex, 1); // moves
     }
+    function test_keepAliveColumns() {
+        const view = createTemporaryObject(columnViewComponent, this, {
+            width: 500,
+            height: 500,
+            columnResizeMode: Kirigami.ColumnView.SingleColumn,
+            scrollDuration: 0,
+        });
+        verify(view);
+
+        const items = [];
+        for (let i = 0; i < 4; ++i) {
+            const item = createTemporaryObject(emptyItemPageComponent, this);
+            view.addItem(item);
+            items.push(item);
+        }
+        waitForPolish(view);
+
+        // Disabled by default
+        for (const item of items) {
+            verify(!item.Kirigami.ColumnView.suspended);
+        }
+
+        view.keepAliveColumns = 1;
+        compare(view.visibleItems.length, 1);
+        const visibleIndex = view.visibleItems[0].Kirigami.ColumnView.index;
+        for (let i = 0; i < items.length; ++i) {
+            compare(items[i].Kirigami.ColumnView.suspended, Math.abs(i - visibleIndex) > 1, `column ${i}`);
+        }
+
+        view.keepAliveColumns = -1;
+        for (const item of items) {
+            verify(!item.Kirigami.ColumnView.suspended);
+        }
+    }
 }
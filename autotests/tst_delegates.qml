@@ -36,6 +36,13 @@ TestCase {
         KD.SwitchSubtitleDelegate {}
     }
 
+    Component {
+        id: titleSubtitle
+        KD.TitleSubtitle {
+            title: "Title"
+        }
+    }
+
     function test_create() {
         failOnWarning(/error/i);
         {
@@ -55,4 +62,34 @@ TestCase {
             verify(delegate);
         }
     }
+
+    function test_titleSubtitle() {
+        const item = createTemporaryObject(titleSubtitle, this);
+        verify(item);
+        verify(!item.subtitleVisible);
+        verify(item.implicitWidth > 0);
+
+        const titleHeight = item.implicitHeight;
+        verify(titleHeight > 0);
+
+        item.reserveSpaceForSubtitle = true;
+        verify(item.subtitleVisible);
+        verify(item.implicitHeight > titleHeight);
+        const reservedHeight = item.implicitHeight;
+
+        item.reserveSpaceForSubtitle = false;
+        item.subtitle = "Subtitle";
+        verify(item.subtitleVisible);
+        compare(item.implicitHeight, reservedHeight);
+
+        verify(!item.truncated);
+        item.width = 5;
+        tryVerify(() => item.truncated);
+
+        const color = item.color;
+        item.color = "red";
+        compare(item.color, "#ff0000");
+        item.color = undefined;
+        compare(item.color, color);
+    }
 }
@@ -32,6 +32,15 @@ TestCase {
             source: Qt.resolvedUrl("stop-icon.svg")
         }
     }
+    Component {
+        id: asynchronousIcon
+        Kirigami.Icon {
+            width: 50
+            height: 50
+            asynchronous: true
+            source: Qt.resolvedUrl("stop-icon.svg")
+        }
+    }
     Kirigami.ImageColors {
         id: imageColors
     }
@@ -67,4 +76,13 @@ TestCase {
         })
         tryCompare(imageColors, "dominant", "#2980b9")
     }
+
+    function test_asynchronous() {
+        var icon = createTemporaryObject(asynchronousIcon, testCase)
+        verify(icon)
+        tryCompare(icon, "status", Kirigami.Icon.Ready)
+        verify(icon.valid)
+        verify(waitForRendering(icon))
+        verify(icon.paintedWidth > 0)
+    }
 }
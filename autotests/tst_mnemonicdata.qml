@@ -25,10 +25,37 @@ TestCase {
     }
 
     function test_disable_shortcut() {
-        compare(sequenceChangedSpy.count, 0);
+        // Sequences are assigned asynchronously
+        tryCompare(testCase.Kirigami.MnemonicData, "mnemonicLabel", "设置(&S)");
+        sequenceChangedSpy.clear();
         testCase.Kirigami.MnemonicData.enabled = false;
-        compare(sequenceChangedSpy.count, 1);
+        tryCompare(sequenceChangedSpy, "count", 1);
+        compare(testCase.Kirigami.MnemonicData.mnemonicLabel, "设置");
         testCase.Kirigami.MnemonicData.enabled = true;
-        compare(sequenceChangedSpy.count, 2);
+        tryCompare(sequenceChangedSpy, "count", 2);
+        compare(testCase.Kirigami.MnemonicData.mnemonicLabel, "设置(&S)");
+    }
+
+    Item {
+        id: conflictA
+        Kirigami.MnemonicData.controlType: Kirigami.MnemonicData.SecondaryControl
+        Kirigami.MnemonicData.label: "Open"
+    }
+
+    Item {
+        id: conflictB
+        Kirigami.MnemonicData.controlType: Kirigami.MnemonicData.DialogButton
+        Kirigami.MnemonicData.label: "Ok"
+    }
+
+    function test_conflict() {
+        // The more important dialog button gets the first letter.
+        tryCompare(conflictB.Kirigami.MnemonicData, "mnemonicLabel", "&Ok");
+        tryCompare(conflictA.Kirigami.MnemonicData, "mnemonicLabel", "O&pen");
+
+        conflictB.Kirigami.MnemonicData.enabled = false;
+        tryCompare(conflictA.Kirigami.MnemonicData, "mnemonicLabel", "&Open");
+        conflictB.Kirigami.MnemonicData.enabled = true;
+        tryCompare(conflictA.Kirigami.MnemonicData, "mnemonicLabel", "O&pen");
     }
 }
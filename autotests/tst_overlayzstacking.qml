@@ -234,4 +234,22 @@ TestCase {
         compare(spy.count, 1);
         compare(child.z, 9001);
     }
+
+    Component {
+        id: itemComponent
+        Item {}
+    }
+
+    function test_ancestorReparented() {
+        const parent = createTemporaryObject(defaultComponent, this, { parent: this });
+        const container = createTemporaryObject(itemComponent, this);
+        const child = createTemporaryObject(defaultComponent, this, { parent: container });
+        compare(child.z, 0);
+
+        container.parent = parent.contentItem;
+        compare(child.z, 1);
+
+        container.parent = this;
+        compare(child.z, 0);
+    }
 }
@@ -231,4 +231,45 @@ TestCase {
         compare(reparentingXSpy.count, 5);
         compare(reparentingYSpy.count, 5);
     }
+
+    Item {
+        id: outerItem
+        x: 5
+        y: 10
+
+        Item {
+            id: middleItem
+            x: 20
+            y: 40
+
+            Item {
+                id: innerItem
+                x: 1
+                y: 2
+            }
+        }
+    }
+
+    function test_ancestorWithScenePosition() {
+        // Make sure the ancestor has a ScenePosition before the inner item.
+        compare(middleItem.Kirigami.ScenePosition.x, 25);
+        compare(middleItem.Kirigami.ScenePosition.y, 50);
+        compare(innerItem.Kirigami.ScenePosition.x, 26);
+        compare(innerItem.Kirigami.ScenePosition.y, 52);
+
+        outerItem.x = 105;
+        compare(middleItem.Kirigami.ScenePosition.x, 125);
+        compare(innerItem.Kirigami.ScenePosition.x, 126);
+
+        middleItem.y = 140;
+        compare(middleItem.Kirigami.ScenePosition.y, 150);
+        compare(innerItem.Kirigami.ScenePosition.y, 152);
+
+        middleItem.parent = newParent;
+        compare(middleItem.Kirigami.ScenePosition.x, newParent.x + 20);
+        compare(innerItem.Kirigami.ScenePosition.x, newParent.x + 21);
+
+        outerItem.x = 0;
+        compare(innerItem.Kirigami.ScenePosition.x, newParent.x + 21);
+    }
 }
@@ -0,0 +1,93 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+import QtQml
+import QtQuick
+import org.kde.kirigami as Kirigami
+import QtTest
+
+TestCase {
+    name: "SearchFilterModelTest"
+
+    Component {
+        id: modelComponent
+        Kirigami.SearchFilterModel {
+            filterRoleName: "name"
+            sourceModel: ListModel {
+                ListElement { name: "Open File" }
+                ListElement { name: "Save File" }
+                ListElement { name: "Save All" }
+                ListElement { name: "Close" }
+            }
+        }
+    }
+
+    Component {
+        id: instantiatorComponent
+        Instantiator {
+            delegate: QtObject {
+                required property string name
+            }
+        }
+    }
+
+    // The names of the rows of model, read the way views read them.
+    function names(model: Kirigami.SearchFilterModel): list<string> {
+        const instantiator = createTemporaryObject(instantiatorComponent, this, { model });
+        const result = [];
+        for (let row = 0; row < instantiator.count; ++row) {
+            result.push(instantiator.objectAt(row).name);
+        }
+        instantiator.destroy();
+        return result;
+    }
+
+    function test_filter() {
+        const model = createTemporaryObject(modelComponent, this);
+        verify(model);
+        compare(model.rowCount(), 4);
+
+        model.filterText = "save";
+        tryVerify(() => !model.busy);
+        compare(names(model), ["Save File", "Save All"]);
+
+        // Narrowing down the previous results.
+        model.filterText = "save f";
+        tryVerify(() => !model.busy);
+        compare(names(model), ["Save File"]);
+
+        model.filterText = "file";
+        tryVerify(() => !model.busy);
+        compare(names(model), ["Open File", "Save File"]);
+
+        model.filterCaseSensitivity = Qt.CaseSensitive;
+        tryVerify(() => !model.busy);
+        compare(model.rowCount(), 0);
+
+        model.filterText = "";
+        tryVerify(() => !model.busy);
+        compare(model.rowCount(), 4);
+    }
+
+    function test_sourceChanges() {
+        const model = createTemporaryObject(modelComponent, this);
+        model.filterText = "save";
+        tryVerify(() => !model.busy);
+        compare(model.rowCount(), 2);
+
+        model.sourceModel.append({ name: "Save As" });
+        tryVerify(() => !model.busy);
+        compare(names(model), ["Save File", "Save All", "Save As"]);
+
+        model.sourceModel.setProperty(0, "name", "Save Copy");
+        tryVerify(() => !model.busy);
+        compare(names(model), ["Save Copy", "Save File", "Save All", "Save As"]);
+
+        model.sourceModel.remove(1);
+        tryVerify(() => !model.busy);
+        compare(names(model), ["Save Copy", "Save All", "Save As"]);
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+import QtQuick
+import QtTest
+import org.kde.kirigami as Kirigami
+
+TestCase {
+    id: testCase
+    name: "ShadowedRectangleTests"
+
+    width: 220
+    height: 100
+    visible: true
+
+    when: windowShown
+
+    // Both rectangles use the same parameters, one rendered by the shader,
+    // the other one by the software path.
+    Kirigami.ShadowedRectangle {
+        id: shaderRectangle
+        x: 0
+        width: 100
+        height: 100
+        color: "red"
+        border.width: 10
+        border.color: "blue"
+    }
+
+    Kirigami.ShadowedRectangle {
+        id: softwareRectangle
+        x: 120
+        width: 100
+        height: 100
+        color: "red"
+        border.width: 10
+        border.color: "blue"
+        renderType: Kirigami.ShadowedRectangle.Software
+    }
+
+    function fuzzyCompareColor(actual, expected, message) {
+        const tolerance = 0.05
+        verify(Math.abs(actual.r - expected.r) < tolerance
+            && Math.abs(actual.g - expected.g) < tolerance
+            && Math.abs(actual.b - expected.b) < tolerance
+            && Math.abs(actual.a - expected.a) < tolerance,
+            `${message}: ${actual} != ${expected}`)
+    }
+
+    function test_border() {
+        waitForRendering(testCase)
+
+        const shaderImage = grabImage(shaderRectangle)
+        const softwareImage = grabImage(softwareRectangle)
+
+        // Skip the pixels next to the edges, which are smoothed differently.
+        for (let x = 1; x < 99; ++x) {
+            if (Math.abs(x - 10) <= 1 || Math.abs(x - 89) <= 1) {
+                continue
+            }
+            const expected = x < 10 || x > 89 ? Qt.color("blue") : Qt.color("red")
+            fuzzyCompareColor(shaderImage.pixel(x, 50), expected, `Shader pixel ${x}`)
+            fuzzyCompareColor(softwareImage.pixel(x, 50), shaderImage.pixel(x, 50), `Software pixel ${x}`)
+        }
+    }
+}
@@ -44,4 +44,18 @@ TestCase {
 
         verify(area.Kirigami.SpellCheck.enabled);
     }
+
+    function test_language() {
+        const area = createTemporaryObject(emptyComponent, this);
+        verify(area);
+
+        const defaultLanguage = area.Kirigami.SpellCheck.language;
+        verify(defaultLanguage.length > 0);
+
+        area.Kirigami.SpellCheck.language = "de_DE";
+        compare(area.Kirigami.SpellCheck.language, "de_DE");
+
+        area.Kirigami.SpellCheck.language = undefined;
+        compare(area.Kirigami.SpellCheck.language, defaultLanguage);
+    }
 }
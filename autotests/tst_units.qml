@@ -0,0 +1,71 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+import QtQuick
+import org.kde.kirigami as Kirigami
+import QtTest
+
+TestCase {
+    id: root
+
+    name: "UnitsTest"
+
+    SignalSpy {
+        id: reducedMotionSpy
+        target: Kirigami.Units
+        signalName: "reducedMotionChanged"
+    }
+
+    SignalSpy {
+        id: longDurationSpy
+        target: Kirigami.Units
+        signalName: "longDurationChanged"
+    }
+
+    function cleanup() {
+        Kirigami.Units.reducedMotion = undefined;
+        reducedMotionSpy.clear();
+        longDurationSpy.clear();
+    }
+
+    function test_reducedMotion() {
+        Kirigami.Units.reducedMotion = false;
+        verify(Kirigami.Units.veryShortDuration > 0);
+        verify(Kirigami.Units.shortDuration > 0);
+        verify(Kirigami.Units.longDuration > 0);
+        verify(Kirigami.Units.veryLongDuration > 0);
+        reducedMotionSpy.clear();
+        longDurationSpy.clear();
+
+        Kirigami.Units.reducedMotion = true;
+        compare(reducedMotionSpy.count, 1);
+        compare(longDurationSpy.count, 1);
+        compare(Kirigami.Units.veryShortDuration, 0);
+        compare(Kirigami.Units.shortDuration, 0);
+        compare(Kirigami.Units.longDuration, 0);
+        compare(Kirigami.Units.veryLongDuration, 0);
+
+        // Durations that are not used for animations are kept.
+        verify(Kirigami.Units.humanMoment > 0);
+        verify(Kirigami.Units.toolTipDelay > 0);
+
+        Kirigami.Units.reducedMotion = true;
+        compare(reducedMotionSpy.count, 1);
+
+        Kirigami.Units.reducedMotion = false;
+        compare(reducedMotionSpy.count, 2);
+        verify(Kirigami.Units.longDuration > 0);
+    }
+
+    function test_resetFollowsPlatform() {
+        const platformValue = Kirigami.Units.reducedMotion;
+        Kirigami.Units.reducedMotion = !platformValue;
+        compare(Kirigami.Units.reducedMotion, !platformValue);
+
+        Kirigami.Units.reducedMotion = undefined;
+        compare(Kirigami.Units.reducedMotion, platformValue);
+    }
+}
@@ -0,0 +1,18 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+/**
+ * The number of allocations made by the process so far.
+ *
+ * Linking allocationcounter.cpp into a benchmark replaces the global
+ * operator new and delete of the whole executable to count allocations, so
+ * only benchmarks reporting them should do it.
+ */
+quint64 allocationCount();
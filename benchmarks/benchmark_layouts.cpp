@@ -0,0 +1,374 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QQuickRenderControl>
+#include <QQuickWindow>
+#include <QTest>
+
+#include <functional>
+#include <memory>
+
+#include "allocationcounter.h"
+
+using namespace Qt::StringLiterals;
+
+static const QString columnViewScene = uR"(
+import QtQuick
+import org.kde.kirigami as Kirigami
+
+Kirigami.ColumnView {
+    width: 800
+    height: 600
+    columnWidth: 300
+    scrollDuration: 0
+}
+)"_s;
+
+static const QString toolBarLayoutScene = uR"(
+import QtQuick
+import org.kde.kirigami as Kirigami
+
+Kirigami.ToolBarLayout {
+    id: root
+
+    property int count
+
+    height: 40
+    spacing: 4
+
+    actions: Array.from({length: count}, (_, index) => action.createObject(root, {text: "Action " + index}))
+
+    fullDelegate: Rectangle {
+        implicitWidth: 80
+        implicitHeight: 32
+    }
+    iconDelegate: Rectangle {
+        implicitWidth: 32
+        implicitHeight: 32
+    }
+    moreButton: Rectangle {
+        implicitWidth: 32
+        implicitHeight: 32
+    }
+
+    property Component action: Component {
+        Kirigami.Action {}
+    }
+}
+)"_s;
+
+static const QString headerFooterLayoutScene = uR"(
+import QtQuick
+import org.kde.kirigami as Kirigami
+
+Kirigami.HeaderFooterLayout {
+    width: 400
+    height: 600
+
+    header: Rectangle {
+        implicitWidth: 400
+        implicitHeight: 40
+    }
+    contentItem: Rectangle {
+        implicitWidth: 400
+        implicitHeight: 400
+    }
+    footer: Rectangle {
+        implicitWidth: 400
+        implicitHeight: 40
+    }
+}
+)"_s;
+
+static const QString sizeGroupScene = uR"(
+import QtQuick
+import org.kde.kirigami as Kirigami
+
+Item {
+    id: root
+
+    property int count
+    property alias group: group
+
+    Repeater {
+        id: repeater
+        model: root.count
+        delegate: Rectangle {
+            implicitWidth: 20 + index % 50
+            implicitHeight: 20 + index % 30
+        }
+    }
+
+    Kirigami.SizeGroup {
+        id: group
+        mode: Kirigami.SizeGroup.Both
+        items: Array.from({length: repeater.count}, (_, index) => repeater.itemAt(index))
+    }
+}
+)"_s;
+
+static const QString paddingScene = uR"(
+import QtQuick
+import org.kde.kirigami as Kirigami
+
+Kirigami.Padding {
+    width: 400
+    height: 300
+
+    contentItem: Rectangle {
+        implicitWidth: 200
+        implicitHeight: 100
+    }
+}
+)"_s;
+
+/**
+ * Micro-benchmarks for the layouts that run on every resize and navigation.
+ *
+ * Every benchmark reports the time per operation through QBENCHMARK and
+ * prints the number of allocations a single operation needs.
+ */
+class LayoutsBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        // Polishing does not need any rendering, so the render control is
+        // never initialized.
+        m_renderControl = std::make_unique<QQuickRenderControl>();
+        m_window = std::make_unique<QQuickWindow>(m_renderControl.get());
+        m_window->resize(1600, 1200);
+    }
+
+    void cleanupTestCase()
+    {
+        m_window.reset();
+        m_renderControl.reset();
+    }
+
+    void cleanup()
+    {
+        delete m_root;
+        m_root = nullptr;
+    }
+
+    void benchmarkColumnViewInsert_data()
+    {
+        addCounts({10, 50});
+    }
+
+    void benchmarkColumnViewInsert()
+    {
+        QFETCH(int, count);
+        createScene(columnViewScene);
+
+        measure([&]() {
+            for (int i = 0; i < count; ++i) {
+                QMetaObject::invokeMethod(m_root, "insertItem", Q_ARG(int, 0), Q_ARG(QQuickItem *, createColumn()));
+                polish();
+            }
+            QMetaObject::invokeMethod(m_root, "clear");
+            polish();
+        });
+    }
+
+    void benchmarkColumnViewPop_data()
+    {
+        addCounts({10, 50});
+    }
+
+    void benchmarkColumnViewPop()
+    {
+        QFETCH(int, count);
+        createScene(columnViewScene);
+
+        measure([&]() {
+            for (int i = 0; i < count; ++i) {
+                QMetaObject::invokeMethod(m_root, "addItem", Q_ARG(QQuickItem *, createColumn()));
+            }
+            polish();
+            for (int i = 0; i < count; ++i) {
+                QQuickItem *item = nullptr;
+                QMetaObject::invokeMethod(m_root, "pop", Q_RETURN_ARG(QQuickItem *, item));
+                polish();
+            }
+        });
+    }
+
+    void benchmarkColumnViewMove_data()
+    {
+        addCounts({10, 50});
+    }
+
+    void benchmarkColumnViewMove()
+    {
+        QFETCH(int, count);
+        createScene(columnViewScene);
+        for (int i = 0; i < count; ++i) {
+            QMetaObject::invokeMethod(m_root, "addItem", Q_ARG(QQuickItem *, createColumn()));
+        }
+        polish();
+
+        measure([&]() {
+            QMetaObject::invokeMethod(m_root, "moveItem", Q_ARG(int, 0), Q_ARG(int, count - 1));
+            polish();
+        });
+    }
+
+    void benchmarkColumnViewScroll_data()
+    {
+        addCounts({10, 50});
+    }
+
+    void benchmarkColumnViewScroll()
+    {
+        QFETCH(int, count);
+        createScene(columnViewScene);
+        for (int i = 0; i < count; ++i) {
+            QMetaObject::invokeMethod(m_root, "addItem", Q_ARG(QQuickItem *, createColumn()));
+        }
+        polish();
+
+        measure([&]() {
+            m_root->setProperty("currentIndex", 0);
+            polish();
+            m_root->setProperty("currentIndex", count - 1);
+            polish();
+        });
+    }
+
+    void benchmarkToolBarLayoutResize_data()
+    {
+        addCounts({5, 20, 100});
+    }
+
+    // Resize a toolbar from narrow to wide, in steps of 100 pixels.
+    void benchmarkToolBarLayoutResize()
+    {
+        QFETCH(int, count);
+        createScene(toolBarLayoutScene, {{u"count"_s, count}});
+        polish();
+
+        measure([&]() {
+            for (int width = 100; width <= 1600; width += 100) {
+                m_root->setWidth(width);
+                polish();
+            }
+        });
+    }
+
+    void benchmarkHeaderFooterLayout()
+    {
+        createScene(headerFooterLayoutScene);
+        polish();
+
+        bool toggle = false;
+        measure([&]() {
+            toggle = !toggle;
+            m_root->setHeight(toggle ? 500 : 600);
+            QMetaObject::invokeMethod(m_root, "forceLayout");
+        });
+    }
+
+    void benchmarkSizeGroup_data()
+    {
+        addCounts({10, 100});
+    }
+
+    void benchmarkSizeGroup()
+    {
+        QFETCH(int, count);
+        createScene(sizeGroupScene, {{u"count"_s, count}});
+
+        auto group = m_root->property("group").value<QObject *>();
+        QVERIFY(group);
+
+        measure([&]() {
+            QMetaObject::invokeMethod(group, "relayout");
+        });
+    }
+
+    void benchmarkPadding()
+    {
+        createScene(paddingScene);
+        polish();
+
+        bool toggle = false;
+        measure([&]() {
+            toggle = !toggle;
+            m_root->setProperty("padding", toggle ? 10.0 : 20.0);
+            polish();
+        });
+    }
+
+private:
+    void addCounts(std::initializer_list<int> counts)
+    {
+        QTest::addColumn<int>("count");
+        for (int count : counts) {
+            QTest::addRow("%d", count) << count;
+        }
+    }
+
+    void createScene(const QString &data, const QVariantMap &properties = {})
+    {
+        QQmlComponent component(&m_engine);
+        component.setData(data.toUtf8(), QUrl{});
+        if (component.isError()) {
+            QFAIL(qPrintable(component.errorString()));
+        }
+
+        m_root = qobject_cast<QQuickItem *>(component.createWithInitialProperties(properties));
+        QVERIFY(m_root);
+        m_root->setParentItem(m_window->contentItem());
+    }
+
+    QQuickItem *createColumn()
+    {
+        // Like columns created from QML, these are deleted by the view when
+        // removed, or together with the view.
+        auto item = new QQuickItem;
+        item->setParent(m_root);
+        item->setImplicitSize(300, 600);
+        QQmlEngine::setObjectOwnership(item, QQmlEngine::JavaScriptOwnership);
+        return item;
+    }
+
+    void polish()
+    {
+        m_renderControl->polishItems();
+    }
+
+    void measure(const std::function<void()> &operation)
+    {
+        QVERIFY(m_root);
+
+        // The first run may create things that are cached afterwards.
+        operation();
+
+        const quint64 before = allocationCount();
+        operation();
+        qInfo() << "Allocations per operation:" << allocationCount() - before;
+
+        QBENCHMARK {
+            operation();
+        }
+    }
+
+    QQmlEngine m_engine;
+    std::unique_ptr<QQuickRenderControl> m_renderControl;
+    std::unique_ptr<QQuickWindow> m_window;
+    QQuickItem *m_root = nullptr;
+};
+
+QTEST_MAIN(LayoutsBenchmark)
+
+#include "benchmark_layouts.moc"
@@ -0,0 +1,248 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QTest>
+
+#include <algorithm>
+#include <memory>
+
+#include "offscreenrenderer.h"
+
+using namespace Qt::StringLiterals;
+
+static const QSize windowSize{1024, 1024};
+
+// Lays out count instances of a delegate in a grid, all of which are visible.
+static const QString sceneTemplate = uR"(
+import QtQuick
+import org.kde.kirigami as Kirigami
+
+Item {
+    id: root
+
+    property int count
+    property color color: "white"
+
+    Rectangle {
+        id: textureSource
+        width: 64
+        height: 64
+        color: "steelblue"
+        layer.enabled: true
+        visible: false
+    }
+
+    Flow {
+        anchors.fill: parent
+        spacing: 4
+
+        Repeater {
+            model: root.count
+            delegate: %1
+        }
+    }
+}
+)"_s;
+
+static const QString shadowedRectangle = uR"(
+Kirigami.ShadowedRectangle {
+    width: 48
+    height: 32
+    radius: 6
+    color: root.color
+    renderType: %1
+    border.width: 1
+    border.color: "black"
+    shadow.size: 8
+    shadow.yOffset: 2
+    shadow.color: Qt.rgba(0, 0, 0, 0.3)
+}
+)"_s;
+
+static const QString shadowedTexture = uR"(
+Kirigami.ShadowedTexture {
+    width: 48
+    height: 32
+    radius: 6
+    color: root.color
+    renderType: %1
+    source: textureSource
+    shadow.size: 8
+    shadow.yOffset: 2
+    shadow.color: Qt.rgba(0, 0, 0, 0.3)
+}
+)"_s;
+
+static const QString icon = uR"(
+Kirigami.Icon {
+    width: 22
+    height: 22
+    source: "document-open"
+    color: root.color
+    isMask: true
+}
+)"_s;
+
+/**
+ * Measures rendering scenes with many instances of the primitives.
+ *
+ * Batches and draw calls for a scene can be inspected by running the
+ * benchmark with `QSG_RENDERER_DEBUG=render`.
+ */
+class PrimitivesBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        m_renderer = std::make_unique<OffscreenRenderer>(windowSize);
+        if (!m_renderer->initialize()) {
+            QSKIP("Could not initialize offscreen rendering");
+        }
+
+        qInfo() << "Rendering using" << m_renderer->rhi()->backendName() << "on" << m_renderer->rhi()->driverInfo().deviceName;
+    }
+
+    void cleanupTestCase()
+    {
+        m_renderer.reset();
+    }
+
+    void cleanup()
+    {
+        if (m_root) {
+            logStatistics();
+        }
+        delete m_root;
+        m_root = nullptr;
+        // Make sure everything related to the scene is released before the next one.
+        renderFrame();
+    }
+
+    void benchmarkStatic_data()
+    {
+        addRows();
+    }
+
+    // Rendering a scene that does not change between frames.
+    void benchmarkStatic()
+    {
+        QFETCH(QString, delegate);
+        QFETCH(int, count);
+
+        createScene(delegate, count);
+        QVERIFY(m_root);
+        renderFrame();
+
+        QBENCHMARK {
+            renderFrame();
+        }
+    }
+
+    void benchmarkUpdate_data()
+    {
+        addRows();
+    }
+
+    // Rendering a scene where every item changes for every frame.
+    void benchmarkUpdate()
+    {
+        QFETCH(QString, delegate);
+        QFETCH(int, count);
+
+        createScene(delegate, count);
+        QVERIFY(m_root);
+        renderFrame();
+
+        bool toggle = false;
+        QBENCHMARK {
+            toggle = !toggle;
+            m_root->setProperty("color", toggle ? QColor(Qt::red) : QColor(Qt::white));
+            renderFrame();
+        }
+    }
+
+    void benchmarkCreate_data()
+    {
+        addRows();
+    }
+
+    // Creating a scene and rendering it for the first time.
+    void benchmarkCreate()
+    {
+        QFETCH(QString, delegate);
+        QFETCH(int, count);
+
+        QBENCHMARK {
+            delete m_root;
+            m_root = nullptr;
+            createScene(delegate, count);
+            renderFrame();
+        }
+    }
+
+private:
+    void addRows()
+    {
+        QTest::addColumn<QString>("delegate");
+        QTest::addColumn<int>("count");
+
+        const std::pair<const char *, QString> delegates[] = {
+            {"ShadowedRectangle", shadowedRectangle.arg(u"Kirigami.ShadowedRectangle.HighQuality")},
+            {"ShadowedRectangle (low power)", shadowedRectangle.arg(u"Kirigami.ShadowedRectangle.LowQuality")},
+            {"ShadowedRectangle (cached shadow)", shadowedRectangle.arg(u"Kirigami.ShadowedRectangle.CachedShadow")},
+            {"ShadowedTexture", shadowedTexture.arg(u"Kirigami.ShadowedRectangle.HighQuality")},
+            {"ShadowedTexture (low power)", shadowedTexture.arg(u"Kirigami.ShadowedRectangle.LowQuality")},
+            {"Icon", icon},
+        };
+
+        for (const auto &[name, delegate] : delegates) {
+            for (int count : {10, 100, 1000}) {
+                QTest::addRow("%s, %d", name, count) << delegate << count;
+            }
+        }
+    }
+
+    void createScene(const QString &delegate, int count)
+    {
+        QQmlComponent component(&m_engine);
+        component.setData(sceneTemplate.arg(delegate).toUtf8(), QUrl{});
+        if (component.isError()) {
+            QFAIL(qPrintable(component.errorString()));
+        }
+
+        m_root = qobject_cast<QQuickItem *>(component.createWithInitialProperties({{u"count"_s, count}}));
+        QVERIFY(m_root);
+        m_root->setSize(windowSize);
+        m_root->setParentItem(m_renderer->window()->contentItem());
+    }
+
+    void renderFrame()
+    {
+        m_renderer->renderFrame();
+    }
+
+    void logStatistics()
+    {
+        // Memory statistics are only available with some graphics APIs.
+        const QRhiStats stats = m_renderer->rhi()->statistics();
+        if (stats.totalUsageBytes > 0 || stats.usedBytes > 0) {
+            qInfo() << "Graphics memory used:" << std::max(stats.totalUsageBytes, stats.usedBytes) / 1024 << "KiB";
+        }
+    }
+
+    QQmlEngine m_engine;
+    std::unique_ptr<OffscreenRenderer> m_renderer;
+    QQuickItem *m_root = nullptr;
+};
+
+QTEST_MAIN(PrimitivesBenchmark)
+
+#include "benchmark_primitives.moc"
@@ -0,0 +1,347 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QTest>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "offscreenrenderer.h"
+
+using namespace Qt::StringLiterals;
+
+static const QSize windowSize{1280, 800};
+// Frames are started at this interval, like a 60Hz display would.
+static constexpr qint64 frameInterval = 16;
+
+// Every scenario provides run(frame), which is called before rendering every
+// frame and returns false once the scenario is done.
+static const QString pageRowScenario = uR"(
+import QtQuick
+import QtQuick.Controls as QQC2
+import org.kde.kirigami as Kirigami
+
+Kirigami.ApplicationItem {
+    id: root
+
+    readonly property int pageCount: 20
+    // Leave enough frames for the animations to finish.
+    readonly property int framesPerStep: 20
+
+    property Component pageComponent: Component {
+        Kirigami.ScrollablePage {
+            title: "Page"
+
+            actions: [
+                Kirigami.Action {
+                    text: "Action"
+                    icon.name: "document-save"
+                }
+            ]
+
+            ListView {
+                model: 50
+                delegate: QQC2.ItemDelegate {
+                    width: ListView.view.width
+                    text: "Item " + index
+                }
+            }
+        }
+    }
+
+    function run(frame) {
+        if (frame % framesPerStep !== 0) {
+            return true;
+        }
+
+        const step = frame / framesPerStep;
+        if (step < pageCount) {
+            pageStack.push(pageComponent);
+            return true;
+        } else if (step < pageCount * 2) {
+            pageStack.pop();
+            return true;
+        }
+        return false;
+    }
+}
+)"_s;
+
+static const QString globalDrawerScenario = uR"(
+import QtQuick
+import org.kde.kirigami as Kirigami
+
+Kirigami.ApplicationItem {
+    id: root
+
+    readonly property int framesPerStep: 30
+
+    globalDrawer: Kirigami.GlobalDrawer {
+        modal: true
+        title: "Application"
+        titleIcon: "applications-graphics"
+
+        actions: [
+            Kirigami.Action { text: "View"; icon.name: "view-list-icons" },
+            Kirigami.Action { text: "Open"; icon.name: "document-open" },
+            Kirigami.Action { text: "Save"; icon.name: "document-save" },
+            Kirigami.Action { text: "Print"; icon.name: "document-print" },
+            Kirigami.Action { text: "Settings"; icon.name: "configure" },
+            Kirigami.Action { text: "Quit"; icon.name: "application-exit" }
+        ]
+    }
+
+    pageStack.initialPage: Kirigami.Page {
+        title: "Page"
+    }
+
+    function run(frame) {
+        if (frame % framesPerStep !== 0) {
+            return true;
+        }
+
+        const step = frame / framesPerStep;
+        if (step >= 20) {
+            return false;
+        }
+
+        if (step % 2 === 0) {
+            globalDrawer.open();
+        } else {
+            globalDrawer.close();
+        }
+        return true;
+    }
+}
+)"_s;
+
+static const QString overlaySheetScenario = uR"(
+import QtQuick
+import QtQuick.Controls as QQC2
+import QtQuick.Layouts
+import org.kde.kirigami as Kirigami
+
+Kirigami.ApplicationItem {
+    id: root
+
+    readonly property int framesPerStep: 30
+
+    pageStack.initialPage: Kirigami.Page {
+        title: "Page"
+
+        Kirigami.OverlaySheet {
+            id: sheet
+            title: "Sheet"
+
+            ColumnLayout {
+                Repeater {
+                    model: 200
+                    delegate: QQC2.Label {
+                        text: "Line " + index + " of the long content of the sheet"
+                    }
+                }
+            }
+        }
+    }
+
+    function run(frame) {
+        if (frame % framesPerStep !== 0) {
+            return true;
+        }
+
+        const step = frame / framesPerStep;
+        if (step >= 20) {
+            return false;
+        }
+
+        if (step % 2 === 0) {
+            sheet.open();
+        } else {
+            sheet.close();
+        }
+        return true;
+    }
+}
+)"_s;
+
+static const QString listScrollScenario = uR"(
+import QtQuick
+import org.kde.kirigami as Kirigami
+import org.kde.kirigami.delegates as KD
+
+Kirigami.ApplicationItem {
+    id: root
+
+    readonly property int scrollFrames: 600
+    readonly property real scrollStep: 40
+
+    pageStack.initialPage: Kirigami.ScrollablePage {
+        title: "List"
+
+        ListView {
+            id: list
+            model: 10000
+            delegate: KD.SubtitleDelegate {
+                width: ListView.view.width
+                text: "Item " + index
+                subtitle: "Subtitle of item " + index
+                icon.name: index % 2 ? "document-open" : "document-save"
+            }
+        }
+    }
+
+    function run(frame) {
+        if (frame >= scrollFrames) {
+            return false;
+        }
+
+        list.contentY = Math.min(frame * scrollStep, list.contentHeight - list.height);
+        return true;
+    }
+}
+)"_s;
+
+// The resident memory of the process, in bytes, or -1 if it is not known.
+static qint64 residentMemory()
+{
+#ifdef Q_OS_LINUX
+    QFile status(u"/proc/self/status"_s);
+    if (status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        while (!status.atEnd()) {
+            const QByteArray line = status.readLine();
+            if (line.startsWith("VmRSS:")) {
+                return line.mid(6).trimmed().split(' ').first().toLongLong() * 1024;
+            }
+        }
+    }
+#endif
+    return -1;
+}
+
+static qreal percentile(const std::vector<qreal> &sortedTimes, qreal fraction)
+{
+    if (sortedTimes.empty()) {
+        return 0.0;
+    }
+    const auto index = std::min(sortedTimes.size() - 1, size_t(fraction * sortedTimes.size()));
+    return sortedTimes[index];
+}
+
+/**
+ * Measures frame times for typical user flows, like navigating through pages
+ * or scrolling long lists.
+ *
+ * Every scenario runs at most one frame every 16 milliseconds, so animations
+ * progress as they would on a display. The benchmark result is the 95th
+ * percentile of the frame times, while the median, 99th percentile and the
+ * peak resident memory are printed.
+ *
+ * The style and platform plugin in use are selected as for applications, for
+ * instance with `QT_QUICK_CONTROLS_STYLE`, so the scenarios can be compared
+ * between styles.
+ */
+class ScenariosBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        m_renderer = std::make_unique<OffscreenRenderer>(windowSize);
+        if (!m_renderer->initialize()) {
+            QSKIP("Could not initialize offscreen rendering");
+        }
+    }
+
+    void cleanupTestCase()
+    {
+        m_renderer.reset();
+    }
+
+    void benchmarkScenario_data()
+    {
+        QTest::addColumn<QString>("scenario");
+
+        QTest::addRow("PageRow push and pop") << pageRowScenario;
+        QTest::addRow("GlobalDrawer open and close") << globalDrawerScenario;
+        QTest::addRow("OverlaySheet with long content") << overlaySheetScenario;
+        QTest::addRow("Scrolling a list of SubtitleDelegates") << listScrollScenario;
+    }
+
+    void benchmarkScenario()
+    {
+        QFETCH(QString, scenario);
+
+        QQmlEngine engine;
+        QQmlComponent component(&engine);
+        component.setData(scenario.toUtf8(), QUrl{});
+        std::unique_ptr<QQuickItem> root(qobject_cast<QQuickItem *>(component.create()));
+        QVERIFY2(root, qPrintable(component.errorString()));
+
+        root->setSize(windowSize);
+        root->setParentItem(m_renderer->window()->contentItem());
+        m_renderer->renderFrame();
+
+        std::vector<qreal> frameTimes;
+        qint64 peakMemory = residentMemory();
+
+        QElapsedTimer clock;
+        clock.start();
+        QElapsedTimer frameTimer;
+
+        for (int frame = 0;; ++frame) {
+            frameTimer.start();
+
+            QVariant running;
+            QMetaObject::invokeMethod(root.get(), "run", Q_RETURN_ARG(QVariant, running), Q_ARG(QVariant, frame));
+            if (!running.toBool()) {
+                break;
+            }
+            m_renderer->renderFrame();
+
+            frameTimes.push_back(frameTimer.nsecsElapsed() / 1000000.0);
+
+            if (frame % 30 == 0) {
+                peakMemory = std::max(peakMemory, residentMemory());
+            }
+
+            // Let timers and animations run until the next frame is due.
+            const qint64 nextFrame = (frame + 1) * frameInterval;
+            while (clock.elapsed() < nextFrame) {
+                QCoreApplication::processEvents(QEventLoop::AllEvents, nextFrame - clock.elapsed());
+            }
+        }
+        peakMemory = std::max(peakMemory, residentMemory());
+
+        root.reset();
+        m_renderer->renderFrame();
+
+        QVERIFY(!frameTimes.empty());
+        std::sort(frameTimes.begin(), frameTimes.end());
+
+        qInfo().nospace() << "Frames: " << frameTimes.size() << ", p50: " << percentile(frameTimes, 0.5) << " ms, p95: " << percentile(frameTimes, 0.95)
+                          << " ms, p99: " << percentile(frameTimes, 0.99) << " ms, max: " << frameTimes.back() << " ms";
+        if (peakMemory >= 0) {
+            qInfo() << "Peak resident memory:" << peakMemory / 1024 << "KiB";
+        }
+
+        QTest::setBenchmarkResult(percentile(frameTimes, 0.95), QTest::WalltimeMilliseconds);
+    }
+
+private:
+    std::unique_ptr<OffscreenRenderer> m_renderer;
+};
+
+QTEST_MAIN(ScenariosBenchmark)
+
+#include "benchmark_scenarios.moc"
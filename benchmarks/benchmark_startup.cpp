@@ -0,0 +1,128 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include <QLoggingCategory>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QTest>
+
+#include <memory>
+
+#include "offscreenrenderer.h"
+
+using namespace Qt::StringLiterals;
+
+// A minimal application, using the components most applications use on startup.
+static const QByteArray scene = R"(
+import QtQuick
+import QtQuick.Controls as QQC2
+import org.kde.kirigami as Kirigami
+
+Kirigami.ApplicationItem {
+    anchors.fill: parent
+
+    globalDrawer: Kirigami.GlobalDrawer {
+        actions: [
+            Kirigami.Action {
+                text: "Action"
+                icon.name: "document-open"
+            }
+        ]
+    }
+
+    pageStack.initialPage: Kirigami.ScrollablePage {
+        title: "Page"
+
+        actions: [
+            Kirigami.Action {
+                text: "Action"
+                icon.name: "document-save"
+            }
+        ]
+
+        ListView {
+            model: 20
+            delegate: QQC2.ItemDelegate {
+                width: ListView.view.width
+                text: "Item " + index
+            }
+        }
+    }
+}
+)";
+
+/**
+ * Measures the time from creating a QML engine to the first rendered frame of
+ * a small Kirigami application.
+ *
+ * The time spent in the individual parts of Kirigami's initialization, like
+ * registering types, resolving the style and loading the platform plugin, is
+ * printed through the `kf.kirigami.startup` logging categories.
+ */
+class StartupBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        if (qEnvironmentVariableIsEmpty("QT_LOGGING_RULES")) {
+            QLoggingCategory::setFilterRules(u"kf.kirigami.startup*.debug=true"_s);
+        }
+
+        m_renderer = std::make_unique<OffscreenRenderer>(QSize{800, 600});
+        if (!m_renderer->initialize()) {
+            QSKIP("Could not initialize offscreen rendering");
+        }
+    }
+
+    void cleanupTestCase()
+    {
+        m_renderer.reset();
+    }
+
+    // The first start in a process, which includes loading plugins and
+    // registering types. This needs to run first to be meaningful.
+    void benchmarkColdStart()
+    {
+        QBENCHMARK_ONCE {
+            startApplication();
+        }
+    }
+
+    // Starting with a new engine once plugins have been loaded, which still
+    // includes creating the per-engine singletons and compiling components.
+    void benchmarkWarmStart()
+    {
+        QBENCHMARK {
+            startApplication();
+        }
+    }
+
+private:
+    void startApplication()
+    {
+        auto engine = std::make_unique<QQmlEngine>();
+        QQmlComponent component(engine.get());
+        component.setData(scene, QUrl{});
+        std::unique_ptr<QQuickItem> root(qobject_cast<QQuickItem *>(component.create()));
+        QVERIFY2(root, qPrintable(component.errorString()));
+
+        root->setParentItem(m_renderer->window()->contentItem());
+        m_renderer->renderFrame();
+
+        root.reset();
+        // Release the scene graph resources of the old scene.
+        m_renderer->renderFrame();
+    }
+
+    std::unique_ptr<OffscreenRenderer> m_renderer;
+};
+
+QTEST_MAIN(StartupBenchmark)
+
+#include "benchmark_startup.moc"
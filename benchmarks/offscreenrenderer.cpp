@@ -0,0 +1,77 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "offscreenrenderer.h"
+
+#include <QQuickRenderTarget>
+
+OffscreenRenderer::OffscreenRenderer(const QSize &size)
+    : m_size(size)
+    , m_renderControl(std::make_unique<QQuickRenderControl>())
+    , m_window(std::make_unique<QQuickWindow>(m_renderControl.get()))
+{
+    m_window->resize(size);
+}
+
+OffscreenRenderer::~OffscreenRenderer()
+{
+    // The window needs to release its resources before the render target and
+    // render control do.
+    m_window.reset();
+    m_renderTarget.reset();
+    m_renderPassDescriptor.reset();
+    m_depthStencil.reset();
+    m_texture.reset();
+}
+
+bool OffscreenRenderer::initialize()
+{
+    if (!m_renderControl->initialize()) {
+        return false;
+    }
+
+    QRhi *rhi = m_renderControl->rhi();
+    m_texture.reset(rhi->newTexture(QRhiTexture::RGBA8, m_size, 1, QRhiTexture::RenderTarget));
+    if (!m_texture->create()) {
+        return false;
+    }
+
+    m_depthStencil.reset(rhi->newRenderBuffer(QRhiRenderBuffer::DepthStencil, m_size, 1));
+    if (!m_depthStencil->create()) {
+        return false;
+    }
+
+    QRhiTextureRenderTargetDescription description{QRhiColorAttachment{m_texture.get()}};
+    description.setDepthStencilBuffer(m_depthStencil.get());
+    m_renderTarget.reset(rhi->newTextureRenderTarget(description));
+    m_renderPassDescriptor.reset(m_renderTarget->newCompatibleRenderPassDescriptor());
+    m_renderTarget->setRenderPassDescriptor(m_renderPassDescriptor.get());
+    if (!m_renderTarget->create()) {
+        return false;
+    }
+
+    m_window->setRenderTarget(QQuickRenderTarget::fromRhiRenderTarget(m_renderTarget.get()));
+    return true;
+}
+
+QQuickWindow *OffscreenRenderer::window() const
+{
+    return m_window.get();
+}
+
+QRhi *OffscreenRenderer::rhi() const
+{
+    return m_renderControl->rhi();
+}
+
+void OffscreenRenderer::renderFrame()
+{
+    m_renderControl->polishItems();
+    m_renderControl->beginFrame();
+    m_renderControl->sync();
+    m_renderControl->render();
+    m_renderControl->endFrame();
+}
@@ -0,0 +1,51 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QQuickRenderControl>
+#include <QQuickWindow>
+
+#include <rhi/qrhi.h>
+
+#include <memory>
+
+/**
+ * Renders a QQuickWindow into an offscreen texture.
+ *
+ * This uses the same graphics API a normal window would use, so that frames
+ * can be measured without depending on vsync or a windowing system.
+ */
+class OffscreenRenderer
+{
+public:
+    explicit OffscreenRenderer(const QSize &size);
+    ~OffscreenRenderer();
+
+    /**
+     * Set up the graphics resources used for rendering.
+     *
+     * @returns false if offscreen rendering is not available.
+     */
+    bool initialize();
+
+    QQuickWindow *window() const;
+    QRhi *rhi() const;
+
+    /**
+     * Polish, synchronize and render a single frame.
+     */
+    void renderFrame();
+
+private:
+    QSize m_size;
+    std::unique_ptr<QQuickRenderControl> m_renderControl;
+    std::unique_ptr<QQuickWindow> m_window;
+    std::unique_ptr<QRhiTexture> m_texture;
+    std::unique_ptr<QRhiRenderBuffer> m_depthStencil;
+    std::unique_ptr<QRhiRenderPassDescriptor> m_renderPassDescriptor;
+    std::unique_ptr<QRhiTextureRenderTarget> m_renderTarget;
+};
@@ -21,3 +21,26 @@ QList<QKeySequence> ActionHelper::alternateShortcuts(QAction *action) const
         return action->shortcuts().mid(1);
     }
 }
+
+QList<QKeySequence> ActionHelper::shortcuts(QObject *action)
+{
+    if (!action) {
+        return {};
+    }
+
+    QList<QKeySequence> sequences;
+
+    // The shortcut of QtQuick.Controls actions may be a string, a sequence or a standard key.
+    const QVariant shortcut = action->property("shortcut");
+    if (shortcut.typeId() == QMetaType::Int) {
+        sequences = QKeySequence::keyBindings(static_cast<QKeySequence::StandardKey>(shortcut.toInt()));
+    } else if (const auto sequence = shortcut.value<QKeySequence>(); !sequence.isEmpty()) {
+        sequences.append(sequence);
+    }
+
+    if (const auto qaction = action->property("fromQAction").value<QAction *>(); qaction && qaction->shortcuts().length() > 1) {
+        sequences.append(qaction->shortcuts().mid(1));
+    }
+
+    return sequences;
+}
@@ -18,4 +18,7 @@ public:
 
     Q_INVOKABLE QList<QKeySequence> alternateShortcuts(QAction *action) const;
     Q_INVOKABLE QString iconName(const QIcon &icon) const;
+
+    /// All shortcuts of @p action, including the alternate shortcuts of its fromQAction.
+    static QList<QKeySequence> shortcuts(QObject *action);
 };
@@ -101,7 +101,7 @@ Kirigami.AbstractApplicationItem {
             fill: parent
         }
 
-        function goBack() {
+        function goBack(): void {
             // NOTE: drawers are handling the back button by themselves
             const backEvent = {accepted: false}
             if (root.pageStack.currentIndex >= 1) {
@@ -116,7 +116,7 @@ Kirigami.AbstractApplicationItem {
                 Qt.quit();
             }
         }
-        function goForward() {
+        function goForward(): void {
             root.pageStack.currentIndex = Math.min(root.pageStack.depth - 1, root.pageStack.currentIndex + 1);
         }
         Keys.onBackPressed: event => {
@@ -267,7 +267,7 @@ Kirigami.OverlayDrawer {
     /**
      * @brief This function reverts the menu back to its initial state
      */
-    function resetMenu() {
+    function resetMenu(): void {
         stackView.pop(stackView.get(0, T.StackView.DontLoad));
         if (root.modal) {
             root.drawerOpen = false;
@@ -300,7 +300,7 @@ Kirigami.OverlayDrawer {
      */
     //END FUNCTIONS
 
-    function ensureVisible(item: Item, yOffset: int) {
+    function ensureVisible(item: Item, yOffset: int): void {
         var actualItemY = item.y + (yOffset ?? 0)
         var viewYPosition = (item.height <= mainFlickable.height)
             ? Math.round(actualItemY + item.height / 2 - mainFlickable.height / 2)
@@ -323,7 +323,9 @@ Kirigami.OverlayDrawer {
         id: menuComponent
 
         Column {
-            property alias model: actionsRepeater.model
+            id: menuLevel
+
+            property var model: root.actions
             property T.Action current
             property int level: 0
 
@@ -358,25 +360,36 @@ Kirigami.OverlayDrawer {
                 onActivated: backItem.clicked()
             }
 
-            Repeater {
-                id: actionsRepeater
+            Loader {
+                width: parent.width
+
+                // Nested levels are only created once they are opened. Their
+                // entries are incubated over several frames, so opening a level
+                // with a lot of actions does not block the drawer's animation.
+                asynchronous: menuLevel.level > 0
 
-                readonly property bool withSections: {
-                    for (const action of root.actions) {
-                        if (action.hasOwnProperty("expandible") && action.expandible) {
-                            return true;
+                sourceComponent: Column {
+                    Repeater {
+                        id: actionsRepeater
+
+                        readonly property bool withSections: {
+                            for (const action of root.actions) {
+                                if (action.hasOwnProperty("expandible") && action.expandible) {
+                                    return true;
+                                }
+                            }
+                            return false;
                         }
-                    }
-                    return false;
-                }
 
-                model: root.actions
+                        model: menuLevel.model
 
-                delegate: ActionDelegate {
-                    required property T.Action modelData
+                        delegate: ActionDelegate {
+                            required property T.Action modelData
 
-                    tAction: modelData
-                    withSections: actionsRepeater.withSections
+                            tAction: modelData
+                            withSections: actionsRepeater.withSections
+                        }
+                    }
                 }
             }
         }
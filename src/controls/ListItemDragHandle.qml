@@ -143,7 +143,7 @@ Item {
             property int oldIndex: -1
             property int newIndex: -1
 
-            function reset() {
+            function reset(): void {
                 _previousMove.oldIndex = -1;
                 _previousMove.newIndex = -1;
             }
@@ -163,7 +163,7 @@ Item {
             property int listItemLastY
             property bool draggingUp
 
-            function arrangeItem() {
+            function arrangeItem(): void {
                 const newIndex = listView.indexAt(1, listView.contentItem.mapFromItem(listItem, 0, listItem.height / 2).y);
 
                 if (newIndex > -1 && ((incrementalMoves && internal.draggingUp && newIndex < index) ||
@@ -213,7 +213,7 @@ Item {
         onReleased: mouse => dropped()
         onCanceled: dropped()
 
-        function dropped() {
+        function dropped(): void {
             listItem.y = internal.originalParent.mapFromItem(listItem, 0, 0).y;
             listItem.parent = internal.originalParent;
             dropAnimation.running = true;
@@ -226,7 +226,7 @@ QQC2.Page {
             }
         }
 
-        function syncSource() {
+        function syncSource(): void {
             if (root.globalToolBarStyle !== Kirigami.ApplicationHeaderStyle.ToolBar &&
                 root.globalToolBarStyle !== Kirigami.ApplicationHeaderStyle.Titles &&
                 root.titleDelegate !== defaultTitleDelegate) {
@@ -84,6 +84,20 @@ Kirigami.Action {
      * @since org.kde.kirigami 2.12
      */
     property bool useLayers: false
+
+    /**
+     * @brief This property sets whether the page should be preloaded in the
+     * background before the action is triggered.
+     *
+     * Use this for pages that are likely to be opened next, so that pushing
+     * them does not need to wait for the page to be created.
+     *
+     * default: ``false``
+     *
+     * @see PagePool::preload()
+     * @since 6.12
+     */
+    property bool preload: false
 //END properties
 
     /**
@@ -120,6 +134,11 @@ Kirigami.Action {
 
     checkable: true
 
+    onPreloadChanged: _private.preloadPage()
+    onPageChanged: _private.preloadPage()
+    onPagePoolChanged: _private.preloadPage()
+    Component.onCompleted: _private.preloadPage()
+
     onTriggered: {
         if (page.length === 0 || !pagePool || !pageStack) {
             return;
@@ -190,14 +209,21 @@ Kirigami.Action {
     property QtObject _private: QtObject {
         id: _private
 
-        function setChecked(checked) {
+        function setChecked(checked: bool): void {
             root.checked = checked;
         }
 
-        function clearLayers() {
+        function clearLayers(): void {
             root.pageStack.layers.clear();
         }
 
+        function preloadPage(): void {
+            if (!root.preload || root.page.length === 0 || !root.pagePool) {
+                return;
+            }
+            root.pagePool.preload(root.page, root.initialProperties && typeof(root.initialProperties) === "object" ? root.initialProperties : {});
+        }
+
         property list<Connections> connections: [
             Connections {
                 target: root.pageStack
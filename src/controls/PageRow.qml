@@ -952,11 +952,10 @@ QT.Control {
 
     QtObject {
         id: pagesLogic
-        readonly property var componentCache: new Array()
 
         property Component __mobileDialogLayerComponent
 
-        function getMobileDialogLayerComponent() {
+        function getMobileDialogLayerComponent(): Component {
             if (!__mobileDialogLayerComponent) {
                 __mobileDialogLayerComponent = Qt.createComponent(Qt.resolvedUrl("private/MobileDialogLayer.qml"));
             }
@@ -1049,17 +1048,11 @@ QT.Control {
                 // page defined as component
                 pageComp = page;
             } else if (typeof page === "string") {
-                // page defined as string (a url)
-                pageComp = pagesLogic.componentCache[page];
-                if (!pageComp) {
-                    pageComp = pagesLogic.componentCache[page] = Qt.createComponent(page);
-                }
+                // page defined as string (a url), the components are shared with PagePool
+                pageComp = Kirigami.PageComponentCache.component(Qt.resolvedUrl(page));
             } else if (typeof page === "object" && !(page instanceof Item) && page.toString !== undefined) {
                 // page defined as url (QML value type, not a string)
-                pageComp = pagesLogic.componentCache[page.toString()];
-                if (!pageComp) {
-                    pageComp = pagesLogic.componentCache[page.toString()] = Qt.createComponent(page.toString());
-                }
+                pageComp = Kirigami.PageComponentCache.component(Qt.resolvedUrl(page.toString()));
             }
 
             return pageComp
@@ -176,7 +176,7 @@ Kirigami.Page {
  * @param item The item that should be in the visible area of the flickable. Item coordinates need to be in the flickable's coordinate system.
  * @param xOffset,yOffset (optional) Offsets to align the item's and the flickable's coordinate system<
  */
-    function ensureVisible(item: Item, xOffset: int, yOffset: int) {
+    function ensureVisible(item: Item, xOffset: int, yOffset: int): void {
         var actualItemX = item.x + (xOffset ?? 0)
         var actualItemY = item.y + (yOffset ?? 0)
         var viewXPosition = (item.width <= root.flickable.width)
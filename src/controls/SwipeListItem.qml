@@ -9,6 +9,7 @@ import QtQuick.Controls as QQC2
 import QtQuick.Layouts
 import QtQuick.Templates as T
 import org.kde.kirigami as Kirigami
+import org.kde.kirigami.private as KirigamiPrivate
 import "private"
 
 /**
@@ -239,8 +240,6 @@ QQC2.SwipeDelegate {
 
         readonly property QtObject swipeFilterItem: (viewHasPropertySwipeFilter() && view.parent.parent._swipeFilter) ? view.parent.parent._swipeFilter : null
 
-        readonly property bool edgeEnabled: swipeFilterItem ? swipeFilterItem.currentItem === listItem || swipeFilterItem.currentItem === listItem.parent : false
-
         // install the SwipeItemEventFilter
         onViewChanged: {
             if (listItem.alwaysVisibleActions || !Kirigami.Settings.tabletMode) {
@@ -331,67 +330,19 @@ QQC2.SwipeDelegate {
     Component {
         id: handleComponent
 
-        MouseArea {
+        KirigamiPrivate.SwipeHandle {
             id: dragButton
             anchors {
                 right: parent.right
             }
             implicitWidth: Kirigami.Units.iconSizes.smallMedium
 
-            preventStealing: true
-            readonly property real openPosition: (listItem.width - width - listItem.leftPadding * 2)/listItem.width
-            property real startX: 0
-            property real lastPosition: 0
-            property bool openIntention
+            target: listItem
+            mirrored: listItem.mirrored
+            openPosition: (listItem.width - width - listItem.leftPadding * 2)/listItem.width
 
-            onPressed: mouse => {
-                startX = mapToItem(listItem, 0, 0).x;
-            }
-            onClicked: mouse => {
-                if (Math.abs(mapToItem(listItem, 0, 0).x - startX) > Qt.styleHints.startDragDistance) {
-                    return;
-                }
-                if (listItem.mirrored) {
-                    if (listItem.swipe.position < 0.5) {
-                        slideAnim.to = openPosition
-                    } else {
-                        slideAnim.to = 0
-                    }
-                } else {
-                    if (listItem.swipe.position > -0.5) {
-                        slideAnim.to = -openPosition
-                    } else {
-                        slideAnim.to = 0
-                    }
-                }
-                slideAnim.restart();
-            }
-            onPositionChanged: mouse => {
-                const pos = mapToItem(listItem, mouse.x, mouse.y);
-
-                if (listItem.mirrored) {
-                    listItem.swipe.position = Math.max(0, Math.min(openPosition, (pos.x / listItem.width)));
-                    openIntention = listItem.swipe.position > lastPosition;
-                } else {
-                    listItem.swipe.position = Math.min(0, Math.max(-openPosition, (pos.x / (listItem.width -listItem.rightPadding) - 1)));
-                    openIntention = listItem.swipe.position < lastPosition;
-                }
-                lastPosition = listItem.swipe.position;
-            }
-            onReleased: mouse => {
-                if (listItem.mirrored) {
-                    if (openIntention) {
-                        slideAnim.to = openPosition
-                    } else {
-                        slideAnim.to = 0
-                    }
-                } else {
-                    if (openIntention) {
-                        slideAnim.to = -openPosition
-                    } else {
-                        slideAnim.to = 0
-                    }
-                }
+            onSettleRequested: position => {
+                slideAnim.to = position;
                 slideAnim.restart();
             }
 
@@ -401,49 +352,6 @@ QQC2.SwipeDelegate {
                 selected: listItem.checked || (listItem.down && !listItem.checked && !listItem.sectionDelegate)
                 source: (listItem.mirrored ? (listItem.background.x < listItem.background.width/2 ? "overflow-menu-right" : "overflow-menu-left") : (listItem.background.x < -listItem.background.width/2 ? "overflow-menu-right" : "overflow-menu-left"))
             }
-
-            Connections {
-                id: swipeFilterConnection
-
-                target: internal.edgeEnabled ? internal.swipeFilterItem : null
-                function onPeekChanged() {
-                    if (!listItem.actionsVisible) {
-                        return;
-                    }
-
-                    if (listItem.mirrored) {
-                        listItem.swipe.position = Math.max(0, Math.min(dragButton.openPosition, internal.swipeFilterItem.peek));
-                        dragButton.openIntention = listItem.swipe.position > dragButton.lastPosition;
-
-                    } else {
-                        listItem.swipe.position = Math.min(0, Math.max(-dragButton.openPosition, -internal.swipeFilterItem.peek));
-                        dragButton.openIntention = listItem.swipe.position < dragButton.lastPosition;
-                    }
-
-                    dragButton.lastPosition = listItem.swipe.position;
-                }
-                function onPressed(mouse) {
-                    if (internal.edgeEnabled) {
-                        dragButton.pressed(mouse);
-                    }
-                }
-                function onClicked(mouse) {
-                    if (Math.abs(listItem.background.x) < Kirigami.Units.gridUnit && internal.edgeEnabled) {
-                        dragButton.clicked(mouse);
-                    }
-                }
-                function onReleased(mouse) {
-                    if (internal.edgeEnabled) {
-                        dragButton.released(mouse);
-                    }
-                }
-                function onCurrentItemChanged() {
-                    if (!internal.edgeEnabled) {
-                        slideAnim.to = 0;
-                        slideAnim.restart();
-                    }
-                }
-            }
         }
     }
 
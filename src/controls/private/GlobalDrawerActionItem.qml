@@ -113,7 +113,11 @@ QQC2.ItemDelegate {
         onActivated: listItem.clicked()
     }
 
-    property ActionsMenu actionsMenu: ActionsMenu {
+    // Only created once it is needed, as most entries never show their
+    // children as a menu. Its entries are only created while it is open.
+    property ActionsMenu actionsMenu: null
+
+    readonly property Component actionsMenuComponent: ActionsMenu {
         x: Qt.application.layoutDirection === Qt.RightToLeft ? -width : listItem.width
         actions: listItem.kAction?.children ?? []
         submenuComponent: ActionsMenu {}
@@ -127,6 +131,16 @@ QQC2.ItemDelegate {
         }
     }
 
+    function popupActionsMenu(): void {
+        if (!actionsMenu) {
+            actionsMenu = actionsMenuComponent.createObject(listItem);
+        }
+        if (actionsMenu.actions.length > 0 && !actionsMenu.visible) {
+            stackView.openSubMenu = actionsMenu;
+            actionsMenu.popup(this, width, 0);
+        }
+    }
+
     // TODO: animate the hide by collapse
     visible: actionVisible && opacity > 0
     opacity: !root.collapsed || iconItem.source.toString().length > 0
@@ -164,8 +178,8 @@ QQC2.ItemDelegate {
         if (stackView.openSubMenu) {
             stackView.openSubMenu.visible = false;
 
-            if (actionsMenu.count > 0) {
-                actionsMenu.popup(this, width, 0);
+            if (hasChildren) {
+                popupActionsMenu();
             }
         }
     }
@@ -175,15 +189,12 @@ QQC2.ItemDelegate {
     Keys.onEnterPressed: event => trigger()
     Keys.onReturnPressed: event => trigger()
 
-    function trigger() {
+    function trigger(): void {
         tAction?.trigger();
 
         if (hasChildren) {
             if (root.collapsed) {
-                if (actionsMenu.count > 0 && !actionsMenu.visible) {
-                    stackView.openSubMenu = actionsMenu;
-                    actionsMenu.popup(this, width, 0);
-                }
+                popupActionsMenu();
             } else {
                 stackView.push(menuComponent, {
                     model: kAction?.children ?? [],
@@ -6,10 +6,9 @@
 
 import QtQuick
 import org.kde.kirigami as Kirigami
+import org.kde.kirigami.private as KirigamiPrivate
 
-
-MouseArea {
-    id: swipeFilter
+KirigamiPrivate.SwipeEdgeArea {
     anchors {
         right: parent.right
         top: parent.top
@@ -17,18 +16,6 @@ MouseArea {
     }
 
     z: 99999
-    property Item currentItem
-    property real peek
-
-    preventStealing: true
     width: Kirigami.Units.gridUnit
-    onPressed: mouse => {
-        const mapped = mapToItem(parent.flickableItem.contentItem, mouse.x, mouse.y);
-        currentItem = parent.flickableItem.itemAt(mapped.x, mapped.y);
-    }
-    onPositionChanged: mouse => {
-        const mapped = mapToItem(parent.flickableItem.contentItem, mouse.x, mouse.y);
-        currentItem = parent.flickableItem.itemAt(mapped.x, mapped.y);
-        peek = 1 - mapped.x / parent.flickableItem.contentItem.width;
-    }
+    flickable: parent.flickableItem
 }
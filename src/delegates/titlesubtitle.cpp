@@ -0,0 +1,505 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "titlesubtitle.h"
+
+#include <QHash>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlEngine>
+
+#include <algorithm>
+#include <cmath>
+
+#include "platform/colorutils.h"
+#include "platform/platformtheme.h"
+
+using namespace Kirigami::Platform;
+
+namespace
+{
+// The components creating the labels, shared by all instances using the same engine.
+class LabelComponents : public QObject
+{
+public:
+    explicit LabelComponents(QQmlEngine *engine);
+
+    static LabelComponents *instance(QQmlEngine *engine);
+
+    QQmlComponent title;
+    QQmlComponent subtitle;
+};
+
+using LabelComponentsHash = QHash<QQmlEngine *, LabelComponents *>;
+Q_GLOBAL_STATIC(LabelComponentsHash, s_labelComponents)
+
+LabelComponents::LabelComponents(QQmlEngine *engine)
+    : QObject(engine)
+    , title(engine)
+    , subtitle(engine)
+{
+    /* clang-format off */
+    title.setData(QByteArrayLiteral(R"(
+import QtQuick
+
+Text {
+    // Switch off here as this is expected to be set in the base component.
+    Accessible.ignored: true
+
+    // Work around Qt bug where left aligned text is not right aligned
+    // in RTL mode unless horizontalAlignment is explicitly set.
+    // https://bugreports.qt.io/browse/QTBUG-95873
+    horizontalAlignment: Text.AlignLeft
+}
+)"), QUrl(QStringLiteral("titlesubtitle.cpp")));
+
+    subtitle.setData(QByteArrayLiteral(R"(
+import QtQuick
+
+Text {
+    // See the title.
+    horizontalAlignment: Text.AlignLeft
+
+    renderType: Text.NativeRendering
+}
+)"), QUrl(QStringLiteral("titlesubtitle.cpp")));
+    /* clang-format on */
+}
+
+LabelComponents *LabelComponents::instance(QQmlEngine *engine)
+{
+    if (auto components = s_labelComponents->value(engine)) {
+        return components;
+    }
+
+    auto components = new LabelComponents(engine);
+    // NB: do not dereference engine, it is being destroyed when this is.
+    QObject::connect(components, &QObject::destroyed, [engine]() {
+        if (!s_labelComponents.isDestroyed()) {
+            s_labelComponents->remove(engine);
+        }
+    });
+    s_labelComponents->insert(engine, components);
+    return components;
+}
+}
+
+TitleSubtitle::TitleSubtitle(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+}
+
+TitleSubtitle::~TitleSubtitle() = default;
+
+QString TitleSubtitle::title() const
+{
+    return m_title;
+}
+
+void TitleSubtitle::setTitle(const QString &title)
+{
+    if (title == m_title) {
+        return;
+    }
+
+    m_title = title;
+    if (m_titleItem) {
+        m_titleItem->setProperty("text", m_title);
+    }
+    Q_EMIT titleChanged();
+}
+
+QString TitleSubtitle::subtitle() const
+{
+    return m_subtitle;
+}
+
+void TitleSubtitle::setSubtitle(const QString &subtitle)
+{
+    if (subtitle == m_subtitle) {
+        return;
+    }
+
+    m_subtitle = subtitle;
+    if (m_subtitleItem) {
+        m_subtitleItem->setProperty("text", m_subtitle);
+        m_subtitleItem->setVisible(!m_subtitle.isEmpty());
+    }
+    Q_EMIT subtitleChanged();
+
+    setSubtitleVisible(!m_subtitle.isEmpty() || m_reserveSpaceForSubtitle);
+    // The title is centered when there is no subtitle.
+    layoutLabels();
+}
+
+QColor TitleSubtitle::color() const
+{
+    if (m_color) {
+        return *m_color;
+    }
+    if (!m_theme) {
+        return QColor();
+    }
+    return m_selected ? m_theme->highlightedTextColor() : m_theme->textColor();
+}
+
+void TitleSubtitle::setColor(const QColor &color)
+{
+    if (m_color == color) {
+        return;
+    }
+
+    m_color = color;
+    updateColors();
+}
+
+void TitleSubtitle::resetColor()
+{
+    m_color.reset();
+    updateColors();
+}
+
+QColor TitleSubtitle::subtitleColor() const
+{
+    if (m_subtitleColor) {
+        return *m_subtitleColor;
+    }
+    if (!m_theme) {
+        return QColor();
+    }
+    if (m_selected) {
+        return m_theme->highlightedTextColor();
+    }
+
+    static ColorUtils colorUtils;
+    return colorUtils.linearInterpolation(color(), m_theme->backgroundColor(), 0.3);
+}
+
+void TitleSubtitle::setSubtitleColor(const QColor &color)
+{
+    if (m_subtitleColor == color) {
+        return;
+    }
+
+    m_subtitleColor = color;
+    updateColors();
+}
+
+void TitleSubtitle::resetSubtitleColor()
+{
+    m_subtitleColor.reset();
+    updateColors();
+}
+
+QFont TitleSubtitle::font() const
+{
+    if (m_font) {
+        return *m_font;
+    }
+    return m_theme ? m_theme->defaultFont() : QFont();
+}
+
+void TitleSubtitle::setFont(const QFont &font)
+{
+    if (m_font == font) {
+        return;
+    }
+
+    m_font = font;
+    updateFonts();
+}
+
+void TitleSubtitle::resetFont()
+{
+    m_font.reset();
+    updateFonts();
+}
+
+QFont TitleSubtitle::subtitleFont() const
+{
+    if (m_subtitleFont) {
+        return *m_subtitleFont;
+    }
+    return m_theme ? m_theme->smallFont() : QFont();
+}
+
+void TitleSubtitle::setSubtitleFont(const QFont &font)
+{
+    if (m_subtitleFont == font) {
+        return;
+    }
+
+    m_subtitleFont = font;
+    updateFonts();
+}
+
+void TitleSubtitle::resetSubtitleFont()
+{
+    m_subtitleFont.reset();
+    updateFonts();
+}
+
+int TitleSubtitle::elide() const
+{
+    return m_elide;
+}
+
+void TitleSubtitle::setElide(int elide)
+{
+    if (elide == m_elide) {
+        return;
+    }
+
+    m_elide = elide;
+    if (m_titleItem) {
+        m_titleItem->setProperty("elide", m_elide);
+        m_subtitleItem->setProperty("elide", m_elide);
+    }
+    Q_EMIT elideChanged();
+}
+
+int TitleSubtitle::wrapMode() const
+{
+    return m_wrapMode;
+}
+
+void TitleSubtitle::setWrapMode(int wrapMode)
+{
+    if (wrapMode == m_wrapMode) {
+        return;
+    }
+
+    m_wrapMode = wrapMode;
+    if (m_titleItem) {
+        m_titleItem->setProperty("wrapMode", m_wrapMode);
+        m_subtitleItem->setProperty("wrapMode", m_wrapMode);
+    }
+    Q_EMIT wrapModeChanged();
+}
+
+bool TitleSubtitle::reserveSpaceForSubtitle() const
+{
+    return m_reserveSpaceForSubtitle;
+}
+
+void TitleSubtitle::setReserveSpaceForSubtitle(bool reserve)
+{
+    if (reserve == m_reserveSpaceForSubtitle) {
+        return;
+    }
+
+    m_reserveSpaceForSubtitle = reserve;
+    Q_EMIT reserveSpaceForSubtitleChanged();
+
+    setSubtitleVisible(!m_subtitle.isEmpty() || m_reserveSpaceForSubtitle);
+}
+
+bool TitleSubtitle::isSelected() const
+{
+    return m_selected;
+}
+
+void TitleSubtitle::setSelected(bool selected)
+{
+    if (selected == m_selected) {
+        return;
+    }
+
+    m_selected = selected;
+    Q_EMIT selectedChanged();
+
+    updateColors();
+}
+
+bool TitleSubtitle::isSubtitleVisible() const
+{
+    return m_subtitleVisible;
+}
+
+bool TitleSubtitle::isTruncated() const
+{
+    return m_truncated;
+}
+
+void TitleSubtitle::classBegin()
+{
+    QQuickItem::classBegin();
+
+    m_theme = static_cast<PlatformTheme *>(qmlAttachedPropertiesObject<PlatformTheme>(this, true));
+    Q_ASSERT(m_theme);
+
+    connect(m_theme, &PlatformTheme::colorsChanged, this, &TitleSubtitle::updateColors);
+    connect(m_theme, &PlatformTheme::defaultFontChanged, this, &TitleSubtitle::updateFonts);
+    connect(m_theme, &PlatformTheme::smallFontChanged, this, &TitleSubtitle::updateFonts);
+
+    // Take the theme into account for the values read before the labels exist.
+    m_effectiveColor = color();
+    m_effectiveSubtitleColor = subtitleColor();
+    m_effectiveFont = font();
+    m_effectiveSubtitleFont = subtitleFont();
+}
+
+void TitleSubtitle::componentComplete()
+{
+    QQuickItem::componentComplete();
+
+    QQmlEngine *engine = qmlEngine(this);
+    if (!engine) {
+        return;
+    }
+
+    auto components = LabelComponents::instance(engine);
+    m_titleItem = createLabel(&components->title, m_title, m_effectiveColor, m_effectiveFont);
+    m_subtitleItem = createLabel(&components->subtitle, m_subtitle, m_effectiveSubtitleColor, m_effectiveSubtitleFont);
+    if (!m_titleItem || !m_subtitleItem) {
+        return;
+    }
+    m_subtitleItem->setVisible(!m_subtitle.isEmpty());
+
+    updateImplicitSize();
+    layoutLabels();
+    updateTruncated();
+}
+
+void TitleSubtitle::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        layoutLabels();
+    }
+}
+
+QQuickItem *TitleSubtitle::createLabel(QQmlComponent *component, const QString &text, const QColor &color, const QFont &font)
+{
+    // Set everything before the label is completed, so its text is only laid out once.
+    auto label = qobject_cast<QQuickItem *>(component->beginCreate(qmlContext(this)));
+    Q_ASSERT(label);
+    if (!label) {
+        return nullptr;
+    }
+
+    label->setProperty("text", text);
+    label->setProperty("color", color);
+    label->setProperty("font", font);
+    label->setProperty("elide", m_elide);
+    label->setProperty("wrapMode", m_wrapMode);
+    component->completeCreate();
+
+    label->setParent(this);
+    label->setParentItem(this);
+
+    connect(label, &QQuickItem::implicitWidthChanged, this, &TitleSubtitle::updateImplicitSize);
+    connect(label, &QQuickItem::implicitHeightChanged, this, &TitleSubtitle::updateImplicitSize);
+    // Without an explicit height, labels follow the height of their text.
+    connect(label, &QQuickItem::heightChanged, this, &TitleSubtitle::layoutLabels);
+    connect(label, SIGNAL(truncatedChanged()), this, SLOT(updateTruncated()));
+    connect(label, SIGNAL(linkActivated(QString)), this, SIGNAL(linkActivated(QString)));
+    connect(label, SIGNAL(linkHovered(QString)), this, SIGNAL(linkHovered(QString)));
+
+    return label;
+}
+
+void TitleSubtitle::updateColors()
+{
+    const QColor color = this->color();
+    if (color != m_effectiveColor) {
+        m_effectiveColor = color;
+        if (m_titleItem) {
+            m_titleItem->setProperty("color", m_effectiveColor);
+        }
+        Q_EMIT colorChanged();
+    }
+
+    const QColor subtitleColor = this->subtitleColor();
+    if (subtitleColor != m_effectiveSubtitleColor) {
+        m_effectiveSubtitleColor = subtitleColor;
+        if (m_subtitleItem) {
+            m_subtitleItem->setProperty("color", m_effectiveSubtitleColor);
+        }
+        Q_EMIT subtitleColorChanged();
+    }
+}
+
+void TitleSubtitle::updateFonts()
+{
+    const QFont font = this->font();
+    if (font != m_effectiveFont) {
+        m_effectiveFont = font;
+        if (m_titleItem) {
+            m_titleItem->setProperty("font", m_effectiveFont);
+        }
+        Q_EMIT fontChanged();
+    }
+
+    const QFont subtitleFont = this->subtitleFont();
+    if (subtitleFont != m_effectiveSubtitleFont) {
+        m_effectiveSubtitleFont = subtitleFont;
+        if (m_subtitleItem) {
+            m_subtitleItem->setProperty("font", m_effectiveSubtitleFont);
+        }
+        Q_EMIT subtitleFontChanged();
+    }
+}
+
+void TitleSubtitle::updateImplicitSize()
+{
+    if (!m_titleItem || !m_subtitleItem) {
+        return;
+    }
+
+    // An empty subtitle still has the height of a line, which is what makes
+    // reserveSpaceForSubtitle work.
+    const qreal width = std::max(m_titleItem->implicitWidth(), m_subtitleItem->implicitWidth());
+    const qreal height = m_titleItem->implicitHeight() + (m_subtitleVisible ? m_subtitleItem->implicitHeight() : 0.0);
+    setImplicitSize(width, height);
+}
+
+void TitleSubtitle::layoutLabels()
+{
+    if (!m_titleItem || !m_subtitleItem) {
+        return;
+    }
+
+    m_titleItem->setWidth(width());
+    m_subtitleItem->setWidth(width());
+
+    // The subtitle sits at the bottom, with the title on top of it or
+    // centered when there is no subtitle.
+    const qreal subtitleY = height() - m_subtitleItem->height();
+    m_subtitleItem->setY(subtitleY);
+    if (m_subtitle.isEmpty()) {
+        m_titleItem->setY(std::round((height() - m_titleItem->height()) / 2));
+    } else {
+        m_titleItem->setY(subtitleY - m_titleItem->height());
+    }
+}
+
+void TitleSubtitle::setSubtitleVisible(bool visible)
+{
+    if (visible == m_subtitleVisible) {
+        return;
+    }
+
+    m_subtitleVisible = visible;
+    Q_EMIT subtitleVisibleChanged();
+
+    updateImplicitSize();
+}
+
+void TitleSubtitle::updateTruncated()
+{
+    if (!m_titleItem || !m_subtitleItem) {
+        return;
+    }
+
+    const bool truncated = m_titleItem->property("truncated").toBool() || m_subtitleItem->property("truncated").toBool();
+    if (truncated != m_truncated) {
+        m_truncated = truncated;
+        Q_EMIT truncatedChanged();
+    }
+}
+
+#include "moc_titlesubtitle.cpp"
@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: 2010 Marco Martin <notmart@gmail.com>
+ * SPDX-FileCopyrightText: 2022 ivan tkachenko <me@ratijas.tk>
+ * SPDX-FileCopyrightText: 2023 Arjen Hiemstra <ahiemstra@heimr.nl>
+ * SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QColor>
+#include <QFont>
+#include <QPointer>
+#include <QQuickItem>
+
+#include <optional>
+
+namespace Kirigami
+{
+namespace Platform
+{
+class PlatformTheme;
+}
+}
+
+/**
+ * A simple item containing a title and subtitle label.
+ *
+ * This is mainly intended as a replacement for a list delegate content item,
+ * but can be used as a replacement for other content items as well.
+ *
+ * When using it as a contentItem, make sure to bind the appropriate properties
+ * to those of the Control. Prefer binding to the Control's properties over
+ * setting the properties directly, as the Control's properties may affect other
+ * things like setting accessible names.
+ *
+ * Example usage as contentItem of an ItemDelegate:
+ *
+ * ```qml
+ * ItemDelegate {
+ *     id: delegate
+ *
+ *     text: "Example"
+ *
+ *     contentItem: Kirigami.TitleSubtitle {
+ *         title: delegate.text
+ *         subtitle: "This is an example."
+ *         font: delegate.font
+ *         selected: delegate.highlighted || delegate.down
+ *     }
+ * }
+ * ```
+ *
+ * The labels are laid out and styled from C++, so an instance only creates
+ * the two labels and no bindings of its own, which keeps delegates using it
+ * cheap to create in long lists.
+ *
+ * \sa Kirigami::Delegates::IconTitleSubtitle
+ * \sa Kirigami::Delegates::ItemDelegate
+ */
+class TitleSubtitle : public QQuickItem
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    /**
+     * The title to display.
+     */
+    Q_PROPERTY(QString title READ title WRITE setTitle NOTIFY titleChanged REQUIRED FINAL)
+    /**
+     * The subtitle to display.
+     */
+    Q_PROPERTY(QString subtitle READ subtitle WRITE setSubtitle NOTIFY subtitleChanged FINAL)
+    /**
+     * The color to use for the title.
+     *
+     * By default this is `Kirigami.Theme.textColor` unless `selected` is true
+     * in which case this is `Kirigami.Theme.highlightedTextColor`.
+     */
+    Q_PROPERTY(QColor color READ color WRITE setColor RESET resetColor NOTIFY colorChanged FINAL)
+    /**
+     * The color to use for the subtitle.
+     *
+     * By default this is `color` mixed with the background color.
+     */
+    Q_PROPERTY(QColor subtitleColor READ subtitleColor WRITE setSubtitleColor RESET resetSubtitleColor NOTIFY subtitleColorChanged FINAL)
+    /**
+     * The font used to display the title.
+     *
+     * By default this is `Kirigami.Theme.defaultFont`.
+     */
+    Q_PROPERTY(QFont font READ font WRITE setFont RESET resetFont NOTIFY fontChanged FINAL)
+    /**
+     * The font used to display the subtitle.
+     *
+     * By default this is `Kirigami.Theme.smallFont`.
+     */
+    Q_PROPERTY(QFont subtitleFont READ subtitleFont WRITE setSubtitleFont RESET resetSubtitleFont NOTIFY subtitleFontChanged FINAL)
+    /**
+     * The text elision mode used for both the title and subtitle.
+     *
+     * default: ``Text.ElideRight``
+     */
+    Q_PROPERTY(int elide READ elide WRITE setElide NOTIFY elideChanged FINAL)
+    /**
+     * The text wrap mode used for both the title and subtitle.
+     *
+     * default: ``Text.NoWrap``
+     */
+    Q_PROPERTY(int wrapMode READ wrapMode WRITE setWrapMode NOTIFY wrapModeChanged FINAL)
+    /**
+     * Make the implicit height use the subtitle's height even if no subtitle is set.
+     */
+    Q_PROPERTY(bool reserveSpaceForSubtitle READ reserveSpaceForSubtitle WRITE setReserveSpaceForSubtitle NOTIFY reserveSpaceForSubtitleChanged FINAL)
+    /**
+     * Should this item be displayed in a selected style?
+     */
+    Q_PROPERTY(bool selected READ isSelected WRITE setSelected NOTIFY selectedChanged FINAL)
+    /**
+     * Is the subtitle visible?
+     */
+    Q_PROPERTY(bool subtitleVisible READ isSubtitleVisible NOTIFY subtitleVisibleChanged FINAL)
+    /**
+     * Is the title or subtitle truncated?
+     */
+    Q_PROPERTY(bool truncated READ isTruncated NOTIFY truncatedChanged FINAL)
+
+public:
+    explicit TitleSubtitle(QQuickItem *parent = nullptr);
+    ~TitleSubtitle() override;
+
+    QString title() const;
+    void setTitle(const QString &title);
+
+    QString subtitle() const;
+    void setSubtitle(const QString &subtitle);
+
+    QColor color() const;
+    void setColor(const QColor &color);
+    void resetColor();
+
+    QColor subtitleColor() const;
+    void setSubtitleColor(const QColor &color);
+    void resetSubtitleColor();
+
+    QFont font() const;
+    void setFont(const QFont &font);
+    void resetFont();
+
+    QFont subtitleFont() const;
+    void setSubtitleFont(const QFont &font);
+    void resetSubtitleFont();
+
+    int elide() const;
+    void setElide(int elide);
+
+    int wrapMode() const;
+    void setWrapMode(int wrapMode);
+
+    bool reserveSpaceForSubtitle() const;
+    void setReserveSpaceForSubtitle(bool reserve);
+
+    bool isSelected() const;
+    void setSelected(bool selected);
+
+    bool isSubtitleVisible() const;
+    bool isTruncated() const;
+
+Q_SIGNALS:
+    void titleChanged();
+    void subtitleChanged();
+    void colorChanged();
+    void subtitleColorChanged();
+    void fontChanged();
+    void subtitleFontChanged();
+    void elideChanged();
+    void wrapModeChanged();
+    void reserveSpaceForSubtitleChanged();
+    void selectedChanged();
+    void subtitleVisibleChanged();
+    void truncatedChanged();
+
+    /**
+     * @brief Emitted when the user clicks on a link embedded in the text of the title or subtitle.
+     */
+    void linkActivated(const QString &link);
+
+    /**
+     * @brief Emitted when the user hovers on a link embedded in the text of the title or subtitle.
+     */
+    void linkHovered(const QString &link);
+
+protected:
+    void classBegin() override;
+    void componentComplete() override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private Q_SLOTS:
+    void updateTruncated();
+
+private:
+    QQuickItem *createLabel(QQmlComponent *component, const QString &text, const QColor &color, const QFont &font);
+    void updateColors();
+    void updateFonts();
+    void updateImplicitSize();
+    void layoutLabels();
+    void setSubtitleVisible(bool visible);
+
+    QPointer<Kirigami::Platform::PlatformTheme> m_theme;
+    QQuickItem *m_titleItem = nullptr;
+    QQuickItem *m_subtitleItem = nullptr;
+
+    QString m_title;
+    QString m_subtitle;
+    // Unset while following the theme.
+    std::optional<QColor> m_color;
+    std::optional<QColor> m_subtitleColor;
+    std::optional<QFont> m_font;
+    std::optional<QFont> m_subtitleFont;
+    // The values last applied to the labels, to only notify about changes.
+    QColor m_effectiveColor;
+    QColor m_effectiveSubtitleColor;
+    QFont m_effectiveFont;
+    QFont m_effectiveSubtitleFont;
+    int m_elide = Qt::ElideRight;
+    int m_wrapMode = 0;
+    bool m_reserveSpaceForSubtitle = false;
+    bool m_selected = false;
+    bool m_subtitleVisible = false;
+    bool m_truncated = false;
+};
@@ -48,6 +48,20 @@ import org.kde.kirigami as Kirigami
  * }
  * @endcode{}
  *
+ * For large models, use a SearchFilterModel as model instead, which is
+ * filtered as the text changes without any further code:
+ *
+ * @code{.qml}
+ * Kirigami.SearchDialog {
+ *    model: Kirigami.SearchFilterModel {
+ *        sourceModel: RoomModel { }
+ *        filterRoleName: "displayName"
+ *    }
+ *
+ *    delegate: RoomDelegate { }
+ * }
+ * @endcode{}
+ *
  * @image html searchdialog.html
  *
  * @note This component is unsuitable on mobile. Instead on mobile prefer to
@@ -140,6 +154,12 @@ QQC2.Dialog {
         listView.currentIndex = 0;
     }
 
+    onTextChanged: {
+        if (model instanceof SearchFilterModel) {
+            model.filterText = text;
+        }
+    }
+
     contentItem: ColumnLayout {
         spacing: 0
 
@@ -0,0 +1,481 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "searchfiltermodel.h"
+
+#include <QtConcurrentRun>
+
+#include <algorithm>
+#include <numeric>
+
+SearchFilterModel::SearchFilterModel(QObject *parent)
+    : QAbstractProxyModel(parent)
+{
+    m_filterTimer.setSingleShot(true);
+    m_filterTimer.setInterval(0);
+    connect(&m_filterTimer, &QTimer::timeout, this, &SearchFilterModel::filter);
+}
+
+SearchFilterModel::~SearchFilterModel()
+{
+    cancelFilter();
+}
+
+QString SearchFilterModel::filterText() const
+{
+    return m_filterText;
+}
+
+void SearchFilterModel::setFilterText(const QString &text)
+{
+    if (text == m_filterText) {
+        return;
+    }
+
+    m_filterText = text;
+    Q_EMIT filterTextChanged();
+
+    scheduleFilter();
+}
+
+QString SearchFilterModel::filterRoleName() const
+{
+    return m_filterRoleName;
+}
+
+void SearchFilterModel::setFilterRoleName(const QString &roleName)
+{
+    if (roleName == m_filterRoleName) {
+        return;
+    }
+
+    m_filterRoleName = roleName;
+    Q_EMIT filterRoleNameChanged();
+
+    invalidateTexts();
+    scheduleFilter();
+}
+
+Qt::CaseSensitivity SearchFilterModel::filterCaseSensitivity() const
+{
+    return m_filterCaseSensitivity;
+}
+
+void SearchFilterModel::setFilterCaseSensitivity(Qt::CaseSensitivity sensitivity)
+{
+    if (sensitivity == m_filterCaseSensitivity) {
+        return;
+    }
+
+    m_filterCaseSensitivity = sensitivity;
+    Q_EMIT filterCaseSensitivityChanged();
+
+    invalidateTexts();
+    scheduleFilter();
+}
+
+int SearchFilterModel::filterDelay() const
+{
+    return m_filterTimer.interval();
+}
+
+void SearchFilterModel::setFilterDelay(int delay)
+{
+    delay = std::max(delay, 0);
+    if (delay == m_filterTimer.interval()) {
+        return;
+    }
+
+    m_filterTimer.setInterval(delay);
+    Q_EMIT filterDelayChanged();
+}
+
+bool SearchFilterModel::isBusy() const
+{
+    return m_busy;
+}
+
+void SearchFilterModel::setSourceModel(QAbstractItemModel *model)
+{
+    if (model == sourceModel()) {
+        return;
+    }
+
+    beginResetModel();
+
+    for (const auto &connection : std::as_const(m_sourceConnections)) {
+        disconnect(connection);
+    }
+    m_sourceConnections.clear();
+
+    QAbstractProxyModel::setSourceModel(model);
+
+    if (model) {
+        // Changes to the rows of the source model change the rows of all
+        // results, so they are treated as a reset.
+        auto reset = [this]() {
+            resetRows();
+            endResetModel();
+        };
+
+        m_sourceConnections = {
+            connect(model, &QAbstractItemModel::modelAboutToBeReset, this, &SearchFilterModel::beginResetModel),
+            connect(model, &QAbstractItemModel::modelReset, this, reset),
+            connect(model, &QAbstractItemModel::layoutAboutToBeChanged, this, &SearchFilterModel::beginResetModel),
+            connect(model, &QAbstractItemModel::layoutChanged, this, reset),
+            connect(model, &QAbstractItemModel::rowsAboutToBeInserted, this, &SearchFilterModel::beginResetModel),
+            connect(model, &QAbstractItemModel::rowsInserted, this, reset),
+            connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this, &SearchFilterModel::beginResetModel),
+            connect(model, &QAbstractItemModel::rowsRemoved, this, reset),
+            connect(model, &QAbstractItemModel::rowsAboutToBeMoved, this, &SearchFilterModel::beginResetModel),
+            connect(model, &QAbstractItemModel::rowsMoved, this, reset),
+            connect(model, &QAbstractItemModel::dataChanged, this, &SearchFilterModel::onSourceDataChanged),
+            // QAbstractProxyModel replaces a deleted source model by an empty one.
+            connect(model, &QObject::destroyed, this,
+                    [this]() {
+                        beginResetModel();
+                        resetRows();
+                        endResetModel();
+                    }),
+        };
+    }
+
+    resetRows();
+    endResetModel();
+}
+
+QModelIndex SearchFilterModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (parent.isValid() || row < 0 || row >= int(m_rows.size()) || column < 0 || column >= columnCount()) {
+        return QModelIndex();
+    }
+    return createIndex(row, column);
+}
+
+QModelIndex SearchFilterModel::parent(const QModelIndex &child) const
+{
+    Q_UNUSED(child)
+    return QModelIndex();
+}
+
+int SearchFilterModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(m_rows.size());
+}
+
+int SearchFilterModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid() || !sourceModel()) {
+        return 0;
+    }
+    return sourceModel()->columnCount();
+}
+
+bool SearchFilterModel::hasChildren(const QModelIndex &parent) const
+{
+    return !parent.isValid() && !m_rows.empty();
+}
+
+QModelIndex SearchFilterModel::mapToSource(const QModelIndex &proxyIndex) const
+{
+    if (!proxyIndex.isValid() || !sourceModel() || proxyIndex.row() >= int(m_rows.size())) {
+        return QModelIndex();
+    }
+    return sourceModel()->index(m_rows[proxyIndex.row()], proxyIndex.column());
+}
+
+QModelIndex SearchFilterModel::mapFromSource(const QModelIndex &sourceIndex) const
+{
+    if (!sourceIndex.isValid() || sourceIndex.model() != sourceModel()) {
+        return QModelIndex();
+    }
+
+    const auto it = std::lower_bound(m_rows.cbegin(), m_rows.cend(), sourceIndex.row());
+    if (it == m_rows.cend() || *it != sourceIndex.row()) {
+        return QModelIndex();
+    }
+    return index(int(std::distance(m_rows.cbegin(), it)), sourceIndex.column());
+}
+
+SearchFilterModel::Rows SearchFilterModel::filterRows(const QStringList &texts, const Rows &candidates, const QString &text, const QPromise<Rows> *promise)
+{
+    Rows rows;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (promise && i % 1024 == 0 && promise->isCanceled()) {
+            return Rows();
+        }
+
+        const int row = candidates[i];
+        // Case insensitive searches compare case folded texts.
+        if (row < texts.size() && texts[row].contains(text, Qt::CaseSensitive)) {
+            rows.push_back(row);
+        }
+    }
+    return rows;
+}
+
+void SearchFilterModel::scheduleFilter()
+{
+    setBusy(true);
+    m_filterTimer.start();
+}
+
+void SearchFilterModel::cancelFilter()
+{
+    if (m_watcher) {
+        // The watcher deletes itself once the canceled job has stopped.
+        m_watcher->cancel();
+        m_watcher = nullptr;
+    }
+}
+
+void SearchFilterModel::filter()
+{
+    m_filterTimer.stop();
+    cancelFilter();
+
+    const QAbstractItemModel *model = sourceModel();
+    if (!model) {
+        applyRows(Rows(), QString(), m_textsGeneration);
+        setBusy(false);
+        return;
+    }
+
+    const QString text = m_filterCaseSensitivity == Qt::CaseInsensitive ? m_filterText.toCaseFolded() : m_filterText;
+    if (text.isEmpty()) {
+        Rows rows(model->rowCount());
+        std::iota(rows.begin(), rows.end(), 0);
+        applyRows(std::move(rows), text, m_textsGeneration);
+        setBusy(false);
+        return;
+    }
+
+    updateTexts();
+
+    // Rows that do not contain the previous text do not contain a text that
+    // extends it either, so only the previous results need to be searched.
+    Rows candidates;
+    if (m_rowsGeneration == m_textsGeneration && text.contains(m_rowsText, Qt::CaseSensitive)) {
+        candidates = m_rows;
+    } else {
+        candidates.resize(m_texts.size());
+        std::iota(candidates.begin(), candidates.end(), 0);
+    }
+
+    const int generation = m_textsGeneration;
+    if (candidates.size() < size_t(s_backgroundThreshold)) {
+        applyRows(filterRows(m_texts, candidates, text), text, generation);
+        setBusy(false);
+        return;
+    }
+
+    auto watcher = new QFutureWatcher<Rows>(this);
+    m_watcher = watcher;
+    connect(watcher, &QFutureWatcher<Rows>::finished, this, [this, watcher, text, generation]() {
+        watcher->deleteLater();
+        if (watcher != m_watcher) {
+            return;
+        }
+        m_watcher = nullptr;
+
+        // Changes to the texts schedule filtering again.
+        if (!watcher->isCanceled() && watcher->future().resultCount() > 0 && generation == m_textsGeneration) {
+            applyRows(watcher->result(), text, generation);
+            setBusy(m_filterTimer.isActive());
+        }
+    });
+
+    // The job works on copies, so it does not need to be waited for when the
+    // texts change or this is deleted.
+    watcher->setFuture(QtConcurrent::run(
+        [](QPromise<Rows> &promise, const QStringList &texts, const Rows &candidates, const QString &text) {
+            promise.addResult(filterRows(texts, candidates, text, &promise));
+        },
+        m_texts,
+        std::move(candidates),
+        text));
+}
+
+void SearchFilterModel::updateTexts()
+{
+    if (m_textsValid) {
+        return;
+    }
+
+    m_textsValid = true;
+    ++m_textsGeneration;
+    m_texts.clear();
+
+    const QAbstractItemModel *model = sourceModel();
+    if (!model) {
+        return;
+    }
+
+    const int role = model->roleNames().key(m_filterRoleName.toUtf8(), Qt::DisplayRole);
+    const int count = model->rowCount();
+    m_texts.reserve(count);
+    for (int row = 0; row < count; ++row) {
+        const QString text = model->data(model->index(row, 0), role).toString();
+        m_texts << (m_filterCaseSensitivity == Qt::CaseInsensitive ? text.toCaseFolded() : text);
+    }
+}
+
+void SearchFilterModel::invalidateTexts()
+{
+    m_textsValid = false;
+    m_texts.clear();
+    ++m_textsGeneration;
+}
+
+void SearchFilterModel::resetRows()
+{
+    cancelFilter();
+    invalidateTexts();
+
+    // Without a search text this is only the list of all rows, so it is
+    // cheaper than scheduling a filter and showing no rows in the meantime.
+    m_rows.clear();
+    if (m_filterText.isEmpty()) {
+        if (const QAbstractItemModel *model = sourceModel()) {
+            m_rows.resize(model->rowCount());
+            std::iota(m_rows.begin(), m_rows.end(), 0);
+        }
+        m_rowsText.clear();
+        m_rowsGeneration = -1;
+    } else {
+        scheduleFilter();
+    }
+}
+
+void SearchFilterModel::applyRows(Rows &&rows, const QString &text, int generation)
+{
+    m_rowsText = text;
+    m_rowsGeneration = generation;
+
+    // Count the ranges of rows that are removed or inserted.
+    int changedRanges = 0;
+    {
+        bool removing = false;
+        bool inserting = false;
+        size_t i = 0;
+        size_t j = 0;
+        while (i < m_rows.size() || j < rows.size()) {
+            if (i < m_rows.size() && j < rows.size() && m_rows[i] == rows[j]) {
+                removing = false;
+                inserting = false;
+                ++i;
+                ++j;
+            } else if (j == rows.size() || (i < m_rows.size() && m_rows[i] < rows[j])) {
+                changedRanges += removing ? 0 : 1;
+                removing = true;
+                inserting = false;
+                ++i;
+            } else {
+                changedRanges += inserting ? 0 : 1;
+                inserting = true;
+                removing = false;
+                ++j;
+            }
+        }
+    }
+
+    if (changedRanges == 0) {
+        return;
+    }
+
+    if (changedRanges > s_maximumChangedRanges) {
+        beginResetModel();
+        m_rows = std::move(rows);
+        endResetModel();
+        return;
+    }
+
+    // Remove the rows that are not kept, starting from the end so the
+    // positions of the ones before stay the same.
+    for (int last = int(m_rows.size()) - 1; last >= 0;) {
+        if (std::binary_search(rows.cbegin(), rows.cend(), m_rows[last])) {
+            --last;
+            continue;
+        }
+
+        int first = last;
+        while (first > 0 && !std::binary_search(rows.cbegin(), rows.cend(), m_rows[first - 1])) {
+            --first;
+        }
+
+        beginRemoveRows(QModelIndex(), first, last);
+        m_rows.erase(m_rows.begin() + first, m_rows.begin() + last + 1);
+        endRemoveRows();
+
+        last = first - 1;
+    }
+
+    // All remaining rows are kept, insert the new ones between them.
+    size_t position = 0;
+    for (size_t i = 0; i < rows.size();) {
+        if (position < m_rows.size() && m_rows[position] == rows[i]) {
+            ++position;
+            ++i;
+            continue;
+        }
+
+        size_t end = i;
+        while (end < rows.size() && (position >= m_rows.size() || rows[end] != m_rows[position])) {
+            ++end;
+        }
+
+        beginInsertRows(QModelIndex(), int(position), int(position + end - i - 1));
+        m_rows.insert(m_rows.begin() + position, rows.cbegin() + i, rows.cbegin() + end);
+        endInsertRows();
+
+        position += end - i;
+        i = end;
+    }
+}
+
+void SearchFilterModel::setBusy(bool busy)
+{
+    if (busy == m_busy) {
+        return;
+    }
+
+    m_busy = busy;
+    Q_EMIT busyChanged();
+}
+
+void SearchFilterModel::onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles)
+{
+    if (topLeft.parent().isValid()) {
+        return;
+    }
+
+    const auto first = std::lower_bound(m_rows.cbegin(), m_rows.cend(), topLeft.row());
+    const auto last = std::upper_bound(first, m_rows.cend(), bottomRight.row());
+    if (first != last) {
+        Q_EMIT dataChanged(index(int(std::distance(m_rows.cbegin(), first)), topLeft.column()),
+                           index(int(std::distance(m_rows.cbegin(), last)) - 1, bottomRight.column()),
+                           roles);
+    }
+
+    const QAbstractItemModel *model = sourceModel();
+    const int role = model->roleNames().key(m_filterRoleName.toUtf8(), Qt::DisplayRole);
+    if (!m_textsValid || topLeft.column() > 0 || (!roles.isEmpty() && !roles.contains(role))) {
+        return;
+    }
+
+    // Only the texts of the changed rows need to be read again.
+    for (int row = topLeft.row(); row <= bottomRight.row() && row < m_texts.size(); ++row) {
+        const QString text = model->data(model->index(row, 0), role).toString();
+        m_texts[row] = m_filterCaseSensitivity == Qt::CaseInsensitive ? text.toCaseFolded() : text;
+    }
+    ++m_textsGeneration;
+
+    if (!m_filterText.isEmpty()) {
+        scheduleFilter();
+    }
+}
+
+#include "moc_searchfiltermodel.cpp"
@@ -0,0 +1,166 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QAbstractProxyModel>
+#include <QFutureWatcher>
+#include <QPromise>
+#include <QQmlEngine>
+#include <QTimer>
+
+#include <vector>
+
+/**
+ * A model filtering the rows of a list model by a search text, meant to be
+ * used with SearchDialog.
+ *
+ * A row is kept when the text of its `filterRoleName` role contains
+ * `filterText`. Setting the model of a SearchDialog to a SearchFilterModel
+ * makes the dialog update `filterText` as the user types.
+ *
+ * Filtering is done on a copy of the texts of the source model, which is
+ * only updated when the source model changes. When the search text extends
+ * the previous one, only the rows matching the previous text are searched
+ * again. Large source models are filtered on a background thread, and the
+ * results are applied as the rows that were removed and inserted compared
+ * to the previous results, so views only create delegates for new rows.
+ *
+ * @code{.qml}
+ * import org.kde.kirigami as Kirigami
+ *
+ * Kirigami.SearchDialog {
+ *     model: Kirigami.SearchFilterModel {
+ *         sourceModel: CommandModel {}
+ *         filterRoleName: "name"
+ *     }
+ *
+ *     delegate: CommandDelegate {}
+ * }
+ * @endcode
+ *
+ * @since 6.12
+ */
+class SearchFilterModel : public QAbstractProxyModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    /**
+     * The text rows need to contain to be kept. All rows are kept when this
+     * is empty.
+     */
+    Q_PROPERTY(QString filterText READ filterText WRITE setFilterText NOTIFY filterTextChanged FINAL)
+
+    /**
+     * The name of the role of the source model that is searched.
+     *
+     * default: ``"display"``
+     */
+    Q_PROPERTY(QString filterRoleName READ filterRoleName WRITE setFilterRoleName NOTIFY filterRoleNameChanged FINAL)
+
+    /**
+     * Whether the search takes the case of the text into account.
+     *
+     * default: ``Qt.CaseInsensitive``
+     */
+    Q_PROPERTY(Qt::CaseSensitivity filterCaseSensitivity READ filterCaseSensitivity WRITE setFilterCaseSensitivity NOTIFY filterCaseSensitivityChanged FINAL)
+
+    /**
+     * The time in milliseconds to wait after the last change of the filter
+     * text before the results are updated. Changes made within the same
+     * event loop iteration are always combined.
+     *
+     * default: ``0``
+     */
+    Q_PROPERTY(int filterDelay READ filterDelay WRITE setFilterDelay NOTIFY filterDelayChanged FINAL)
+
+    /**
+     * Whether new results are being computed.
+     */
+    Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged FINAL)
+
+public:
+    explicit SearchFilterModel(QObject *parent = nullptr);
+    ~SearchFilterModel() override;
+
+    QString filterText() const;
+    void setFilterText(const QString &text);
+
+    QString filterRoleName() const;
+    void setFilterRoleName(const QString &roleName);
+
+    Qt::CaseSensitivity filterCaseSensitivity() const;
+    void setFilterCaseSensitivity(Qt::CaseSensitivity sensitivity);
+
+    int filterDelay() const;
+    void setFilterDelay(int delay);
+
+    bool isBusy() const;
+
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+
+    QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
+    QModelIndex mapFromSource(const QModelIndex &sourceIndex) const override;
+
+Q_SIGNALS:
+    void filterTextChanged();
+    void filterRoleNameChanged();
+    void filterCaseSensitivityChanged();
+    void filterDelayChanged();
+    void busyChanged();
+
+private:
+    // The rows of the source model that are kept, in increasing order.
+    using Rows = std::vector<int>;
+
+    static Rows filterRows(const QStringList &texts, const Rows &candidates, const QString &text, const QPromise<Rows> *promise = nullptr);
+
+    void scheduleFilter();
+    void cancelFilter();
+    void filter();
+    void updateTexts();
+    void invalidateTexts();
+    void resetRows();
+    void applyRows(Rows &&rows, const QString &text, int generation);
+    void setBusy(bool busy);
+    void onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles);
+
+    // Candidates above this are filtered on a background thread.
+    static constexpr int s_backgroundThreshold = 5000;
+    // Results changing more ranges of rows than this reset the model, as
+    // updating views for every range would be slower.
+    static constexpr int s_maximumChangedRanges = 64;
+
+    QString m_filterText;
+    QString m_filterRoleName = QStringLiteral("display");
+    Qt::CaseSensitivity m_filterCaseSensitivity = Qt::CaseInsensitive;
+    QTimer m_filterTimer;
+
+    // The searched texts of all rows of the source model, case folded for
+    // case insensitive searches.
+    QStringList m_texts;
+    bool m_textsValid = false;
+    // Incremented whenever m_texts changes, to drop outdated results.
+    int m_textsGeneration = 0;
+
+    Rows m_rows;
+    // The search text and generation of m_texts m_rows was computed for,
+    // used to narrow down the results when the search text is extended.
+    QString m_rowsText;
+    int m_rowsGeneration = -1;
+
+    QFutureWatcher<Rows> *m_watcher = nullptr;
+    bool m_busy = false;
+
+    QList<QMetaObject::Connection> m_sourceConnections;
+};
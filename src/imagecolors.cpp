@@ -6,13 +6,20 @@
  */
 
 #include "imagecolors.h"
+#include "imagecolorscache.h"
 
 #include <QDebug>
 #include <QFutureWatcher>
 #include <QGuiApplication>
+#include <QImageReader>
+#include <QThread>
+#include <QThreadPool>
 #include <QtConcurrentRun>
+#include <QtConcurrentTask>
 
 #include "loggingcategory.h"
+#include "tracelogging.h"
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
@@ -21,18 +28,47 @@
 #include <omp.h>
 #endif
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "platform/performancecounters_p.h"
 #include "platform/platformtheme.h"
+#include "platform/tracescope_p.h"
+
+// Palette jobs run on their own bounded pool, so that a lot of ImageColors
+// changing their source at once, like when scrolling through a grid of album
+// covers, neither starves the global pool nor oversubscribes the CPU.
+class PaletteThreadPool : public QThreadPool
+{
+public:
+    PaletteThreadPool()
+    {
+        setObjectName(QStringLiteral("ImageColors"));
+        setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+    }
+};
+
+Q_GLOBAL_STATIC(PaletteThreadPool, s_threadPool)
+
+// Palettes computed with different algorithms are cached separately.
+static QString cacheKeySuffix(ImageColors::Algorithm algorithm)
+{
+    return algorithm == ImageColors::MedianCut ? QStringLiteral(":mediancut") : QString();
+}
 
 #define return_fallback(value)                                                                                                                                 \
-    if (m_imageData.m_samples.size() == 0) {                                                                                                                   \
+    if (m_imageData.m_palette.isEmpty()) {                                                                                                                   \
         return value;                                                                                                                                          \
     }
 
 #define return_fallback_finally(value, finally)                                                                                                                \
-    if (m_imageData.m_samples.size() == 0) {                                                                                                                   \
+    if (m_imageData.m_palette.isEmpty()) {                                                                                                                   \
         return value.isValid()                                                                                                                                 \
             ? value                                                                                                                                            \
-            : static_cast<Kirigami::Platform::PlatformTheme *>(qmlAttachedPropertiesObject<Kirigami::Platform::PlatformTheme>(this, true))->finally();         \
+            : Kirigami::Platform::PlatformTheme::themeForReading(this)->finally();                                                                             \
     }
 
 PaletteSwatch::PaletteSwatch()
@@ -75,6 +111,7 @@ ImageColors::ImageColors(QObject *parent)
 
 ImageColors::~ImageColors()
 {
+    Kirigami::Platform::PerformanceCounters::adjust(Kirigami::Platform::PerformanceCounters::ImageColorsBytes, -m_reportedBytes);
 }
 
 void ImageColors::setSource(const QVariant &source)
@@ -85,6 +122,8 @@ void ImageColors::setSource(const QVariant &source)
         m_futureSourceImageData = nullptr;
     }
 
+    m_fileCacheKey.clear();
+
     if (source.canConvert<QQuickItem *>()) {
         setSourceItem(source.value<QQuickItem *>());
     } else if (source.canConvert<QImage>()) {
@@ -94,21 +133,42 @@ void ImageColors::setSource(const QVariant &source)
     } else if (source.canConvert<QString>()) {
         const QString sourceString = source.toString();
 
+        const QUrl url(sourceString);
+        if (m_persistentCache) {
+            m_fileCacheKey = ImageColorsCache::fileKey(url.isLocalFile() ? url.toLocalFile() : sourceString) + cacheKeySuffix(m_algorithm);
+        }
+
         if (QIcon::hasThemeIcon(sourceString)) {
             setSourceImage(QIcon::fromTheme(sourceString).pixmap(128, 128).toImage());
+        } else if (ImageColorsCache::contains(m_fileCacheKey)) {
+            // The palette of this file is known already, no need to load it.
+            clearSourceItem();
+            m_sourceImage = QImage();
+            update();
         } else {
-            QFuture<QImage> future = QtConcurrent::run([sourceString]() {
+            QFuture<QImage> future = QtConcurrent::run(s_threadPool(), [sourceString]() {
+                QImageReader reader;
                 if (auto url = QUrl(sourceString); url.isLocalFile()) {
-                    return QImage(url.toLocalFile());
+                    reader.setFileName(url.toLocalFile());
+                } else {
+                    reader.setFileName(sourceString);
+                }
+                // Let the decoder skip detail we don't need, which is much
+                // cheaper than decoding at full size, e.g. for JPEG files.
+                const QSize size = reader.size();
+                if (size.isValid() && std::max(size.width(), size.height()) > s_downscaleThreshold) {
+                    reader.setScaledSize(samplingSize(size));
                 }
-                return QImage(sourceString);
+                return reader.read();
             });
             m_futureSourceImageData = new QFutureWatcher<QImage>(this);
             connect(m_futureSourceImageData, &QFutureWatcher<QImage>::finished, this, [this, source]() {
                 const QImage image = m_futureSourceImageData->future().result();
                 m_futureSourceImageData->deleteLater();
                 m_futureSourceImageData = nullptr;
-                setSourceImage(image);
+                clearSourceItem();
+                m_sourceImage = image;
+                update();
                 m_source = source;
                 Q_EMIT sourceChanged();
             });
@@ -129,6 +189,15 @@ QVariant ImageColors::source() const
 }
 
 void ImageColors::setSourceImage(const QImage &image)
+{
+    m_fileCacheKey.clear();
+    clearSourceItem();
+
+    m_sourceImage = image;
+    update();
+}
+
+void ImageColors::clearSourceItem()
 {
     if (m_window) {
         disconnect(m_window.data(), nullptr, this, nullptr);
@@ -142,9 +211,6 @@ void ImageColors::setSourceImage(const QImage &image)
     }
 
     m_sourceItem.clear();
-
-    m_sourceImage = image;
-    update();
 }
 
 QImage ImageColors::sourceImage() const
@@ -158,6 +224,8 @@ void ImageColors::setSourceItem(QQuickItem *source)
         return;
     }
 
+    m_fileCacheKey.clear();
+
     if (m_window) {
         disconnect(m_window.data(), nullptr, this, nullptr);
     }
@@ -198,22 +266,64 @@ void ImageColors::update()
         m_futureImageData = nullptr;
     }
 
+    // Stop a job that is already running as soon as possible, jobs that did
+    // not start yet are dropped by QFuture::cancel() above.
+    if (m_canceled) {
+        m_canceled->store(true);
+        m_canceled.reset();
+    }
+
     auto runUpdate = [this]() {
         auto sourceImage{m_sourceImage};
-        QFuture<ImageData> future = QtConcurrent::run([sourceImage = std::move(sourceImage)]() {
-            return generatePalette(sourceImage);
-        });
+        QList<QRgb> initialCentroids;
+        if (m_incremental) {
+            initialCentroids.reserve(m_imageData.m_clusters.size());
+            for (const auto &stat : std::as_const(m_imageData.m_clusters)) {
+                initialCentroids << stat.centroid;
+            }
+        }
+        const bool persistentCache = m_persistentCache;
+        const Algorithm algorithm = m_algorithm;
+        const QString fileCacheKey = m_fileCacheKey;
+        auto canceled = std::make_shared<std::atomic_bool>(false);
+        m_canceled = canceled;
+        // Items that are currently on screen are more likely to be looked at.
+        const int priority = m_sourceItem && m_sourceItem->isVisible() && m_window && m_window->isVisible() ? 1 : 0;
+
+        QFuture<ImageData> future =
+            QtConcurrent::task(
+                [sourceImage = std::move(sourceImage), initialCentroids = std::move(initialCentroids), persistentCache, algorithm, fileCacheKey, canceled]() {
+                    const QImage image = downscaleForSampling(sourceImage);
+                    if (!persistentCache) {
+                        return generatePalette(image, initialCentroids, canceled.get(), algorithm);
+                    }
+
+                    const QString imageKey = ImageColorsCache::imageKey(image) + cacheKeySuffix(algorithm);
+                    if (auto imageData = ImageColorsCache::find(imageKey)) {
+                        return *imageData;
+                    }
+
+                    ImageData imageData = generatePalette(image, initialCentroids, canceled.get(), algorithm);
+                    if (!canceled->load()) {
+                        ImageColorsCache::insert(imageKey, imageData);
+                        ImageColorsCache::insert(fileCacheKey, imageData);
+                    }
+                    return imageData;
+                })
+                .onThreadPool(*s_threadPool)
+                .withPriority(priority)
+                .spawn();
         m_futureImageData = new QFutureWatcher<ImageData>(this);
         connect(m_futureImageData, &QFutureWatcher<ImageData>::finished, this, [this]() {
             if (!m_futureImageData) {
                 return;
             }
-            m_imageData = m_futureImageData->future().result();
-            postProcess(m_imageData);
+            const ImageData imageData = m_futureImageData->future().result();
             m_futureImageData->deleteLater();
             m_futureImageData = nullptr;
+            m_canceled.reset();
 
-            Q_EMIT paletteChanged();
+            setImageData(imageData);
         });
         m_futureImageData->setFuture(future);
     };
@@ -221,8 +331,11 @@ void ImageColors::update()
     if (!m_sourceItem || !m_sourceItem->window() || !m_sourceItem->window()->isVisible()) {
         if (!m_sourceImage.isNull()) {
             runUpdate();
+        } else if (auto imageData = ImageColorsCache::find(m_fileCacheKey)) {
+            setImageData(*imageData);
         } else {
             m_imageData = {};
+            updateReportedBytes();
             Q_EMIT paletteChanged();
         }
         return;
@@ -233,7 +346,8 @@ void ImageColors::update()
         m_grabResult.clear();
     }
 
-    m_grabResult = m_sourceItem->grabToImage(QSize(128, 128));
+    const QSize itemSize = (m_sourceItem->size() * m_sourceItem->window()->effectiveDevicePixelRatio()).toSize();
+    m_grabResult = m_sourceItem->grabToImage(samplingSize(itemSize, m_sourceItemSamplingSize));
 
     if (m_grabResult) {
         connect(m_grabResult.data(), &QQuickItemGrabResult::ready, this, [this, runUpdate]() {
@@ -248,22 +362,33 @@ static inline int squareDistance(QRgb color1, QRgb color2)
 {
     // https://en.wikipedia.org/wiki/Color_difference
     // Using RGB distance for performance, as CIEDE2000 is too complicated
-    if (qRed(color1) - qRed(color2) < 128) {
-        return 2 * pow(qRed(color1) - qRed(color2), 2) //
-            + 4 * pow(qGreen(color1) - qGreen(color2), 2) //
-            + 3 * pow(qBlue(color1) - qBlue(color2), 2);
+    const int red = qRed(color1) - qRed(color2);
+    const int green = qGreen(color1) - qGreen(color2);
+    const int blue = qBlue(color1) - qBlue(color2);
+    if (red < 128) {
+        return 2 * red * red + 4 * green * green + 3 * blue * blue;
     } else {
-        return 3 * pow(qRed(color1) - qRed(color2), 2) //
-            + 4 * pow(qGreen(color1) - qGreen(color2), 2) //
-            + 2 * pow(qBlue(color1) - qBlue(color2), 2);
+        return 3 * red * red + 4 * green * green + 2 * blue * blue;
     }
 }
 
-void ImageColors::positionColor(QRgb rgb, QList<ImageData::colorStat> &clusters)
+void ImageColors::positionColor(QRgb rgb, QList<ImageData::colorStat> &clusters, QHash<QRgb, qsizetype> &lookup)
 {
-    for (auto &stat : clusters) {
+    // Clusters are only ever appended while positioning colors and their
+    // centroids don't move, so a color always ends up in the same cluster as
+    // the last sample with the same value. Images usually contain far fewer
+    // distinct colors than pixels, so this avoids most of the linear scans.
+    const auto it = lookup.constFind(rgb);
+    if (it != lookup.constEnd()) {
+        clusters[*it].colors.append(rgb);
+        return;
+    }
+
+    for (qsizetype i = 0; i < clusters.size(); ++i) {
+        auto &stat = clusters[i];
         if (squareDistance(rgb, stat.centroid) < s_minimumSquareDistance) {
             stat.colors.append(rgb);
+            lookup.insert(rgb, i);
             return;
         }
     }
@@ -271,6 +396,7 @@ void ImageColors::positionColor(QRgb rgb, QList<ImageData::colorStat> &clusters)
     ImageData::colorStat stat;
     stat.colors.append(rgb);
     stat.centroid = rgb;
+    lookup.insert(rgb, clusters.size());
     clusters << stat;
 }
 
@@ -282,8 +408,9 @@ void ImageColors::positionColorMP(const decltype(ImageData::m_samples) &samples,
     if (true) {
 #endif
         // Fall back to single thread
+        QHash<QRgb, qsizetype> lookup;
         for (auto color : samples) {
-            positionColor(color, clusters);
+            positionColor(color, clusters, lookup);
         }
         return;
     }
@@ -296,8 +423,9 @@ void ImageColors::positionColorMP(const decltype(ImageData::m_samples) &samples,
         const auto beginIt = std::next(samples.begin(), numSamplesPerThread * i);
         const auto endIt = i < numCore - 1 ? std::next(samples.begin(), numSamplesPerThread * (i + 1)) : samples.end();
 
+        QHash<QRgb, qsizetype> lookup;
         for (auto it = beginIt; it != endIt; it = std::next(it)) {
-            positionColor(*it, tempClusters[omp_get_thread_num()]);
+            positionColor(*it, tempClusters[omp_get_thread_num()], lookup);
         }
     } // END omp parallel for
 
@@ -331,57 +459,199 @@ void ImageColors::positionColorMP(const decltype(ImageData::m_samples) &samples,
 #endif
 }
 
-ImageData ImageColors::generatePalette(const QImage &sourceImage)
+// Returns whether none of the four ARGB32 pixels at @p pixels can be a sample,
+// because they are either fully transparent or gray, and thus have no chroma.
+static inline bool rejectFourPixels(const QRgb *pixels)
 {
-    ImageData imageData;
+#if defined(__SSE2__)
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels));
+    const __m128i mask = _mm_set1_epi32(0xff);
+    const __m128i blue = _mm_and_si128(v, mask);
+    const __m128i green = _mm_and_si128(_mm_srli_epi32(v, 8), mask);
+    const __m128i red = _mm_and_si128(_mm_srli_epi32(v, 16), mask);
+    const __m128i alpha = _mm_srli_epi32(v, 24);
+    const __m128i transparent = _mm_cmpeq_epi32(alpha, _mm_setzero_si128());
+    const __m128i gray = _mm_and_si128(_mm_cmpeq_epi32(red, green), _mm_cmpeq_epi32(green, blue));
+    return _mm_movemask_epi8(_mm_or_si128(transparent, gray)) == 0xffff;
+#elif defined(__ARM_NEON)
+    const uint32x4_t v = vld1q_u32(pixels);
+    const uint32x4_t mask = vdupq_n_u32(0xff);
+    const uint32x4_t blue = vandq_u32(v, mask);
+    const uint32x4_t green = vandq_u32(vshrq_n_u32(v, 8), mask);
+    const uint32x4_t red = vandq_u32(vshrq_n_u32(v, 16), mask);
+    const uint32x4_t alpha = vshrq_n_u32(v, 24);
+    const uint32x4_t transparent = vceqq_u32(alpha, vdupq_n_u32(0));
+    const uint32x4_t gray = vandq_u32(vceqq_u32(red, green), vceqq_u32(green, blue));
+    const uint32x4_t rejected = vorrq_u32(transparent, gray);
+    return vgetq_lane_u32(rejected, 0) && vgetq_lane_u32(rejected, 1) && vgetq_lane_u32(rejected, 2) && vgetq_lane_u32(rejected, 3);
+#else
+    for (int i = 0; i < 4; ++i) {
+        const QRgb pixel = pixels[i];
+        if (qAlpha(pixel) != 0 && !(qRed(pixel) == qGreen(pixel) && qGreen(pixel) == qBlue(pixel))) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
 
-    if (sourceImage.isNull() || sourceImage.width() == 0) {
-        return imageData;
+QSize ImageColors::samplingSize(const QSize &size, int maximum)
+{
+    if (size.width() <= maximum && size.height() <= maximum) {
+        return size.expandedTo(QSize(1, 1));
     }
+    return size.scaled(maximum, maximum, Qt::KeepAspectRatio).expandedTo(QSize(1, 1));
+}
 
-    imageData.m_clusters.clear();
-    imageData.m_samples.clear();
+QImage ImageColors::downscaleForSampling(const QImage &image)
+{
+    const int largestSide = std::max(image.width(), image.height());
+    if (image.isNull() || largestSide <= s_downscaleThreshold) {
+        return image;
+    }
 
-#if HAVE_OpenMP
-    static const int numCore = std::min(8, omp_get_num_procs());
-    omp_set_num_threads(numCore);
-#else
-    constexpr int numCore = 1;
-#endif
-    int r = 0;
-    int g = 0;
-    int b = 0;
-    int c = 0;
+    const int factor = (largestSide + s_samplingSize - 1) / s_samplingSize;
+
+    // A box filter: every output pixel is the average of a factor x factor
+    // block. Averaging is done on premultiplied colors so that transparent
+    // pixels don't bleed their color into the result.
+    const QImage source = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    const int width = source.width() / factor;
+    const int height = source.height() / factor;
+    const int blockSize = factor * factor;
+
+    QImage result(std::max(width, 1), std::max(height, 1), QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < result.height(); ++y) {
+        QRgb *out = reinterpret_cast<QRgb *>(result.scanLine(y));
+        for (int x = 0; x < result.width(); ++x) {
+            int a = 0;
+            int r = 0;
+            int g = 0;
+            int b = 0;
+            for (int blockY = 0; blockY < factor; ++blockY) {
+                const QRgb *line = reinterpret_cast<const QRgb *>(source.constScanLine(std::min(y * factor + blockY, source.height() - 1)));
+                for (int blockX = 0; blockX < factor; ++blockX) {
+                    const QRgb pixel = line[std::min(x * factor + blockX, source.width() - 1)];
+                    a += qAlpha(pixel);
+                    r += qRed(pixel);
+                    g += qGreen(pixel);
+                    b += qBlue(pixel);
+                }
+            }
+            out[x] = qRgba(r / blockSize, g / blockSize, b / blockSize, a / blockSize);
+        }
+    }
+    return result;
+}
+
+ImageColors::SampleSums ImageColors::sampleImage(const QImage &sourceImage, QList<QRgb> &samples)
+{
+    // Work on unpremultiplied 32 bit pixels, the same values QImage::pixelColor() would return.
+    const QImage image = sourceImage.convertToFormat(QImage::Format_ARGB32);
+    const int width = image.width();
+    const int height = image.height();
+
+    // Every row writes its samples into its own part of the buffer, so rows can
+    // be processed in parallel without any synchronization.
+    samples.resize(qsizetype(width) * height);
+    std::vector<int> rowCounts(height, 0);
+    QRgb *const buffer = samples.data();
+
+    qint64 r = 0;
+    qint64 g = 0;
+    qint64 b = 0;
+    qint64 c = 0;
+
+#pragma omp parallel for reduction(+ : r) reduction(+ : g) reduction(+ : b) reduction(+ : c)
+    for (int y = 0; y < height; ++y) {
+        const QRgb *line = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+        QRgb *out = buffer + qsizetype(y) * width;
+        int count = 0;
+
+        // Chroma is expensive to compute and neighbouring pixels often share
+        // their color, so remember the last result.
+        QRgb lastColor = 0;
+        bool lastAccepted = false;
+        bool hasLast = false;
+
+        for (int x = 0; x < width; ++x) {
+            if (x + 4 <= width && rejectFourPixels(line + x)) {
+                x += 3;
+                continue;
+            }
 
-#pragma omp parallel for collapse(2) reduction(+ : r) reduction(+ : g) reduction(+ : b) reduction(+ : c)
-    for (int x = 0; x < sourceImage.width(); ++x) {
-        for (int y = 0; y < sourceImage.height(); ++y) {
-            const QColor sampleColor = sourceImage.pixelColor(x, y);
-            if (sampleColor.alpha() == 0) {
+            const QRgb pixel = line[x];
+            if (qAlpha(pixel) == 0) {
                 continue;
             }
-            if (ColorUtils::chroma(sampleColor) < 20) {
+
+            const QRgb rgb = pixel | 0xff000000;
+            if (!hasLast || rgb != lastColor) {
+                lastColor = rgb;
+                lastAccepted = ColorUtils::rgbChroma(rgb) >= 20;
+                hasLast = true;
+            }
+            if (!lastAccepted) {
                 continue;
             }
-            QRgb rgb = sampleColor.rgb();
-            ++c;
+
+            out[count++] = rgb;
             r += qRed(rgb);
             g += qGreen(rgb);
             b += qBlue(rgb);
-#pragma omp critical
-            imageData.m_samples << rgb;
         }
+
+        rowCounts[y] = count;
+        c += count;
     } // END omp parallel for
 
-    if (imageData.m_samples.isEmpty()) {
-        return imageData;
+    // Compact the rows.
+    qsizetype size = 0;
+    for (int y = 0; y < height; ++y) {
+        if (size != qsizetype(y) * width) {
+            std::copy_n(buffer + qsizetype(y) * width, rowCounts[y], buffer + size);
+        }
+        size += rowCounts[y];
+    }
+    samples.resize(size);
+
+    return SampleSums{r, g, b, c};
+}
+
+bool ImageColors::clusterKMeans(ImageData &imageData, const QList<QRgb> &initialCentroids, int numCore, const std::atomic_bool *canceled)
+{
+    auto isCanceled = [canceled]() {
+        return canceled && canceled->load(std::memory_order_relaxed);
+    };
+
+    // Warm start from a previous result. Unlike the centroids of a previous
+    // iteration, the seeds are not colors of this image, so they don't count
+    // as members of their cluster: seeds that attract no samples are dropped
+    // instead of carrying colors of the previous image over.
+    for (QRgb centroid : initialCentroids) {
+        ImageData::colorStat stat;
+        stat.centroid = centroid;
+        imageData.m_clusters << stat;
     }
 
     positionColorMP(imageData.m_samples, imageData.m_clusters, numCore);
 
-    imageData.m_average = QColor(r / c, g / c, b / c, 255);
+    int r = 0;
+    int g = 0;
+    int b = 0;
+    int c = 0;
 
+    QList<QRgb> previousCentroids;
     for (int iteration = 0; iteration < 5; ++iteration) {
+        if (isCanceled()) {
+            return false;
+        }
+
+        // Only seeds can be left without any colors.
+        imageData.m_clusters.removeIf([](const ImageData::colorStat &stat) {
+            return stat.colors.empty();
+        });
+
 #pragma omp parallel for private(r, g, b, c)
         for (int i = 0; i < imageData.m_clusters.size(); ++i) {
             auto &stat = imageData.m_clusters[i];
@@ -404,9 +674,151 @@ ImageData ImageColors::generatePalette(const QImage &sourceImage)
             stat.colors = QList<QRgb>({stat.centroid});
         } // END omp parallel for
 
+        // Once the centroids stop moving every further iteration produces the
+        // same clusters, which happens quickly when starting from a previous
+        // palette of a similar image.
+        QList<QRgb> centroids;
+        centroids.reserve(imageData.m_clusters.size());
+        for (const auto &stat : std::as_const(imageData.m_clusters)) {
+            centroids << stat.centroid;
+        }
+        if (centroids == previousCentroids) {
+            break;
+        }
+        previousCentroids = std::move(centroids);
+
         positionColorMP(imageData.m_samples, imageData.m_clusters, numCore);
     }
 
+    return true;
+}
+
+void ImageColors::clusterMedianCut(ImageData &imageData)
+{
+    // Every box is a range of this copy of the samples, which is reordered
+    // while splitting the boxes.
+    std::vector<QRgb> colors(imageData.m_samples.cbegin(), imageData.m_samples.cend());
+
+    struct Box {
+        qsizetype begin = 0;
+        qsizetype end = 0;
+        // The channel the colors of the box are spread the most along.
+        int channel = 0;
+        int range = 0;
+    };
+
+    auto channelValue = [](QRgb color, int channel) {
+        return channel == 0 ? qRed(color) : channel == 1 ? qGreen(color) : qBlue(color);
+    };
+
+    auto makeBox = [&colors](qsizetype begin, qsizetype end) {
+        int minimum[3] = {255, 255, 255};
+        int maximum[3] = {0, 0, 0};
+        for (qsizetype i = begin; i < end; ++i) {
+            const int values[3] = {qRed(colors[i]), qGreen(colors[i]), qBlue(colors[i])};
+            for (int channel = 0; channel < 3; ++channel) {
+                minimum[channel] = std::min(minimum[channel], values[channel]);
+                maximum[channel] = std::max(maximum[channel], values[channel]);
+            }
+        }
+
+        Box box{begin, end};
+        for (int channel = 0; channel < 3; ++channel) {
+            if (maximum[channel] - minimum[channel] > box.range) {
+                box.range = maximum[channel] - minimum[channel];
+                box.channel = channel;
+            }
+        }
+        return box;
+    };
+
+    auto score = [](const Box &box) {
+        return qint64(box.range) * (box.end - box.begin);
+    };
+
+    // Every split only looks at the colors of one box, so this takes
+    // O(n log(s_medianCutBoxes)) regardless of the contents of the image.
+    std::vector<Box> boxes{makeBox(0, colors.size())};
+    while (boxes.size() < size_t(s_medianCutBoxes)) {
+        auto largest = std::max_element(boxes.begin(), boxes.end(), [&score](const Box &a, const Box &b) {
+            return score(a) < score(b);
+        });
+        if (score(*largest) == 0) {
+            // Every box contains a single color.
+            break;
+        }
+
+        const Box box = *largest;
+        const qsizetype middle = box.begin + (box.end - box.begin) / 2;
+        std::nth_element(colors.begin() + box.begin, colors.begin() + middle, colors.begin() + box.end, [&channelValue, channel = box.channel](QRgb a, QRgb b) {
+            return channelValue(a, channel) < channelValue(b, channel);
+        });
+
+        *largest = makeBox(box.begin, middle);
+        boxes.push_back(makeBox(middle, box.end));
+    }
+
+    imageData.m_clusters.reserve(boxes.size());
+    for (const Box &box : boxes) {
+        qint64 r = 0;
+        qint64 g = 0;
+        qint64 b = 0;
+        for (qsizetype i = box.begin; i < box.end; ++i) {
+            r += qRed(colors[i]);
+            g += qGreen(colors[i]);
+            b += qBlue(colors[i]);
+        }
+
+        const qsizetype count = box.end - box.begin;
+        ImageData::colorStat stat;
+        stat.centroid = qRgb(int(r / count), int(g / count), int(b / count));
+        stat.ratio = qreal(count) / qreal(colors.size());
+        stat.colors = QList<QRgb>({stat.centroid});
+        imageData.m_clusters << stat;
+    }
+}
+
+ImageData ImageColors::generatePalette(const QImage &sourceImage, const QList<QRgb> &initialCentroids, const std::atomic_bool *canceled, Algorithm algorithm)
+{
+    ImageData imageData;
+
+    if (sourceImage.isNull() || sourceImage.width() == 0) {
+        return imageData;
+    }
+
+    // This runs in a thread pool, the events are logged from that thread.
+    TraceScope trace(KirigamiTraceLog(), "ImageColors::generatePalette");
+    trace.addArgument("size", sourceImage.size());
+
+    imageData.m_clusters.clear();
+    imageData.m_samples.clear();
+
+    auto isCanceled = [canceled]() {
+        return canceled && canceled->load(std::memory_order_relaxed);
+    };
+
+#if HAVE_OpenMP
+    // Several palettes may be computed at the same time, share the cores
+    // between them instead of starting a full team of threads for each.
+    static const int numCore = std::clamp(omp_get_num_procs() / s_threadPool->maxThreadCount(), 1, 8);
+    omp_set_num_threads(numCore);
+#else
+    constexpr int numCore = 1;
+#endif
+    const SampleSums sums = sampleImage(sourceImage, imageData.m_samples);
+
+    if (imageData.m_samples.isEmpty() || isCanceled()) {
+        return ImageData{};
+    }
+
+    imageData.m_average = QColor(int(sums.red / sums.count), int(sums.green / sums.count), int(sums.blue / sums.count), 255);
+
+    if (algorithm == MedianCut) {
+        clusterMedianCut(imageData);
+    } else if (!clusterKMeans(imageData, initialCentroids, numCore, canceled)) {
+        return ImageData{};
+    }
+
     std::sort(imageData.m_clusters.begin(), imageData.m_clusters.end(), [](const ImageData::colorStat &a, const ImageData::colorStat &b) {
         return getClusterScore(a) > getClusterScore(b);
     });
@@ -506,7 +918,7 @@ ImageData ImageColors::generatePalette(const QImage &sourceImage)
 
 double ImageColors::getClusterScore(const ImageData::colorStat &stat)
 {
-    return stat.ratio * ColorUtils::chroma(QColor(stat.centroid));
+    return stat.ratio * ColorUtils::rgbChroma(stat.centroid);
 }
 
 void ImageColors::postProcess(ImageData &imageData) const
@@ -530,8 +942,7 @@ void ImageColors::postProcess(ImageData &imageData) const
     } else {
         // For light themes, still prefer lighter colors
         // (lowerLum + 0.05) / (textLum + 0.05) >= 4.5
-        const QColor textColor =
-            static_cast<Kirigami::Platform::PlatformTheme *>(qmlAttachedPropertiesObject<Kirigami::Platform::PlatformTheme>(this, true))->textColor();
+        const QColor textColor = Kirigami::Platform::PlatformTheme::themeForReading(this)->textColor();
         const qreal textLum = ColorUtils::luminance(textColor);
         lowerLum = WCAG_TEXT_CONTRAST_RATIO * (textLum + 0.05) - 0.05;
         upperLum = backgroundLum;
@@ -566,6 +977,92 @@ void ImageColors::postProcess(ImageData &imageData) const
     adjustLightness(imageData.m_average);
 }
 
+void ImageColors::setImageData(const ImageData &imageData)
+{
+    m_imageData = imageData;
+    postProcess(m_imageData);
+    updateReportedBytes();
+    Q_EMIT paletteChanged();
+}
+
+void ImageColors::updateReportedBytes()
+{
+    // The lists may be shared with ImageColorsCache or other instances, so
+    // this is an upper bound.
+    qint64 bytes = m_imageData.m_samples.capacity() * sizeof(QRgb);
+    for (const auto &cluster : std::as_const(m_imageData.m_clusters)) {
+        bytes += sizeof(ImageData::colorStat) + cluster.colors.capacity() * sizeof(QRgb);
+    }
+
+    Kirigami::Platform::PerformanceCounters::adjust(Kirigami::Platform::PerformanceCounters::ImageColorsBytes, bytes - m_reportedBytes);
+    m_reportedBytes = bytes;
+}
+
+void ImageColors::setPersistentCache(bool persistentCache)
+{
+    if (persistentCache == m_persistentCache) {
+        return;
+    }
+
+    m_persistentCache = persistentCache;
+    Q_EMIT persistentCacheChanged();
+}
+
+bool ImageColors::persistentCache() const
+{
+    return m_persistentCache;
+}
+
+void ImageColors::setSourceItemSamplingSize(int size)
+{
+    size = std::clamp(size, 1, int(s_samplingSize));
+    if (size == m_sourceItemSamplingSize) {
+        return;
+    }
+
+    m_sourceItemSamplingSize = size;
+    Q_EMIT sourceItemSamplingSizeChanged();
+
+    if (m_sourceItem) {
+        update();
+    }
+}
+
+int ImageColors::sourceItemSamplingSize() const
+{
+    return m_sourceItemSamplingSize;
+}
+
+void ImageColors::setIncremental(bool incremental)
+{
+    if (incremental == m_incremental) {
+        return;
+    }
+
+    m_incremental = incremental;
+    Q_EMIT incrementalChanged();
+}
+
+bool ImageColors::isIncremental() const
+{
+    return m_incremental;
+}
+
+void ImageColors::setAlgorithm(Algorithm algorithm)
+{
+    if (algorithm == m_algorithm) {
+        return;
+    }
+
+    m_algorithm = algorithm;
+    Q_EMIT algorithmChanged();
+}
+
+ImageColors::Algorithm ImageColors::algorithm() const
+{
+    return m_algorithm;
+}
+
 QList<PaletteSwatch> ImageColors::palette() const
 {
     if (m_futureImageData) {
@@ -579,7 +1076,7 @@ ColorUtils::Brightness ImageColors::paletteBrightness() const
     /* clang-format off */
     return_fallback(m_fallbackPaletteBrightness)
 
-    return qGray(m_imageData.m_dominant.rgb()) < 128 ? ColorUtils::Dark : ColorUtils::Light;
+    return brightness(m_imageData);
     /* clang-format on */
 }
 
@@ -615,18 +1112,7 @@ QColor ImageColors::foreground() const
     /* clang-format off */
     return_fallback_finally(m_fallbackForeground, textColor)
 
-    if (paletteBrightness() == ColorUtils::Dark)
-    {
-        if (qGray(m_imageData.m_closestToWhite.rgb()) < 200) {
-            return QColor(230, 230, 230);
-        }
-        return m_imageData.m_closestToWhite;
-    } else {
-        if (qGray(m_imageData.m_closestToBlack.rgb()) > 80) {
-            return QColor(20, 20, 20);
-        }
-        return m_imageData.m_closestToBlack;
-    }
+    return brightness(m_imageData) == ColorUtils::Dark ? lightest(m_imageData) : darkest(m_imageData);
     /* clang-format on */
 }
 
@@ -635,17 +1121,7 @@ QColor ImageColors::background() const
     /* clang-format off */
     return_fallback_finally(m_fallbackBackground, backgroundColor)
 
-    if (paletteBrightness() == ColorUtils::Dark) {
-        if (qGray(m_imageData.m_closestToBlack.rgb()) > 80) {
-            return QColor(20, 20, 20);
-        }
-        return m_imageData.m_closestToBlack;
-    } else {
-        if (qGray(m_imageData.m_closestToWhite.rgb()) < 200) {
-            return QColor(230, 230, 230);
-        }
-        return m_imageData.m_closestToWhite;
-    }
+    return brightness(m_imageData) == ColorUtils::Dark ? darkest(m_imageData) : lightest(m_imageData);
     /* clang-format on */
 }
 
@@ -662,23 +1138,125 @@ QColor ImageColors::closestToWhite() const
 {
     /* clang-format off */
     return_fallback(Qt::white)
-    if (qGray(m_imageData.m_closestToWhite.rgb()) < 200) {
-        return QColor(230, 230, 230);
-    }
     /* clang-format on */
 
-    return m_imageData.m_closestToWhite;
+    return lightest(m_imageData);
 }
 
 QColor ImageColors::closestToBlack() const
 {
     /* clang-format off */
     return_fallback(Qt::black)
-    if (qGray(m_imageData.m_closestToBlack.rgb()) > 80) {
+    /* clang-format on */
+
+    return darkest(m_imageData);
+}
+
+ColorUtils::Brightness ImageColors::brightness(const ImageData &imageData)
+{
+    return qGray(imageData.m_dominant.rgb()) < 128 ? ColorUtils::Dark : ColorUtils::Light;
+}
+
+QColor ImageColors::lightest(const ImageData &imageData)
+{
+    if (qGray(imageData.m_closestToWhite.rgb()) < 200) {
+        return QColor(230, 230, 230);
+    }
+    return imageData.m_closestToWhite;
+}
+
+QColor ImageColors::darkest(const ImageData &imageData)
+{
+    if (qGray(imageData.m_closestToBlack.rgb()) > 80) {
         return QColor(20, 20, 20);
     }
-    /* clang-format on */
-    return m_imageData.m_closestToBlack;
+    return imageData.m_closestToBlack;
+}
+
+QFuture<ImageData> ImageColors::generatePalettes(const QVariantList &sources, Algorithm algorithm)
+{
+    return QtConcurrent::run(
+        s_threadPool(),
+        [algorithm](QPromise<ImageData> &promise, const QVariantList &sources) {
+            const int count = sources.size();
+#if HAVE_OpenMP
+            [[maybe_unused]] const int numThreads = std::clamp(omp_get_num_procs(), 1, std::max(count, 1));
+#else
+            [[maybe_unused]] const int numThreads = 1;
+#endif
+            // A single parallel region over all images. Computing a single
+            // palette is then done on one thread, as nested regions are disabled.
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+            for (int i = 0; i < count; ++i) {
+                if (promise.isCanceled()) {
+                    continue;
+                }
+
+                const QVariant &source = sources[i];
+                const QImage image = source.userType() == QMetaType::QImage ? source.value<QImage>() : QImage(source.toString());
+                promise.addResult(generatePalette(downscaleForSampling(image), {}, nullptr, algorithm), i);
+            } // END omp parallel for
+        },
+        sources);
+}
+
+void ImageColors::computeBatch(const QVariantList &sources)
+{
+    if (m_batchWatcher) {
+        m_batchWatcher->disconnect(this);
+        m_batchWatcher->cancel();
+        m_batchWatcher->deleteLater();
+        m_batchWatcher = nullptr;
+    }
+
+    // Anything that can only be rendered on the GUI thread is converted here,
+    // files are left for the worker threads to load.
+    QVariantList images;
+    images.reserve(sources.size());
+    for (const QVariant &source : sources) {
+        if (source.canConvert<QImage>() && source.userType() != QMetaType::QString && source.userType() != QMetaType::QUrl) {
+            images << QVariant::fromValue(source.value<QImage>());
+        } else if (source.userType() == QMetaType::QIcon) {
+            images << QVariant::fromValue(source.value<QIcon>().pixmap(128, 128).toImage());
+        } else if (source.canConvert<QString>()) {
+            const QString sourceString = source.toString();
+            if (QIcon::hasThemeIcon(sourceString)) {
+                images << QVariant::fromValue(QIcon::fromTheme(sourceString).pixmap(128, 128).toImage());
+            } else if (const QUrl url(sourceString); url.isLocalFile()) {
+                images << url.toLocalFile();
+            } else {
+                images << sourceString;
+            }
+        } else {
+            // Items need to be grabbed and are not supported here.
+            images << QVariant::fromValue(QImage());
+        }
+    }
+
+    m_batchWatcher = new QFutureWatcher<ImageData>(this);
+    connect(m_batchWatcher, &QFutureWatcher<ImageData>::resultReadyAt, this, [this](int index) {
+        ImageData imageData = m_batchWatcher->resultAt(index);
+        postProcess(imageData);
+
+        QVariantMap colors;
+        if (!imageData.m_palette.isEmpty()) {
+            colors[QStringLiteral("palette")] = QVariant::fromValue(imageData.m_palette);
+            colors[QStringLiteral("paletteBrightness")] = QVariant::fromValue(brightness(imageData));
+            colors[QStringLiteral("average")] = imageData.m_average;
+            colors[QStringLiteral("dominant")] = imageData.m_dominant;
+            colors[QStringLiteral("dominantContrast")] = imageData.m_dominantContrast;
+            colors[QStringLiteral("highlight")] = imageData.m_highlight;
+            colors[QStringLiteral("closestToWhite")] = lightest(imageData);
+            colors[QStringLiteral("closestToBlack")] = darkest(imageData);
+        }
+        Q_EMIT batchPaletteReady(index, colors);
+    });
+    connect(m_batchWatcher, &QFutureWatcher<ImageData>::finished, this, [this]() {
+        m_batchWatcher->deleteLater();
+        m_batchWatcher = nullptr;
+        Q_EMIT batchFinished();
+    });
+    m_batchWatcher->setFuture(generatePalettes(images, m_algorithm));
 }
 
 #include "moc_imagecolors.cpp"
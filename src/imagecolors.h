@@ -9,6 +9,7 @@
 
 #include <QColor>
 #include <QFuture>
+#include <QHash>
 #include <QImage>
 #include <QObject>
 #include <QPointer>
@@ -18,6 +19,9 @@
 
 #include <platform/colorutils.h>
 
+#include <atomic>
+#include <memory>
+
 struct PaletteSwatch {
     Q_GADGET
     QML_VALUE_TYPE(imageColorsPaletteSwatch)
@@ -88,9 +92,80 @@ class ImageColors : public QObject
      *
      * Note that an Item's color palette will only be extracted once unless you
      * call `update()`, regardless of how the item hanges.
+     *
+     * Images and image files larger than 512 pixels in either dimension are
+     * scaled down to 128 pixels before their colors are extracted, which is much
+     * faster for large pictures, but may give slightly different colors than
+     * extracting them from the full image. Smaller images are used as they are.
      */
     Q_PROPERTY(QVariant source READ source WRITE setSource NOTIFY sourceChanged FINAL)
 
+    /**
+     * Whether a new palette is computed starting from the clusters of the
+     * previous one.
+     *
+     * This makes recomputing the palette much cheaper when the source changes
+     * to a similar image, for example an item that is updated or a list of
+     * covers from the same album, at the cost of the result depending on the
+     * previous source.
+     *
+     * default: ``false``
+     *
+     * @since 6.12
+     */
+    Q_PROPERTY(bool incremental READ isIncremental WRITE setIncremental NOTIFY incrementalChanged FINAL)
+
+    /**
+     * Whether palettes are stored on disk and reused across application runs.
+     *
+     * Palettes are looked up by the contents of the source image and, for
+     * image files, by the file's location and modification time. The latter
+     * means the palette of a file that was seen before is available without
+     * loading the file at all.
+     *
+     * This must be set before setting the source.
+     *
+     * default: ``false``
+     *
+     * @since 6.12
+     */
+    Q_PROPERTY(bool persistentCache READ persistentCache WRITE setPersistentCache NOTIFY persistentCacheChanged FINAL)
+
+    /**
+     * The largest size, in pixels, an item used as source is rendered at to
+     * compute its palette.
+     *
+     * The item is rendered at this size by the GPU and only the result is
+     * read back, so smaller sizes make updating the palette of items that
+     * change often, like videos, cheaper, at the cost of less accurate
+     * palettes. Values above the default have no effect.
+     *
+     * default: ``128``
+     *
+     * @since 6.12
+     */
+    Q_PROPERTY(int sourceItemSamplingSize READ sourceItemSamplingSize WRITE setSourceItemSamplingSize NOTIFY sourceItemSamplingSizeChanged FINAL)
+
+    /**
+     * The method used to group the colors of the source into the palette.
+     *
+     * * `ImageColors.KMeans`: Iteratively refines the clusters, which gives the
+     *   most accurate palettes.
+     * * `ImageColors.MedianCut`: Splits the colors at their median a fixed number
+     *   of times, which takes a bounded time that only depends on the size of
+     *   the source. Use this for sources that change often, like videos.
+     *
+     * Both produce the same kind of palette. The incremental property only
+     * has an effect with `ImageColors.KMeans`.
+     *
+     * This must be set before setting the source.
+     *
+     * default: ``ImageColors.KMeans``
+     *
+     * @since 6.12
+     */
+    Q_PROPERTY(Algorithm algorithm READ algorithm WRITE setAlgorithm NOTIFY algorithmChanged FINAL)
+
     /**
      * A list of colors and related information about then.
      *
@@ -226,6 +301,12 @@ class ImageColors : public QObject
     Q_PROPERTY(QColor fallbackBackground MEMBER m_fallbackBackground NOTIFY fallbackBackgroundChanged FINAL)
 
 public:
+    enum Algorithm {
+        KMeans,
+        MedianCut,
+    };
+    Q_ENUM(Algorithm)
+
     explicit ImageColors(QObject *parent = nullptr);
     ~ImageColors() override;
 
@@ -240,6 +321,43 @@ public:
 
     Q_INVOKABLE void update();
 
+    /**
+     * Compute the palettes of several images at once.
+     *
+     * Each of @p sources can be anything supported by the source property
+     * except items. The palettes are computed in parallel and reported with
+     * batchPaletteReady() as they become available, which is not necessarily
+     * in order. batchFinished() is emitted once all palettes are done.
+     *
+     * This does not change the properties of this object. Starting a new
+     * batch cancels the previous one.
+     *
+     * @since 6.12
+     */
+    Q_INVOKABLE void computeBatch(const QVariantList &sources);
+
+    /**
+     * Compute the palettes of @p sources, which are either images or paths to
+     * image files, in a single parallel job.
+     *
+     * Results are added to the returned future at the index of their source
+     * as they become available. The palettes are not post-processed for the
+     * current theme.
+     */
+    static QFuture<ImageData> generatePalettes(const QVariantList &sources, Algorithm algorithm = KMeans);
+
+    void setIncremental(bool incremental);
+    bool isIncremental() const;
+
+    void setPersistentCache(bool persistentCache);
+    bool persistentCache() const;
+
+    void setSourceItemSamplingSize(int size);
+    int sourceItemSamplingSize() const;
+
+    void setAlgorithm(Algorithm algorithm);
+    Algorithm algorithm() const;
+
     QList<PaletteSwatch> palette() const;
     ColorUtils::Brightness paletteBrightness() const;
     QColor average() const;
@@ -253,7 +371,20 @@ public:
 
 Q_SIGNALS:
     void sourceChanged();
+    void incrementalChanged();
+    void persistentCacheChanged();
+    void sourceItemSamplingSizeChanged();
+    void algorithmChanged();
     void paletteChanged();
+    /**
+     * Emitted by computeBatch() for the source at @p index.
+     *
+     * @p colors contains the `palette`, `paletteBrightness`, `average`,
+     * `dominant`, `dominantContrast`, `highlight`, `closestToWhite` and
+     * `closestToBlack` of the source, or nothing if it had no palette.
+     */
+    void batchPaletteReady(int index, const QVariantMap &colors);
+    void batchFinished();
     void fallbackPaletteChanged();
     void fallbackPaletteBrightnessChanged();
     void fallbackAverageChanged();
@@ -264,15 +395,43 @@ Q_SIGNALS:
     void fallbackBackgroundChanged();
 
 private:
-    static inline void positionColor(QRgb rgb, QList<ImageData::colorStat> &clusters);
+    struct SampleSums {
+        qint64 red = 0;
+        qint64 green = 0;
+        qint64 blue = 0;
+        qint64 count = 0;
+    };
+    static SampleSums sampleImage(const QImage &sourceImage, QList<QRgb> &samples);
+    static QSize samplingSize(const QSize &size, int maximum = s_samplingSize);
+    static QImage downscaleForSampling(const QImage &image);
+    static inline void positionColor(QRgb rgb, QList<ImageData::colorStat> &clusters, QHash<QRgb, qsizetype> &lookup);
     static void positionColorMP(const decltype(ImageData::m_samples) &samples, decltype(ImageData::m_clusters) &clusters, int numCore = 0);
-    static ImageData generatePalette(const QImage &sourceImage);
+    static bool clusterKMeans(ImageData &imageData, const QList<QRgb> &initialCentroids, int numCore, const std::atomic_bool *canceled);
+    static void clusterMedianCut(ImageData &imageData);
+    static ImageData
+    generatePalette(const QImage &sourceImage, const QList<QRgb> &initialCentroids = {}, const std::atomic_bool *canceled = nullptr, Algorithm algorithm = KMeans);
 
     static double getClusterScore(const ImageData::colorStat &stat);
+    static ColorUtils::Brightness brightness(const ImageData &imageData);
+    static QColor lightest(const ImageData &imageData);
+    static QColor darkest(const ImageData &imageData);
     void postProcess(ImageData &imageData) const;
+    void setImageData(const ImageData &imageData);
+    void updateReportedBytes();
+    void clearSourceItem();
 
     // Arbitrary number that seems to work well
     static const int s_minimumSquareDistance = 32000;
+    // The largest width or height of the images palettes are computed from
+    // when scaled down. This is plenty for the handful of colors the palette
+    // contains.
+    static const int s_samplingSize = 128;
+    // Images and files are only scaled down when larger than this in either
+    // dimension, so that smaller ones keep the palette they always had.
+    static const int s_downscaleThreshold = 512;
+    // The number of boxes the median cut splits the colors into, before
+    // similar ones are merged like the clusters of k-means.
+    static const int s_medianCutBoxes = 16;
     QPointer<QQuickWindow> m_window;
     QVariant m_source;
     QPointer<QQuickItem> m_sourceItem;
@@ -281,7 +440,18 @@ private:
     QFutureWatcher<QImage> *m_futureSourceImageData = nullptr;
 
     QFutureWatcher<ImageData> *m_futureImageData = nullptr;
+    // Set to stop the job computing the palette of a previous source.
+    std::shared_ptr<std::atomic_bool> m_canceled;
+    QFutureWatcher<ImageData> *m_batchWatcher = nullptr;
     ImageData m_imageData;
+    // The size of m_imageData reported to PerformanceCounters.
+    qint64 m_reportedBytes = 0;
+    bool m_incremental = false;
+    bool m_persistentCache = false;
+    int m_sourceItemSamplingSize = s_samplingSize;
+    Algorithm m_algorithm = KMeans;
+    // Only set for image files while the persistent cache is enabled.
+    QString m_fileCacheKey;
 
     QList<PaletteSwatch> m_fallbackPalette;
     ColorUtils::Brightness m_fallbackPaletteBrightness;
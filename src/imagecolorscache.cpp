@@ -0,0 +1,180 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "imagecolorscache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <atomic>
+
+#include "loggingcategory.h"
+
+// Identifies the files of this cache, followed by the version of the format.
+static constexpr quint32 cacheMagic = 0x4b494343; // "KICC"
+// Increase when the stored data or the palette extraction changes in a way
+// that makes old entries invalid.
+static constexpr quint32 cacheVersion = 2;
+// Pinned so that the format doesn't depend on the version of Qt.
+static constexpr QDataStream::Version streamVersion = QDataStream::Qt_6_5;
+
+// Entries take a few hundred bytes, so this keeps the cache below a megabyte.
+static constexpr int maximumEntries = 2000;
+// The cache directory is only checked for entries to evict every so many
+// insertions, starting with the first one of the process.
+static constexpr int evictionInterval = 100;
+
+static std::atomic_int s_insertions = 0;
+
+static QString cacheDirectory()
+{
+    static const QString directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/kirigami/imagecolors/");
+    return directory;
+}
+
+static QString cacheFile(const QString &key)
+{
+    return cacheDirectory() + key;
+}
+
+// Removes the least recently used entries above maximumEntries. Using an
+// entry updates its modification time, so that is what they are sorted by.
+static void evictEntries()
+{
+    const QDir directory(cacheDirectory());
+    const QFileInfoList entries = directory.entryInfoList(QDir::Files | QDir::NoDotAndDotDot, QDir::Time);
+    for (qsizetype i = maximumEntries; i < entries.size(); ++i) {
+        QFile::remove(entries[i].absoluteFilePath());
+    }
+}
+
+QString ImageColorsCache::fileKey(const QString &path)
+{
+    const QFileInfo info(path);
+    if (!info.exists()) {
+        return QString();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(info.absoluteFilePath().toUtf8());
+    hash.addData(QByteArray::number(info.size()));
+    hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    return QStringLiteral("file-") + QString::fromLatin1(hash.result().toHex());
+}
+
+QString ImageColorsCache::imageKey(const QImage &image)
+{
+    if (image.isNull()) {
+        return QString();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::number(image.width()) + 'x' + QByteArray::number(image.height()) + '@' + QByteArray::number(int(image.format())));
+    // Scanlines can contain padding, so only hash the actual pixels.
+    const qsizetype lineBytes = (qsizetype(image.width()) * image.depth() + 7) / 8;
+    for (int y = 0; y < image.height(); ++y) {
+        hash.addData(QByteArrayView(reinterpret_cast<const char *>(image.constScanLine(y)), lineBytes));
+    }
+    return QStringLiteral("image-") + QString::fromLatin1(hash.result().toHex());
+}
+
+bool ImageColorsCache::contains(const QString &key)
+{
+    return !key.isEmpty() && QFileInfo::exists(cacheFile(key));
+}
+
+std::optional<ImageData> ImageColorsCache::find(const QString &key)
+{
+    if (key.isEmpty()) {
+        return std::nullopt;
+    }
+
+    QFile file(cacheFile(key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(streamVersion);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != cacheMagic || version != cacheVersion) {
+        return std::nullopt;
+    }
+
+    ImageData imageData;
+    qint64 count = 0;
+    stream >> count;
+    for (qint64 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        qreal ratio = 0;
+        QColor color;
+        QColor contrastColor;
+        stream >> ratio >> color >> contrastColor;
+        imageData.m_palette << PaletteSwatch(ratio, color, contrastColor);
+
+        // Keep the clusters around so incremental updates can start from them.
+        ImageData::colorStat stat;
+        stat.centroid = color.rgb();
+        stat.ratio = ratio;
+        imageData.m_clusters << stat;
+    }
+
+    stream >> imageData.m_dominant >> imageData.m_dominantContrast >> imageData.m_average >> imageData.m_highlight >> imageData.m_closestToBlack
+        >> imageData.m_closestToWhite;
+
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(KirigamiLog) << "Ignoring corrupt palette cache entry" << file.fileName();
+        return std::nullopt;
+    }
+
+    // Mark the entry as recently used for evictEntries().
+    file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+
+    return imageData;
+}
+
+void ImageColorsCache::insert(const QString &key, const ImageData &imageData)
+{
+    if (key.isEmpty() || imageData.m_palette.isEmpty()) {
+        return;
+    }
+
+    if (!QDir().mkpath(cacheDirectory())) {
+        return;
+    }
+
+    // QSaveFile writes to a temporary file first, so concurrent readers never
+    // see a partially written entry.
+    QSaveFile file(cacheFile(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(streamVersion);
+    stream << cacheMagic << cacheVersion;
+    stream << qint64(imageData.m_palette.size());
+    for (const auto &swatch : imageData.m_palette) {
+        stream << swatch.ratio() << swatch.color() << swatch.contrastColor();
+    }
+    stream << imageData.m_dominant << imageData.m_dominantContrast << imageData.m_average << imageData.m_highlight << imageData.m_closestToBlack
+           << imageData.m_closestToWhite;
+
+    if (!file.commit()) {
+        return;
+    }
+
+    if (s_insertions.fetch_add(1, std::memory_order_relaxed) % evictionInterval == 0) {
+        evictEntries();
+    }
+}
@@ -0,0 +1,46 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QImage>
+#include <QString>
+
+#include <optional>
+
+#include "imagecolors.h"
+
+/**
+ * A persistent cache of ImageColors palettes, stored in the cache location of
+ * the application.
+ *
+ * Each palette is stored in its own small file named after its key, so the
+ * cache can be used from several threads at the same time. Only the result of
+ * the palette extraction is stored, not the samples and clusters used to
+ * compute it.
+ *
+ * The cache keeps a limited number of entries, evicting the least recently
+ * used ones first.
+ */
+namespace ImageColorsCache
+{
+/**
+ * @returns a key for the image file at @p path, based on its location, size
+ * and modification time, or an empty string if the file does not exist.
+ *
+ * This does not read the file.
+ */
+QString fileKey(const QString &path);
+
+/**
+ * @returns a key based on the contents of @p image.
+ */
+QString imageKey(const QImage &image);
+
+bool contains(const QString &key);
+std::optional<ImageData> find(const QString &key);
+void insert(const QString &key, const ImageData &imageData);
+}
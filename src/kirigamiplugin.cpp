@@ -16,6 +16,8 @@
 #include <QQuickItem>
 
 #include "platform/styleselector.h"
+#include "platform/tracescope_p.h"
+#include "startuplogging.h"
 
 #ifdef KIRIGAMI_BUILD_TYPE_STATIC
 #include "loggingcategory.h"
@@ -66,6 +68,8 @@ QUrl KirigamiPlugin::componentUrl(const QString &fileName) const
 
 void KirigamiPlugin::registerTypes(const char *uri)
 {
+    TraceScope trace(KirigamiStartupLog(), "KirigamiPlugin::registerTypes");
+
 #if defined(Q_OS_ANDROID)
     QResource::registerResource(QStringLiteral("assets:/android_rcc_bundle.rcc"));
 #endif
@@ -132,36 +132,19 @@ Item {
         property var reverseTwins: []
         property var knownItems: []
         property var buddies: []
-        property int knownItemsImplicitWidth: {
-            let hint = 0;
-            for (const item of knownItems) {
-                if (typeof item.Layout === "undefined") {
-                    // Items may have been dynamically destroyed. Even
-                    // printing such zombie wrappers results in a
-                    // meaningless "TypeError: Type error". Normally they
-                    // should be cleaned up from the array, but it would
-                    // trigger a binding loop if done here.
-                    //
-                    // This is, so far, the only way to detect them.
-                    continue;
-                }
-                const actualWidth = item.Layout.preferredWidth > 0
-                    ? item.Layout.preferredWidth
-                    : item.implicitWidth;
-
-                hint = Math.max(hint, item.Layout.minimumWidth, Math.min(actualWidth, item.Layout.maximumWidth));
-            }
-            return hint;
+        property var containers: []
+        property int knownItemsImplicitWidth: fieldsHint.implicitWidth
+        property int buddiesImplicitWidth: labelsHint.implicitWidth
+
+        // Widths of the two columns, updated as the width hint of a single
+        // row changes rather than by visiting every row.
+        Kirigami.FormLayoutColumnHint {
+            id: fieldsHint
+            items: lay.containers
         }
-        property int buddiesImplicitWidth: {
-            let hint = 0;
-
-            for (const buddy of buddies) {
-                if (buddy.visible && buddy.item !== null && !buddy.item.Kirigami.FormData.isSection) {
-                    hint = Math.max(hint, buddy.implicitWidth);
-                }
-            }
-            return hint;
+        Kirigami.FormLayoutColumnHint {
+            id: labelsHint
+            items: lay.buddies
         }
         readonly property var actualTwinFormLayouts: {
             // We need to copy that array by value
@@ -295,9 +278,11 @@ Item {
                 const buddy = buddyComponent.createObject(lay, { item, index: i - 2 });
 
                 itemContainer.parent = lay;
+                lay.containers.push(itemContainer);
                 lay.buddies.push(buddy);
             }
             lay.knownItemsChanged();
+            lay.containersChanged();
             lay.buddiesChanged();
             hintCompression.triggered();
         }
@@ -312,6 +297,18 @@ Item {
 
             property Item item
 
+            // Used by the column width of the fields
+            readonly property real widthHint: {
+                if (item === null) {
+                    return 0;
+                }
+                const actualWidth = item.Layout.preferredWidth > 0
+                    ? item.Layout.preferredWidth
+                    : item.implicitWidth;
+
+                return Math.max(item.Layout.minimumWidth, Math.min(actualWidth, item.Layout.maximumWidth));
+            }
+
             enabled: item?.enabled ?? false
             visible: item?.visible ?? false
 
@@ -376,6 +373,9 @@ Item {
             property Item item
             property int index
 
+            // Used by the column width of the labels
+            readonly property real widthHint: visible && item !== null && !item.Kirigami.FormData.isSection ? implicitWidth : 0
+
             enabled: {
                 const buddy = item?.Kirigami.FormData.buddyFor;
                 if (buddy) {
@@ -0,0 +1,324 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "cardsgridlayout.h"
+
+#include <cmath>
+#include <limits>
+
+#include "platform/performancecounters_p.h"
+
+CardsGridLayout::CardsGridLayout(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_isDirty(false)
+    , m_performingLayout(false)
+{
+}
+
+CardsGridLayout::~CardsGridLayout()
+{
+    // The cards are destroyed after us, don't get notified about it.
+    const auto children = childItems();
+    for (QQuickItem *child : children) {
+        disconnectItem(child);
+    }
+    disconnectItem(m_parent);
+}
+
+int CardsGridLayout::maximumColumns() const
+{
+    return m_maximumColumns;
+}
+
+void CardsGridLayout::setMaximumColumns(int columns)
+{
+    if (m_maximumColumns == columns) {
+        return;
+    }
+
+    m_maximumColumns = columns;
+    updateColumns();
+    updateParentColumns();
+
+    Q_EMIT maximumColumnsChanged();
+}
+
+qreal CardsGridLayout::maximumColumnWidth() const
+{
+    return m_maximumColumnWidth;
+}
+
+void CardsGridLayout::setMaximumColumnWidth(qreal width)
+{
+    if (qFuzzyCompare(m_maximumColumnWidth, width)) {
+        return;
+    }
+
+    m_maximumColumnWidth = width;
+    updateColumns();
+    updateParentColumns();
+    // The implicit width is based on it.
+    markImplicitSizeDirty();
+
+    Q_EMIT maximumColumnWidthChanged();
+}
+
+qreal CardsGridLayout::minimumColumnWidth() const
+{
+    return m_minimumColumnWidth;
+}
+
+void CardsGridLayout::setMinimumColumnWidth(qreal width)
+{
+    if (qFuzzyCompare(m_minimumColumnWidth, width)) {
+        return;
+    }
+
+    m_minimumColumnWidth = width;
+    updateColumns();
+    updateParentColumns();
+
+    Q_EMIT minimumColumnWidthChanged();
+}
+
+qreal CardsGridLayout::rowSpacing() const
+{
+    return m_rowSpacing;
+}
+
+void CardsGridLayout::setRowSpacing(qreal spacing)
+{
+    if (qFuzzyCompare(m_rowSpacing, spacing)) {
+        return;
+    }
+
+    m_rowSpacing = spacing;
+    markImplicitSizeDirty();
+
+    Q_EMIT rowSpacingChanged();
+}
+
+qreal CardsGridLayout::columnSpacing() const
+{
+    return m_columnSpacing;
+}
+
+void CardsGridLayout::setColumnSpacing(qreal spacing)
+{
+    if (qFuzzyCompare(m_columnSpacing, spacing)) {
+        return;
+    }
+
+    m_columnSpacing = spacing;
+    markImplicitSizeDirty();
+
+    Q_EMIT columnSpacingChanged();
+}
+
+int CardsGridLayout::columns() const
+{
+    return m_columns;
+}
+
+int CardsGridLayout::columnsForWidth(qreal width) const
+{
+    qreal columns = m_maximumColumns > 0 ? m_maximumColumns : std::numeric_limits<int>::max();
+    if (m_minimumColumnWidth > 0) {
+        columns = std::min(columns, std::floor(width / m_minimumColumnWidth));
+    }
+    if (m_maximumColumnWidth > 0) {
+        columns = std::min(columns, std::ceil(width / m_maximumColumnWidth));
+    }
+    return std::max(1, int(columns));
+}
+
+void CardsGridLayout::forceLayout()
+{
+    updatePolish();
+}
+
+void CardsGridLayout::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    if (newGeometry.width() != oldGeometry.width()) {
+        // The rows only need to be measured again when the column count
+        // changes, otherwise the cards are just resized.
+        updateColumns();
+    }
+    if (newGeometry.size() != oldGeometry.size()) {
+        markAsDirty();
+    }
+
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+}
+
+void CardsGridLayout::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value)
+{
+    switch (change) {
+    case QQuickItem::ItemChildAddedChange:
+        connectItem(value.item);
+        markImplicitSizeDirty();
+        break;
+    case QQuickItem::ItemChildRemovedChange:
+        disconnectItem(value.item);
+        markImplicitSizeDirty();
+        break;
+    case QQuickItem::ItemParentHasChanged:
+        disconnectItem(m_parent);
+        m_parent = value.item;
+        if (m_parent) {
+            connect(m_parent, &QQuickItem::widthChanged, this, &CardsGridLayout::updateParentColumns);
+        }
+        updateParentColumns();
+        break;
+    default:
+        break;
+    }
+
+    QQuickItem::itemChange(change, value);
+}
+
+void CardsGridLayout::componentComplete()
+{
+    QQuickItem::componentComplete();
+    if (m_isDirty) {
+        performLayout();
+    }
+}
+
+void CardsGridLayout::updatePolish()
+{
+    if (m_isDirty) {
+        performLayout();
+    }
+}
+
+QList<QQuickItem *> CardsGridLayout::cards() const
+{
+    QList<QQuickItem *> items;
+    const auto children = childItems();
+    items.reserve(children.size());
+    for (QQuickItem *child : children) {
+        // Repeaters are only there to create the cards.
+        if (child->isVisible() && !child->inherits("QQuickRepeater")) {
+            items.append(child);
+        }
+    }
+    return items;
+}
+
+void CardsGridLayout::updateColumns()
+{
+    const int columns = columnsForWidth(width());
+    if (columns == m_columns) {
+        return;
+    }
+
+    m_columns = columns;
+    markImplicitSizeDirty();
+
+    Q_EMIT columnsChanged();
+}
+
+void CardsGridLayout::updateParentColumns()
+{
+    const int columns = columnsForWidth(m_parent ? m_parent->width() : 0);
+    if (columns == m_parentColumns) {
+        return;
+    }
+
+    m_parentColumns = columns;
+    markImplicitSizeDirty();
+}
+
+void CardsGridLayout::markAsDirty()
+{
+    if (!m_isDirty) {
+        m_isDirty = true;
+        polish();
+    }
+}
+
+void CardsGridLayout::markImplicitSizeDirty()
+{
+    invalidateMeasure();
+    markAsDirty();
+}
+
+void CardsGridLayout::performLayout()
+{
+    if (!isComponentComplete() || m_performingLayout) {
+        return;
+    }
+
+    m_performingLayout = true;
+    Kirigami::Platform::PerformanceCounters::count(Kirigami::Platform::PerformanceCounters::LayoutPass);
+
+    // Measuring computes the height of the rows, which is then used as is.
+    ensureMeasured();
+    m_isDirty = false;
+
+    const QList<QQuickItem *> items = cards();
+    const qreal columnWidth = std::max<qreal>(0, (width() - m_columnSpacing * (m_columns - 1)) / m_columns);
+    qreal y = 0;
+
+    for (qsizetype i = 0; i < items.size(); ++i) {
+        const qsizetype row = i / m_columns;
+        const int column = i % m_columns;
+        if (column == 0 && row > 0) {
+            y += m_rowHeights.value(row - 1) + m_rowSpacing;
+        }
+
+        QQuickItem *item = items.at(i);
+        item->setPosition(QPointF(column * (columnWidth + m_columnSpacing), y));
+        item->setSize(QSizeF(columnWidth, m_rowHeights.value(row, item->implicitHeight())));
+    }
+
+    m_performingLayout = false;
+}
+
+void CardsGridLayout::updateMeasure()
+{
+    const QList<QQuickItem *> items = cards();
+
+    m_rowHeights.clear();
+    m_rowHeights.reserve((items.size() + m_columns - 1) / m_columns);
+
+    for (qsizetype i = 0; i < items.size(); ++i) {
+        QQuickItem *item = items.at(i);
+        MeasurableLayout::ensureMeasured(item);
+
+        if (i % m_columns == 0) {
+            m_rowHeights.append(item->implicitHeight());
+        } else {
+            m_rowHeights.last() = std::max(m_rowHeights.last(), item->implicitHeight());
+        }
+    }
+
+    qreal impHeight = m_rowSpacing * std::max<qsizetype>(0, m_rowHeights.size() - 1);
+    for (qreal height : std::as_const(m_rowHeights)) {
+        impHeight += height;
+    }
+    const qreal impWidth = m_maximumColumnWidth * m_parentColumns + m_columnSpacing * (m_parentColumns - 1);
+
+    setImplicitSize(impWidth, impHeight);
+}
+
+void CardsGridLayout::connectItem(QQuickItem *item)
+{
+    // Implicit width changes of the cards don't matter, they are as wide as
+    // their column.
+    connect(item, &QQuickItem::implicitHeightChanged, this, &CardsGridLayout::markImplicitSizeDirty);
+    connect(item, &QQuickItem::visibleChanged, this, &CardsGridLayout::markImplicitSizeDirty);
+}
+
+void CardsGridLayout::disconnectItem(QQuickItem *item)
+{
+    if (item) {
+        disconnect(item, nullptr, this, nullptr);
+    }
+}
+
+#include "moc_cardsgridlayout.cpp"
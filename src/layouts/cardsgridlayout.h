@@ -0,0 +1,155 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+#ifndef CARDSGRIDLAYOUT_H
+#define CARDSGRIDLAYOUT_H
+
+#include <QList>
+#include <QPointer>
+#include <QQuickItem>
+
+#include "measurablelayout_p.h"
+
+/**
+ * A grid layout for cards, the native base of CardsLayout.
+ *
+ * Its visible child items are laid out in rows of ::columns cards, where the
+ * number of columns depends on the width of the layout. Every card takes the
+ * width of its column, and the height of the tallest card of its row.
+ *
+ * The number of columns and the height of the rows are cached: changes to the
+ * width of the layout only resize the cards as long as the number of columns
+ * stays the same, and the rows are only measured again when the column count
+ * or the implicit height of a card changes.
+ *
+ * The implicit width is the width the cards need at their maximum column
+ * width, for the number of columns that would fit in the parent item.
+ *
+ * @since 6.12
+ */
+class CardsGridLayout : public QQuickItem, public MeasurableLayout
+{
+    Q_OBJECT
+    QML_ELEMENT
+    Q_INTERFACES(MeasurableLayout)
+
+    /**
+     * @brief This property holds the maximum number of columns.
+     *
+     * This layout will never lay out the items in more columns than
+     * maximumColumns. A value of 0 or less means there is no limit.
+     *
+     * default: ``2``
+     */
+    Q_PROPERTY(int maximumColumns READ maximumColumns WRITE setMaximumColumns NOTIFY maximumColumnsChanged FINAL)
+
+    /**
+     * @brief This property holds the maximum width the columns may have.
+     *
+     * The layout uses as many columns as needed for them to be at most this
+     * wide, as long as they stay wider than ::minimumColumnWidth.
+     */
+    Q_PROPERTY(qreal maximumColumnWidth READ maximumColumnWidth WRITE setMaximumColumnWidth NOTIFY maximumColumnWidthChanged FINAL)
+
+    /**
+     * @brief This property holds the minimum width the columns may have.
+     *
+     * The layout will try to dispose of items in a number of columns that will
+     * respect this size constraint.
+     */
+    Q_PROPERTY(qreal minimumColumnWidth READ minimumColumnWidth WRITE setMinimumColumnWidth NOTIFY minimumColumnWidthChanged FINAL)
+
+    /**
+     * @brief This property holds the space between two rows.
+     */
+    Q_PROPERTY(qreal rowSpacing READ rowSpacing WRITE setRowSpacing NOTIFY rowSpacingChanged FINAL)
+
+    /**
+     * @brief This property holds the space between two columns.
+     */
+    Q_PROPERTY(qreal columnSpacing READ columnSpacing WRITE setColumnSpacing NOTIFY columnSpacingChanged FINAL)
+
+    /**
+     * @brief This property holds the number of columns for the current width.
+     */
+    Q_PROPERTY(int columns READ columns NOTIFY columnsChanged FINAL)
+
+public:
+    CardsGridLayout(QQuickItem *parent = nullptr);
+    ~CardsGridLayout() override;
+
+    int maximumColumns() const;
+    void setMaximumColumns(int columns);
+
+    qreal maximumColumnWidth() const;
+    void setMaximumColumnWidth(qreal width);
+
+    qreal minimumColumnWidth() const;
+    void setMinimumColumnWidth(qreal width);
+
+    qreal rowSpacing() const;
+    void setRowSpacing(qreal spacing);
+
+    qreal columnSpacing() const;
+    void setColumnSpacing(qreal spacing);
+
+    int columns() const;
+
+    /**
+     * @return the number of columns the layout uses when it is @p width wide.
+     */
+    Q_INVOKABLE int columnsForWidth(qreal width) const;
+
+    /**
+     * @brief CardsGridLayout normally positions its cards once per frame (at
+     * polish event). This method forces it to recalculate the layout
+     * immediately.
+     */
+    Q_INVOKABLE void forceLayout();
+
+Q_SIGNALS:
+    void maximumColumnsChanged();
+    void maximumColumnWidthChanged();
+    void minimumColumnWidthChanged();
+    void rowSpacingChanged();
+    void columnSpacingChanged();
+    void columnsChanged();
+
+protected:
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+    void itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value) override;
+    void componentComplete() override;
+    void updatePolish() override;
+    void updateMeasure() override;
+
+private:
+    QList<QQuickItem *> cards() const;
+    void updateColumns();
+    void updateParentColumns();
+    void markAsDirty();
+    void markImplicitSizeDirty();
+    void performLayout();
+    void connectItem(QQuickItem *item);
+    void disconnectItem(QQuickItem *item);
+
+    int m_maximumColumns = 2;
+    qreal m_maximumColumnWidth = 0;
+    qreal m_minimumColumnWidth = 0;
+    qreal m_rowSpacing = 0;
+    qreal m_columnSpacing = 0;
+
+    int m_columns = 1;
+    // The number of columns that would fit in the parent, of which the
+    // implicit width is computed.
+    int m_parentColumns = 1;
+    QList<qreal> m_rowHeights;
+
+    QPointer<QQuickItem> m_parent;
+
+    bool m_isDirty : 1;
+    bool m_performingLayout : 1;
+};
+
+#endif
@@ -6,8 +6,10 @@
 
 #include "columnview.h"
 #include "columnview_p.h"
+#include "measurablelayout_p.h"
 
 #include "loggingcategory.h"
+#include "tracelogging.h"
 #include <QAbstractItemModel>
 #include <QGuiApplication>
 #include <QPropertyAnimation>
@@ -16,6 +18,12 @@
 #include <QQmlEngine>
 #include <QStyleHints>
 
+#include <algorithm>
+#include <limits>
+
+#include "platform/deferreddeletion_p.h"
+#include "platform/performancecounters_p.h"
+#include "platform/tracescope_p.h"
 #include "platform/units.h"
 
 class QmlComponentsPoolSingleton
@@ -74,7 +82,7 @@ QtObject {
 
         // positioning trick to hide the very first separator
         visible: {
-            if (!view || !view.separatorVisible) {
+            if (!view || !view.separatorVisible || !column) {
                 return false;
             }
 
@@ -83,9 +91,9 @@ QtObject {
                 : view.contentX < column.x);
         }
 
-        anchors.top: column.top
-        anchors.left: column.left
-        anchors.bottom: column.bottom
+        anchors.top: column ? column.top : undefined
+        anchors.left: column ? column.left : undefined
+        anchors.bottom: column ? column.bottom : undefined
         anchors.topMargin: inToolBar ? Kirigami.Units.largeSpacing : 0
         anchors.bottomMargin: inToolBar ? Kirigami.Units.largeSpacing : 0
         Kirigami.Theme.colorSet: Kirigami.Theme.Header
@@ -95,9 +103,9 @@ QtObject {
     readonly property Component trailingSeparator: Kirigami.Separator {
         property Item column
 
-        anchors.top: column.top
-        anchors.right: column.right
-        anchors.bottom: column.bottom
+        anchors.top: column ? column.top : undefined
+        anchors.right: column ? column.right : undefined
+        anchors.bottom: column ? column.bottom : undefined
         Kirigami.Theme.colorSet: Kirigami.Theme.Header
         Kirigami.Theme.inherit: false
     }
@@ -314,6 +322,22 @@ void ColumnViewAttached::setInViewport(bool inViewport)
     Q_EMIT inViewportChanged();
 }
 
+bool ColumnViewAttached::isSuspended() const
+{
+    return m_suspended;
+}
+
+void ColumnViewAttached::setSuspended(bool suspended)
+{
+    if (m_suspended == suspended) {
+        return;
+    }
+
+    m_suspended = suspended;
+
+    Q_EMIT suspendedChanged();
+}
+
 QQuickItem *ColumnViewAttached::globalHeader() const
 {
     return m_globalHeader;
@@ -392,6 +416,7 @@ ContentItem::ContentItem(ColumnView *parent)
     });
 
     connect(this, &QQuickItem::xChanged, this, &ContentItem::layoutPinnedItems);
+    connect(m_slideAnim, &QAbstractAnimation::stateChanged, this, &ContentItem::updateColumnLayers);
     m_creationInProgress = false;
 }
 
@@ -419,6 +444,18 @@ void ContentItem::animateX(qreal newX)
     m_slideAnim->stop();
     m_slideAnim->setStartValue(x());
     m_slideAnim->setEndValue(to);
+
+    // Jump to the end also when the application set a custom scrollDuration.
+    // An animation without duration finishes as soon as it is started.
+    QQmlEngine *engine = qmlEngine(m_view);
+    if (engine && QmlComponentsPoolSingleton::instance(engine)->m_units->reducedMotion()) {
+        const int duration = m_slideAnim->duration();
+        m_slideAnim->setDuration(0);
+        m_slideAnim->start();
+        m_slideAnim->setDuration(duration);
+        return;
+    }
+
     m_slideAnim->start();
 }
 
@@ -468,7 +505,7 @@ qreal ContentItem::childWidth(QQuickItem *child)
         return 0.0;
     }
 
-    ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(child, true));
+    ColumnViewAttached *attached = attachedObject(child);
 
     if (m_columnResizeMode == ColumnView::SingleColumn) {
         return qRound(parentItem()->width());
@@ -482,6 +519,7 @@ qreal ContentItem::childWidth(QQuickItem *child)
         // DynamicColumns
     } else {
         // TODO:look for Layout size hints
+        MeasurableLayout::ensureMeasured(child);
         qreal width = child->implicitWidth();
 
         if (width < 1.0) {
@@ -492,8 +530,33 @@ qreal ContentItem::childWidth(QQuickItem *child)
     }
 }
 
-void ContentItem::layoutItems()
+ColumnViewAttached *ContentItem::attachedObject(QQuickItem *item)
+{
+    auto it = m_attachedObjects.constFind(item);
+    if (it != m_attachedObjects.constEnd()) {
+        return *it;
+    }
+
+    auto attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(item, true));
+    if (m_items.contains(item)) {
+        m_attachedObjects.insert(item, attached);
+    }
+    return attached;
+}
+
+void ContentItem::scheduleLayout(int fromIndex)
+{
+    m_firstDirtyIndex = std::min(m_firstDirtyIndex, std::max(0, fromIndex));
+    m_view->polish();
+}
+
+void ContentItem::layoutItems(int fromIndex)
 {
+    TraceScope trace(KirigamiLayoutsTrace(), "ContentItem::layoutItems");
+    trace.addArgument("columns", m_items.count());
+    trace.addArgument("fromIndex", fromIndex);
+    Kirigami::Platform::PerformanceCounters::count(Kirigami::Platform::PerformanceCounters::LayoutPass);
+
     setY(m_view->topPadding());
     setHeight(m_view->height() - m_view->topPadding() - m_view->bottomPadding());
 
@@ -505,14 +568,50 @@ void ContentItem::layoutItems()
     m_rightPinnedSpace = 0;
 
     bool reverse = qApp->layoutDirection() == Qt::RightToLeft;
-    auto it = !reverse ? m_items.begin() : m_items.end();
+
+    // Columns before fromIndex keep their geometry as long as nothing that
+    // affects all columns changed. Pinned columns move with the view, and
+    // right to left layouts start from the end, so those are always laid out
+    // completely.
+    // Columns scheduled for a layout before this direct call are dirty too.
+    fromIndex = std::min(fromIndex, m_firstDirtyIndex);
+
+    const LayoutInputs inputs{height(), m_view->width(), m_columnWidth, m_columnResizeMode, m_view->separatorVisible()};
+    int start = 0;
+    if (fromIndex > 0 && fromIndex < m_items.count() && !reverse && inputs == m_lastLayoutInputs) {
+        start = fromIndex;
+        for (QQuickItem *child : std::as_const(m_items)) {
+            if (attachedObject(child)->isPinned()) {
+                start = 0;
+                break;
+            }
+        }
+    }
+    m_lastLayoutInputs = inputs;
+    m_firstDirtyIndex = std::numeric_limits<int>::max();
+
+    for (int j = 0; j < start; ++j) {
+        QQuickItem *child = m_items[j];
+        if (child == m_globalHeaderParent || child == m_globalFooterParent) {
+            continue;
+        }
+        if (child->isVisible()) {
+            partialWidth = child->x() + child->width();
+        }
+        ++i;
+        MeasurableLayout::ensureMeasured(child);
+        implicitWidth += child->implicitWidth();
+        implicitHeight = qMax(implicitHeight, child->implicitHeight());
+    }
+
+    auto it = !reverse ? m_items.begin() + start : m_items.end();
     int increment = reverse ? -1 : +1;
     auto lastPos = reverse ? m_items.begin() : m_items.end();
 
     for (; it != lastPos; it += increment) {
         // for (QQuickItem *child : std::as_const(m_items)) {
         QQuickItem *child = reverse ? *(it - 1) : *it;
-        ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(child, true));
+        ColumnViewAttached *attached = attachedObject(child);
         if (child == m_globalHeaderParent || child == m_globalFooterParent) {
             continue;
         }
@@ -578,7 +677,7 @@ void ContentItem::layoutItems()
                     header->setZ(1);
                     auto it = m_trailingSeparators.find(header);
                     if (it != m_trailingSeparators.end()) {
-                        it.value()->deleteLater();
+                        releaseSeparator(it.value(), m_trailingSeparatorPool);
                         m_trailingSeparators.erase(it);
                     }
                 }
@@ -593,7 +692,7 @@ void ContentItem::layoutItems()
                     footer->setZ(1);
                     auto it = m_trailingSeparators.find(footer);
                     if (it != m_trailingSeparators.end()) {
-                        it.value()->deleteLater();
+                        releaseSeparator(it.value(), m_trailingSeparatorPool);
                         m_trailingSeparators.erase(it);
                     }
                 }
@@ -602,7 +701,7 @@ void ContentItem::layoutItems()
 
                 auto it = m_trailingSeparators.find(child);
                 if (it != m_trailingSeparators.end()) {
-                    it.value()->deleteLater();
+                    releaseSeparator(it.value(), m_trailingSeparatorPool);
                     m_trailingSeparators.erase(it);
                 }
                 child->setPosition(QPointF(partialWidth, headerHeight));
@@ -618,6 +717,7 @@ void ContentItem::layoutItems()
             attached->setIndex(i++);
         }
 
+        MeasurableLayout::ensureMeasured(child);
         implicitWidth += child->implicitWidth();
 
         implicitHeight = qMax(implicitHeight, child->implicitHeight());
@@ -638,6 +738,10 @@ void ContentItem::layoutItems()
         setBoundedX(newContentX);
     }
 
+    updateColumnEnds();
+    // Columns that were added or moved need their state updated even when
+    // the visible range itself did not change.
+    m_updateAllVisibleItems = true;
     updateVisibleItems();
 }
 
@@ -652,7 +756,7 @@ void ContentItem::layoutPinnedItems()
     m_rightPinnedSpace = 0;
 
     for (QQuickItem *child : std::as_const(m_items)) {
-        ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(child, true));
+        ColumnViewAttached *attached = attachedObject(child);
 
         if (child->isVisible()) {
             if (attached->isPinned()) {
@@ -696,29 +800,121 @@ void ContentItem::layoutPinnedItems()
     }
 }
 
+void ContentItem::updateColumnEnds()
+{
+    m_columnEnds.clear();
+
+    // Pinned columns are not in x order and right to left layouts start from
+    // the last column, fall back to checking every column in those cases.
+    if (qApp->layoutDirection() == Qt::RightToLeft) {
+        return;
+    }
+
+    m_columnEnds.reserve(m_items.count());
+    qreal end = 0;
+    for (QQuickItem *child : std::as_const(m_items)) {
+        if (child == m_globalHeaderParent || child == m_globalFooterParent) {
+            m_columnEnds << end;
+            continue;
+        }
+        if (child->isVisible()) {
+            if (attachedObject(child)->isPinned() && m_columnResizeMode != ColumnView::SingleColumn) {
+                m_columnEnds.clear();
+                return;
+            }
+            end = child->x() + child->width();
+        }
+        m_columnEnds << end;
+    }
+}
+
 void ContentItem::updateVisibleItems()
 {
     QList<QQuickItem *> newItems;
+    int firstVisible = -1;
+    int lastVisible = -1;
 
-    for (auto *item : std::as_const(m_items)) {
-        ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(item, true));
+    const auto isInViewport = [this](QQuickItem *item) {
+        return item->isVisible() && item->x() + x() < m_view->width() && item->x() + item->width() + x() > 0;
+    };
 
-        if (item->isVisible() && item->x() + x() < m_view->width() && item->x() + item->width() + x() > 0) {
-            newItems << item;
-            connect(item, &QObject::destroyed, this, [this, item] {
-                m_visibleItems.removeAll(item);
-            });
-            attached->setInViewport(true);
+    // The column ends are only up to date as long as no layout is pending.
+    const bool useColumnEnds = !m_updateAllVisibleItems && m_firstDirtyIndex == std::numeric_limits<int>::max() && m_columnEnds.count() == m_items.count();
+
+    if (useColumnEnds) {
+        // Columns are laid out next to each other, so the first candidate is
+        // the first column ending after the left edge of the view and the last
+        // one is the last column starting before its right edge.
+        const qreal left = -x();
+        const qreal right = -x() + m_view->width();
+        const int first = std::upper_bound(m_columnEnds.cbegin(), m_columnEnds.cend(), left) - m_columnEnds.cbegin();
+        const int last = std::lower_bound(m_columnEnds.cbegin(), m_columnEnds.cend(), right) - m_columnEnds.cbegin();
+
+        for (int i = first; i <= std::min(last, int(m_items.count()) - 1); ++i) {
+            QQuickItem *item = m_items[i];
+            if (isInViewport(item)) {
+                if (firstVisible < 0) {
+                    firstVisible = i;
+                }
+                lastVisible = i;
+                newItems << item;
+            }
+        }
+
+        for (QQuickItem *item : std::as_const(m_visibleItems)) {
+            if (!newItems.contains(item)) {
+                attachedObject(item)->setInViewport(false);
+                item->setEnabled(false);
+            }
+        }
+        for (QQuickItem *item : std::as_const(newItems)) {
+            attachedObject(item)->setInViewport(true);
             item->setEnabled(true);
+        }
+    } else {
+        for (int i = 0; i < m_items.count(); ++i) {
+            QQuickItem *item = m_items[i];
+            ColumnViewAttached *attached = attachedObject(item);
+
+            if (isInViewport(item)) {
+                if (firstVisible < 0) {
+                    firstVisible = i;
+                }
+                lastVisible = i;
+                newItems << item;
+                attached->setInViewport(true);
+                item->setEnabled(true);
+            } else {
+                attached->setInViewport(false);
+                item->setEnabled(false);
+            }
+        }
+    }
+
+    // Only touch the connections of items that entered or left the view.
+    for (auto it = m_visibleItemConnections.begin(); it != m_visibleItemConnections.end();) {
+        if (!newItems.contains(it.key())) {
+            disconnect(it.value());
+            it = m_visibleItemConnections.erase(it);
         } else {
-            attached->setInViewport(false);
-            item->setEnabled(false);
+            ++it;
+        }
+    }
+    for (QQuickItem *item : std::as_const(newItems)) {
+        if (!m_visibleItemConnections.contains(item)) {
+            m_visibleItemConnections.insert(item, connect(item, &QObject::destroyed, this, [this, item] {
+                m_visibleItems.removeAll(item);
+                m_visibleItemConnections.remove(item);
+            }));
         }
     }
 
-    for (auto *item : std::as_const(m_visibleItems)) {
-        disconnect(item, &QObject::destroyed, this, nullptr);
+    if (!useColumnEnds || firstVisible != m_firstVisibleIndex || lastVisible != m_lastVisibleIndex) {
+        updateSuspendedItems(firstVisible, lastVisible);
     }
+    m_firstVisibleIndex = firstVisible;
+    m_lastVisibleIndex = lastVisible;
+    m_updateAllVisibleItems = false;
 
     const QQuickItem *oldLeadingVisibleItem = m_view->leadingVisibleItem();
     const QQuickItem *oldTrailingVisibleItem = m_view->trailingVisibleItem();
@@ -732,6 +928,74 @@ void ContentItem::updateVisibleItems()
         if (!m_visibleItems.isEmpty() && m_visibleItems.last() != oldTrailingVisibleItem) {
             Q_EMIT m_view->trailingVisibleItemChanged();
         }
+        if (m_cacheColumnsWhileMoving) {
+            updateColumnLayers();
+        }
+    }
+}
+
+void ContentItem::updateSuspendedItems(int firstVisible, int lastVisible)
+{
+    // No column is ever suspended, see ColumnView::setKeepAliveColumns().
+    if (m_keepAliveColumns < 0) {
+        return;
+    }
+
+    if (firstVisible < 0) {
+        // Nothing is in the viewport, e.g. while the view is hidden; keep the
+        // columns around the current one.
+        firstVisible = lastVisible = m_view->currentIndex();
+    }
+
+    for (int i = 0; i < m_items.count(); ++i) {
+        ColumnViewAttached *attached = attachedObject(m_items[i]);
+        const int distance = i < firstVisible ? firstVisible - i : std::max(0, i - lastVisible);
+        attached->setSuspended(firstVisible >= 0 && distance > m_keepAliveColumns);
+    }
+}
+
+// The layer of an item is only exposed through its meta object.
+static void setLayerEnabled(QQuickItem *item, bool enabled)
+{
+    if (auto layer = item->property("layer").value<QObject *>()) {
+        layer->setProperty("enabled", enabled);
+    }
+}
+
+static bool isLayerEnabled(QQuickItem *item)
+{
+    auto layer = item->property("layer").value<QObject *>();
+    return layer && layer->property("enabled").toBool();
+}
+
+void ContentItem::updateColumnLayers()
+{
+    const bool moving = m_cacheColumnsWhileMoving && (m_view->dragging() || m_slideAnim->state() == QAbstractAnimation::Running);
+
+    if (!moving) {
+        for (const auto &item : std::as_const(m_layeredItems)) {
+            if (item) {
+                setLayerEnabled(item, false);
+            }
+        }
+        m_layeredItems.clear();
+        return;
+    }
+
+    // The current column is the one the user interacts with, keep it live.
+    QQuickItem *currentItem = m_view->currentItem();
+    const int currentIndex = m_layeredItems.indexOf(currentItem);
+    if (currentIndex >= 0) {
+        setLayerEnabled(currentItem, false);
+        m_layeredItems.removeAt(currentIndex);
+    }
+
+    for (QQuickItem *item : std::as_const(m_visibleItems)) {
+        if (item == currentItem || m_layeredItems.contains(item) || isLayerEnabled(item)) {
+            continue;
+        }
+        setLayerEnabled(item, true);
+        m_layeredItems.append(item);
     }
 }
 
@@ -741,55 +1005,48 @@ void ContentItem::forgetItem(QQuickItem *item)
         return;
     }
 
-    ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(item, true));
+    if (m_layeredItems.removeAll(item) > 0) {
+        setLayerEnabled(item, false);
+    }
+
+    ColumnViewAttached *attached = attachedObject(item);
     attached->setView(nullptr);
     attached->setIndex(-1);
+    attached->setSuspended(false);
 
     disconnect(attached, nullptr, this, nullptr);
     disconnect(item, nullptr, this, nullptr);
     disconnect(item, nullptr, m_view, nullptr);
 
-    QQuickItem *separatorItem = m_leadingSeparators.take(item);
-    if (separatorItem) {
-        separatorItem->deleteLater();
-    }
-    separatorItem = m_trailingSeparators.take(item);
-    if (separatorItem) {
-        separatorItem->deleteLater();
-    }
+    const auto releaseSeparators = [this](QQuickItem *item) {
+        if (QQuickItem *separatorItem = m_leadingSeparators.take(item)) {
+            releaseSeparator(separatorItem, m_leadingSeparatorPool);
+        }
+        if (QQuickItem *separatorItem = m_trailingSeparators.take(item)) {
+            releaseSeparator(separatorItem, m_trailingSeparatorPool);
+        }
+    };
+    releaseSeparators(item);
 
     if (QQuickItem *header = attached->globalHeader()) {
         header->setVisible(false);
         header->setParentItem(item);
-        separatorItem = m_leadingSeparators.take(header);
-        if (separatorItem) {
-            separatorItem->deleteLater();
-        }
-        separatorItem = m_trailingSeparators.take(header);
-        if (separatorItem) {
-            separatorItem->deleteLater();
-        }
+        releaseSeparators(header);
     }
     if (QQuickItem *footer = attached->globalFooter()) {
         footer->setVisible(false);
         footer->setParentItem(item);
-        separatorItem = m_leadingSeparators.take(footer);
-        if (separatorItem) {
-            separatorItem->deleteLater();
-        }
-        separatorItem = m_trailingSeparators.take(footer);
-        if (separatorItem) {
-            separatorItem->deleteLater();
-        }
+        releaseSeparators(footer);
     }
 
     const int index = m_items.indexOf(item);
     m_items.removeAll(item);
+    m_attachedObjects.remove(item);
     // We are connected not only to destroyed but also to lambdas
     disconnect(item, nullptr, this, nullptr);
     updateVisibleItems();
     m_shouldAnimate = true;
-    m_view->polish();
+    scheduleLayout(index - 1);
 
     if (index <= m_view->currentIndex()) {
         m_view->setCurrentIndex(m_items.isEmpty() ? 0 : qBound(0, index - 1, m_items.count() - 1));
@@ -797,20 +1054,53 @@ void ContentItem::forgetItem(QQuickItem *item)
     Q_EMIT m_view->countChanged();
 }
 
+// Separators that are not used by any column are kept around up to this
+// amount, so navigating does not need to create new ones.
+static constexpr int maximumPooledSeparators = 16;
+
+bool ContentItem::canPoolSeparators(QQuickItem *item) const
+{
+    // Pooled separators are reused for other columns, so they are created in
+    // the context of the view instead of the one of their column, which may
+    // be destroyed together with it.
+    QQmlContext *viewContext = QQmlEngine::contextForObject(m_view);
+    return viewContext && viewContext->engine() == qmlEngine(item);
+}
+
+void ContentItem::releaseSeparator(QQuickItem *separatorItem, QList<QQuickItem *> &pool)
+{
+    if (pool.count() >= maximumPooledSeparators || !canPoolSeparators(separatorItem)) {
+        separatorItem->deleteLater();
+        return;
+    }
+
+    separatorItem->setParentItem(nullptr);
+    separatorItem->setProperty("column", QVariant::fromValue<QQuickItem *>(nullptr));
+    pool.append(separatorItem);
+}
+
 QQuickItem *ContentItem::ensureLeadingSeparator(QQuickItem *item)
 {
     QQuickItem *separatorItem = m_leadingSeparators.value(item);
 
+    if (!separatorItem && !m_leadingSeparatorPool.isEmpty() && canPoolSeparators(item)) {
+        separatorItem = m_leadingSeparatorPool.takeLast();
+        separatorItem->setParentItem(item);
+        separatorItem->setProperty("column", QVariant::fromValue(item));
+        separatorItem->setProperty("inToolBar", false);
+        m_leadingSeparators[item] = separatorItem;
+    }
+
     if (!separatorItem) {
-        separatorItem = qobject_cast<QQuickItem *>(
-            QmlComponentsPoolSingleton::instance(qmlEngine(item))->m_leadingSeparatorComponent->beginCreate(QQmlEngine::contextForObject(item)));
+        QQmlComponent *component = QmlComponentsPoolSingleton::instance(qmlEngine(item))->m_leadingSeparatorComponent;
+        separatorItem = qobject_cast<QQuickItem *>(component->beginCreate(canPoolSeparators(item) ? QQmlEngine::contextForObject(m_view) : QQmlEngine::contextForObject(item)));
         if (separatorItem) {
             separatorItem->setParent(this);
             separatorItem->setParentItem(item);
             separatorItem->setZ(9999);
             separatorItem->setProperty("column", QVariant::fromValue(item));
             separatorItem->setProperty("view", QVariant::fromValue(m_view));
-            QmlComponentsPoolSingleton::instance(qmlEngine(item))->m_leadingSeparatorComponent->completeCreate();
+            component->completeCreate();
             m_leadingSeparators[item] = separatorItem;
         }
     }
@@ -822,15 +1112,22 @@ QQuickItem *ContentItem::ensureTrailingSeparator(QQuickItem *item)
 {
     QQuickItem *separatorItem = m_trailingSeparators.value(item);
 
+    if (!separatorItem && !m_trailingSeparatorPool.isEmpty() && canPoolSeparators(item)) {
+        separatorItem = m_trailingSeparatorPool.takeLast();
+        separatorItem->setParentItem(item);
+        separatorItem->setProperty("column", QVariant::fromValue(item));
+        m_trailingSeparators[item] = separatorItem;
+    }
+
     if (!separatorItem) {
-        separatorItem = qobject_cast<QQuickItem *>(
-            QmlComponentsPoolSingleton::instance(qmlEngine(item))->m_trailingSeparatorComponent->beginCreate(QQmlEngine::contextForObject(item)));
+        QQmlComponent *component = QmlComponentsPoolSingleton::instance(qmlEngine(item))->m_trailingSeparatorComponent;
+        separatorItem = qobject_cast<QQuickItem *>(component->beginCreate(canPoolSeparators(item) ? QQmlEngine::contextForObject(m_view) : QQmlEngine::contextForObject(item)));
         if (separatorItem) {
             separatorItem->setParent(this);
             separatorItem->setParentItem(item);
             separatorItem->setZ(9999);
             separatorItem->setProperty("column", QVariant::fromValue(item));
-            QmlComponentsPoolSingleton::instance(qmlEngine(item))->m_trailingSeparatorComponent->completeCreate();
+            component->completeCreate();
             m_trailingSeparators[item] = separatorItem;
         }
     }
@@ -849,17 +1146,26 @@ void ContentItem::itemChange(QQuickItem::ItemChange change, const QQuickItem::It
         ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(value.item, true));
         attached->setView(m_view);
 
-        // connect(attached, &ColumnViewAttached::fillWidthChanged, m_view, &ColumnView::polish);
-        connect(attached, &ColumnViewAttached::fillWidthChanged, this, [this] {
-            m_view->polish();
+        QQuickItem *item = value.item;
+        m_attachedObjects[item] = attached;
+
+        // Changes to a single column only require laying out that column and the ones after it.
+        connect(attached, &ColumnViewAttached::fillWidthChanged, this, [this, item] {
+            scheduleLayout(m_items.indexOf(item));
+        });
+        connect(attached, &ColumnViewAttached::reservedSpaceChanged, this, [this, item] {
+            scheduleLayout(m_items.indexOf(item));
+        });
+        connect(attached, &ColumnViewAttached::pinnedChanged, this, [this] {
+            scheduleLayout();
         });
-        connect(attached, &ColumnViewAttached::reservedSpaceChanged, m_view, &ColumnView::polish);
 
         value.item->setVisible(true);
 
         if (!m_items.contains(value.item)) {
-            connect(value.item, &QQuickItem::widthChanged, m_view, &ColumnView::polish);
-            QQuickItem *item = value.item;
+            connect(value.item, &QQuickItem::widthChanged, this, [this, item] {
+                scheduleLayout(m_items.indexOf(item));
+            });
             m_items << item;
             connect(item, &QObject::destroyed, this, [this, item]() {
                 m_view->removeItem(item);
@@ -871,7 +1177,8 @@ void ContentItem::itemChange(QQuickItem::ItemChange change, const QQuickItem::It
         }
 
         m_shouldAnimate = true;
-        m_view->polish();
+        // The previous column may lose its fillWidth.
+        scheduleLayout(m_items.indexOf(item) - 1);
         Q_EMIT m_view->countChanged();
         break;
     }
@@ -882,7 +1189,7 @@ void ContentItem::itemChange(QQuickItem::ItemChange change, const QQuickItem::It
     case QQuickItem::ItemVisibleHasChanged:
         updateVisibleItems();
         if (value.boolValue) {
-            m_view->polish();
+            scheduleLayout();
         }
         break;
     default:
@@ -944,8 +1251,11 @@ void ContentItem::connectHeader(QQuickItem *oldHeader, QQuickItem *newHeader)
         oldHeader->setParentItem(nullptr);
     }
     if (newHeader) {
-        connect(newHeader, &QQuickItem::heightChanged, this, &ContentItem::layoutItems);
-        connect(newHeader, &QQuickItem::visibleChanged, this, &ContentItem::layoutItems);
+        auto layout = [this] {
+            layoutItems();
+        };
+        connect(newHeader, &QQuickItem::heightChanged, this, layout);
+        connect(newHeader, &QQuickItem::visibleChanged, this, layout);
         newHeader->setParentItem(m_globalHeaderParent);
     }
 }
@@ -957,8 +1267,11 @@ void ContentItem::connectFooter(QQuickItem *oldFooter, QQuickItem *newFooter)
         oldFooter->setParentItem(nullptr);
     }
     if (newFooter) {
-        connect(newFooter, &QQuickItem::heightChanged, this, &ContentItem::layoutItems);
-        connect(newFooter, &QQuickItem::visibleChanged, this, &ContentItem::layoutItems);
+        auto layout = [this] {
+            layoutItems();
+        };
+        connect(newFooter, &QQuickItem::heightChanged, this, layout);
+        connect(newFooter, &QQuickItem::visibleChanged, this, layout);
         newFooter->setParentItem(m_globalFooterParent);
     }
 }
@@ -981,6 +1294,8 @@ ColumnView::ColumnView(QQuickItem *parent)
     });
     connect(m_contentItem, &ContentItem::widthChanged, this, &ColumnView::contentWidthChanged);
     connect(m_contentItem, &ContentItem::xChanged, this, &ColumnView::contentXChanged);
+    connect(this, &ColumnView::draggingChanged, m_contentItem, &ContentItem::updateColumnLayers);
+    connect(this, &ColumnView::currentItemChanged, m_contentItem, &ContentItem::updateColumnLayers);
 
     connect(this, &ColumnView::activeFocusChanged, this, [this]() {
         if (hasActiveFocus() && m_currentItem) {
@@ -1013,7 +1328,7 @@ void ColumnView::setColumnResizeMode(ColumnResizeMode mode)
         m_contentItem->m_viewAnchorItem = m_currentItem;
     }
     m_contentItem->m_shouldAnimate = false;
-    polish();
+    m_contentItem->scheduleLayout();
     Q_EMIT columnResizeModeChanged();
 }
 
@@ -1033,7 +1348,7 @@ void ColumnView::setColumnWidth(qreal width)
 
     m_contentItem->m_columnWidth = width;
     m_contentItem->m_shouldAnimate = false;
-    polish();
+    m_contentItem->scheduleLayout();
     Q_EMIT columnWidthChanged();
 }
 
@@ -1135,7 +1450,7 @@ void ColumnView::setTopPadding(qreal padding)
     }
 
     m_topPadding = padding;
-    polish();
+    m_contentItem->scheduleLayout();
     Q_EMIT topPaddingChanged();
 }
 
@@ -1151,7 +1466,7 @@ void ColumnView::setBottomPadding(qreal padding)
     }
 
     m_bottomPadding = padding;
-    polish();
+    m_contentItem->scheduleLayout();
     Q_EMIT bottomPaddingChanged();
 }
 
@@ -1193,6 +1508,46 @@ void ColumnView::setSeparatorVisible(bool visible)
     Q_EMIT separatorVisibleChanged();
 }
 
+int ColumnView::keepAliveColumns() const
+{
+    return m_contentItem->m_keepAliveColumns;
+}
+
+void ColumnView::setKeepAliveColumns(int columns)
+{
+    if (columns == m_contentItem->m_keepAliveColumns) {
+        return;
+    }
+
+    m_contentItem->m_keepAliveColumns = columns;
+    if (columns < 0) {
+        for (QQuickItem *item : std::as_const(m_contentItem->m_items)) {
+            m_contentItem->attachedObject(item)->setSuspended(false);
+        }
+    } else {
+        m_contentItem->updateSuspendedItems(m_contentItem->m_firstVisibleIndex, m_contentItem->m_lastVisibleIndex);
+    }
+
+    Q_EMIT keepAliveColumnsChanged();
+}
+
+bool ColumnView::cacheColumnsWhileMoving() const
+{
+    return m_contentItem->m_cacheColumnsWhileMoving;
+}
+
+void ColumnView::setCacheColumnsWhileMoving(bool cache)
+{
+    if (cache == m_contentItem->m_cacheColumnsWhileMoving) {
+        return;
+    }
+
+    m_contentItem->m_cacheColumnsWhileMoving = cache;
+    m_contentItem->updateColumnLayers();
+
+    Q_EMIT cacheColumnsWhileMovingChanged();
+}
+
 bool ColumnView::dragging() const
 {
     return m_dragging;
@@ -1304,7 +1659,8 @@ void ColumnView::insertItem(int pos, QQuickItem *item)
 
     // Animate shift to new item.
     m_contentItem->m_shouldAnimate = true;
-    m_contentItem->layoutItems();
+    // The previous column may lose its fillWidth.
+    m_contentItem->layoutItems(pos - 1);
     Q_EMIT contentChildrenChanged();
 
     // In order to keep the same current item we need to increase the current index if displaced
@@ -1342,7 +1698,10 @@ void ColumnView::replaceItem(int pos, QQuickItem *item)
     ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(oldItem, false));
 
     if (attached && attached->shouldDeleteOnRemove()) {
-        oldItem->deleteLater();
+        // Destroying the item may take a while, do it once idle rather than
+        // during the animation removing it.
+        oldItem->setParentItem(nullptr);
+        Kirigami::Platform::DeferredDeletion::deleteLater(oldItem);
     } else {
         oldItem->setParentItem(attached ? attached->originalParent() : nullptr);
     }
@@ -1405,7 +1764,7 @@ void ColumnView::moveItem(int from, int to)
         Q_EMIT currentIndexChanged();
     }
 
-    polish();
+    m_contentItem->scheduleLayout();
 }
 
 QQuickItem *ColumnView::removeItem(QQuickItem *item)
@@ -1427,7 +1786,8 @@ QQuickItem *ColumnView::removeItem(QQuickItem *item)
     ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(item, false));
 
     if (attached && attached->shouldDeleteOnRemove()) {
-        item->deleteLater();
+        item->setParentItem(nullptr);
+        Kirigami::Platform::DeferredDeletion::deleteLater(item);
     } else {
         item->setParentItem(attached ? attached->originalParent() : nullptr);
     }
@@ -1529,12 +1889,30 @@ void ColumnView::geometryChange(const QRectF &newGeometry, const QRectF &oldGeom
     m_contentItem->setY(m_topPadding);
     m_contentItem->setHeight(newGeometry.height() - m_topPadding - m_bottomPadding);
     m_contentItem->m_shouldAnimate = false;
-    polish();
+    m_contentItem->scheduleLayout();
 
     m_contentItem->updateVisibleItems();
     QQuickItem::geometryChange(newGeometry, oldGeometry);
 }
 
+QQuickItem *ColumnView::filteredColumn(QQuickItem *item)
+{
+    // All events of a gesture usually go to the same item, so remember its
+    // column instead of walking up the parents for every move.
+    if (item == m_filteredItem && m_filteredColumn) {
+        return m_filteredColumn;
+    }
+
+    QQuickItem *candidateItem = item;
+    while (candidateItem->parentItem() && candidateItem->parentItem() != m_contentItem) {
+        candidateItem = candidateItem->parentItem();
+    }
+
+    m_filteredItem = item;
+    m_filteredColumn = candidateItem;
+    return candidateItem;
+}
+
 bool ColumnView::childMouseEventFilter(QQuickItem *item, QEvent *event)
 {
     if (!m_interactive || item == m_contentItem) {
@@ -1550,10 +1928,8 @@ bool ColumnView::childMouseEventFilter(QQuickItem *item, QEvent *event)
         }
 
         // On press, we set the current index of the view to the root item
-        QQuickItem *candidateItem = item;
-        while (candidateItem->parentItem() && candidateItem->parentItem() != m_contentItem) {
-            candidateItem = candidateItem->parentItem();
-        }
+        m_filteredItem = nullptr;
+        QQuickItem *candidateItem = filteredColumn(item);
         if (int idx = m_contentItem->m_items.indexOf(candidateItem); idx >= 0 && candidateItem->parentItem() == m_contentItem) {
             setCurrentIndex(idx);
         }
@@ -1581,32 +1957,27 @@ bool ColumnView::childMouseEventFilter(QQuickItem *item, QEvent *event)
     case QEvent::MouseMove: {
         QMouseEvent *me = static_cast<QMouseEvent *>(event);
 
-        if (!m_acceptsMouse && me->source() == Qt::MouseEventNotSynthesized) {
+        // Moves without a button pressed can't start a drag, reject them
+        // before doing anything else as they are the most frequent ones.
+        if (!(me->buttons() & Qt::LeftButton)) {
             return false;
         }
 
-        if (!(me->buttons() & Qt::LeftButton)) {
+        if (!m_acceptsMouse && me->source() == Qt::MouseEventNotSynthesized) {
             return false;
         }
 
-        const QPointF pos = mapFromItem(item, me->position());
-
         bool verticalScrollIntercepted = false;
 
-        QQuickItem *candidateItem = item;
-        while (candidateItem->parentItem() && candidateItem->parentItem() != m_contentItem) {
-            candidateItem = candidateItem->parentItem();
-        }
-        if (candidateItem->parentItem() == m_contentItem) {
-            ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(candidateItem, true));
-            if (attached->preventStealing()) {
-                return false;
-            }
+        QQuickItem *candidateItem = filteredColumn(item);
+        ColumnViewAttached *attached = m_contentItem->attachedObject(candidateItem);
+        if (candidateItem->parentItem() == m_contentItem && attached->preventStealing()) {
+            return false;
         }
 
-        {
-            ColumnViewAttached *attached = qobject_cast<ColumnViewAttached *>(qmlAttachedPropertiesObject<ColumnView>(candidateItem, true));
+        const QPointF pos = mapFromItem(item, me->position());
 
+        {
             ScrollIntentionEvent scrollIntentionEvent;
             scrollIntentionEvent.delta = QPointF(pos.x() - m_oldMouseX, pos.y() - m_oldMouseY);
 
@@ -1627,7 +1998,7 @@ bool ColumnView::childMouseEventFilter(QQuickItem *item, QEvent *event)
 
         const bool wasDragging = m_dragging;
         // If a drag happened, start to steal all events, use startDragDistance * 2 to give time to widgets to take the mouse grab by themselves
-        m_dragging = keepMouseGrab() || qAbs(mapFromItem(item, me->position()).x() - m_startMouseX) > qApp->styleHints()->startDragDistance() * 3;
+        m_dragging = keepMouseGrab() || qAbs(pos.x() - m_startMouseX) > qApp->styleHints()->startDragDistance() * 3;
 
         if (m_dragging != wasDragging) {
             m_moving = true;
@@ -1828,7 +2199,7 @@ void ColumnView::componentComplete()
 
 void ColumnView::updatePolish()
 {
-    m_contentItem->layoutItems();
+    m_contentItem->layoutItems(m_contentItem->m_firstDirtyIndex);
 }
 
 void ColumnView::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value)
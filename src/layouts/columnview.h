@@ -78,6 +78,19 @@ class ColumnViewAttached : public QObject
      */
     Q_PROPERTY(bool inViewport READ inViewport NOTIFY inViewportChanged FINAL)
 
+    /**
+     * True if this column is further away from the viewport than
+     * ColumnView::keepAliveColumns allows.
+     *
+     * Columns can use this to release expensive content while they are out of
+     * sight, for example by deactivating a Loader, and restore it when they
+     * come back close to the viewport.
+     *
+     * @see ColumnView::keepAliveColumns
+     * @since 6.12
+     */
+    Q_PROPERTY(bool suspended READ isSuspended NOTIFY suspendedChanged FINAL)
+
     Q_PROPERTY(QQuickItem *globalHeader READ globalHeader WRITE setGlobalHeader NOTIFY globalHeaderChanged FINAL)
     Q_PROPERTY(QQuickItem *globalFooter READ globalFooter WRITE setGlobalFooter NOTIFY globalFooterChanged FINAL)
 
@@ -113,6 +126,9 @@ public:
     bool inViewport() const;
     void setInViewport(bool inViewport);
 
+    bool isSuspended() const;
+    void setSuspended(bool suspended);
+
     QQuickItem *globalHeader() const;
     void setGlobalHeader(QQuickItem *header);
 
@@ -128,6 +144,7 @@ Q_SIGNALS:
     void pinnedChanged();
     void scrollIntention(ScrollIntentionEvent *event);
     void inViewportChanged();
+    void suspendedChanged();
     void globalHeaderChanged(QQuickItem *oldHeader, QQuickItem *newHeader);
     void globalFooterChanged(QQuickItem *oldFooter, QQuickItem *newFooter);
 
@@ -143,6 +160,7 @@ private:
     bool m_preventStealing = false;
     bool m_pinned = false;
     bool m_inViewport = false;
+    bool m_suspended = false;
     QPointer<QQuickItem> m_globalHeader;
     QPointer<QQuickItem> m_globalFooter;
 };
@@ -227,6 +245,35 @@ class ColumnView : public QQuickItem
      */
     Q_PROPERTY(bool separatorVisible READ separatorVisible WRITE setSeparatorVisible NOTIFY separatorVisibleChanged FINAL)
 
+    /**
+     * How many columns before and after the ones in the viewport are kept active.
+     *
+     * Columns further away than this from any column in the viewport have
+     * their ColumnView.suspended attached property set, so that they can
+     * release their content. This keeps the memory use of deep navigation
+     * stacks bounded. Negative values disable suspending columns.
+     *
+     * default: ``-1``
+     *
+     * @since 6.12
+     */
+    Q_PROPERTY(int keepAliveColumns READ keepAliveColumns WRITE setKeepAliveColumns NOTIFY keepAliveColumnsChanged FINAL)
+
+    /**
+     * True if the columns other than the current one should be rendered into
+     * a texture while the view is sliding or being dragged.
+     *
+     * Moving the view then only moves these textures instead of rendering
+     * the items of every column again for each frame, at the cost of the
+     * memory used by the textures. Live rendering is restored as soon as the
+     * view stops. Columns that already have a layer enabled are left alone.
+     *
+     * default: ``false``
+     *
+     * @since 6.12
+     */
+    Q_PROPERTY(bool cacheColumnsWhileMoving READ cacheColumnsWhileMoving WRITE setCacheColumnsWhileMoving NOTIFY cacheColumnsWhileMovingChanged FINAL)
+
     /**
      * The list of all visible column items that are at least partially in the viewport at any given moment
      */
@@ -301,6 +348,12 @@ public:
     bool separatorVisible() const;
     void setSeparatorVisible(bool visible);
 
+    int keepAliveColumns() const;
+    void setKeepAliveColumns(int columns);
+
+    bool cacheColumnsWhileMoving() const;
+    void setCacheColumnsWhileMoving(bool cache);
+
     int count() const;
 
     qreal topPadding() const;
@@ -515,12 +568,19 @@ Q_SIGNALS:
     void acceptsMouseChanged();
     void scrollDurationChanged();
     void separatorVisibleChanged();
+    void keepAliveColumnsChanged();
+    void cacheColumnsWhileMovingChanged();
     void leadingVisibleItemChanged();
     void trailingVisibleItemChanged();
     void topPaddingChanged();
     void bottomPaddingChanged();
 
 private:
+    /**
+     * The top level item containing @p item, usually its column.
+     */
+    QQuickItem *filteredColumn(QQuickItem *item);
+
     static void contentChildren_append(QQmlListProperty<QQuickItem> *prop, QQuickItem *object);
     static qsizetype contentChildren_count(QQmlListProperty<QQuickItem> *prop);
     static QQuickItem *contentChildren_at(QQmlListProperty<QQuickItem> *prop, qsizetype index);
@@ -535,6 +595,8 @@ private:
 
     ContentItem *m_contentItem;
     QPointer<QQuickItem> m_currentItem;
+    QPointer<QQuickItem> m_filteredItem;
+    QPointer<QQuickItem> m_filteredColumn;
 
     qreal m_oldMouseX = -1.0;
     qreal m_startMouseX = -1.0;
@@ -49,13 +49,40 @@ public:
     ContentItem(ColumnView *parent = nullptr);
     ~ContentItem() override;
 
-    void layoutItems();
+    /**
+     * Lay out the columns starting at @p fromIndex, the ones before it are
+     * assumed to be laid out already. A full layout is done when anything
+     * that affects every column changed since the last layout.
+     */
+    void layoutItems(int fromIndex = 0);
     void layoutPinnedItems();
+    /**
+     * Schedule a layout of the columns starting at @p fromIndex for the next polish.
+     */
+    void scheduleLayout(int fromIndex = 0);
+    ColumnViewAttached *attachedObject(QQuickItem *item);
     qreal childWidth(QQuickItem *child);
     void updateVisibleItems();
+    /**
+     * Remember where every column ends after a layout, so that
+     * updateVisibleItems() can find the visible columns with a binary search
+     * instead of checking all of them whenever the view scrolls.
+     */
+    void updateColumnEnds();
+    void updateSuspendedItems(int firstVisible, int lastVisible);
+    /**
+     * Enable the layer of the visible columns other than the current one while
+     * the view is moving, and restore the columns once it stopped.
+     */
+    void updateColumnLayers();
     void forgetItem(QQuickItem *item);
     QQuickItem *ensureLeadingSeparator(QQuickItem *item);
     QQuickItem *ensureTrailingSeparator(QQuickItem *item);
+    /**
+     * Detach @p separatorItem from its column and keep it in @p pool to be
+     * reused for another column, or delete it if the pool is full.
+     */
+    void releaseSeparator(QQuickItem *separatorItem, QList<QQuickItem *> &pool);
 
     void setBoundedX(qreal x);
     void animateX(qreal x);
@@ -76,24 +103,59 @@ private Q_SLOTS:
     void updateRepeaterModel();
 
 private:
+    bool canPoolSeparators(QQuickItem *item) const;
+
+    struct LayoutInputs {
+        qreal height = -1;
+        qreal viewWidth = -1;
+        qreal columnWidth = -1;
+        ColumnView::ColumnResizeMode columnResizeMode = ColumnView::FixedColumns;
+        bool separatorVisible = false;
+
+        bool operator==(const LayoutInputs &other) const
+        {
+            return height == other.height && viewWidth == other.viewWidth && columnWidth == other.columnWidth && columnResizeMode == other.columnResizeMode
+                && separatorVisible == other.separatorVisible;
+        }
+    };
+
     ColumnView *m_view;
     QQuickItem *m_globalHeaderParent;
     QQuickItem *m_globalFooterParent;
     QPropertyAnimation *m_slideAnim;
     QList<QQuickItem *> m_items;
     QList<QQuickItem *> m_visibleItems;
+    QHash<QQuickItem *, QMetaObject::Connection> m_visibleItemConnections;
+    // The right edge of every column in m_items, empty when the columns are not in x order.
+    QList<qreal> m_columnEnds;
     QPointer<QQuickItem> m_viewAnchorItem;
     QHash<QQuickItem *, QQuickItem *> m_leadingSeparators;
     QHash<QQuickItem *, QQuickItem *> m_trailingSeparators;
+    // Separators not used by any column, see releaseSeparator().
+    QList<QQuickItem *> m_leadingSeparatorPool;
+    QList<QQuickItem *> m_trailingSeparatorPool;
     QHash<QObject *, QObject *> m_models;
+    // qmlAttachedPropertiesObject() is comparatively expensive and called for
+    // every column on every layout, so remember the attached objects.
+    QHash<QQuickItem *, ColumnViewAttached *> m_attachedObjects;
+    // The columns whose layer has been enabled by updateColumnLayers().
+    QList<QPointer<QQuickItem>> m_layeredItems;
+    LayoutInputs m_lastLayoutInputs;
+    // The first column that needs to be laid out on the next polish.
+    int m_firstDirtyIndex = 0;
 
     qreal m_leftPinnedSpace = 361;
     qreal m_rightPinnedSpace = 0;
 
     qreal m_columnWidth = 0;
     qreal m_lastDragDelta = 0;
+    int m_keepAliveColumns = -1;
+    int m_firstVisibleIndex = -1;
+    int m_lastVisibleIndex = -1;
     ColumnView::ColumnResizeMode m_columnResizeMode = ColumnView::FixedColumns;
     bool m_shouldAnimate = false;
+    bool m_cacheColumnsWhileMoving = false;
+    bool m_updateAllVisibleItems = true;
     bool m_creationInProgress = true;
     friend class ColumnView;
 };
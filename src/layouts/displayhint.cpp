@@ -6,10 +6,56 @@
 
 #include "displayhint.h"
 
-#include "moc_displayhint.cpp"
-
+#include <QHash>
+#include <QMetaProperty>
 #include <QVariant>
 
+// Caches the display hints of objects, updated when their displayHint
+// property changes.
+class DisplayHintCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    DisplayHint::DisplayHints hints(QObject *object)
+    {
+        auto itr = m_hints.constFind(object);
+        if (itr != m_hints.constEnd()) {
+            return *itr;
+        }
+
+        DisplayHint::DisplayHints hints = DisplayHint::NoPreference;
+        const QMetaObject *metaObject = object->metaObject();
+        const int index = metaObject->indexOfProperty("displayHint");
+        if (index >= 0) {
+            const QMetaProperty property = metaObject->property(index);
+            hints = DisplayHint::DisplayHints{property.read(object).toInt()};
+            if (property.hasNotifySignal()) {
+                static const QMetaMethod updateMethod = staticMetaObject.method(staticMetaObject.indexOfSlot("update()"));
+                connect(object, property.notifySignal(), this, updateMethod);
+            }
+        }
+
+        m_hints.insert(object, hints);
+        connect(object, &QObject::destroyed, this, [this](QObject *object) {
+            m_hints.remove(object);
+        });
+        return hints;
+    }
+
+private Q_SLOTS:
+    void update()
+    {
+        QObject *object = sender();
+        m_hints.insert(object, DisplayHint::DisplayHints{object->property("displayHint").toInt()});
+    }
+
+private:
+    QHash<QObject *, DisplayHint::DisplayHints> m_hints;
+};
+
+Q_GLOBAL_STATIC(DisplayHintCache, s_displayHintCache)
+
 bool DisplayHint::displayHintSet(DisplayHints values, Hint hint)
 {
     return isDisplayHintSet(values, hint);
@@ -21,12 +67,9 @@ bool DisplayHint::displayHintSet(QObject *object, DisplayHint::Hint hint)
         return false;
     }
 
-    auto property = object->property("displayHint");
-    if (property.isValid()) {
-        return isDisplayHintSet(DisplayHints{property.toInt()}, hint);
-    } else {
-        return false;
-    }
+    // Bindings may be notified about a change of the property before the
+    // cache is, so don't use it here.
+    return isDisplayHintSet(DisplayHints{object->property("displayHint").toInt()}, hint);
 }
 
 bool DisplayHint::isDisplayHintSet(DisplayHint::DisplayHints values, DisplayHint::Hint hint)
@@ -37,3 +80,17 @@ bool DisplayHint::isDisplayHintSet(DisplayHint::DisplayHints values, DisplayHint
 
     return values & hint;
 }
+
+DisplayHint::DisplayHints DisplayHint::displayHints(QObject *object)
+{
+    if (!object) {
+        return NoPreference;
+    }
+    if (s_displayHintCache.isDestroyed()) {
+        return DisplayHints{object->property("displayHint").toInt()};
+    }
+    return s_displayHintCache->hints(object);
+}
+
+#include "displayhint.moc"
+#include "moc_displayhint.cpp"
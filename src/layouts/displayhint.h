@@ -89,6 +89,20 @@ public:
      * called from C++ code.
      */
     static bool isDisplayHintSet(DisplayHints values, Hint hint);
+
+    /**
+     * The display hints of an object, NoPreference if it has no displayHint
+     * property.
+     *
+     * The property is only read the first time an object is queried, after
+     * which the value is kept up to date through the notify signal of the
+     * property, so this is cheap enough to call while laying out. Other
+     * handlers of the notify signal may run before the value is updated, so
+     * they should read the property instead.
+     *
+     * @since 6.12
+     */
+    static DisplayHints displayHints(QObject *object);
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(DisplayHint::DisplayHints)
@@ -0,0 +1,114 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "formlayoutcolumnhint.h"
+
+#include <algorithm>
+
+FormLayoutColumnHint::FormLayoutColumnHint(QObject *parent)
+    : QObject(parent)
+{
+}
+
+QList<QQuickItem *> FormLayoutColumnHint::items() const
+{
+    return m_items;
+}
+
+void FormLayoutColumnHint::setItems(const QList<QQuickItem *> &items)
+{
+    if (items == m_items) {
+        return;
+    }
+
+    for (QQuickItem *item : std::as_const(m_items)) {
+        item->disconnect(this);
+    }
+    m_rows.clear();
+    m_items.clear();
+
+    // The notify signal differs between items, so it can only be connected by method.
+    static const QMetaMethod updateRowMethod = metaObject()->method(metaObject()->indexOfSlot("updateRow()"));
+
+    for (QQuickItem *item : items) {
+        // Zombie wrappers of destroyed items end up as null here.
+        if (!item || m_rows.contains(item)) {
+            continue;
+        }
+
+        m_items.append(item);
+        connect(item, &QObject::destroyed, this, &FormLayoutColumnHint::removeRow);
+
+        const QMetaObject *metaObject = item->metaObject();
+        const QMetaProperty hint = metaObject->property(metaObject->indexOfProperty("widthHint"));
+        Row row;
+        if (hint.isValid() && hint.hasNotifySignal()) {
+            row.hint = hint;
+            row.width = hint.read(item).toReal();
+            connect(item, hint.notifySignal(), this, updateRowMethod);
+        }
+        m_rows.insert(item, row);
+    }
+
+    computeImplicitWidth();
+    Q_EMIT itemsChanged();
+}
+
+qreal FormLayoutColumnHint::implicitWidth() const
+{
+    return m_implicitWidth;
+}
+
+void FormLayoutColumnHint::updateRow()
+{
+    auto itr = m_rows.find(sender());
+    if (itr == m_rows.end()) {
+        return;
+    }
+
+    const qreal oldWidth = itr->width;
+    itr->width = itr->hint.read(sender()).toReal();
+
+    if (itr->width >= m_implicitWidth) {
+        setImplicitWidth(itr->width);
+    } else if (oldWidth >= m_implicitWidth) {
+        // The widest row became narrower, any other row may be the widest now.
+        computeImplicitWidth();
+    }
+}
+
+void FormLayoutColumnHint::removeRow()
+{
+    QObject *item = sender();
+    const auto row = m_rows.take(item);
+    m_items.removeOne(static_cast<QQuickItem *>(item));
+
+    if (row.width >= m_implicitWidth) {
+        computeImplicitWidth();
+    }
+    Q_EMIT itemsChanged();
+}
+
+void FormLayoutColumnHint::setImplicitWidth(qreal width)
+{
+    if (qFuzzyCompare(width, m_implicitWidth)) {
+        return;
+    }
+
+    m_implicitWidth = width;
+    Q_EMIT implicitWidthChanged();
+}
+
+void FormLayoutColumnHint::computeImplicitWidth()
+{
+    qreal width = 0.0;
+    for (const Row &row : std::as_const(m_rows)) {
+        width = std::max(width, row.width);
+    }
+    setImplicitWidth(width);
+}
+
+#include "moc_formlayoutcolumnhint.cpp"
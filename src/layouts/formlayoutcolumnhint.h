@@ -0,0 +1,70 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef FORMLAYOUTCOLUMNHINT_H
+#define FORMLAYOUTCOLUMNHINT_H
+
+#include <QHash>
+#include <QMetaProperty>
+#include <QObject>
+#include <QQmlEngine>
+#include <QQuickItem>
+
+/**
+ * Computes the width of a column of a FormLayout, which is the largest
+ * `widthHint` property of the items in the column.
+ *
+ * Instead of visiting every row whenever one of them changes, the width is
+ * updated incrementally from the row that changed, and only computed again
+ * from all the rows when the widest one became narrower.
+ *
+ * @internal
+ */
+class FormLayoutColumnHint : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    /**
+     * The items of the column, each of which needs a notifiable `widthHint`
+     * property. Items without it are ignored.
+     */
+    Q_PROPERTY(QList<QQuickItem *> items READ items WRITE setItems NOTIFY itemsChanged FINAL)
+
+    /**
+     * The largest width hint of all items.
+     */
+    Q_PROPERTY(qreal implicitWidth READ implicitWidth NOTIFY implicitWidthChanged FINAL)
+
+public:
+    explicit FormLayoutColumnHint(QObject *parent = nullptr);
+
+    QList<QQuickItem *> items() const;
+    void setItems(const QList<QQuickItem *> &items);
+
+    qreal implicitWidth() const;
+
+Q_SIGNALS:
+    void itemsChanged();
+    void implicitWidthChanged();
+
+private:
+    struct Row {
+        QMetaProperty hint;
+        qreal width = 0.0;
+    };
+
+    Q_SLOT void updateRow();
+    Q_SLOT void removeRow();
+    void setImplicitWidth(qreal width);
+    void computeImplicitWidth();
+
+    QList<QQuickItem *> m_items;
+    QHash<QObject *, Row> m_rows;
+    qreal m_implicitWidth = 0.0;
+};
+
+#endif
@@ -10,6 +10,8 @@
 #include <QDebug>
 #include <QTimer>
 
+#include "platform/performancecounters_p.h"
+
 HeaderFooterLayout::HeaderFooterLayout(QQuickItem *parent)
     : QQuickItem(parent)
     , m_isDirty(false)
@@ -43,9 +45,7 @@ void HeaderFooterLayout::setHeader(QQuickItem *item)
             m_header->setZ(1);
         }
 
-        connect(m_header, &QQuickItem::implicitWidthChanged, this, &HeaderFooterLayout::markAsDirty);
-        connect(m_header, &QQuickItem::implicitHeightChanged, this, &HeaderFooterLayout::markAsDirty);
-        connect(m_header, &QQuickItem::visibleChanged, this, &HeaderFooterLayout::markAsDirty);
+        connectItem(m_header);
 
         if (m_header->inherits("QQuickTabBar") || m_header->inherits("QQuickToolBar") || m_header->inherits("QQuickDialogButtonBox")) {
             // Assume 0 is Header for all 3 types
@@ -53,7 +53,7 @@ void HeaderFooterLayout::setHeader(QQuickItem *item)
         }
     }
 
-    markAsDirty();
+    markImplicitSizeDirty();
 
     Q_EMIT headerChanged();
 }
@@ -78,12 +78,10 @@ void HeaderFooterLayout::setContentItem(QQuickItem *item)
 
     if (m_contentItem) {
         m_contentItem->setParentItem(this);
-        connect(m_contentItem, &QQuickItem::implicitWidthChanged, this, &HeaderFooterLayout::markAsDirty);
-        connect(m_contentItem, &QQuickItem::implicitHeightChanged, this, &HeaderFooterLayout::markAsDirty);
-        connect(m_contentItem, &QQuickItem::visibleChanged, this, &HeaderFooterLayout::markAsDirty);
+        connectItem(m_contentItem);
     }
 
-    markAsDirty();
+    markImplicitSizeDirty();
 
     Q_EMIT contentItemChanged();
 }
@@ -112,9 +110,7 @@ void HeaderFooterLayout::setFooter(QQuickItem *item)
             m_footer->setZ(1);
         }
 
-        connect(m_footer, &QQuickItem::implicitWidthChanged, this, &HeaderFooterLayout::markAsDirty);
-        connect(m_footer, &QQuickItem::implicitHeightChanged, this, &HeaderFooterLayout::markAsDirty);
-        connect(m_footer, &QQuickItem::visibleChanged, this, &HeaderFooterLayout::markAsDirty);
+        connectItem(m_footer);
 
         if (m_footer->inherits("QQuickTabBar") || m_footer->inherits("QQuickToolBar") || m_footer->inherits("QQuickDialogButtonBox")) {
             // Assume 1 is Footer for all 3 types
@@ -122,7 +118,7 @@ void HeaderFooterLayout::setFooter(QQuickItem *item)
         }
     }
 
-    markAsDirty();
+    markImplicitSizeDirty();
 
     Q_EMIT footerChanged();
 }
@@ -139,7 +135,8 @@ void HeaderFooterLayout::forceLayout()
 
 void HeaderFooterLayout::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
 {
-    if (newGeometry != oldGeometry) {
+    // Our own geometry does not affect the implicit size, only the arrangement.
+    if (newGeometry.size() != oldGeometry.size()) {
         markAsDirty();
     }
 
@@ -169,18 +166,27 @@ void HeaderFooterLayout::markAsDirty()
     }
 }
 
+void HeaderFooterLayout::markImplicitSizeDirty()
+{
+    invalidateMeasure();
+    markAsDirty();
+}
+
 void HeaderFooterLayout::performLayout()
 {
     if (!isComponentComplete() || m_performingLayout) {
         return;
     }
 
-    m_isDirty = false;
     m_performingLayout = true;
+    Kirigami::Platform::PerformanceCounters::count(Kirigami::Platform::PerformanceCounters::LayoutPass);
 
     // Implicit size has to be updated first, as it may propagate to the
-    // actual size which will be used below during layouting.
-    updateImplicitSize();
+    // actual size which will be used below during layouting. Implicit size
+    // changes of nested layouts while measuring are picked up right away, so
+    // we are only marked dirty again by what happens while arranging.
+    ensureMeasured();
+    m_isDirty = false;
 
     const QSizeF newSize = size();
     qreal headerHeight = 0;
@@ -206,10 +212,26 @@ void HeaderFooterLayout::performLayout()
     }
 
     m_performingLayout = false;
+
+    // Nested layouts now have their final size, so arrange them right away
+    // instead of waiting for their own polish, which would otherwise run after
+    // ours and might require us to lay out again in the same frame.
+    for (QQuickItem *item : {m_header.data(), m_contentItem.data(), m_footer.data()}) {
+        if (auto nested = qobject_cast<HeaderFooterLayout *>(item); nested && nested->m_isDirty) {
+            nested->performLayout();
+        }
+    }
 }
 
-void HeaderFooterLayout::updateImplicitSize()
+void HeaderFooterLayout::updateMeasure()
 {
+    // Measure nested layouts first, bottom-up, so that their implicit size
+    // change is seen here before our own implicit size is computed, rather
+    // than in another polish pass.
+    MeasurableLayout::ensureMeasured(m_header);
+    MeasurableLayout::ensureMeasured(m_contentItem);
+    MeasurableLayout::ensureMeasured(m_footer);
+
     qreal impWidth = 0;
     qreal impHeight = 0;
 
@@ -228,12 +250,17 @@ void HeaderFooterLayout::updateImplicitSize()
     setImplicitSize(impWidth, impHeight);
 }
 
+void HeaderFooterLayout::connectItem(QQuickItem *item)
+{
+    connect(item, &QQuickItem::implicitWidthChanged, this, &HeaderFooterLayout::markImplicitSizeDirty);
+    connect(item, &QQuickItem::implicitHeightChanged, this, &HeaderFooterLayout::markImplicitSizeDirty);
+    connect(item, &QQuickItem::visibleChanged, this, &HeaderFooterLayout::markImplicitSizeDirty);
+}
+
 void HeaderFooterLayout::disconnectItem(QQuickItem *item)
 {
     if (item) {
-        disconnect(item, &QQuickItem::implicitWidthChanged, this, &HeaderFooterLayout::markAsDirty);
-        disconnect(item, &QQuickItem::implicitHeightChanged, this, &HeaderFooterLayout::markAsDirty);
-        disconnect(item, &QQuickItem::visibleChanged, this, &HeaderFooterLayout::markAsDirty);
+        disconnect(item, nullptr, this, nullptr);
     }
 }
 
@@ -10,6 +10,8 @@
 #include <QQuickItem>
 #include <qtmetamacros.h>
 
+#include "measurablelayout_p.h"
+
 /**
  * replicates a little part of what Page does,
  * It's a container with 3 properties, header, contentItem and footer
@@ -18,10 +20,11 @@
  * user, which would require ugly reparenting dances and container items to
  * maintain the layout well behaving.
  */
-class HeaderFooterLayout : public QQuickItem
+class HeaderFooterLayout : public QQuickItem, public MeasurableLayout
 {
     Q_OBJECT
     QML_ELEMENT
+    Q_INTERFACES(MeasurableLayout)
     /**
      * @brief This property holds the page header item.
      *
@@ -75,11 +78,13 @@ protected:
     void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
     void componentComplete() override;
     void updatePolish() override;
+    void updateMeasure() override;
 
 private:
     void markAsDirty();
+    void markImplicitSizeDirty();
     void performLayout();
-    void updateImplicitSize();
+    void connectItem(QQuickItem *item);
     void disconnectItem(QQuickItem *item);
 
     QPointer<QQuickItem> m_header;
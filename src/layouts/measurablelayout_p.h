@@ -0,0 +1,82 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QQuickItem>
+
+/**
+ * Measuring protocol shared by the layouts in this module.
+ *
+ * Layouts normally compute their implicit size while polishing, so a parent
+ * layout that is polished before its children sees their outdated implicit
+ * size and has to lay out again once they are polished. Layouts implementing
+ * this interface keep the measuring separate from arranging their items: the
+ * implicit size acts as the cached result, which is only computed again after
+ * invalidateMeasure() has been called. A parent can then bring the implicit
+ * size of a child up to date with ensureMeasured() before reading it, without
+ * triggering the full layout of that child.
+ */
+class MeasurableLayout
+{
+public:
+    virtual ~MeasurableLayout() = default;
+
+    /**
+     * Mark the implicit size as outdated, for instance because the implicit
+     * size of one of the items changed. This does not schedule a polish.
+     */
+    void invalidateMeasure()
+    {
+        m_measureValid = false;
+    }
+
+    bool isMeasureValid() const
+    {
+        return m_measureValid;
+    }
+
+    /**
+     * Update the implicit size if it has been invalidated since it was last
+     * computed.
+     */
+    void ensureMeasured()
+    {
+        if (!m_measureValid) {
+            updateMeasure();
+            // Set afterwards, as measuring the items may invalidate the
+            // measure again while their changes have been taken into account.
+            m_measureValid = true;
+        }
+    }
+
+    /**
+     * Update the implicit size of @p item if it implements this interface.
+     * This does nothing for any other item.
+     */
+    static void ensureMeasured(QQuickItem *item);
+
+protected:
+    /**
+     * Compute the implicit size from the items of the layout and apply it.
+     * Implementations should make sure the items they contain are measured
+     * first, using ensureMeasured().
+     */
+    virtual void updateMeasure() = 0;
+
+private:
+    bool m_measureValid = false;
+};
+
+Q_DECLARE_INTERFACE(MeasurableLayout, "org.kde.kirigami.layouts.MeasurableLayout")
+
+inline void MeasurableLayout::ensureMeasured(QQuickItem *item)
+{
+    if (auto layout = qobject_cast<MeasurableLayout *>(item)) {
+        layout->ensureMeasured();
+    }
+}
@@ -11,6 +11,8 @@
 #include <qnumeric.h>
 #include <qtypes.h>
 
+#include "platform/performancecounters_p.h"
+
 class PaddingPrivate
 {
     Padding *const q;
@@ -51,6 +53,8 @@ public:
 
 void PaddingPrivate::calculateImplicitSize()
 {
+    MeasurableLayout::ensureMeasured(m_contentItem);
+
     qreal impWidth = 0;
     qreal impHeight = 0;
 
@@ -103,11 +107,7 @@ void PaddingPrivate::signalPaddings(const QMarginsF &oldPaddings, Paddings which
 void PaddingPrivate::disconnect()
 {
     if (m_contentItem) {
-        QObject::disconnect(m_contentItem, &QQuickItem::implicitWidthChanged, q, &Padding::polish);
-        QObject::disconnect(m_contentItem, &QQuickItem::implicitHeightChanged, q, &Padding::polish);
-        QObject::disconnect(m_contentItem, &QQuickItem::visibleChanged, q, &Padding::polish);
-        QObject::disconnect(m_contentItem, &QQuickItem::implicitWidthChanged, q, &Padding::implicitContentWidthChanged);
-        QObject::disconnect(m_contentItem, &QQuickItem::implicitHeightChanged, q, &Padding::implicitContentHeightChanged);
+        QObject::disconnect(m_contentItem, nullptr, q, nullptr);
     }
 }
 
@@ -142,13 +142,18 @@ void Padding::setContentItem(QQuickItem *item)
 
     if (d->m_contentItem) {
         d->m_contentItem->setParentItem(this);
-        connect(d->m_contentItem, &QQuickItem::implicitWidthChanged, this, &Padding::polish);
-        connect(d->m_contentItem, &QQuickItem::implicitHeightChanged, this, &Padding::polish);
-        connect(d->m_contentItem, &QQuickItem::visibleChanged, this, &Padding::polish);
+        const auto markImplicitSizeDirty = [this]() {
+            invalidateMeasure();
+            polish();
+        };
+        connect(d->m_contentItem, &QQuickItem::implicitWidthChanged, this, markImplicitSizeDirty);
+        connect(d->m_contentItem, &QQuickItem::implicitHeightChanged, this, markImplicitSizeDirty);
+        connect(d->m_contentItem, &QQuickItem::visibleChanged, this, markImplicitSizeDirty);
         connect(d->m_contentItem, &QQuickItem::implicitWidthChanged, this, &Padding::implicitContentWidthChanged);
         connect(d->m_contentItem, &QQuickItem::implicitHeightChanged, this, &Padding::implicitContentHeightChanged);
     }
 
+    invalidateMeasure();
     polish();
 
     Q_EMIT contentItemChanged();
@@ -174,6 +179,7 @@ void Padding::setPadding(qreal padding)
 
     d->signalPaddings(oldPadding, PaddingPrivate::All);
 
+    invalidateMeasure();
     polish();
 }
 
@@ -190,6 +196,7 @@ void Padding::resetPadding()
 
     d->signalPaddings(oldPadding, PaddingPrivate::All);
 
+    invalidateMeasure();
     polish();
 }
 
@@ -209,6 +216,7 @@ void Padding::setHorizontalPadding(qreal padding)
 
     d->signalPaddings(oldPadding, PaddingPrivate::Horizontal);
 
+    invalidateMeasure();
     polish();
 }
 
@@ -223,6 +231,7 @@ void Padding::resetHorizontalPadding()
 
     d->signalPaddings(oldPadding, PaddingPrivate::Horizontal);
 
+    invalidateMeasure();
     polish();
 }
 
@@ -242,6 +251,7 @@ void Padding::setVerticalPadding(qreal padding)
 
     d->signalPaddings(oldPadding, PaddingPrivate::Vertical);
 
+    invalidateMeasure();
     polish();
 }
 
@@ -256,6 +266,7 @@ void Padding::resetVerticalPadding()
 
     d->signalPaddings(oldPadding, PaddingPrivate::Vertical);
 
+    invalidateMeasure();
     polish();
 }
 
@@ -275,6 +286,7 @@ void Padding::setLeftPadding(qreal padding)
 
     d->signalPaddings(oldPadding, PaddingPrivate::Left);
 
+    invalidateMeasure();
     polish();
 }
 
@@ -289,6 +301,7 @@ void Padding::resetLeftPadding()
 
     d->signalPaddings(oldPadding, PaddingPrivate::Left);
 
+    invalidateMeasure();
     polish();
 }
 
@@ -312,6 +325,7 @@ void Padding::setTopPadding(qreal padding)
 
     d->signalPaddings(oldPadding, PaddingPrivate::Top);
 
+    invalidateMeasure();
     polish();
 }
 
@@ -326,6 +340,7 @@ void Padding::resetTopPadding()
 
     d->signalPaddings(oldPadding, PaddingPrivate::Top);
 
+    invalidateMeasure();
     polish();
 }
 
@@ -349,6 +364,7 @@ void Padding::setRightPadding(qreal padding)
 
     d->signalPaddings(oldPadding, PaddingPrivate::Right);
 
+    invalidateMeasure();
     polish();
 }
 
@@ -363,6 +379,7 @@ void Padding::resetRightPadding()
 
     d->signalPaddings(oldPadding, PaddingPrivate::Right);
 
+    invalidateMeasure();
     polish();
 }
 
@@ -386,6 +403,7 @@ void Padding::setBottomPadding(qreal padding)
 
     d->signalPaddings(oldPadding, PaddingPrivate::Bottom);
 
+    invalidateMeasure();
     polish();
 }
 
@@ -400,6 +418,7 @@ void Padding::resetBottomPadding()
 
     d->signalPaddings(oldPadding, PaddingPrivate::Bottom);
 
+    invalidateMeasure();
     polish();
 }
 
@@ -453,7 +472,11 @@ void Padding::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometr
 
 void Padding::updatePolish()
 {
-    d->calculateImplicitSize();
+    Kirigami::Platform::PerformanceCounters::count(Kirigami::Platform::PerformanceCounters::LayoutPass);
+
+    // The implicit size only needs updating if the content or the paddings
+    // changed, not when just being resized.
+    ensureMeasured();
     if (!d->m_contentItem) {
         return;
     }
@@ -469,4 +492,9 @@ void Padding::componentComplete()
     updatePolish();
 }
 
+void Padding::updateMeasure()
+{
+    d->calculateImplicitSize();
+}
+
 #include "moc_padding.cpp"
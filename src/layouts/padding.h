@@ -10,6 +10,8 @@
 #include <QQuickItem>
 #include <qtmetamacros.h>
 
+#include "measurablelayout_p.h"
+
 class PaddingPrivate;
 
 /**
@@ -57,10 +59,11 @@ class PaddingPrivate;
  *
  * @since KDE Frameworks 6.0
  */
-class Padding : public QQuickItem
+class Padding : public QQuickItem, public MeasurableLayout
 {
     Q_OBJECT
     QML_ELEMENT
+    Q_INTERFACES(MeasurableLayout)
 
     /**
      * @brief This property holds the visual content Item.
@@ -204,6 +207,7 @@ protected:
     void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
     void updatePolish() override;
     void componentComplete() override;
+    void updateMeasure() override;
 
 private:
     friend class PaddingPrivate;
@@ -4,15 +4,13 @@
  *  SPDX-License-Identifier: LGPL-2.0-or-later
  */
 
-#include <QQmlProperty>
-
 #include "sizegroup.h"
+#include "measurablelayout_p.h"
 
 #define pThis (static_cast<SizeGroup *>(prop->object))
 
 void SizeGroup::appendItem(QQmlListProperty<QQuickItem> *prop, QQuickItem *value)
 {
-    pThis->m_items << value;
     pThis->connectItem(value);
 }
 
@@ -23,28 +21,32 @@ qsizetype SizeGroup::itemCount(QQmlListProperty<QQuickItem> *prop)
 
 QQuickItem *SizeGroup::itemAt(QQmlListProperty<QQuickItem> *prop, qsizetype index)
 {
-    return pThis->m_items[index];
+    return pThis->m_items[index].item;
 }
 
 void SizeGroup::clearItems(QQmlListProperty<QQuickItem> *prop)
 {
-    for (const auto &item : std::as_const(pThis->m_items)) {
-        QObject::disconnect(pThis->m_connections[item].first);
-        QObject::disconnect(pThis->m_connections[item].second);
+    for (const auto &groupItem : std::as_const(pThis->m_items)) {
+        QObject::disconnect(groupItem.implicitWidthConnection);
+        QObject::disconnect(groupItem.implicitHeightConnection);
     }
     pThis->m_items.clear();
 }
 
 void SizeGroup::connectItem(QQuickItem *item)
 {
-    auto conn1 = connect(item, &QQuickItem::implicitWidthChanged, this, [this]() {
-        adjustItems(Mode::Width);
-    });
-    auto conn2 = connect(item, &QQuickItem::implicitHeightChanged, this, [this]() {
-        adjustItems(Mode::Height);
-    });
-    m_connections[item] = qMakePair(conn1, conn2);
-    adjustItems(m_mode);
+    GroupItem groupItem;
+    groupItem.item = item;
+    if (item) {
+        groupItem.implicitWidthConnection = connect(item, &QQuickItem::implicitWidthChanged, this, [this]() {
+            scheduleAdjustItems(Mode::Width);
+        });
+        groupItem.implicitHeightConnection = connect(item, &QQuickItem::implicitHeightChanged, this, [this]() {
+            scheduleAdjustItems(Mode::Height);
+        });
+    }
+    m_items << groupItem;
+    scheduleAdjustItems(m_mode);
 }
 
 QQmlListProperty<QQuickItem> SizeGroup::items()
@@ -67,6 +69,49 @@ void SizeGroup::componentComplete()
     adjustItems(Mode::Both);
 }
 
+void SizeGroup::scheduleAdjustItems(Mode whatChanged)
+{
+    m_pendingChanges |= whatChanged;
+
+    if (m_adjustScheduled) {
+        return;
+    }
+
+    m_adjustScheduled = true;
+    QMetaObject::invokeMethod(this, &SizeGroup::adjustPendingItems, Qt::QueuedConnection);
+}
+
+void SizeGroup::adjustPendingItems()
+{
+    const Modes changes = m_pendingChanges;
+    m_adjustScheduled = false;
+    m_pendingChanges = {};
+
+    if (changes == Modes(Mode::Both)) {
+        adjustItems(Mode::Both);
+    } else if (changes.testFlag(Mode::Width)) {
+        adjustItems(Mode::Width);
+    } else if (changes.testFlag(Mode::Height)) {
+        adjustItems(Mode::Height);
+    }
+}
+
+bool SizeGroup::resolveProperties(GroupItem &groupItem)
+{
+    if (groupItem.preferredWidth.isValid() && groupItem.preferredHeight.isValid()) {
+        return true;
+    }
+
+    QQuickItem *item = groupItem.item;
+    if (!qmlEngine(item) || !qmlContext(item)) {
+        return false;
+    }
+
+    groupItem.preferredWidth = QQmlProperty(item, QStringLiteral("Layout.preferredWidth"), qmlContext(item));
+    groupItem.preferredHeight = QQmlProperty(item, QStringLiteral("Layout.preferredHeight"), qmlContext(item));
+    return groupItem.preferredWidth.isValid() && groupItem.preferredHeight.isValid();
+}
+
 void SizeGroup::adjustItems(Mode whatChanged)
 {
     if (m_mode == Mode::Width && whatChanged == Mode::Height) {
@@ -79,11 +124,14 @@ void SizeGroup::adjustItems(Mode whatChanged)
     qreal maxHeight = 0.0;
     qreal maxWidth = 0.0;
 
-    for (const auto &item : std::as_const(m_items)) {
+    for (const auto &groupItem : std::as_const(m_items)) {
+        QQuickItem *item = groupItem.item;
         if (item == nullptr) {
             continue;
         }
 
+        MeasurableLayout::ensureMeasured(item);
+
         switch (m_mode) {
         case Mode::Width:
             maxWidth = qMax(maxWidth, item->implicitWidth());
@@ -100,25 +148,25 @@ void SizeGroup::adjustItems(Mode whatChanged)
         }
     }
 
-    for (const auto &item : std::as_const(m_items)) {
-        if (item == nullptr) {
+    for (auto &groupItem : m_items) {
+        if (groupItem.item == nullptr) {
             continue;
         }
 
-        if (!qmlEngine(item) || !qmlContext(item)) {
+        if (!resolveProperties(groupItem)) {
             continue;
         }
 
         switch (m_mode) {
         case Mode::Width:
-            QQmlProperty(item, QStringLiteral("Layout.preferredWidth"), qmlContext(item)).write(maxWidth);
+            groupItem.preferredWidth.write(maxWidth);
             break;
         case Mode::Height:
-            QQmlProperty(item, QStringLiteral("Layout.preferredHeight"), qmlContext(item)).write(maxHeight);
+            groupItem.preferredHeight.write(maxHeight);
             break;
         case Mode::Both:
-            QQmlProperty(item, QStringLiteral("Layout.preferredWidth"), qmlContext(item)).write(maxWidth);
-            QQmlProperty(item, QStringLiteral("Layout.preferredHeight"), qmlContext(item)).write(maxHeight);
+            groupItem.preferredWidth.write(maxWidth);
+            groupItem.preferredHeight.write(maxHeight);
             break;
         case Mode::None:
             break;
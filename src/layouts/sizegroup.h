@@ -6,16 +6,18 @@
 
 #pragma once
 
-#include <QMap>
 #include <QObject>
-#include <QPair>
 #include <QPointer>
 #include <QQmlListProperty>
 #include <QQmlParserStatus>
+#include <QQmlProperty>
 #include <QQuickItem>
 
 /**
  * SizeGroup is a utility object that makes groups of items request the same size.
+ *
+ * Changes to the implicit sizes of the items are collected and applied
+ * together once per event loop iteration.
  */
 class SizeGroup : public QObject, public QQmlParserStatus
 {
@@ -34,9 +36,19 @@ public:
     Q_DECLARE_FLAGS(Modes, Mode)
 
 private:
+    struct GroupItem {
+        QPointer<QQuickItem> item;
+        QMetaObject::Connection implicitWidthConnection;
+        QMetaObject::Connection implicitHeightConnection;
+        // Resolved once, as looking up attached properties by name is expensive
+        QQmlProperty preferredWidth;
+        QQmlProperty preferredHeight;
+    };
+
     Mode m_mode = None;
-    QList<QPointer<QQuickItem>> m_items;
-    QMap<QQuickItem *, QPair<QMetaObject::Connection, QMetaObject::Connection>> m_connections;
+    QList<GroupItem> m_items;
+    Modes m_pendingChanges;
+    bool m_adjustScheduled = false;
 
 public:
     /**
@@ -72,4 +84,8 @@ private:
     static qsizetype itemCount(QQmlListProperty<QQuickItem> *prop);
     static QQuickItem *itemAt(QQmlListProperty<QQuickItem> *prop, qsizetype index);
     static void clearItems(QQmlListProperty<QQuickItem> *prop);
+
+    void scheduleAdjustItems(Mode whatChanged);
+    void adjustPendingItems();
+    static bool resolveProperties(GroupItem &groupItem);
 };
@@ -6,15 +6,20 @@
 
 #include "toolbarlayout.h"
 
+#include <algorithm>
 #include <cmath>
 #include <unordered_map>
+#include <vector>
 
 #include <QDeadlineTimer>
 #include <QQmlComponent>
 #include <QTimer>
 
 #include "loggingcategory.h"
+#include "platform/performancecounters_p.h"
+#include "platform/tracescope_p.h"
 #include "toolbarlayoutdelegate.h"
+#include "tracelogging.h"
 
 ToolBarLayoutAttached::ToolBarLayoutAttached(QObject *parent)
     : QObject(parent)
@@ -28,7 +33,12 @@ QObject *ToolBarLayoutAttached::action() const
 
 void ToolBarLayoutAttached::setAction(QObject *action)
 {
+    if (action == m_action) {
+        return;
+    }
+
     m_action = action;
+    Q_EMIT actionChanged();
 }
 
 class ToolBarLayoutPrivate
@@ -52,9 +62,28 @@ public:
     void performLayout();
     QList<ToolBarLayoutDelegate *> createDelegates();
     ToolBarLayoutDelegate *createDelegate(QObject *action);
+    QQmlComponent *fullComponentFor(QObject *action) const;
+    void setDeferredActions(const QList<QObject *> &newDeferredActions);
+    void mergeDeferredActions();
+    void recycleDelegate(QObject *action);
     qreal layoutStart(qreal layoutWidth);
     void maybeHideDelegate(int index, qreal &currentWidth, qreal totalWidth);
 
+    // The outcome of calculateImplicitSize() for a given width.
+    struct LayoutResult {
+        enum DelegateState : quint8 {
+            Hidden,
+            Icon,
+            Full,
+        };
+        QList<DelegateState> states;
+        QList<QObject *> hiddenActions;
+        qreal visibleActionsWidth = 0.0;
+        QSizeF implicitSize;
+    };
+    void storeLayoutResult(const QSizeF &implicitSize);
+    bool applyLayoutResult();
+
     QList<QObject *> actions;
     ToolBarLayout::ActionsProperty actionsProperty;
     QList<QObject *> hiddenActions;
@@ -74,7 +103,17 @@ public:
     bool implicitSizeValid = false;
 
     std::unordered_map<QObject *, std::unique_ptr<ToolBarLayoutDelegate>> delegates;
+    // Delegates of removed actions, kept to be reused for new actions.
+    std::vector<std::unique_ptr<ToolBarLayoutDelegate>> recycledDelegates;
     QList<ToolBarLayoutDelegate *> sortedDelegates;
+    // Actions that are known to end up in the overflow menu, which have no
+    // delegate until that changes.
+    QList<QObject *> deferredActions;
+    // The width the deferred actions would take, including spacing.
+    qreal deferredActionsWidth = 0.0;
+    // Only depends on the width as long as nothing else changes, which is
+    // what happens while a window is being resized.
+    QHash<qreal, LayoutResult> layoutResults;
     QQuickItem *moreButtonInstance = nullptr;
     ToolBarDelegateIncubator *moreButtonIncubator = nullptr;
     bool shouldShowMoreButton = false;
@@ -111,7 +150,7 @@ ToolBarLayout::ToolBarLayout(QQuickItem *parent)
     connect(d->removalTimer, &QTimer::timeout, this, [this]() {
         for (auto action : std::as_const(d->removedActions)) {
             if (!d->actions.contains(action)) {
-                d->delegates.erase(action);
+                d->recycleDelegate(action);
             }
         }
         d->removedActions.clear();
@@ -140,8 +179,17 @@ void ToolBarLayout::addAction(QObject *action)
         if (itr != d->delegates.end()) {
             d->delegates.erase(itr);
         }
+        // Recycled delegates keep their action until they are reused.
+        auto &recycled = d->recycledDelegates;
+        recycled.erase(std::remove_if(recycled.begin(),
+                                      recycled.end(),
+                                      [action](const std::unique_ptr<ToolBarLayoutDelegate> &delegate) {
+                                          return delegate->action() == action;
+                                      }),
+                       recycled.end());
 
         d->actions.removeOne(action);
+        d->deferredActions.removeOne(action);
         d->actionsChanged = true;
 
         relayout();
@@ -160,6 +208,9 @@ void ToolBarLayout::removeAction(QObject *action)
     d->actions.removeOne(action);
     d->removedActions.append(action);
     d->removalTimer->start();
+    if (d->deferredActions.removeOne(action)) {
+        QObject::disconnect(action, nullptr, this, SLOT(relayout()));
+    }
     d->actionsChanged = true;
 
     relayout();
@@ -176,6 +227,7 @@ void ToolBarLayout::clearActions()
 
     d->removedActions.append(d->actions);
     d->actions.clear();
+    d->setDeferredActions({});
     d->actionsChanged = true;
 
     relayout();
@@ -199,6 +251,7 @@ void ToolBarLayout::setFullDelegate(QQmlComponent *newFullDelegate)
 
     d->fullDelegate = newFullDelegate;
     d->delegates.clear();
+    d->recycledDelegates.clear();
     relayout();
     Q_EMIT fullDelegateChanged();
 }
@@ -216,6 +269,7 @@ void ToolBarLayout::setIconDelegate(QQmlComponent *newIconDelegate)
 
     d->iconDelegate = newIconDelegate;
     d->delegates.clear();
+    d->recycledDelegates.clear();
     relayout();
     Q_EMIT iconDelegateChanged();
 }
@@ -233,6 +287,7 @@ void ToolBarLayout::setSeparatorDelegate(QQmlComponent *newSeparatorDelegate)
 
     d->separatorDelegate = newSeparatorDelegate;
     d->delegates.clear();
+    d->recycledDelegates.clear();
     relayout();
     Q_EMIT separatorDelegateChanged();
 }
@@ -334,6 +389,8 @@ void ToolBarLayout::setHeightMode(HeightMode newHeightMode)
 void ToolBarLayout::relayout()
 {
     d->implicitSizeValid = false;
+    d->sortedDelegates.clear();
+    d->layoutResults.clear();
     polish();
 }
 
@@ -348,7 +405,14 @@ void ToolBarLayout::geometryChange(const QRectF &newGeometry, const QRectF &oldG
 {
     if (newGeometry != oldGeometry) {
         if (newGeometry.size() != QSizeF{implicitWidth(), implicitHeight()}) {
-            relayout();
+            // A different size does not change the delegates, so previous
+            // layout results remain valid.
+            d->implicitSizeValid = false;
+            if (!d->deferredActions.isEmpty() && newGeometry.width() > oldGeometry.width()) {
+                // Some of the deferred actions may fit now.
+                d->sortedDelegates.clear();
+            }
+            polish();
         } else {
             polish();
         }
@@ -399,10 +463,13 @@ void ToolBarLayoutPrivate::calculateImplicitSize()
         return;
     }
 
+    const QList<QObject *> oldHiddenActions = hiddenActions;
     hiddenActions.clear();
     firstHiddenIndex = -1;
 
-    sortedDelegates = createDelegates();
+    if (sortedDelegates.isEmpty()) {
+        sortedDelegates = createDelegates();
+    }
 
     bool ready = std::all_of(delegates.cbegin(), delegates.cend(), [](const std::pair<QObject *const, std::unique_ptr<ToolBarLayoutDelegate>> &entry) {
         return entry.second->isReady();
@@ -411,6 +478,15 @@ void ToolBarLayoutPrivate::calculateImplicitSize()
         return;
     }
 
+    if (applyLayoutResult()) {
+        if (hiddenActions != oldHiddenActions) {
+            Q_EMIT q->hiddenActionsChanged();
+        }
+        implicitSizeValid = true;
+        q->polish();
+        return;
+    }
+
     qreal maxHeight = 0.0;
     qreal maxWidth = 0.0;
 
@@ -435,16 +511,20 @@ void ToolBarLayoutPrivate::calculateImplicitSize()
             entry->showFull();
         }
 
+        ToolBarActionMetrics::setWidth(entry->action(), entry->fullComponent(), entry->width());
         maxWidth += entry->width() + spacing;
         maxHeight = std::max(maxHeight, entry->maxHeight());
     }
 
+    maxWidth += deferredActionsWidth;
+
     // The last entry also gets spacing but shouldn't, so remove that.
     maxWidth -= spacing;
 
     visibleActionsWidth = 0.0;
 
-    if (maxWidth > q->width() - (hiddenActions.isEmpty() ? 0.0 : moreButtonInstance->width() + spacing)) {
+    const bool hasHiddenActions = !hiddenActions.isEmpty() || !deferredActions.isEmpty();
+    if (maxWidth > q->width() - (hasHiddenActions ? moreButtonInstance->width() + spacing : 0.0)) {
         // We have more items than fit into the view, so start hiding some.
 
         qreal layoutWidth = q->width() - (moreButtonInstance->width() + spacing);
@@ -472,12 +552,18 @@ void ToolBarLayoutPrivate::calculateImplicitSize()
         visibleActionsWidth = maxWidth;
     }
 
+    mergeDeferredActions();
+
     if (!hiddenActions.isEmpty()) {
         maxHeight = std::max(maxHeight, moreButtonInstance->implicitHeight());
     };
 
     q->setImplicitSize(maxWidth, maxHeight);
-    Q_EMIT q->hiddenActionsChanged();
+    if (hiddenActions != oldHiddenActions) {
+        Q_EMIT q->hiddenActionsChanged();
+    }
+
+    storeLayoutResult(QSizeF{maxWidth, maxHeight});
 
     implicitSizeValid = true;
 
@@ -490,6 +576,11 @@ void ToolBarLayoutPrivate::performLayout()
         return;
     }
 
+    TraceScope trace(KirigamiLayoutsTrace(), "ToolBarLayout::performLayout");
+    trace.addArgument("actions", actions.count());
+    trace.addArgument("width", q->width());
+    Kirigami::Platform::PerformanceCounters::count(Kirigami::Platform::PerformanceCounters::LayoutPass);
+
     if (!implicitSizeValid) {
         calculateImplicitSize();
     }
@@ -582,25 +673,125 @@ void ToolBarLayoutPrivate::performLayout()
         Q_EMIT q->actionsChanged();
         actionsChanged = false;
     }
+}
+
+void ToolBarLayoutPrivate::storeLayoutResult(const QSizeF &implicitSize)
+{
+    // Keep the cache bounded when resizing continuously through many widths.
+    static constexpr qsizetype maximumLayoutResults = 64;
+    if (layoutResults.size() >= maximumLayoutResults) {
+        layoutResults.clear();
+    }
 
-    sortedDelegates.clear();
+    LayoutResult result;
+    result.states.reserve(sortedDelegates.size());
+    for (auto delegate : std::as_const(sortedDelegates)) {
+        if (!delegate->isVisible()) {
+            result.states.append(LayoutResult::Hidden);
+        } else if (delegate->isIconVisible()) {
+            result.states.append(LayoutResult::Icon);
+        } else {
+            result.states.append(LayoutResult::Full);
+        }
+    }
+    result.hiddenActions = hiddenActions;
+    result.visibleActionsWidth = visibleActionsWidth;
+    result.implicitSize = implicitSize;
+
+    layoutResults.insert(q->width(), result);
+}
+
+bool ToolBarLayoutPrivate::applyLayoutResult()
+{
+    auto itr = layoutResults.constFind(q->width());
+    if (itr == layoutResults.constEnd() || itr->states.size() != sortedDelegates.size()) {
+        return false;
+    }
+
+    for (int i = 0; i < sortedDelegates.size(); ++i) {
+        auto delegate = sortedDelegates.at(i);
+        switch (itr->states.at(i)) {
+        case LayoutResult::Hidden:
+            delegate->hide();
+            break;
+        case LayoutResult::Icon:
+            delegate->showIcon();
+            break;
+        case LayoutResult::Full:
+            delegate->showFull();
+            break;
+        }
+    }
+
+    hiddenActions = itr->hiddenActions;
+    visibleActionsWidth = itr->visibleActionsWidth;
+    q->setImplicitSize(itr->implicitSize.width(), itr->implicitSize.height());
+    return true;
 }
 
 QList<ToolBarLayoutDelegate *> ToolBarLayoutPrivate::createDelegates()
 {
     QList<ToolBarLayoutDelegate *> result;
+    QList<QObject *> newDeferredActions;
+    deferredActionsWidth = 0.0;
+
+    // Where each action starts, using the widths actions had in other
+    // layouts. Unknown widths count as zero, so this never overestimates.
+    qreal x = 0.0;
+    // KeepVisible actions may hide earlier actions to make room, after which
+    // later actions may fit again.
+    bool keepVisibleSeen = false;
+
     for (auto action : std::as_const(actions)) {
-        if (delegates.find(action) != delegates.end()) {
-            result.append(delegates.at(action).get());
-        } else if (action) {
-            auto delegate = std::unique_ptr<ToolBarLayoutDelegate>(createDelegate(action));
-            if (delegate) {
-                result.append(delegate.get());
-                delegates.emplace(action, std::move(delegate));
+        if (!action) {
+            continue;
+        }
+
+        auto itr = delegates.find(action);
+        if (itr != delegates.end()) {
+            auto delegate = itr->second.get();
+            result.append(delegate);
+            if (delegate->isActionVisible() && !delegate->isHidden()) {
+                x += std::max(ToolBarActionMetrics::width(action, delegate->fullComponent()), 0.0) + spacing;
+                keepVisibleSeen = keepVisibleSeen || delegate->isKeepVisible();
+            }
+            continue;
+        }
+
+        // Invisible actions take no space, but need a delegate to notice when
+        // they become visible.
+        const auto visible = action->property("visible");
+        if (!visible.isValid() || visible.toBool()) {
+            const auto hints = DisplayHint::displayHints(action);
+            const qreal width = ToolBarActionMetrics::width(action, fullComponentFor(action));
+            const bool keepVisible = DisplayHint::isDisplayHintSet(hints, DisplayHint::KeepVisible);
+
+            if (DisplayHint::isDisplayHintSet(hints, DisplayHint::AlwaysHide)) {
+                newDeferredActions.append(action);
+                continue;
+            }
+
+            // Actions that do not fit in the width of the layout are always
+            // moved to the overflow menu by maybeHideDelegate().
+            if (!keepVisible && !keepVisibleSeen && width >= 0.0 && q->width() > 0.0 && x + width > q->width()) {
+                newDeferredActions.append(action);
+                deferredActionsWidth += width + spacing;
+                continue;
             }
+
+            x += std::max(width, 0.0) + spacing;
+            keepVisibleSeen = keepVisibleSeen || keepVisible;
+        }
+
+        auto delegate = std::unique_ptr<ToolBarLayoutDelegate>(createDelegate(action));
+        if (delegate) {
+            result.append(delegate.get());
+            delegates.emplace(action, std::move(delegate));
         }
     }
 
+    setDeferredActions(newDeferredActions);
+
     if (!moreButtonInstance && !moreButtonIncubator) {
         moreButtonIncubator = new ToolBarDelegateIncubator(moreButton, qmlContext(moreButton));
         moreButtonIncubator->setStateCallback([this](QQuickItem *item) {
@@ -614,6 +805,10 @@ QList<ToolBarLayoutDelegate *> ToolBarLayoutPrivate::createDelegates()
                 moreButtonInstance->setVisible(shouldShowMoreButton);
             });
             QObject::connect(moreButtonInstance, &QQuickItem::widthChanged, q, &ToolBarLayout::minimumWidthChanged);
+            QObject::connect(moreButtonInstance, &QQuickItem::widthChanged, q, [this]() {
+                // The space reserved for the more button is part of every layout result.
+                layoutResults.clear();
+            });
             q->relayout();
             Q_EMIT q->minimumWidthChanged();
 
@@ -628,7 +823,7 @@ QList<ToolBarLayoutDelegate *> ToolBarLayoutPrivate::createDelegates()
     return result;
 }
 
-ToolBarLayoutDelegate *ToolBarLayoutPrivate::createDelegate(QObject *action)
+QQmlComponent *ToolBarLayoutPrivate::fullComponentFor(QObject *action) const
 {
     QQmlComponent *fullComponent = nullptr;
     auto displayComponent = action->property("displayComponent");
@@ -645,6 +840,74 @@ ToolBarLayoutDelegate *ToolBarLayoutPrivate::createDelegate(QObject *action)
         fullComponent = separatorDelegate;
     }
 
+    return fullComponent;
+}
+
+void ToolBarLayoutPrivate::setDeferredActions(const QList<QObject *> &newDeferredActions)
+{
+    if (newDeferredActions == deferredActions) {
+        return;
+    }
+
+    // Without a delegate, nothing else notices these actions changing in a way
+    // that may need one.
+    for (auto action : std::as_const(deferredActions)) {
+        if (!newDeferredActions.contains(action)) {
+            QObject::disconnect(action, nullptr, q, SLOT(relayout()));
+        }
+    }
+    for (auto action : newDeferredActions) {
+        if (deferredActions.contains(action)) {
+            continue;
+        }
+        if (action->property("visible").isValid()) {
+            QObject::connect(action, SIGNAL(visibleChanged()), q, SLOT(relayout()), Qt::UniqueConnection);
+        }
+        if (action->property("displayHint").isValid()) {
+            QObject::connect(action, SIGNAL(displayHintChanged()), q, SLOT(relayout()), Qt::UniqueConnection);
+        }
+    }
+
+    deferredActions = newDeferredActions;
+    layoutResults.clear();
+}
+
+void ToolBarLayoutPrivate::mergeDeferredActions()
+{
+    if (deferredActions.isEmpty()) {
+        return;
+    }
+
+    // Keep the overflow menu in the order of the actions.
+    QList<QObject *> merged;
+    merged.reserve(hiddenActions.size() + deferredActions.size());
+    for (auto action : std::as_const(actions)) {
+        if (deferredActions.contains(action) || hiddenActions.contains(action)) {
+            merged.append(action);
+        }
+    }
+    hiddenActions = merged;
+}
+
+ToolBarLayoutDelegate *ToolBarLayoutPrivate::createDelegate(QObject *action)
+{
+    QQmlComponent *fullComponent = fullComponentFor(action);
+
+    // Reuse the items of a removed action if they were created from the same
+    // components. Only the shared delegates are reused, as items created from
+    // an action's displayComponent may rely on that specific action.
+    if (fullComponent == fullDelegate || fullComponent == separatorDelegate) {
+        auto itr = std::find_if(recycledDelegates.begin(), recycledDelegates.end(), [fullComponent](const std::unique_ptr<ToolBarLayoutDelegate> &delegate) {
+            return delegate->fullComponent() == fullComponent;
+        });
+        if (itr != recycledDelegates.end()) {
+            auto result = itr->release();
+            recycledDelegates.erase(itr);
+            result->setAction(action);
+            return result;
+        }
+    }
+
     auto result = new ToolBarLayoutDelegate(q);
     result->setAction(action);
     result->createItems(fullComponent, iconDelegate, [this, action](QQuickItem *newItem) {
@@ -665,6 +928,29 @@ ToolBarLayoutDelegate *ToolBarLayoutPrivate::createDelegate(QObject *action)
     return result;
 }
 
+void ToolBarLayoutPrivate::recycleDelegate(QObject *action)
+{
+    // Enough to swap a typical set of page actions without recreating them.
+    static constexpr std::size_t maximumRecycledDelegates = 16;
+
+    auto itr = delegates.find(action);
+    if (itr == delegates.end()) {
+        return;
+    }
+
+    auto delegate = std::move(itr->second);
+    delegates.erase(itr);
+
+    if (!delegate->isReady() || recycledDelegates.size() >= maximumRecycledDelegates) {
+        return;
+    }
+
+    // The action is kept until the delegate is reused so its items do not
+    // have to deal with a null action in the meantime.
+    delegate->hide();
+    recycledDelegates.push_back(std::move(delegate));
+}
+
 qreal ToolBarLayoutPrivate::layoutStart(qreal layoutWidth)
 {
     qreal availableWidth = moreButtonInstance->isVisible() ? q->width() - (moreButtonInstance->width() + spacing) : q->width();
@@ -21,13 +21,19 @@ class ToolBarLayoutAttached : public QObject
     /**
      * The action this delegate was created for.
      */
-    Q_PROPERTY(QObject *action READ action CONSTANT FINAL)
+    Q_PROPERTY(QObject *action READ action NOTIFY actionChanged FINAL)
 public:
     ToolBarLayoutAttached(QObject *parent = nullptr);
 
     QObject *action() const;
     void setAction(QObject *action);
 
+    /**
+     * Delegates are reused for other actions when their action is removed,
+     * so the action can change during the lifetime of a delegate.
+     */
+    Q_SIGNAL void actionChanged();
+
 private:
     QObject *m_action = nullptr;
 };
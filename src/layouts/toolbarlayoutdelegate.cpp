@@ -9,6 +9,39 @@
 #include "loggingcategory.h"
 #include "toolbarlayout.h"
 
+#include <QQmlComponent>
+
+struct ToolBarActionWidth {
+    QUrl url;
+    qreal width = -1.0;
+};
+
+Q_GLOBAL_STATIC(QHash<QObject *, ToolBarActionWidth>, s_actionWidths)
+
+qreal ToolBarActionMetrics::width(QObject *action, QQmlComponent *component)
+{
+    auto itr = s_actionWidths->constFind(action);
+    if (itr == s_actionWidths->constEnd() || itr->url != component->url()) {
+        return -1.0;
+    }
+    return itr->width;
+}
+
+void ToolBarActionMetrics::setWidth(QObject *action, QQmlComponent *component, qreal width)
+{
+    auto itr = s_actionWidths->find(action);
+    if (itr == s_actionWidths->end()) {
+        itr = s_actionWidths->insert(action, ToolBarActionWidth{});
+        QObject::connect(action, &QObject::destroyed, [](QObject *action) {
+            if (!s_actionWidths.isDestroyed()) {
+                s_actionWidths->remove(action);
+            }
+        });
+    }
+    itr->url = component->url();
+    itr->width = width;
+}
+
 ToolBarDelegateIncubator::ToolBarDelegateIncubator(QQmlComponent *component, QQmlContext *context)
     : QQmlIncubator(QQmlIncubator::Asynchronous)
     , m_component(component)
@@ -104,23 +137,49 @@ void ToolBarLayoutDelegate::setAction(QObject *action)
     }
 
     m_action = action;
+    m_actionVisible = true;
+    m_displayHint = DisplayHint::NoPreference;
+
+    // Recycled delegates already have items that need to follow the new action.
+    for (auto item : {m_full, m_icon}) {
+        if (item) {
+            auto attached = static_cast<ToolBarLayoutAttached *>(qmlAttachedPropertiesObject<ToolBarLayout>(item, true));
+            attached->setAction(action);
+        }
+    }
+
     if (m_action) {
         if (m_action->property("visible").isValid()) {
             QObject::connect(m_action, SIGNAL(visibleChanged()), this, SLOT(actionVisibleChanged()));
             m_actionVisible = m_action->property("visible").toBool();
         }
 
+        m_displayHint = DisplayHint::displayHints(m_action);
         if (m_action->property("displayHint").isValid()) {
             QObject::connect(m_action, SIGNAL(displayHintChanged()), this, SLOT(displayHintChanged()));
-            m_displayHint = DisplayHint::DisplayHints{m_action->property("displayHint").toInt()};
         }
     }
+
+    // A recycled delegate may not have an icon item yet.
+    if (m_full && needsIcon()) {
+        createIconItem();
+    }
 }
 
 void ToolBarLayoutDelegate::createItems(QQmlComponent *fullComponent, QQmlComponent *iconComponent, std::function<void(QQuickItem *)> callback)
 {
+    m_fullComponent = fullComponent;
+    m_iconComponent = iconComponent;
+    // The attached action is set from m_action rather than by the callback,
+    // as the icon item may be created after the delegate was recycled.
+    m_stateCallback = [this, callback](QQuickItem *item) {
+        callback(item);
+        auto attached = static_cast<ToolBarLayoutAttached *>(qmlAttachedPropertiesObject<ToolBarLayout>(item, true));
+        attached->setAction(m_action);
+    };
+
     m_fullIncubator = new ToolBarDelegateIncubator(fullComponent, qmlContext(fullComponent));
-    m_fullIncubator->setStateCallback(callback);
+    m_fullIncubator->setStateCallback(m_stateCallback);
     m_fullIncubator->setCompletedCallback([this](ToolBarDelegateIncubator *incubator) {
         if (incubator->isError()) {
             qCWarning(KirigamiLayoutsLog) << "Could not create delegate for ToolBarLayout";
@@ -137,16 +196,31 @@ void ToolBarLayoutDelegate::createItems(QQmlComponent *fullComponent, QQmlCompon
         connect(m_full, &QQuickItem::implicitHeightChanged, this, &ToolBarLayoutDelegate::triggerRelayout);
         connect(m_full, &QQuickItem::visibleChanged, this, &ToolBarLayoutDelegate::ensureItemVisibility);
 
-        if (m_icon) {
-            m_ready = true;
-        }
+        updateReady();
 
         m_parent->relayout();
 
         QMetaObject::invokeMethod(this, &ToolBarLayoutDelegate::cleanupIncubators, Qt::QueuedConnection);
     });
-    m_iconIncubator = new ToolBarDelegateIncubator(iconComponent, qmlContext(iconComponent));
-    m_iconIncubator->setStateCallback(callback);
+    m_fullIncubator->create();
+
+    // Only actions that may be shown icon-only need the icon delegate, for
+    // all others it is created once their display hint changes.
+    if (needsIcon()) {
+        createIconItem();
+    }
+}
+
+void ToolBarLayoutDelegate::createIconItem()
+{
+    if (m_icon || m_iconIncubator || !m_iconComponent) {
+        return;
+    }
+
+    m_ready = false;
+
+    m_iconIncubator = new ToolBarDelegateIncubator(m_iconComponent, qmlContext(m_iconComponent));
+    m_iconIncubator->setStateCallback(m_stateCallback);
     m_iconIncubator->setCompletedCallback([this](ToolBarDelegateIncubator *incubator) {
         if (incubator->isError()) {
             qCWarning(KirigamiLayoutsLog) << "Could not create delegate for ToolBarLayout";
@@ -159,23 +233,39 @@ void ToolBarLayoutDelegate::createItems(QQmlComponent *fullComponent, QQmlCompon
 
         m_icon = qobject_cast<QQuickItem *>(incubator->object());
         m_icon->setVisible(false);
+        if (m_full) {
+            m_icon->setPosition(m_full->position());
+        }
         connect(m_icon, &QQuickItem::implicitWidthChanged, this, &ToolBarLayoutDelegate::triggerRelayout);
         connect(m_icon, &QQuickItem::implicitHeightChanged, this, &ToolBarLayoutDelegate::triggerRelayout);
         connect(m_icon, &QQuickItem::visibleChanged, this, &ToolBarLayoutDelegate::ensureItemVisibility);
 
-        if (m_full) {
-            m_ready = true;
-        }
+        updateReady();
 
         m_parent->relayout();
 
         QMetaObject::invokeMethod(this, &ToolBarLayoutDelegate::cleanupIncubators, Qt::QueuedConnection);
     });
-
-    m_fullIncubator->create();
     m_iconIncubator->create();
 }
 
+bool ToolBarLayoutDelegate::needsIcon() const
+{
+    // ToolBarLayout only collapses actions to icon-only when they are marked
+    // as IconOnly or KeepVisible, other actions are hidden instead.
+    return isIconOnly() || isKeepVisible();
+}
+
+void ToolBarLayoutDelegate::updateReady()
+{
+    m_ready = m_full && (m_icon || !needsIcon());
+}
+
+QQmlComponent *ToolBarLayoutDelegate::fullComponent() const
+{
+    return m_fullComponent;
+}
+
 bool ToolBarLayoutDelegate::isReady() const
 {
     return m_ready;
@@ -206,6 +296,11 @@ bool ToolBarLayoutDelegate::isVisible() const
     return m_iconVisible || m_fullVisible;
 }
 
+bool ToolBarLayoutDelegate::isIconVisible() const
+{
+    return m_iconVisible;
+}
+
 void ToolBarLayoutDelegate::hide()
 {
     m_iconVisible = false;
@@ -221,6 +316,11 @@ void ToolBarLayoutDelegate::showFull()
 
 void ToolBarLayoutDelegate::showIcon()
 {
+    if (!m_icon) {
+        showFull();
+        return;
+    }
+
     m_iconVisible = true;
     m_fullVisible = false;
 }
@@ -233,21 +333,27 @@ void ToolBarLayoutDelegate::show()
 void ToolBarLayoutDelegate::setPosition(qreal x, qreal y)
 {
     m_full->setX(x);
-    m_icon->setX(x);
     m_full->setY(y);
-    m_icon->setY(y);
+    if (m_icon) {
+        m_icon->setX(x);
+        m_icon->setY(y);
+    }
 }
 
 void ToolBarLayoutDelegate::setHeight(qreal height)
 {
     m_full->setHeight(height);
-    m_icon->setHeight(height);
+    if (m_icon) {
+        m_icon->setHeight(height);
+    }
 }
 
 void ToolBarLayoutDelegate::resetHeight()
 {
     m_full->resetHeight();
-    m_icon->resetHeight();
+    if (m_icon) {
+        m_icon->resetHeight();
+    }
 }
 
 qreal ToolBarLayoutDelegate::width() const
@@ -284,12 +390,12 @@ qreal ToolBarLayoutDelegate::implicitHeight() const
 
 qreal ToolBarLayoutDelegate::maxHeight() const
 {
-    return std::max(m_full->implicitHeight(), m_icon->implicitHeight());
+    return std::max(m_full->implicitHeight(), m_icon ? m_icon->implicitHeight() : 0.0);
 }
 
 qreal ToolBarLayoutDelegate::iconWidth() const
 {
-    return m_icon->width();
+    return m_icon ? m_icon->width() : m_full->width();
 }
 
 qreal ToolBarLayoutDelegate::fullWidth() const
@@ -305,7 +411,11 @@ void ToolBarLayoutDelegate::actionVisibleChanged()
 
 void ToolBarLayoutDelegate::displayHintChanged()
 {
+    // The cache of display hints may not have been notified yet.
     m_displayHint = DisplayHint::DisplayHints{m_action->property("displayHint").toInt()};
+    if (m_full && needsIcon()) {
+        createIconItem();
+    }
     m_parent->relayout();
 }
 
@@ -40,6 +40,25 @@ private:
     bool m_finished = false;
 };
 
+/*
+ * The width of the delegates of an action when it was last laid out by any
+ * ToolBarLayout. This lets layouts tell which actions will end up in the
+ * overflow menu before creating delegates for them, which is common when the
+ * same actions are shown by several toolbars. Widths are only shared between
+ * delegates created from the same file, as different toolbars may use
+ * different delegates.
+ */
+class ToolBarActionMetrics
+{
+public:
+    /*
+     * Returns the last width of the delegates of action created from
+     * component, or a negative value if it is unknown.
+     */
+    static qreal width(QObject *action, QQmlComponent *component);
+    static void setWidth(QObject *action, QQmlComponent *component, qreal width);
+};
+
 /*
  * A helper class to encapsulate some of the delegate functionality used by
  * ToolBarLayout. Primarily, this hides some of the difference that delegates
@@ -55,6 +74,7 @@ public:
     QObject *action() const;
     void setAction(QObject *action);
     void createItems(QQmlComponent *fullComponent, QQmlComponent *iconComponent, std::function<void(QQuickItem *)> callback);
+    QQmlComponent *fullComponent() const;
 
     bool isReady() const;
     bool isActionVisible() const;
@@ -63,6 +83,7 @@ public:
     bool isKeepVisible() const;
 
     bool isVisible() const;
+    bool isIconVisible() const;
 
     void hide();
     void showIcon();
@@ -93,11 +114,17 @@ private:
             m_icon->setVisible(m_iconVisible);
         }
     }
+    void createIconItem();
+    bool needsIcon() const;
+    void updateReady();
     void cleanupIncubators();
     void triggerRelayout();
 
     ToolBarLayout *m_parent = nullptr;
     QObject *m_action = nullptr;
+    QQmlComponent *m_fullComponent = nullptr;
+    QQmlComponent *m_iconComponent = nullptr;
+    std::function<void(QQuickItem *)> m_stateCallback;
     QQuickItem *m_full = nullptr;
     QQuickItem *m_icon = nullptr;
     ToolBarDelegateIncubator *m_fullIncubator = nullptr;
@@ -5,15 +5,18 @@
  */
 
 #include "mnemonicattached.h"
+#include "actionhelper.h"
+
 #include <QDebug>
 #include <QGuiApplication>
 #include <QQuickItem>
 #include <QQuickRenderControl>
 #include <QQuickWindow>
 #include <QRegularExpression>
+#include <QSet>
 #include <QWindow>
 
-QHash<QKeySequence, MnemonicAttached *> MnemonicAttached::s_sequenceToObject = QHash<QKeySequence, MnemonicAttached *>();
+#include <algorithm>
 
 // If pos points to alphanumeric X in "...(X)...", which is preceded or
 // followed only by non-alphanumerics, then "(X)" gets removed.
@@ -105,6 +108,72 @@ static QString removeAcceleratorMarker(const QString &label_)
     return label;
 }
 
+// The forms of a label shown by controls, for one assigned character.
+struct LabelForms {
+    QString plain;
+    QString richText;
+    QString mnemonic;
+};
+
+// Menus and lists show the same labels many times, and rebind them whenever
+// they create their delegates again, so the forms of a label are only built
+// once and then shared by all mnemonics using it.
+using LabelFormsKey = std::pair<QString, QChar>;
+using LabelFormsCache = QHash<LabelFormsKey, LabelForms>;
+Q_GLOBAL_STATIC(LabelFormsCache, s_labelForms)
+
+static constexpr qsizetype maximumCachedLabels = 512;
+
+// The character is null when no sequence is assigned.
+static LabelForms labelForms(const QString &label, QChar character)
+{
+    const LabelFormsKey key{label, character};
+    if (auto itr = s_labelForms->constFind(key); itr != s_labelForms->cend()) {
+        return *itr;
+    }
+
+    // Preserve strings like "One & Two" where & is not an accelerator escape
+    const QString text = QString(label).replace(QStringLiteral("& "), QStringLiteral("&& "));
+
+    LabelForms forms;
+    if (!character.isNull()) {
+        forms.plain = labelForms(label, QChar{}).plain;
+    } else {
+        forms.plain = removeAcceleratorMarker(text);
+    }
+
+    static const QRegularExpression acceleratorMarker(QStringLiteral("\\&([^\\&])"));
+    forms.richText = text;
+    forms.richText.replace(acceleratorMarker, QStringLiteral("\\1"));
+    forms.mnemonic = forms.richText;
+
+    if (!character.isNull()) {
+        forms.mnemonic = text;
+        const int mnemonicPos = forms.mnemonic.indexOf(character);
+
+        if (mnemonicPos > -1 && (mnemonicPos == 0 || forms.mnemonic[mnemonicPos - 1] != QLatin1Char('&'))) {
+            forms.mnemonic.replace(mnemonicPos, 1, QStringLiteral("&") % character);
+        }
+
+        const int richTextPos = forms.richText.indexOf(character);
+        if (richTextPos > -1) {
+            forms.richText.replace(richTextPos, 1, QLatin1String("<u>") % character % QLatin1String("</u>"));
+        }
+    }
+
+    if (s_labelForms->size() >= maximumCachedLabels) {
+        s_labelForms->clear();
+    }
+    s_labelForms->insert(key, forms);
+    return forms;
+}
+
+/**
+ * Activates the mnemonics of the focused window while Alt is held.
+ *
+ * Only the mnemonics of that window are activated, so pressing Alt costs the
+ * same no matter how many other windows the application has.
+ */
 class MnemonicEventFilter : public QObject
 {
     Q_OBJECT
@@ -116,56 +185,207 @@ public:
         return s_instance;
     }
 
-    bool eventFilter(QObject *watched, QEvent *event) override
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    MnemonicEventFilter()
+        : QObject(nullptr)
     {
-        Q_UNUSED(watched);
+        qGuiApp->installEventFilter(this);
+    }
 
-        if (event->type() == QEvent::KeyPress) {
-            QKeyEvent *ke = static_cast<QKeyEvent *>(event);
-            if (ke->key() == Qt::Key_Alt) {
-                m_altPressed = true;
-                Q_EMIT altPressed();
-            }
-        } else if (event->type() == QEvent::KeyRelease) {
-            QKeyEvent *ke = static_cast<QKeyEvent *>(event);
-            if (ke->key() == Qt::Key_Alt) {
-                m_altPressed = false;
-                Q_EMIT altReleased();
-            }
-        } else if (event->type() == QEvent::ApplicationStateChange) {
-            if (m_altPressed) {
-                m_altPressed = false;
-                Q_EMIT altReleased();
-            }
+    void release();
+
+    // The allocator of the window the mnemonics were activated in.
+    QPointer<MnemonicAllocator> m_activeAllocator;
+    bool m_altPressed = false;
+};
+
+/**
+ * Assigns the sequences of all mnemonics in a window.
+ *
+ * Any change to a mnemonic only schedules a new assignment, which then
+ * happens once for all changes made during an event loop iteration. The
+ * mnemonics choose their sequences ordered by weight, so a mnemonic only
+ * loses a letter to a more important one. Sequences used as shortcuts by the
+ * actions of the controls in the window are never assigned to a mnemonic.
+ */
+class MnemonicAllocator : public QObject
+{
+public:
+    static MnemonicAllocator *forWindow(QWindow *window)
+    {
+        if (!window) {
+            return nullptr;
+        }
+
+        auto allocator = s_allocators.value(window);
+        if (!allocator) {
+            // Allocators of windows are deleted together with their window.
+            allocator = new MnemonicAllocator(window);
+            s_allocators.insert(window, allocator);
+        }
+        return allocator;
+    }
+
+    static MnemonicAllocator *existingForWindow(QWindow *window)
+    {
+        return window ? s_allocators.value(window) : nullptr;
+    }
+
+    ~MnemonicAllocator() override
+    {
+        s_allocators.remove(m_window);
+    }
+
+    void add(MnemonicAttached *mnemonic)
+    {
+        m_mnemonics.append(mnemonic);
+        schedule();
+    }
+
+    void remove(MnemonicAttached *mnemonic)
+    {
+        m_mnemonics.removeOne(mnemonic);
+        if (m_altPressed) {
+            mnemonic->onAltReleased();
+        }
+        if (!mnemonic->m_sequence.isEmpty()) {
+            // Another mnemonic may want the sequence that is now free.
+            schedule();
+        }
+    }
+
+    void schedule()
+    {
+        if (m_scheduled) {
+            return;
         }
 
-        return false;
+        m_scheduled = true;
+        QMetaObject::invokeMethod(this, &MnemonicAllocator::assign, Qt::QueuedConnection);
     }
 
-Q_SIGNALS:
-    void altPressed();
-    void altReleased();
+    void setAltPressed(bool pressed)
+    {
+        m_altPressed = pressed;
+        for (MnemonicAttached *mnemonic : std::as_const(m_mnemonics)) {
+            if (pressed) {
+                mnemonic->onAltPressed();
+            } else {
+                mnemonic->onAltReleased();
+            }
+        }
+    }
 
 private:
-    MnemonicEventFilter()
-        : QObject(nullptr)
+    explicit MnemonicAllocator(QWindow *window)
+        : QObject(window)
+        , m_window(window)
     {
-        qGuiApp->installEventFilter(this);
+        MnemonicEventFilter::instance();
+    }
+
+    void assign()
+    {
+        m_scheduled = false;
+
+        QList<MnemonicAttached *> mnemonics = m_mnemonics;
+        std::stable_sort(mnemonics.begin(), mnemonics.end(), [](MnemonicAttached *left, MnemonicAttached *right) {
+            return left->m_weight > right->m_weight;
+        });
+
+        QSet<QKeySequence> used;
+        used.reserve(mnemonics.size());
+
+        for (MnemonicAttached *mnemonic : std::as_const(mnemonics)) {
+            for (const QKeySequence &shortcut : mnemonic->actionShortcuts()) {
+                used.insert(shortcut);
+            }
+        }
+
+        for (MnemonicAttached *mnemonic : std::as_const(mnemonics)) {
+            if (!mnemonic->m_enabled) {
+                mnemonic->assignSequence({}, QChar{});
+                continue;
+            }
+
+            bool assigned = false;
+            for (const auto &candidate : std::as_const(mnemonic->m_candidates)) {
+                if (!used.contains(candidate.sequence)) {
+                    used.insert(candidate.sequence);
+                    mnemonic->assignSequence(candidate.sequence, candidate.character);
+                    assigned = true;
+                    break;
+                }
+            }
+
+            if (!assigned) {
+                mnemonic->assignSequence({}, QChar{});
+            }
+        }
     }
 
+    QWindow *const m_window;
+    QList<MnemonicAttached *> m_mnemonics;
+    bool m_scheduled = false;
     bool m_altPressed = false;
+
+    inline static QHash<QWindow *, MnemonicAllocator *> s_allocators;
 };
 
+bool MnemonicEventFilter::eventFilter(QObject *watched, QEvent *event)
+{
+    Q_UNUSED(watched);
+
+    if (event->type() == QEvent::KeyPress) {
+        QKeyEvent *ke = static_cast<QKeyEvent *>(event);
+        if (ke->key() == Qt::Key_Alt && !m_altPressed) {
+            m_altPressed = true;
+            m_activeAllocator = MnemonicAllocator::existingForWindow(QGuiApplication::focusWindow());
+            if (m_activeAllocator) {
+                m_activeAllocator->setAltPressed(true);
+            }
+        }
+    } else if (event->type() == QEvent::KeyRelease) {
+        QKeyEvent *ke = static_cast<QKeyEvent *>(event);
+        if (ke->key() == Qt::Key_Alt) {
+            release();
+        }
+    } else if (event->type() == QEvent::ApplicationStateChange) {
+        release();
+    }
+
+    return false;
+}
+
+void MnemonicEventFilter::release()
+{
+    if (!m_altPressed) {
+        return;
+    }
+
+    m_altPressed = false;
+    if (m_activeAllocator) {
+        m_activeAllocator->setAltPressed(false);
+        m_activeAllocator = nullptr;
+    }
+}
+
 MnemonicAttached::MnemonicAttached(QObject *parent)
     : QObject(parent)
 {
-    connect(&MnemonicEventFilter::instance(), &MnemonicEventFilter::altPressed, this, &MnemonicAttached::onAltPressed);
-    connect(&MnemonicEventFilter::instance(), &MnemonicEventFilter::altReleased, this, &MnemonicAttached::onAltReleased);
+    if (auto item = qobject_cast<QQuickItem *>(parent)) {
+        connect(item, &QQuickItem::windowChanged, this, &MnemonicAttached::updateAllocator);
+    }
+    updateAllocator();
 }
 
 MnemonicAttached::~MnemonicAttached()
 {
-    s_sequenceToObject.remove(m_sequence);
+    if (m_allocator) {
+        m_allocator->remove(this);
+    }
 }
 
 QWindow *MnemonicAttached::window() const
@@ -183,6 +403,16 @@ QWindow *MnemonicAttached::window() const
     return nullptr;
 }
 
+QList<QKeySequence> MnemonicAttached::actionShortcuts() const
+{
+    if (!parent()) {
+        return {};
+    }
+
+    // Controls showing an action, like buttons and menu items, expose it as "action".
+    return ActionHelper::shortcuts(parent()->property("action").value<QObject *>());
+}
+
 void MnemonicAttached::onAltPressed()
 {
     if (m_active || !m_enabled || m_richTextLabel.isEmpty()) {
@@ -209,12 +439,41 @@ void MnemonicAttached::onAltReleased()
     // Disabling menmonics again is always fine, e.g. on window deactivation,
     // don't check for enabled or window is active here.
 
-    m_actualRichTextLabel = removeAcceleratorMarker(m_label);
+    m_actualRichTextLabel = m_plainLabel;
     Q_EMIT richTextLabelChanged();
     m_active = false;
     Q_EMIT activeChanged();
 }
 
+void MnemonicAttached::updateAllocator()
+{
+    auto allocator = MnemonicAllocator::forWindow(window());
+    if (allocator == m_allocator) {
+        return;
+    }
+
+    if (m_allocator) {
+        m_allocator->remove(this);
+    }
+    m_allocator = allocator;
+    if (m_allocator) {
+        m_allocator->add(this);
+    } else {
+        // Items outside of a window don't compete for sequences, they get
+        // one once they are shown in a window.
+        assignSequence({}, QChar{});
+    }
+}
+
+void MnemonicAttached::scheduleAssignment()
+{
+    if (m_allocator) {
+        m_allocator->schedule();
+    } else {
+        assignSequence({}, QChar{});
+    }
+}
+
 // Algorithm adapted from KAccelString
 void MnemonicAttached::calculateWeights()
 {
@@ -284,88 +543,49 @@ void MnemonicAttached::calculateWeights()
     } else {
         m_weight = m_baseWeight + (std::prev(m_weights.cend())).key();
     }
-}
 
-void MnemonicAttached::updateSequence()
-{
-    const QKeySequence oldSequence = m_sequence;
-
-    if (!m_sequence.isEmpty()) {
-        s_sequenceToObject.remove(m_sequence);
-        m_sequence = {};
+    m_candidates.clear();
+    m_candidates.reserve(m_weights.size());
+    for (auto it = m_weights.crbegin(); it != m_weights.crend(); ++it) {
+        m_candidates.append({QKeySequence(QStringLiteral("Alt+") % it.value()), it.value()});
     }
+}
 
-    calculateWeights();
-
-    // Preserve strings like "One & Two" where & is not an accelerator escape
-    const QString text = label().replace(QStringLiteral("& "), QStringLiteral("&& "));
-    m_actualRichTextLabel = removeAcceleratorMarker(text);
-
-    if (!m_enabled) {
-        // was the label already completely plain text? try to limit signal emission
-        if (m_mnemonicLabel != m_actualRichTextLabel) {
-            m_mnemonicLabel = m_actualRichTextLabel;
-            Q_EMIT mnemonicLabelChanged();
-            Q_EMIT richTextLabelChanged();
-        }
-
-        if (m_sequence != oldSequence) {
-            Q_EMIT sequenceChanged();
-        }
+void MnemonicAttached::assignSequence(const QKeySequence &sequence, QChar character)
+{
+    // Most mnemonics keep their sequence when another one in the window changed.
+    if (!m_assignmentDirty && sequence == m_sequence) {
         return;
     }
+    m_assignmentDirty = false;
 
-    m_mnemonicLabel = text;
-    m_mnemonicLabel.replace(QRegularExpression(QLatin1String("\\&([^\\&])")), QStringLiteral("\\1"));
-
-    if (!m_weights.isEmpty()) {
-        QMap<int, QChar>::const_iterator i = m_weights.constEnd();
-        do {
-            --i;
-            QChar c = i.value();
-
-            QKeySequence ks(QStringLiteral("Alt+") % c);
-            MnemonicAttached *otherMa = s_sequenceToObject.value(ks);
-            Q_ASSERT(otherMa != this);
-            if (!otherMa || otherMa->m_weight < m_weight) {
-                // the old shortcut is less valuable than the current: remove it
-                if (otherMa) {
-                    s_sequenceToObject.remove(otherMa->sequence());
-                    otherMa->m_sequence = {};
-                }
-
-                s_sequenceToObject[ks] = this;
-                m_sequence = ks;
-                m_richTextLabel = text;
-                m_richTextLabel.replace(QRegularExpression(QLatin1String("\\&([^\\&])")), QStringLiteral("\\1"));
-                m_mnemonicLabel = text;
-                const int mnemonicPos = m_mnemonicLabel.indexOf(c);
-
-                if (mnemonicPos > -1 && (mnemonicPos == 0 || m_mnemonicLabel[mnemonicPos - 1] != QLatin1Char('&'))) {
-                    m_mnemonicLabel.replace(mnemonicPos, 1, QStringLiteral("&") % c);
-                }
+    const QKeySequence oldSequence = m_sequence;
+    const QString oldRichTextLabel = m_richTextLabel;
+    const QString oldMnemonicLabel = m_mnemonicLabel;
 
-                const int richTextPos = m_richTextLabel.indexOf(c);
-                if (richTextPos > -1) {
-                    m_richTextLabel.replace(richTextPos, 1, QLatin1String("<u>") % c % QLatin1String("</u>"));
-                }
+    m_sequence = sequence;
 
-                // remap the sequence of the previous shortcut
-                if (otherMa) {
-                    otherMa->updateSequence();
-                }
+    const LabelForms forms = labelForms(m_label, m_enabled && !sequence.isEmpty() ? character : QChar{});
 
-                break;
-            }
-        } while (i != m_weights.constBegin());
+    if (!m_enabled) {
+        m_mnemonicLabel = forms.plain;
+    } else {
+        m_richTextLabel = forms.richText;
+        m_mnemonicLabel = forms.mnemonic;
     }
 
+    const QString &actualRichTextLabel = m_active && m_enabled ? m_richTextLabel : m_plainLabel;
+
     if (m_sequence != oldSequence) {
         Q_EMIT sequenceChanged();
     }
-
-    Q_EMIT richTextLabelChanged();
-    Q_EMIT mnemonicLabelChanged();
+    if (m_richTextLabel != oldRichTextLabel || m_actualRichTextLabel != actualRichTextLabel) {
+        m_actualRichTextLabel = actualRichTextLabel;
+        Q_EMIT richTextLabelChanged();
+    }
+    if (m_mnemonicLabel != oldMnemonicLabel) {
+        Q_EMIT mnemonicLabelChanged();
+    }
 }
 
 void MnemonicAttached::setLabel(const QString &text)
@@ -375,8 +595,13 @@ void MnemonicAttached::setLabel(const QString &text)
     }
 
     m_label = text;
-    updateSequence();
+    calculateWeights();
+    m_plainLabel = labelForms(m_label, QChar{}).plain;
+    m_actualRichTextLabel = m_plainLabel;
+    m_assignmentDirty = true;
+    scheduleAssignment();
     Q_EMIT labelChanged();
+    Q_EMIT richTextLabelChanged();
 }
 
 QString MnemonicAttached::richTextLabel() const
@@ -384,7 +609,7 @@ QString MnemonicAttached::richTextLabel() const
     if (!m_actualRichTextLabel.isEmpty()) {
         return m_actualRichTextLabel;
     } else {
-        return removeAcceleratorMarker(m_label);
+        return m_plainLabel;
     }
 }
 
@@ -405,7 +630,8 @@ void MnemonicAttached::setEnabled(bool enabled)
     }
 
     m_enabled = enabled;
-    updateSequence();
+    m_assignmentDirty = true;
+    scheduleAssignment();
     Q_EMIT enabledChanged();
 }
 
@@ -445,6 +671,7 @@ void MnemonicAttached::setControlType(MnemonicAttached::ControlType controlType)
     } else {
         m_weight = m_baseWeight + (std::prev(m_weights.constEnd())).key();
     }
+    scheduleAssignment();
     Q_EMIT controlTypeChanged();
 }
 
@@ -486,7 +713,7 @@ void MnemonicAttached::setActive(bool active)
         }
 
     } else {
-        m_actualRichTextLabel = removeAcceleratorMarker(m_label);
+        m_actualRichTextLabel = m_plainLabel;
         Q_EMIT richTextLabelChanged();
     }
 
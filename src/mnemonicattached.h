@@ -7,11 +7,14 @@
 #ifndef MNEMONICATTACHED_H
 #define MNEMONICATTACHED_H
 
+#include <QKeySequence>
 #include <QObject>
 #include <QQuickWindow>
 
 #include <QQmlEngine>
 
+class MnemonicAllocator;
+
 /**
  * This Attached property is used to calculate automated keyboard sequences
  * to trigger actions based upon their text: if an "&" mnemonic is
@@ -21,6 +24,10 @@
  * Different kinds of controls will have different priorities in assigning the
  * shortcut: for instance the "Ok/Cancel" buttons in a dialog will have priority
  * over fields of a FormLayout.
+ *
+ * Sequences are assigned per window, once per event loop iteration, so
+ * sequence and the labels containing the assigned letter update
+ * asynchronously after any of the mnemonics in the window changed.
  * @see ControlType
  *
  * Usually the developer shouldn't use this directly as base components
@@ -109,9 +116,6 @@ public:
     // QML attached property
     static MnemonicAttached *qmlAttachedProperties(QObject *object);
 
-protected:
-    void updateSequence();
-
 Q_SIGNALS:
     void labelChanged();
     void enabledChanged();
@@ -122,7 +126,13 @@ Q_SIGNALS:
     void activeChanged();
 
 private:
+    friend class MnemonicAllocator;
+
     QWindow *window() const;
+    void updateAllocator();
+    void scheduleAssignment();
+    void assignSequence(const QKeySequence &sequence, QChar character);
+    QList<QKeySequence> actionShortcuts() const;
 
     void onAltPressed();
     void onAltReleased();
@@ -155,19 +165,25 @@ private:
     ControlType m_controlType = SecondaryControl;
     QMap<int, QChar> m_weights;
 
+    // The possible sequences, from the most to the least wanted one
+    struct Candidate {
+        QKeySequence sequence;
+        QChar character;
+    };
+    QList<Candidate> m_candidates;
+
     QString m_label;
+    // The label without accelerator markers
+    QString m_plainLabel;
     QString m_actualRichTextLabel;
     QString m_richTextLabel;
     QString m_mnemonicLabel;
     QKeySequence m_sequence;
     bool m_enabled = true;
     bool m_active = false;
+    bool m_assignmentDirty = true;
 
-    QPointer<QQuickWindow> m_window;
-
-    // global mapping of mnemonics
-    // TODO: map by QWindow
-    static QHash<QKeySequence, MnemonicAttached *> s_sequenceToObject;
+    QPointer<MnemonicAllocator> m_allocator;
 };
 
 QML_DECLARE_TYPEINFO(MnemonicAttached, QML_HAS_ATTACHED_PROPERTIES)
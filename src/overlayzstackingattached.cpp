@@ -8,7 +8,133 @@
 
 #include "loggingcategory.h"
 
+#include <QHash>
 #include <QQuickItem>
+#include <QQuickWindow>
+
+// QQuickPopup is not public API, so its signals can only be connected to
+// through the meta object. Resolve them once by index instead of parsing
+// signatures on every connection.
+static QMetaMethod popupSignal(const QObject *popup, const char *signature)
+{
+    const QMetaObject *metaObject = popup->metaObject();
+    return metaObject->method(metaObject->indexOfSignal(signature));
+}
+
+static QMetaMethod ownSlot(const char *signature)
+{
+    const QMetaObject &metaObject = OverlayZStackingAttached::staticMetaObject;
+    return metaObject.method(metaObject.indexOfSlot(signature));
+}
+
+/**
+ * Keeps track of the items the popups of a window found their parent popup
+ * through.
+ *
+ * Finding the parent popup walks up the item tree, which only needs to happen
+ * again once one of the items on the way is reparented. Every watched item is
+ * connected to only once, however many popups found their parent through it,
+ * and only the popups depending on a reparented item look for their parent
+ * popup again.
+ */
+class OverlayZStackingManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    static OverlayZStackingManager *forWindow(QQuickWindow *window)
+    {
+        if (!window) {
+            return nullptr;
+        }
+
+        // Managers of windows are deleted together with their window.
+        auto manager = window->findChild<OverlayZStackingManager *>(QString{}, Qt::FindDirectChildrenOnly);
+        if (!manager) {
+            manager = new OverlayZStackingManager(window);
+        }
+        return manager;
+    }
+
+    ~OverlayZStackingManager() override
+    {
+        const auto popups = m_ancestors.keys();
+        for (OverlayZStackingAttached *popup : popups) {
+            popup->m_parentPopupResolved = false;
+        }
+    }
+
+    void watch(OverlayZStackingAttached *popup, const QList<QQuickItem *> &ancestors)
+    {
+        for (QQuickItem *item : ancestors) {
+            auto &watched = m_items[item];
+            if (watched.popups.isEmpty()) {
+                watched.parentConnection = connect(item, &QQuickItem::parentChanged, this, [this, item]() {
+                    itemChanged(item, true);
+                });
+                watched.destroyedConnection = connect(item, &QObject::destroyed, this, [this, item]() {
+                    itemChanged(item, false);
+                });
+            }
+            watched.popups.append(popup);
+        }
+        m_ancestors.insert(popup, ancestors);
+    }
+
+    void unwatch(OverlayZStackingAttached *popup)
+    {
+        const QList<QQuickItem *> ancestors = m_ancestors.take(popup);
+        for (QQuickItem *item : ancestors) {
+            auto itr = m_items.find(item);
+            if (itr == m_items.end()) {
+                continue;
+            }
+
+            itr->popups.removeOne(popup);
+            if (itr->popups.isEmpty()) {
+                disconnect(itr->parentConnection);
+                disconnect(itr->destroyedConnection);
+                m_items.erase(itr);
+            }
+        }
+    }
+
+private:
+    struct WatchedItem {
+        QList<OverlayZStackingAttached *> popups;
+        QMetaObject::Connection parentConnection;
+        QMetaObject::Connection destroyedConnection;
+    };
+
+    explicit OverlayZStackingManager(QQuickWindow *window)
+        : QObject(window)
+    {
+    }
+
+    void itemChanged(QQuickItem *item, bool update)
+    {
+        const auto itr = m_items.constFind(item);
+        if (itr == m_items.cend()) {
+            return;
+        }
+
+        // Looking for the parent popup again changes the watched items.
+        const QList<OverlayZStackingAttached *> popups = itr->popups;
+        for (OverlayZStackingAttached *popup : popups) {
+            unwatch(popup);
+            popup->m_manager = nullptr;
+            popup->m_parentPopupResolved = false;
+            // The tree of a destroyed item is being torn down, the popups find
+            // their parent popup again once they are read or reparented.
+            if (update) {
+                popup->updateParentPopup();
+            }
+        }
+    }
+
+    QHash<QQuickItem *, WatchedItem> m_items;
+    QHash<OverlayZStackingAttached *, QList<QQuickItem *>> m_ancestors;
+};
 
 OverlayZStackingAttached::OverlayZStackingAttached(QObject *parent)
     : QObject(parent)
@@ -22,19 +148,26 @@ OverlayZStackingAttached::OverlayZStackingAttached(QObject *parent)
         return;
     }
 
-    connect(parent, SIGNAL(parentChanged()), this, SLOT(updateParentPopup()));
-    connect(parent, SIGNAL(closed()), this, SLOT(dispatchPendingSignal()));
+    static const QMetaMethod updateParentPopupSlot = ownSlot("updateParentPopup()");
+    static const QMetaMethod dispatchPendingSignalSlot = ownSlot("dispatchPendingSignal()");
+
+    connect(parent, popupSignal(parent, "parentChanged()"), this, updateParentPopupSlot);
+    connect(parent, popupSignal(parent, "closed()"), this, dispatchPendingSignalSlot);
     // Note: aboutToShow is too late, as QQuickPopup has already created modal
     // dimmer based off current z index.
 }
 
 OverlayZStackingAttached::~OverlayZStackingAttached()
 {
+    if (m_manager) {
+        m_manager->unwatch(this);
+    }
 }
 
 qreal OverlayZStackingAttached::z() const
 {
-    if (!m_parentPopup) {
+    // Only walk the item tree once until the popup is reparented.
+    if (!m_parentPopupResolved) {
         const_cast<OverlayZStackingAttached *>(this)->updateParentPopupSilent();
     }
 
@@ -95,8 +228,29 @@ void OverlayZStackingAttached::updateParentPopup()
 
 void OverlayZStackingAttached::updateParentPopupSilent()
 {
-    auto popup = findParentPopup(parent());
+    if (m_manager) {
+        m_manager->unwatch(this);
+        m_manager = nullptr;
+    }
+
+    QList<QQuickItem *> ancestors;
+    auto popup = findParentPopup(parent(), &ancestors);
     setParentPopup(popup);
+
+    // The result stays valid until one of the items on the way is reparented,
+    // or the popup itself, which updateParentPopup() already handles. Without
+    // a parent item in a window yet, the popup is most likely still being
+    // created, so the result is not kept.
+    if (ancestors.isEmpty()) {
+        m_parentPopupResolved = popup != nullptr;
+        return;
+    }
+
+    m_manager = OverlayZStackingManager::forWindow(ancestors.constFirst()->window());
+    if (m_manager) {
+        m_manager->watch(this, ancestors);
+    }
+    m_parentPopupResolved = m_manager != nullptr;
 }
 
 void OverlayZStackingAttached::setParentPopup(QObject *parentPopup)
@@ -105,15 +259,13 @@ void OverlayZStackingAttached::setParentPopup(QObject *parentPopup)
         return;
     }
 
-    if (m_parentPopup) {
-        disconnect(m_parentPopup.data(), SIGNAL(zChanged()), this, SLOT(enqueueSignal()));
-    }
+    disconnect(m_parentPopupZConnection);
 
-    // Ideally, we would also connect to all the parent items' parentChanged() on the way to parent popup.
     m_parentPopup = parentPopup;
 
     if (m_parentPopup) {
-        connect(m_parentPopup.data(), SIGNAL(zChanged()), this, SLOT(enqueueSignal()));
+        static const QMetaMethod enqueueSignalSlot = ownSlot("enqueueSignal()");
+        m_parentPopupZConnection = connect(m_parentPopup.data(), popupSignal(m_parentPopup, "zChanged()"), this, enqueueSignalSlot);
     }
 }
 
@@ -139,9 +291,9 @@ bool OverlayZStackingAttached::isPopup(const QObject *object)
     return object && object->inherits("QQuickPopup");
 }
 
-QObject *OverlayZStackingAttached::findParentPopup(const QObject *popup)
+QObject *OverlayZStackingAttached::findParentPopup(const QObject *popup, QList<QQuickItem *> *ancestors)
 {
-    auto item = findParentPopupItem(popup);
+    auto item = findParentPopupItem(popup, ancestors);
     if (!item) {
         return nullptr;
     }
@@ -152,7 +304,7 @@ QObject *OverlayZStackingAttached::findParentPopup(const QObject *popup)
     return parentPopup;
 }
 
-QQuickItem *OverlayZStackingAttached::findParentPopupItem(const QObject *popup)
+QQuickItem *OverlayZStackingAttached::findParentPopupItem(const QObject *popup, QList<QQuickItem *> *ancestors)
 {
     if (!isPopup(popup)) {
         return nullptr;
@@ -168,6 +320,9 @@ QQuickItem *OverlayZStackingAttached::findParentPopupItem(const QObject *popup)
         if (item && item->inherits("QQuickPopupItem")) {
             return item;
         }
+        if (ancestors) {
+            ancestors->append(item);
+        }
         item = item->parentItem();
     } while (item);
 
@@ -212,3 +367,4 @@ qreal OverlayZStackingAttached::defaultZForLayer(Layer layer)
 }
 
 #include "moc_overlayzstackingattached.cpp"
+#include "overlayzstackingattached.moc"
@@ -13,6 +13,7 @@
 #include <qqmlregistration.h>
 
 class QQuickItem;
+class OverlayZStackingManager;
 
 /**
  * This attached property manages z-index for stacking overlays relative to each other.
@@ -88,18 +89,24 @@ private Q_SLOTS:
     void updateParentPopup();
 
 private:
+    friend class OverlayZStackingManager;
+
     void updateParentPopupSilent();
+    void invalidateParentPopup();
     void setParentPopup(QObject *popup);
     qreal parentPopupZ() const;
     static bool isVisible(const QObject *popup);
     static bool isPopup(const QObject *object);
-    static QObject *findParentPopup(const QObject *popup);
-    static QQuickItem *findParentPopupItem(const QObject *popup);
+    static QObject *findParentPopup(const QObject *popup, QList<QQuickItem *> *ancestors = nullptr);
+    static QQuickItem *findParentPopupItem(const QObject *popup, QList<QQuickItem *> *ancestors = nullptr);
     static Layer defaultLayerForPopupType(const QObject *popup);
     static qreal defaultZForLayer(Layer layer);
 
     Layer m_layer = Layer::DefaultLowest;
     QPointer<QObject> m_parentPopup;
+    QMetaObject::Connection m_parentPopupZConnection;
+    QPointer<OverlayZStackingManager> m_manager;
+    bool m_parentPopupResolved = false;
     bool m_pending;
 };
 
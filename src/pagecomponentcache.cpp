@@ -0,0 +1,77 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "pagecomponentcache.h"
+
+#include <QQmlEngine>
+
+PageComponentCache::PageComponentCache(QQmlEngine *engine)
+    : QObject(engine)
+    , m_engine(engine)
+{
+}
+
+PageComponentCache *PageComponentCache::instance(QQmlEngine *engine)
+{
+    Q_ASSERT(engine);
+
+    // One cache per engine, which also owns it.
+    auto cache = engine->findChild<PageComponentCache *>(QString(), Qt::FindDirectChildrenOnly);
+    if (!cache) {
+        cache = new PageComponentCache(engine);
+        QQmlEngine::setObjectOwnership(cache, QQmlEngine::CppOwnership);
+    }
+    return cache;
+}
+
+PageComponentCache *PageComponentCache::create(QQmlEngine *engine, QJSEngine *)
+{
+    return instance(engine);
+}
+
+QQmlComponent *PageComponentCache::component(const QUrl &url, QQmlComponent::CompilationMode mode)
+{
+    if (QQmlComponent *component = m_components.value(url)) {
+        return component;
+    }
+
+    auto component = new QQmlComponent(m_engine, url, mode, this);
+    QQmlEngine::setObjectOwnership(component, QQmlEngine::CppOwnership);
+
+    if (component->isError()) {
+        // Not cached, the caller reports the errors.
+        component->deleteLater();
+        return component;
+    }
+
+    m_components.insert(url, component);
+
+    if (component->isLoading()) {
+        connect(component, &QQmlComponent::statusChanged, this, [this, url, component](QQmlComponent::Status status) {
+            if (status == QQmlComponent::Error && m_components.value(url) == component) {
+                m_components.remove(url);
+                component->deleteLater();
+            }
+        });
+    }
+
+    return component;
+}
+
+QQmlComponent *PageComponentCache::component(const QString &url)
+{
+    return component(QUrl(url));
+}
+
+void PageComponentCache::clear()
+{
+    for (QQmlComponent *component : std::as_const(m_components)) {
+        component->deleteLater();
+    }
+    m_components.clear();
+}
+
+#include "moc_pagecomponentcache.cpp"
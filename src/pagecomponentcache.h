@@ -0,0 +1,63 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QQmlComponent>
+#include <QUrl>
+#include <qqmlregistration.h>
+
+class QQmlEngine;
+class QJSEngine;
+
+/**
+ * A cache of page components, shared by every PagePool and PageRow of a
+ * QML engine.
+ *
+ * Components are compiled once per url and kept for the lifetime of the
+ * engine, so that loading the same page from different pools, or again
+ * after it was deleted, does not compile it again.
+ *
+ * \internal This is private API, do not use.
+ */
+class PageComponentCache : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+public:
+    static PageComponentCache *instance(QQmlEngine *engine);
+    static PageComponentCache *create(QQmlEngine *engine, QJSEngine *);
+
+    /**
+     * @returns the component for @p url, creating it with @p mode if it is
+     * not in the cache yet.
+     *
+     * The component is owned by the cache and must not be deleted. Components
+     * that fail to load are removed from the cache so that the next call can
+     * try again.
+     */
+    QQmlComponent *component(const QUrl &url, QQmlComponent::CompilationMode mode = QQmlComponent::PreferSynchronous);
+
+    /**
+     * Same as above, for use from QML. Relative urls should be resolved by the
+     * caller.
+     */
+    Q_INVOKABLE QQmlComponent *component(const QString &url);
+
+    /**
+     * Removes all components from the cache.
+     */
+    Q_INVOKABLE void clear();
+
+private:
+    explicit PageComponentCache(QQmlEngine *engine);
+
+    QQmlEngine *m_engine;
+    QHash<QUrl, QQmlComponent *> m_components;
+};
@@ -6,21 +6,71 @@
 
 #include "pagepool.h"
 
+#include <QCoreApplication>
 #include <QDebug>
 #include <QQmlComponent>
 #include <QQmlContext>
 #include <QQmlEngine>
+#include <QQmlIncubator>
 #include <QQmlProperty>
 
 #include "loggingcategory.h"
+#include "pagecomponentcache.h"
+#include "platform/deferreddeletion_p.h"
+#include "platform/performancecounters_p.h"
+
+using Kirigami::Platform::PerformanceCounters;
+
+class PageIncubator : public QQmlIncubator
+{
+public:
+    PageIncubator(std::function<void(PageIncubator *)> finished)
+        : QQmlIncubator(QQmlIncubator::Asynchronous)
+        , m_finished(std::move(finished))
+    {
+    }
+
+protected:
+    void statusChanged(Status status) override
+    {
+        if (status == Ready || status == Error) {
+            m_finished(this);
+        }
+    }
+
+private:
+    std::function<void(PageIncubator *)> m_finished;
+};
+
+// An incubator cannot be deleted while it is reporting its status.
+static void deleteIncubatorLater(PageIncubator *incubator)
+{
+    QMetaObject::invokeMethod(
+        QCoreApplication::instance(),
+        [incubator] {
+            delete incubator;
+        },
+        Qt::QueuedConnection);
+}
 
 PagePool::PagePool(QObject *parent)
     : QObject(parent)
 {
+    connect(this, &PagePool::itemsChanged, this, [this]() {
+        PerformanceCounters::adjust(PerformanceCounters::PoolPages, m_itemForUrl.count() - m_reportedPages);
+        m_reportedPages = m_itemForUrl.count();
+    });
 }
 
 PagePool::~PagePool()
 {
+    PerformanceCounters::adjust(PerformanceCounters::PoolPages, -m_reportedPages);
+
+    const auto urls = m_preloads.keys();
+    for (const QUrl &url : urls) {
+        cancelPreload(url);
+    }
+    qDeleteAll(m_incubators);
 }
 
 QUrl PagePool::lastLoadedUrl() const
@@ -62,20 +112,76 @@ bool PagePool::cachePages() const
     return m_cachePages;
 }
 
+void PagePool::setAsynchronous(bool asynchronous)
+{
+    if (asynchronous == m_asynchronous) {
+        return;
+    }
+
+    m_asynchronous = asynchronous;
+    Q_EMIT asynchronousChanged();
+}
+
+bool PagePool::isAsynchronous() const
+{
+    return m_asynchronous;
+}
+
+void PagePool::setHibernatePages(bool hibernate)
+{
+    if (hibernate == m_hibernatePages) {
+        return;
+    }
+
+    m_hibernatePages = hibernate;
+    if (!hibernate) {
+        m_hibernatedPages.clear();
+    }
+    Q_EMIT hibernatePagesChanged();
+}
+
+bool PagePool::hibernatePages() const
+{
+    return m_hibernatePages;
+}
+
+void PagePool::setMaximumCachedPages(int pages)
+{
+    if (pages == m_maximumCachedPages) {
+        return;
+    }
+
+    m_maximumCachedPages = pages;
+    evictPages();
+    Q_EMIT maximumCachedPagesChanged();
+}
+
+int PagePool::maximumCachedPages() const
+{
+    return m_maximumCachedPages;
+}
+
 QQuickItem *PagePool::loadPage(const QString &url, QJSValue callback)
 {
     return loadPageWithProperties(url, QVariantMap(), callback);
 }
 
-QQuickItem *PagePool::loadPageWithProperties(const QString &url, const QVariantMap &properties, QJSValue callback)
+QQuickItem *PagePool::loadPageWithProperties(const QString &url, const QVariantMap &requestedProperties, QJSValue callback)
 {
     const auto engine = qmlEngine(this);
     Q_ASSERT(engine);
 
     const QUrl actualUrl = resolvedUrl(url);
 
+    // Rather than creating the page a second time, finish the preload if it is still incubating.
+    if (auto preload = m_preloads.constFind(actualUrl); preload != m_preloads.constEnd() && preload->incubator && preload->incubator->isLoading()) {
+        preload->incubator->forceCompletion();
+    }
+
     auto found = m_itemForUrl.find(actualUrl);
     if (found != m_itemForUrl.end()) {
+        m_recentUrls.removeOne(found.key());
+        m_recentUrls.append(found.key());
         m_lastLoadedUrl = found.key();
         m_lastLoadedItem = found.value();
 
@@ -94,36 +200,46 @@ QQuickItem *PagePool::loadPageWithProperties(const QString &url, const QVariantM
         }
     }
 
-    QQmlComponent *component = m_componentForUrl.value(actualUrl);
+    if (QQuickItem *item = takePreloadedPage(actualUrl, requestedProperties)) {
+        QQmlEngine::setObjectOwnership(item, QQmlEngine::JavaScriptOwnership);
+        finishLoading(actualUrl, item, callback);
+        return callback.isCallable() ? nullptr : item;
+    }
 
-    if (!component) {
-        component = new QQmlComponent(engine, actualUrl, QQmlComponent::PreferSynchronous);
+    // A hibernated page is recreated with the properties it had, the ones
+    // passed now take precedence.
+    QVariantMap properties = requestedProperties;
+    if (auto hibernated = m_hibernatedPages.find(actualUrl); hibernated != m_hibernatedPages.end()) {
+        properties = hibernated.value();
+        properties.insert(requestedProperties);
+        m_hibernatedPages.erase(hibernated);
     }
 
+    // Components are shared with all other pools and kept even when the pages are cached.
+    QQmlComponent *component = PageComponentCache::instance(engine)->component(actualUrl);
+
     if (component->status() == QQmlComponent::Loading) {
         if (!callback.isCallable()) {
-            component->deleteLater();
-            m_componentForUrl.remove(actualUrl);
             return nullptr;
         }
 
         connect(component, &QQmlComponent::statusChanged, this, [this, engine, component, callback, properties](QQmlComponent::Status status) mutable {
             if (status != QQmlComponent::Ready) {
                 qCWarning(KirigamiLog) << component->errors();
-                m_componentForUrl.remove(component->url());
-                component->deleteLater();
                 return;
             }
-            QQuickItem *item = createFromComponent(component, properties);
-            if (item) {
-                QJSValueList args = {engine->newQObject(item)};
-                callback.call(args);
-            }
 
-            if (m_cachePages) {
-                component->deleteLater();
+            auto finished = [engine, callback](QQuickItem *item) mutable {
+                if (item) {
+                    QJSValueList args = {engine->newQObject(item)};
+                    callback.call(args);
+                }
+            };
+
+            if (m_asynchronous) {
+                incubateFromComponent(component, properties, finished);
             } else {
-                m_componentForUrl[component->url()] = component;
+                finished(createFromComponent(component, properties));
             }
         });
 
@@ -134,36 +250,236 @@ QQuickItem *PagePool::loadPageWithProperties(const QString &url, const QVariantM
         return nullptr;
     }
 
+    if (m_asynchronous && callback.isCallable()) {
+        incubateFromComponent(component, properties, [this, actualUrl, properties, callback](QQuickItem *item) {
+            if (!item) {
+                return;
+            }
+            // With cachePages the page may have been loaded by another call in the meantime.
+            if (QQuickItem *existing = m_cachePages ? m_itemForUrl.value(actualUrl) : nullptr) {
+                item->deleteLater();
+                item = existing;
+            } else {
+                addPage(actualUrl, item, properties);
+            }
+            finishLoading(actualUrl, item, callback);
+        });
+        return nullptr;
+    }
+
     QQuickItem *item = createFromComponent(component, properties);
     if (!item) {
         return nullptr;
     }
 
+    addPage(actualUrl, item, properties);
+    finishLoading(actualUrl, item, callback);
+
+    // We could return the item when there is a callback, but for api coherence return null
+    return callback.isCallable() ? nullptr : item;
+}
+
+void PagePool::addPage(const QUrl &url, QQuickItem *item, const QVariantMap &properties)
+{
     if (m_cachePages) {
-        component->deleteLater();
-        QQmlEngine::setObjectOwnership(item, QQmlEngine::CppOwnership);
-        m_itemForUrl[component->url()] = item;
-        m_urlForItem[item] = component->url();
+        insertPage(url, item, properties);
+    } else {
+        QQmlEngine::setObjectOwnership(item, QQmlEngine::JavaScriptOwnership);
+    }
+}
+
+void PagePool::insertPage(const QUrl &url, QQuickItem *item, const QVariantMap &properties)
+{
+    QQmlEngine::setObjectOwnership(item, QQmlEngine::CppOwnership);
+    m_itemForUrl[url] = item;
+    m_urlForItem[item] = url;
+    m_propertiesForUrl[url] = properties;
+    m_recentUrls.append(url);
+
+    // Pages that could not be evicted while they were shown can be once they are removed.
+    connect(item, &QQuickItem::parentChanged, this, [this](QQuickItem *parent) {
+        if (!parent) {
+            evictPages();
+        }
+    });
+
+    Q_EMIT itemsChanged();
+    Q_EMIT urlsChanged();
+
+    evictPages();
+}
+
+void PagePool::evictPages()
+{
+    if (m_maximumCachedPages <= 0) {
+        return;
+    }
+
+    bool evicted = false;
+    for (auto it = m_recentUrls.begin(); it != m_recentUrls.end() && m_itemForUrl.count() > m_maximumCachedPages;) {
+        QQuickItem *item = m_itemForUrl.value(*it);
+        // Pages that have a parent are still in use by a ColumnView or some
+        // other stack, the most recent one is about to be used.
+        if (!item || item->parentItem() || item == m_lastLoadedItem || *it == m_recentUrls.constLast()) {
+            ++it;
+            continue;
+        }
+
+        const QUrl url = *it;
+        it = m_recentUrls.erase(it);
+        removePage(url, item, m_hibernatePages);
+        evicted = true;
+    }
+
+    if (evicted) {
         Q_EMIT itemsChanged();
         Q_EMIT urlsChanged();
+    }
+}
 
-    } else {
-        m_componentForUrl[component->url()] = component;
-        QQmlEngine::setObjectOwnership(item, QQmlEngine::JavaScriptOwnership);
+void PagePool::removePage(const QUrl &url, QQuickItem *item, bool hibernate)
+{
+    QVariantMap properties = m_propertiesForUrl.take(url);
+    if (hibernate) {
+        const QVariant state = item->property("hibernationState");
+        if (state.isValid()) {
+            properties.insert(QStringLiteral("hibernationState"), state);
+        }
+        m_hibernatedPages.insert(url, properties);
     }
 
-    m_lastLoadedUrl = actualUrl;
+    m_itemForUrl.remove(url);
+    m_urlForItem.remove(item);
+    m_recentUrls.removeOne(url);
+    disconnect(item, nullptr, this, nullptr);
+    Kirigami::Platform::DeferredDeletion::deleteLater(item);
+}
+
+void PagePool::finishLoading(const QUrl &url, QQuickItem *item, QJSValue callback)
+{
+    m_lastLoadedUrl = url;
     m_lastLoadedItem = item;
     Q_EMIT lastLoadedUrlChanged();
     Q_EMIT lastLoadedItemChanged();
 
     if (callback.isCallable()) {
-        QJSValueList args = {engine->newQObject(item)};
+        QJSValueList args = {qmlEngine(this)->newQObject(item)};
         callback.call(args);
-        // We could return the item, but for api coherence return null
+    }
+}
+
+void PagePool::preload(const QString &url, const QVariantMap &properties)
+{
+    const auto engine = qmlEngine(this);
+    Q_ASSERT(engine);
+
+    const QUrl actualUrl = resolvedUrl(url);
+    if (m_itemForUrl.contains(actualUrl) || m_preloadedPages.contains(actualUrl) || m_preloads.contains(actualUrl)) {
+        return;
+    }
+
+    Preload preload;
+    preload.properties = properties;
+    preload.component = PageComponentCache::instance(engine)->component(actualUrl, QQmlComponent::Asynchronous);
+    m_preloads.insert(actualUrl, preload);
+
+    if (preload.component->isLoading()) {
+        connect(preload.component, &QQmlComponent::statusChanged, this, [this, actualUrl](QQmlComponent::Status status) {
+            if (status != QQmlComponent::Loading) {
+                incubatePreload(actualUrl);
+            }
+        });
+    } else {
+        incubatePreload(actualUrl);
+    }
+}
+
+void PagePool::incubatePreload(const QUrl &url)
+{
+    auto it = m_preloads.find(url);
+    if (it == m_preloads.end() || it->incubator) {
+        return;
+    }
+
+    QQmlComponent *component = it->component;
+    if (!component->isReady()) {
+        qCWarning(KirigamiLog) << component->errors();
+        cancelPreload(url);
+        return;
+    }
+
+    PageIncubator *incubator = new PageIncubator([this, url](PageIncubator *) {
+        finishPreload(url);
+    });
+    incubator->setInitialProperties(it->properties);
+    it->incubator = incubator;
+
+    // Without an incubation controller on the engine this completes right away.
+    component->create(*incubator, qmlContext(this));
+}
+
+void PagePool::finishPreload(const QUrl &url)
+{
+    const Preload preload = m_preloads.take(url);
+
+    QObject *obj = preload.incubator->object();
+    if (preload.incubator->isError()) {
+        qCWarning(KirigamiLog) << preload.incubator->errors();
+    }
+
+    QQuickItem *item = qobject_cast<QQuickItem *>(obj);
+    if (obj && !item) {
+        qCWarning(KirigamiLog) << "Storing Non-QQuickItem in PagePool not supported";
+        obj->deleteLater();
+    }
+
+    deleteIncubatorLater(preload.incubator);
+
+    if (!item) {
+        return;
+    }
+
+    // Until the page is requested nothing else references it, so keep it from
+    // being garbage collected.
+    QQmlEngine::setObjectOwnership(item, QQmlEngine::CppOwnership);
+
+    if (m_cachePages) {
+        if (m_itemForUrl.contains(url)) {
+            // The page was loaded in the meantime.
+            item->deleteLater();
+            return;
+        }
+        insertPage(url, item, preload.properties);
+    } else {
+        m_preloadedPages.insert(url, PreloadedPage{item, preload.properties});
+    }
+
+    Q_EMIT preloaded(url);
+}
+
+void PagePool::cancelPreload(const QUrl &url)
+{
+    const Preload preload = m_preloads.take(url);
+    if (preload.incubator) {
+        // Deletes any partially created page as well.
+        preload.incubator->clear();
+        delete preload.incubator;
+    }
+}
+
+QQuickItem *PagePool::takePreloadedPage(const QUrl &url, const QVariantMap &properties)
+{
+    const PreloadedPage page = m_preloadedPages.take(url);
+    if (!page.item) {
         return nullptr;
     }
-    return item;
+
+    if (page.properties != properties) {
+        page.item->deleteLater();
+        return nullptr;
+    }
+
+    return page.item;
 }
 
 QQuickItem *PagePool::createFromComponent(QQmlComponent *component, const QVariantMap &properties)
@@ -191,6 +507,34 @@ QQuickItem *PagePool::createFromComponent(QQmlComponent *component, const QVaria
     return item;
 }
 
+void PagePool::incubateFromComponent(QQmlComponent *component, const QVariantMap &properties, const std::function<void(QQuickItem *)> &finished)
+{
+    const auto ctx = qmlContext(this);
+    Q_ASSERT(ctx);
+
+    auto incubator = new PageIncubator([this, finished](PageIncubator *incubator) {
+        m_incubators.remove(incubator);
+
+        QObject *obj = incubator->object();
+        if (incubator->isError()) {
+            qCWarning(KirigamiLog) << incubator->errors();
+        }
+
+        QQuickItem *item = qobject_cast<QQuickItem *>(obj);
+        if (obj && !item) {
+            qCWarning(KirigamiLog) << "Storing Non-QQuickItem in PagePool not supported";
+            obj->deleteLater();
+        }
+
+        deleteIncubatorLater(incubator);
+        finished(item);
+    });
+    incubator->setInitialProperties(properties);
+    m_incubators.insert(incubator);
+
+    component->create(*incubator, ctx);
+}
+
 QUrl PagePool::resolvedUrl(const QString &stringUrl) const
 {
     const auto ctx = qmlContext(this);
@@ -234,6 +578,10 @@ bool PagePool::contains(const QVariant &page) const
 
 void PagePool::deletePage(const QVariant &page)
 {
+    if (!page.canConvert<QQuickItem *>() && page.canConvert<QString>()) {
+        m_hibernatedPages.remove(resolvedUrl(page.value<QString>()));
+    }
+
     if (!contains(page)) {
         return;
     }
@@ -265,28 +613,83 @@ void PagePool::deletePage(const QVariant &page)
 
     m_itemForUrl.remove(url);
     m_urlForItem.remove(item);
-    item->deleteLater();
+    m_propertiesForUrl.remove(url);
+    m_recentUrls.removeOne(url);
+    disconnect(item, nullptr, this, nullptr);
+    // Pages still shown somewhere are deleted right away, as they would stay
+    // visible otherwise.
+    if (item->parentItem()) {
+        item->deleteLater();
+    } else {
+        Kirigami::Platform::DeferredDeletion::deleteLater(item);
+    }
 
     Q_EMIT itemsChanged();
     Q_EMIT urlsChanged();
 }
 
+bool PagePool::hibernatePage(const QVariant &page)
+{
+    if (!m_cachePages || !contains(page)) {
+        return false;
+    }
+
+    QQuickItem *item = nullptr;
+    if (page.canConvert<QQuickItem *>()) {
+        item = page.value<QQuickItem *>();
+    } else if (page.canConvert<QString>()) {
+        item = m_itemForUrl.value(resolvedUrl(page.value<QString>()));
+    }
+
+    if (!item || item->parentItem()) {
+        return false;
+    }
+
+    removePage(m_urlForItem.value(item), item, true);
+    if (item == m_lastLoadedItem) {
+        m_lastLoadedItem = nullptr;
+        Q_EMIT lastLoadedItemChanged();
+    }
+
+    Q_EMIT itemsChanged();
+    Q_EMIT urlsChanged();
+    return true;
+}
+
+bool PagePool::isHibernated(const QString &url) const
+{
+    return m_hibernatedPages.contains(resolvedUrl(url));
+}
+
 void PagePool::clear()
 {
-    for (const auto &component : std::as_const(m_componentForUrl)) {
-        component->deleteLater();
+    const auto preloadUrls = m_preloads.keys();
+    for (const QUrl &url : preloadUrls) {
+        cancelPreload(url);
     }
-    m_componentForUrl.clear();
+    // Deleting an incubator also deletes the page it was creating.
+    qDeleteAll(m_incubators);
+    m_incubators.clear();
+    for (const auto &page : std::as_const(m_preloadedPages)) {
+        if (page.item) {
+            page.item->deleteLater();
+        }
+    }
+    m_preloadedPages.clear();
 
     for (const auto &item : std::as_const(m_itemForUrl)) {
         // items that had been deparented are safe to delete
         if (!item->parentItem()) {
-            item->deleteLater();
+            Kirigami::Platform::DeferredDeletion::deleteLater(item);
         }
         QQmlEngine::setObjectOwnership(item, QQmlEngine::JavaScriptOwnership);
+        disconnect(item, nullptr, this, nullptr);
     }
     m_itemForUrl.clear();
     m_urlForItem.clear();
+    m_propertiesForUrl.clear();
+    m_hibernatedPages.clear();
+    m_recentUrls.clear();
     m_lastLoadedUrl = QUrl();
     m_lastLoadedItem = nullptr;
 
@@ -8,6 +8,12 @@
 #include <QObject>
 #include <QPointer>
 #include <QQuickItem>
+#include <QSet>
+
+#include <functional>
+
+class QQmlComponent;
+class PageIncubator;
 
 /**
  * A Pool of Page items, pages will be unique per url and the items
@@ -51,11 +57,61 @@ class PagePool : public QObject
      * If true (default) the pages will be kept around, will have C++ ownership and
      * only one instance per page will be created.
      * If false the pages will have Javascript ownership (thus deleted on pop by the
-     * page stacks) and each call to loadPage will create a new page instance. When
-     * cachePages is false, Components get cached nevertheless.
+     * page stacks) and each call to loadPage will create a new page instance.
+     * Components are cached in either case and shared by all pools of the same engine.
      */
     Q_PROPERTY(bool cachePages READ cachePages WRITE setCachePages NOTIFY cachePagesChanged FINAL)
 
+    /**
+     * The maximum number of pages kept around when cachePages is true.
+     *
+     * When more pages are loaded, the least recently loaded pages are
+     * deleted. Pages that are still in use, i.e. that are shown in a
+     * ColumnView or any other item, and the last loaded page are never
+     * deleted, so the pool can temporarily contain more pages than this.
+     *
+     * A value of 0 or less means no limit.
+     *
+     * default: ``0``
+     *
+     * @since 6.12
+     */
+    Q_PROPERTY(int maximumCachedPages READ maximumCachedPages WRITE setMaximumCachedPages NOTIFY maximumCachedPagesChanged FINAL)
+
+    /**
+     * If true, pages loaded with a callback are created asynchronously: the
+     * creation is spread over several frames by the engine's incubation
+     * controller and the callback is called once the page is complete.
+     * If false, pages are created synchronously and only loading the
+     * component of a remote url is asynchronous.
+     *
+     * This has no effect on loadPage() calls without a callback.
+     *
+     * default: ``false``
+     *
+     * @since 6.12
+     */
+    Q_PROPERTY(bool asynchronous READ isAsynchronous WRITE setAsynchronous NOTIFY asynchronousChanged FINAL)
+
+    /**
+     * If true, pages evicted because of maximumCachedPages are hibernated
+     * instead of being forgotten: their item is deleted, but the properties
+     * they were loaded with are kept, so that loading them again recreates
+     * them in the same state.
+     *
+     * Pages can keep state of their own across hibernation by declaring a
+     * `hibernationState` property: its value when the page is hibernated is
+     * passed back as an initial property when the page is recreated.
+     *
+     * This has no effect when cachePages is false.
+     *
+     * default: ``false``
+     *
+     * @see hibernatePage()
+     * @since 6.12
+     */
+    Q_PROPERTY(bool hibernatePages READ hibernatePages WRITE setHibernatePages NOTIFY hibernatePagesChanged FINAL)
+
 public:
     PagePool(QObject *parent = nullptr);
     ~PagePool() override;
@@ -68,6 +124,15 @@ public:
     void setCachePages(bool cache);
     bool cachePages() const;
 
+    void setMaximumCachedPages(int pages);
+    int maximumCachedPages() const;
+
+    void setAsynchronous(bool asynchronous);
+    bool isAsynchronous() const;
+
+    void setHibernatePages(bool hibernate);
+    bool hibernatePages() const;
+
     /**
      * Returns the instance of the item defined in the QML file identified
      * by url, only one instance will be made per url if cachePAges is true.
@@ -89,6 +154,26 @@ public:
 
     Q_INVOKABLE QQuickItem *loadPageWithProperties(const QString &url, const QVariantMap &properties, QJSValue callback = QJSValue());
 
+    /**
+     * Starts loading the page identified by url in the background, so that
+     * a later call to loadPage() or loadPageWithProperties() for the same url
+     * returns immediately.
+     *
+     * The component is compiled and the page is incubated asynchronously,
+     * spread over several frames. If the page is requested before the preload
+     * is done, the remaining work is finished right away.
+     *
+     * If cachePages is false, the preloaded page is only used if it is
+     * requested with the same properties it was preloaded with.
+     *
+     * @param url full url of the item, as for loadPage()
+     * @param properties the initial properties of the page
+     *
+     * @see preloaded()
+     * @since 6.12
+     */
+    Q_INVOKABLE void preload(const QString &url, const QVariantMap &properties = QVariantMap());
+
     /**
      * @returns The url of the page for the given instance, empty if there is no correspondence
      */
@@ -111,6 +196,24 @@ public:
      */
     Q_INVOKABLE void deletePage(const QVariant &page);
 
+    /**
+     * Deletes the item of a page while keeping the state needed to recreate
+     * it, as described for hibernatePages. Loading the page again recreates it.
+     *
+     * Pages that are shown, i.e. that have a parent item, can't be hibernated.
+     *
+     * @param page either the url or the instance of the page
+     * @returns true if the page has been hibernated
+     * @since 6.12
+     */
+    Q_INVOKABLE bool hibernatePage(const QVariant &page);
+
+    /**
+     * @returns true if the page identified by url is hibernated
+     * @since 6.12
+     */
+    Q_INVOKABLE bool isHibernated(const QString &url) const;
+
     /**
      * @returns full url from an absolute or relative path
      */
@@ -133,15 +236,60 @@ Q_SIGNALS:
     void itemsChanged();
     void urlsChanged();
     void cachePagesChanged();
+    void maximumCachedPagesChanged();
+    void asynchronousChanged();
+    void hibernatePagesChanged();
+
+    /**
+     * Emitted when preloading the page identified by url is done.
+     * @since 6.12
+     */
+    void preloaded(const QUrl &url);
 
 private:
+    struct Preload {
+        QQmlComponent *component = nullptr;
+        PageIncubator *incubator = nullptr;
+        QVariantMap properties;
+    };
+
+    struct PreloadedPage {
+        QPointer<QQuickItem> item;
+        QVariantMap properties;
+    };
+
     QQuickItem *createFromComponent(QQmlComponent *component, const QVariantMap &properties);
+    void incubateFromComponent(QQmlComponent *component, const QVariantMap &properties, const std::function<void(QQuickItem *)> &finished);
+    void addPage(const QUrl &url, QQuickItem *item, const QVariantMap &properties);
+    void insertPage(const QUrl &url, QQuickItem *item, const QVariantMap &properties);
+    void removePage(const QUrl &url, QQuickItem *item, bool hibernate);
+    void evictPages();
+    void finishLoading(const QUrl &url, QQuickItem *item, QJSValue callback);
+    void incubatePreload(const QUrl &url);
+    void finishPreload(const QUrl &url);
+    void cancelPreload(const QUrl &url);
+    QQuickItem *takePreloadedPage(const QUrl &url, const QVariantMap &properties);
 
     QUrl m_lastLoadedUrl;
     QPointer<QQuickItem> m_lastLoadedItem;
     QHash<QUrl, QQuickItem *> m_itemForUrl;
-    QHash<QUrl, QQmlComponent *> m_componentForUrl;
     QHash<QQuickItem *, QUrl> m_urlForItem;
+    // Cached page urls, least recently loaded first.
+    QList<QUrl> m_recentUrls;
+    QHash<QUrl, Preload> m_preloads;
+    // Only used when cachePages is false, otherwise preloaded pages go to m_itemForUrl.
+    QHash<QUrl, PreloadedPage> m_preloadedPages;
+    // The initial properties of the pages in m_itemForUrl.
+    QHash<QUrl, QVariantMap> m_propertiesForUrl;
+    // The initial properties to recreate hibernated pages with.
+    QHash<QUrl, QVariantMap> m_hibernatedPages;
+    // Pages created asynchronously for a callback.
+    QSet<PageIncubator *> m_incubators;
 
     bool m_cachePages = true;
+    bool m_asynchronous = false;
+    bool m_hibernatePages = false;
+    int m_maximumCachedPages = 0;
+    // The number of pages reported to PerformanceCounters.
+    qsizetype m_reportedPages = 0;
 };
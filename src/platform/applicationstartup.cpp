@@ -0,0 +1,117 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "applicationstartup.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QQmlApplicationEngine>
+#include <QQmlComponent>
+#include <QQuickGraphicsConfiguration>
+#include <QQuickWindow>
+#include <QStandardPaths>
+
+#include <memory>
+
+#include "kirigamiplatform_startup_logging.h"
+
+namespace Kirigami
+{
+namespace Platform
+{
+
+// Creates the Kirigami singletons and the theme of the platform plugin,
+// which loads the plugin, the same way the first items using them would.
+static const char s_warmUpSource[] =
+    "import QtQml\n"
+    "import org.kde.kirigami.platform as Platform\n"
+    "QtObject {\n"
+    "    readonly property real gridUnit: Platform.Units.gridUnit\n"
+    "    readonly property bool isMobile: Platform.Settings.isMobile\n"
+    "    readonly property color textColor: Platform.Theme.textColor\n"
+    "}\n";
+
+void ApplicationStartup::enablePipelineCache(QQmlApplicationEngine *engine)
+{
+    Q_ASSERT(engine);
+
+    if (QCoreApplication::testAttribute(Qt::AA_DisableShaderDiskCache)) {
+        return;
+    }
+
+    // Don't override the choice of the user, which Qt applies by itself.
+    if (qEnvironmentVariableIsSet("QSG_RHI_PIPELINE_CACHE_SAVE") || qEnvironmentVariableIsSet("QSG_RHI_PIPELINE_CACHE_LOAD")) {
+        return;
+    }
+
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (cacheDir.isEmpty() || !QDir().mkpath(cacheDir)) {
+        qCWarning(KirigamiPlatformStartup) << "Cannot create the cache directory, not caching graphics pipelines";
+        return;
+    }
+
+    // Qt checks that the cache was written for the same graphics API, device
+    // and driver before using it, and otherwise starts from an empty cache.
+    // This is set on the windows rather than through the environment, which
+    // would be inherited by the processes the application starts.
+    const QString cacheFile = cacheDir + QStringLiteral("/kirigami-pipelines.cache");
+
+    // Root windows are created, and possibly shown, while loading, but they
+    // are only exposed, which initializes their scene graph, once the event
+    // loop runs. Only the first window uses the cache, as every window would
+    // overwrite the file with its own pipelines when it is destroyed.
+    auto connection = std::make_shared<QMetaObject::Connection>();
+    *connection = QObject::connect(engine, &QQmlApplicationEngine::objectCreated, engine, [connection, cacheFile](QObject *object) {
+        auto window = qobject_cast<QQuickWindow *>(object);
+        if (!window) {
+            return;
+        }
+        QObject::disconnect(*connection);
+
+        if (window->isSceneGraphInitialized()) {
+            qCWarning(KirigamiPlatformStartup) << "The scene graph of" << window << "is already initialized, not caching graphics pipelines";
+            return;
+        }
+
+        QQuickGraphicsConfiguration config = window->graphicsConfiguration();
+        config.setPipelineCacheSaveFile(cacheFile);
+        if (QFileInfo::exists(cacheFile)) {
+            config.setPipelineCacheLoadFile(cacheFile);
+        }
+        window->setGraphicsConfiguration(config);
+    });
+}
+
+void ApplicationStartup::loadFromModule(QQmlApplicationEngine *engine, QAnyStringView uri, QAnyStringView typeName)
+{
+    Q_ASSERT(engine);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Start loading and compiling the type, and the modules it imports, on
+    // the loader thread of the engine.
+    QQmlComponent component(engine);
+    component.loadFromModule(uri, typeName, QQmlComponent::Asynchronous);
+
+    QQmlComponent warmUp(engine);
+    warmUp.setData(QByteArray(s_warmUpSource), QUrl());
+    std::unique_ptr<QObject> warmUpObject(warmUp.create());
+    if (!warmUpObject) {
+        qCWarning(KirigamiPlatformStartup) << "Failed to create the Kirigami singletons:" << warmUp.errors();
+    }
+    qCDebug(KirigamiPlatformStartup) << "Creating the Kirigami singletons took" << timer.nsecsElapsed() / 1000000.0 << "ms";
+
+    // This reuses the compilation started above, only waiting for what is
+    // left of it.
+    engine->loadFromModule(uri, typeName);
+    qCDebug(KirigamiPlatformStartup) << "Loading" << typeName.toString() << "took" << timer.nsecsElapsed() / 1000000.0 << "ms";
+}
+
+}
+}
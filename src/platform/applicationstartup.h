@@ -0,0 +1,68 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef KIRIGAMI_APPLICATIONSTARTUP_H
+#define KIRIGAMI_APPLICATIONSTARTUP_H
+
+#include <QAnyStringView>
+
+#include "kirigamiplatform_export.h"
+
+class QQmlApplicationEngine;
+
+namespace Kirigami
+{
+namespace Platform
+{
+
+/**
+ * @class ApplicationStartup applicationstartup.h <Kirigami/ApplicationStartup>
+ *
+ * Helpers to start a Kirigami application quickly, meant to be used in its
+ * main() function instead of loading the main QML file directly:
+ *
+ * @code
+ * QQmlApplicationEngine engine;
+ * Kirigami::Platform::ApplicationStartup::enablePipelineCache(&engine);
+ * Kirigami::Platform::ApplicationStartup::loadFromModule(&engine, "org.kde.example", "Main");
+ * @endcode
+ *
+ * @since 6.12
+ */
+class KIRIGAMIPLATFORM_EXPORT ApplicationStartup
+{
+public:
+    /**
+     * Makes the first window loaded as a root object of @p engine keep the
+     * graphics pipelines it compiles in a file in the cache location of the
+     * application, so that later runs don't need to compile them again before
+     * showing their first frame.
+     *
+     * This needs to be called after the application name is set and before
+     * the root objects are loaded. It has no effect when
+     * Qt::AA_DisableShaderDiskCache is set, or when the
+     * `QSG_RHI_PIPELINE_CACHE_SAVE` or `QSG_RHI_PIPELINE_CACHE_LOAD`
+     * environment variables are set.
+     */
+    static void enablePipelineCache(QQmlApplicationEngine *engine);
+
+    /**
+     * Loads the QML type @p typeName of the module @p uri as a root object of
+     * @p engine, like QQmlApplicationEngine::loadFromModule().
+     *
+     * The type and its imports are compiled on the QML loader thread while the
+     * Kirigami singletons, Units and Settings, and the platform plugin and
+     * theme for the current style are created on the calling thread, so that
+     * both don't add up. Check QQmlApplicationEngine::rootObjects() to know
+     * whether loading succeeded.
+     */
+    static void loadFromModule(QQmlApplicationEngine *engine, QAnyStringView uri, QAnyStringView typeName);
+};
+
+}
+}
+
+#endif // KIRIGAMI_APPLICATIONSTARTUP_H
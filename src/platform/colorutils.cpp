@@ -6,8 +6,10 @@
 
 #include "colorutils.h"
 
+#include <QHash>
 #include <QIcon>
 #include <QtMath>
+#include <array>
 #include <cmath>
 #include <map>
 
@@ -79,60 +81,108 @@ QColor ColorUtils::linearInterpolation(const QColor &one, const QColor &two, dou
     return QColor::fromHsvF(hue, saturation, value, alpha);
 }
 
-// Some private things for the adjust, change, and scale properties
-struct ParsedAdjustments {
-    double red = 0.0;
-    double green = 0.0;
-    double blue = 0.0;
-
-    double hue = 0.0;
-    double saturation = 0.0;
-    double value = 0.0;
+static ColorUtils::Adjustments parseAdjustments(const QJSValue &value)
+{
+    ColorUtils::Adjustments parsed;
 
-    double alpha = 0.0;
-};
+    if (!value.isObject()) {
+        return parsed;
+    }
 
-ParsedAdjustments parseAdjustments(const QJSValue &value)
-{
-    ParsedAdjustments parsed;
-
-    auto checkProperty = [](const QJSValue &value, const QString &property) {
-        if (value.hasProperty(property)) {
-            auto val = value.property(property);
-            if (val.isNumber()) {
-                return QVariant::fromValue(val.toNumber());
-            }
-        }
-        return QVariant();
+    static const std::pair<QString, double ColorUtils::Adjustments::*> items[] = {
+        {QStringLiteral("red"), &ColorUtils::Adjustments::red},
+        {QStringLiteral("green"), &ColorUtils::Adjustments::green},
+        {QStringLiteral("blue"), &ColorUtils::Adjustments::blue},
+        //
+        {QStringLiteral("hue"), &ColorUtils::Adjustments::hue},
+        {QStringLiteral("saturation"), &ColorUtils::Adjustments::saturation},
+        {QStringLiteral("value"), &ColorUtils::Adjustments::value},
+        //
+        {QStringLiteral("alpha"), &ColorUtils::Adjustments::alpha},
     };
 
-    std::vector<std::pair<QString, double &>> items{{QStringLiteral("red"), parsed.red},
-                                                    {QStringLiteral("green"), parsed.green},
-                                                    {QStringLiteral("blue"), parsed.blue},
-                                                    //
-                                                    {QStringLiteral("hue"), parsed.hue},
-                                                    {QStringLiteral("saturation"), parsed.saturation},
-                                                    {QStringLiteral("value"), parsed.value},
-                                                    //
-                                                    {QStringLiteral("alpha"), parsed.alpha}};
-
-    for (const auto &item : items) {
-        auto val = checkProperty(value, item.first);
-        if (val.isValid()) {
-            item.second = val.toDouble();
+    for (const auto &[name, member] : items) {
+        // Missing properties are undefined, which is not a number.
+        const QJSValue property = value.property(name);
+        if (property.isNumber()) {
+            parsed.*member = property.toNumber();
         }
     }
 
-    if ((parsed.red || parsed.green || parsed.blue) && (parsed.hue || parsed.saturation || parsed.value)) {
-        qCCritical(KirigamiPlatform) << "It is an error to have both RGB and HSV values in an adjustment.";
+    return parsed;
+}
+
+namespace
+{
+// The results of adjustColor() and scaleColor() are cached, as they are
+// mostly used in bindings that are evaluated again with the same arguments
+// whenever the theme changes.
+struct AdjustmentKey {
+    bool scale;
+    QColor::Spec spec;
+    QRgba64 color;
+    std::array<double, 7> adjustments;
+
+    bool operator==(const AdjustmentKey &other) const
+    {
+        return scale == other.scale && spec == other.spec && color == other.color && adjustments == other.adjustments;
     }
+};
 
-    return parsed;
+size_t qHash(const AdjustmentKey &key, size_t seed = 0)
+{
+    seed = qHashMulti(seed, key.scale, int(key.spec), quint64(key.color));
+    return qHashRange(key.adjustments.begin(), key.adjustments.end(), seed);
+}
+
+constexpr qsizetype maximumCachedAdjustments = 512;
+
+AdjustmentKey adjustmentKey(bool scale, const QColor &color, const ColorUtils::Adjustments &adjusts)
+{
+    return AdjustmentKey{scale,
+                         color.spec(),
+                         color.rgba64(),
+                         {adjusts.red, adjusts.green, adjusts.blue, adjusts.hue, adjusts.saturation, adjusts.value, adjusts.alpha}};
+}
+
+QHash<AdjustmentKey, QColor> &adjustmentCache()
+{
+    static QHash<AdjustmentKey, QColor> cache;
+    return cache;
+}
+
+void insertAdjustment(const AdjustmentKey &key, const QColor &color)
+{
+    auto &cache = adjustmentCache();
+    // Theme changes produce a new set of colors, so there is no point in
+    // tracking which entries are still in use.
+    if (cache.size() >= maximumCachedAdjustments) {
+        cache.clear();
+    }
+    cache.insert(key, color);
+}
 }
 
 QColor ColorUtils::adjustColor(const QColor &color, const QJSValue &adjustments)
 {
-    auto adjusts = parseAdjustments(adjustments);
+    return adjustColor(color, parseAdjustments(adjustments));
+}
+
+QColor ColorUtils::scaleColor(const QColor &color, const QJSValue &adjustments)
+{
+    return scaleColor(color, parseAdjustments(adjustments));
+}
+
+QColor ColorUtils::adjustColor(const QColor &color, const Adjustments &adjusts)
+{
+    const auto key = adjustmentKey(false, color, adjusts);
+    if (auto itr = adjustmentCache().constFind(key); itr != adjustmentCache().constEnd()) {
+        return *itr;
+    }
+
+    if ((adjusts.red || adjusts.green || adjusts.blue) && (adjusts.hue || adjusts.saturation || adjusts.value)) {
+        qCCritical(KirigamiPlatform) << "It is an error to have both RGB and HSV values in an adjustment.";
+    }
 
     if (qBound(-360.0, adjusts.hue, 360.0) != adjusts.hue) {
         qCCritical(KirigamiPlatform) << "Hue is out of bounds";
@@ -173,12 +223,21 @@ QColor ColorUtils::adjustColor(const QColor &color, const QJSValue &adjustments)
                     copy.alpha());
     }
 
+    insertAdjustment(key, copy);
     return copy;
 }
 
-QColor ColorUtils::scaleColor(const QColor &color, const QJSValue &adjustments)
+QColor ColorUtils::scaleColor(const QColor &color, const Adjustments &adjusts)
 {
-    auto adjusts = parseAdjustments(adjustments);
+    const auto key = adjustmentKey(true, color, adjusts);
+    if (auto itr = adjustmentCache().constFind(key); itr != adjustmentCache().constEnd()) {
+        return *itr;
+    }
+
+    if ((adjusts.red || adjusts.green || adjusts.blue) && (adjusts.hue || adjusts.saturation || adjusts.value)) {
+        qCCritical(KirigamiPlatform) << "It is an error to have both RGB and HSV values in an adjustment.";
+    }
+
     auto copy = color;
 
     if (qBound(-100.0, adjusts.red, 100.00) != adjusts.red) {
@@ -224,6 +283,7 @@ QColor ColorUtils::scaleColor(const QColor &color, const QJSValue &adjustments)
                     copy.alpha());
     }
 
+    insertAdjustment(key, copy);
     return copy;
 }
 
@@ -301,6 +361,57 @@ ColorUtils::LabColor ColorUtils::colorToLab(const QColor &color)
     return labColor;
 }
 
+// Linear space values of all 8 bit sRGB channel values.
+static const std::array<qreal, 256> &linearTable()
+{
+    static const std::array<qreal, 256> table = []() {
+        std::array<qreal, 256> table;
+        for (int i = 0; i < 256; ++i) {
+            const qreal v = i / 255.0;
+            table[i] = v > 0.04045 ? std::pow((v + 0.055) / 1.055, 2.4) : v / 12.92;
+        }
+        return table;
+    }();
+    return table;
+}
+
+static inline qreal labPivot(qreal v)
+{
+    return v > 0.008856 ? std::cbrt(v) : (7.787 * v) + (16.0 / 116.0);
+}
+
+ColorUtils::LabColor ColorUtils::rgbToLab(QRgb rgb)
+{
+    const auto &linear = linearTable();
+    const qreal r = linear[qRed(rgb)];
+    const qreal g = linear[qGreen(rgb)];
+    const qreal b = linear[qBlue(rgb)];
+
+    // The same as colorToXYZ() and colorToLab().
+    const qreal x = labPivot((r * 0.4124 + g * 0.3576 + b * 0.1805) / 0.95047);
+    const qreal y = labPivot(r * 0.2126 + g * 0.7152 + b * 0.0722);
+    const qreal z = labPivot((r * 0.0193 + g * 0.1192 + b * 0.9505) / 1.08883);
+
+    LabColor labColor;
+    labColor.l = std::max(0.0, (116 * y) - 16);
+    labColor.a = 500 * (x - y);
+    labColor.b = 200 * (y - z);
+    return labColor;
+}
+
+void ColorUtils::rgbToLab(const QRgb *colors, qsizetype count, LabColor *result)
+{
+    for (qsizetype i = 0; i < count; ++i) {
+        result[i] = rgbToLab(colors[i]);
+    }
+}
+
+qreal ColorUtils::rgbChroma(QRgb rgb)
+{
+    const LabColor labColor = rgbToLab(rgb);
+    return std::hypot(labColor.a, labColor.b);
+}
+
 qreal ColorUtils::chroma(const QColor &color)
 {
     LabColor labColor = colorToLab(color);
@@ -309,6 +420,78 @@ qreal ColorUtils::chroma(const QColor &color)
     return sqrt(pow(labColor.a, 2) + pow(labColor.b, 2));
 }
 
+QList<qreal> ColorUtils::grayForColors(const QList<QColor> &colors)
+{
+    QList<qreal> result(colors.size());
+    for (qsizetype i = 0; i < colors.size(); ++i) {
+        const QRgb rgb = colors[i].rgb();
+        result[i] = (0.299 * qRed(rgb) + 0.587 * qGreen(rgb) + 0.114 * qBlue(rgb)) / 255;
+    }
+    return result;
+}
+
+QList<QColor> ColorUtils::linearInterpolations(const QColor &one, const QColor &two, const QList<double> &balances)
+{
+    // Same as linearInterpolation(), with everything that doesn't depend on
+    // the balance done once.
+    const double sourceHue = std::max(one.hueF() > 0.0 ? one.hueF() : two.hueF(), 0.0f);
+    const double targetHue = std::max(two.hueF() > 0.0 ? two.hueF() : one.hueF(), 0.0f);
+    const double hueDelta = targetHue - sourceHue;
+    const double sourceSaturation = one.saturationF();
+    const double saturationDelta = two.saturationF() - sourceSaturation;
+    const double sourceValue = one.valueF();
+    const double valueDelta = two.valueF() - sourceValue;
+    const double sourceAlpha = one.alphaF();
+    const double alphaDelta = two.alphaF() - sourceAlpha;
+
+    QList<QColor> result(balances.size());
+    for (qsizetype i = 0; i < balances.size(); ++i) {
+        const double balance = balances[i];
+        result[i] = QColor::fromHsvF(std::fmod(sourceHue + hueDelta * balance, 1.0),
+                                     std::clamp(sourceSaturation + saturationDelta * balance, 0.0, 1.0),
+                                     std::clamp(sourceValue + valueDelta * balance, 0.0, 1.0),
+                                     std::clamp(sourceAlpha + alphaDelta * balance, 0.0, 1.0));
+    }
+    return result;
+}
+
+QList<QColor> ColorUtils::tintColorsWithAlpha(const QList<QColor> &targetColors, const QColor &tintColor, double alpha)
+{
+    const qreal tintAlpha = tintColor.alphaF() * alpha;
+
+    if (qFuzzyCompare(tintAlpha, 1.0)) {
+        return QList<QColor>(targetColors.size(), tintColor);
+    } else if (qFuzzyIsNull(tintAlpha)) {
+        return targetColors;
+    }
+
+    const qreal inverseAlpha = 1.0 - tintAlpha;
+    const qreal red = tintColor.redF() * tintAlpha;
+    const qreal green = tintColor.greenF() * tintAlpha;
+    const qreal blue = tintColor.blueF() * tintAlpha;
+
+    QList<QColor> result(targetColors.size());
+    for (qsizetype i = 0; i < targetColors.size(); ++i) {
+        float targetRed, targetGreen, targetBlue, targetAlpha;
+        targetColors[i].getRgbF(&targetRed, &targetGreen, &targetBlue, &targetAlpha);
+        result[i] = QColor::fromRgbF(red + targetRed * inverseAlpha,
+                                     green + targetGreen * inverseAlpha,
+                                     blue + targetBlue * inverseAlpha,
+                                     tintAlpha + inverseAlpha * targetAlpha);
+    }
+    return result;
+}
+
+QList<qreal> ColorUtils::chromaForColors(const QList<QColor> &colors)
+{
+    QList<qreal> result(colors.size());
+    for (qsizetype i = 0; i < colors.size(); ++i) {
+        const LabColor labColor = colorToLab(colors[i]);
+        result[i] = std::hypot(labColor.a, labColor.b);
+    }
+    return result;
+}
+
 qreal ColorUtils::luminance(const QColor &color)
 {
     const auto &xyz = colorToXYZ(color);
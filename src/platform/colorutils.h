@@ -196,6 +196,79 @@ public:
      */
     Q_INVOKABLE static qreal chroma(const QColor &color);
 
+    /**
+     * Returns the result of grayForColor() for each color in @p colors.
+     *
+     * This avoids calling into C++ once per color when processing many colors,
+     * for example for every point of a chart. A color is light in terms of
+     * brightnessForColor() if its gray value is larger than 0.5.
+     *
+     * @since 6.12
+     */
+    Q_INVOKABLE QList<qreal> grayForColors(const QList<QColor> &colors);
+
+    /**
+     * Returns a color for each of @p balances, interpolated between @p one and
+     * @p two like linearInterpolation() does.
+     *
+     * @code{.qml}
+     * import QtQuick
+     * import org.kde.kirigami as Kirigami
+     *
+     * Repeater {
+     *     property list<real> values: [0.0, 0.25, 0.5, 1.0]
+     *     readonly property list<color> colors: Kirigami.ColorUtils.linearInterpolations("blue", "red", values)
+     *     model: values.length
+     *     delegate: Rectangle {
+     *         color: colors[index]
+     *     }
+     * }
+     * @endcode
+     *
+     * @since 6.12
+     */
+    Q_INVOKABLE QList<QColor> linearInterpolations(const QColor &one, const QColor &two, const QList<double> &balances);
+
+    /**
+     * Returns each color in @p targetColors tinted like tintWithAlpha() does.
+     *
+     * @since 6.12
+     */
+    Q_INVOKABLE QList<QColor> tintColorsWithAlpha(const QList<QColor> &targetColors, const QColor &tintColor, double alpha);
+
+    /**
+     * Returns the CIELAB chroma of each color in @p colors.
+     *
+     * @see chroma()
+     * @since 6.12
+     */
+    Q_INVOKABLE static QList<qreal> chromaForColors(const QList<QColor> &colors);
+
+    /**
+     * The adjustments accepted by adjustColor() and scaleColor(), for use from C++.
+     *
+     * @see adjustColor()
+     * @see scaleColor()
+     * @since 6.12
+     */
+    struct Adjustments {
+        double red = 0.0;
+        double green = 0.0;
+        double blue = 0.0;
+
+        double hue = 0.0;
+        double saturation = 0.0;
+        double value = 0.0;
+
+        double alpha = 0.0;
+    };
+
+    // Not for QML, same as adjustColor() above without having to go through a QJSValue
+    static QColor adjustColor(const QColor &color, const Adjustments &adjustments);
+
+    // Not for QML, same as scaleColor() above without having to go through a QJSValue
+    static QColor scaleColor(const QColor &color, const Adjustments &adjustments);
+
     struct XYZColor {
         qreal x = 0;
         qreal y = 0;
@@ -214,5 +287,30 @@ public:
     // Not for QML, returns the comvertion from srgb of a QColor and Lab colorspace
     static ColorUtils::LabColor colorToLab(const QColor &color);
 
+    /**
+     * Not for QML, the same as colorToLab() for an opaque 8 bit color.
+     *
+     * This uses a lookup table for the conversion to linear space and avoids
+     * going through QColor, to convert many colors like the pixels of an image.
+     *
+     * @since 6.12
+     */
+    static ColorUtils::LabColor rgbToLab(QRgb rgb);
+
+    /**
+     * Not for QML, converts @p count colors from @p colors using rgbToLab()
+     * and stores them in @p result.
+     *
+     * @since 6.12
+     */
+    static void rgbToLab(const QRgb *colors, qsizetype count, ColorUtils::LabColor *result);
+
+    /**
+     * Not for QML, the same as chroma() for an opaque 8 bit color, see rgbToLab().
+     *
+     * @since 6.12
+     */
+    static qreal rgbChroma(QRgb rgb);
+
     static qreal luminance(const QColor &color);
 };
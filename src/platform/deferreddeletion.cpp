@@ -0,0 +1,130 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "deferreddeletion_p.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QQmlEngine>
+#include <QTimer>
+
+#include <deque>
+
+namespace Kirigami
+{
+namespace Platform
+{
+
+// How long nothing needs to be queued before deleting anything, long enough
+// for the animations that removed the objects to finish.
+static constexpr int idleInterval = 500;
+// Once deleting, how much time to spend for every frame.
+static constexpr qint64 frameBudget = 4;
+static constexpr int frameInterval = 16;
+
+class DeferredDeletionQueue : public QObject
+{
+public:
+    DeferredDeletionQueue()
+    {
+        m_timer.setSingleShot(true);
+        connect(&m_timer, &QTimer::timeout, this, &DeferredDeletionQueue::deleteSome);
+        connect(qApp, &QCoreApplication::aboutToQuit, this, &DeferredDeletionQueue::deleteAll);
+    }
+
+    void enqueue(QObject *object)
+    {
+        // Make sure QML objects do not outlive their engine while waiting, the
+        // engine deletes its children when it is destroyed.
+        if (!object->parent()) {
+            if (QQmlEngine *engine = qmlEngine(object)) {
+                object->setParent(engine);
+            }
+        }
+        m_objects.emplace_back(object);
+        m_timer.start(idleInterval);
+    }
+
+    void deleteSome()
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        // Always delete at least one object, even if it takes longer than
+        // the budget, to make progress.
+        do {
+            deleteFirst();
+        } while (!m_objects.empty() && timer.elapsed() < frameBudget);
+
+        if (!m_objects.empty()) {
+            m_timer.start(frameInterval);
+        }
+    }
+
+    void deleteAll()
+    {
+        m_timer.stop();
+        while (!m_objects.empty()) {
+            deleteFirst();
+        }
+    }
+
+    int count() const
+    {
+        return int(m_objects.size());
+    }
+
+private:
+    void deleteFirst()
+    {
+        // Objects may have been deleted by their parent in the meantime.
+        QPointer<QObject> object = m_objects.front();
+        m_objects.pop_front();
+        delete object.data();
+    }
+
+    std::deque<QPointer<QObject>> m_objects;
+    QTimer m_timer;
+};
+
+Q_GLOBAL_STATIC(DeferredDeletionQueue, s_queue)
+
+bool DeferredDeletion::isEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("KIRIGAMI_DEFERRED_DELETION") == 1;
+    return enabled;
+}
+
+void DeferredDeletion::deleteLater(QObject *object)
+{
+    if (!object) {
+        return;
+    }
+
+    if (!isEnabled() || !qApp || s_queue.isDestroyed()) {
+        object->deleteLater();
+        return;
+    }
+
+    Q_ASSERT(object->thread() == qApp->thread());
+    s_queue->enqueue(object);
+}
+
+void DeferredDeletion::flush()
+{
+    if (isEnabled() && !s_queue.isDestroyed()) {
+        s_queue->deleteAll();
+    }
+}
+
+int DeferredDeletion::pendingCount()
+{
+    return !isEnabled() || s_queue.isDestroyed() ? 0 : s_queue->count();
+}
+
+}
+}
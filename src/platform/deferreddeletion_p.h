@@ -0,0 +1,55 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QObject>
+
+#include "kirigamiplatform_export.h"
+
+namespace Kirigami
+{
+namespace Platform
+{
+
+/**
+ * Deletes objects that are no longer displayed once the application is idle,
+ * instead of on the next event loop iteration like QObject::deleteLater().
+ *
+ * Destroying a large item tree, like a page, can take long enough to make the
+ * frame it happens in miss its deadline, which is often the first frame of the
+ * animation that removed the item. Objects are only destroyed once nothing
+ * has been queued for a short while, a few at a time, so that rendering can
+ * happen in between.
+ *
+ * This is only used when the `KIRIGAMI_DEFERRED_DELETION` environment
+ * variable is set to 1, otherwise objects are deleted with
+ * QObject::deleteLater(). Must only be used from the GUI thread.
+ */
+class KIRIGAMIPLATFORM_EXPORT DeferredDeletion
+{
+public:
+    static bool isEnabled();
+
+    /**
+     * Queue @p object for deletion. Items should already be hidden and
+     * removed from their parent item, as they stay alive for a while.
+     */
+    static void deleteLater(QObject *object);
+
+    /**
+     * Delete all queued objects right away.
+     */
+    static void flush();
+
+    /**
+     * The number of objects waiting to be deleted.
+     */
+    static int pendingCount();
+};
+
+}
+}
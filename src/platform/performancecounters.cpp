@@ -0,0 +1,39 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "performancecounters_p.h"
+
+namespace Kirigami
+{
+namespace Platform
+{
+
+std::atomic_int PerformanceCounters::s_consumers{0};
+std::array<std::atomic<quint64>, PerformanceCounters::EventCount> PerformanceCounters::s_events{};
+std::array<std::atomic<qint64>, PerformanceCounters::GaugeCount> PerformanceCounters::s_gauges{};
+
+void PerformanceCounters::acquire()
+{
+    s_consumers.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerformanceCounters::release()
+{
+    s_consumers.fetch_sub(1, std::memory_order_relaxed);
+}
+
+quint64 PerformanceCounters::value(Event event)
+{
+    return s_events[event].load(std::memory_order_relaxed);
+}
+
+qint64 PerformanceCounters::value(Gauge gauge)
+{
+    return s_gauges[gauge].load(std::memory_order_relaxed);
+}
+
+}
+}
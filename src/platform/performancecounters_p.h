@@ -0,0 +1,87 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <array>
+#include <atomic>
+
+#include "kirigamiplatform_export.h"
+
+namespace Kirigami
+{
+namespace Platform
+{
+
+/**
+ * Process wide counters of the work done and memory held by Kirigami, shared
+ * between all of Kirigami's libraries for diagnostics such as the
+ * PerformanceOverlay and MemoryStatistics.
+ *
+ * Events are only counted while at least one consumer has called acquire(),
+ * so they cost a single relaxed load otherwise. Gauges are always kept up to
+ * date, as they cannot be reconstructed later.
+ */
+class KIRIGAMIPLATFORM_EXPORT PerformanceCounters
+{
+public:
+    enum Event {
+        // An item was polished.
+        Polish,
+        // A layout arranged its items.
+        LayoutPass,
+        // A PlatformTheme recomputed its colors.
+        ThemeUpdate,
+        EventCount,
+    };
+
+    enum Gauge {
+        // Pages held by all PagePool instances.
+        PoolPages,
+        // Approximate memory used by PlatformThemeData instances, in bytes.
+        ThemeDataBytes,
+        // Approximate memory used by the samples and clusters of all
+        // ImageColors instances, in bytes.
+        ImageColorsBytes,
+        GaugeCount,
+    };
+
+    static void acquire();
+    static void release();
+
+    static bool isCounting()
+    {
+        return s_consumers.load(std::memory_order_relaxed) > 0;
+    }
+
+    static void count(Event event)
+    {
+        if (isCounting()) {
+            s_events[event].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    static void adjust(Gauge gauge, qint64 delta)
+    {
+        s_gauges[gauge].fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    /**
+     * The number of times @p event happened since counting started.
+     */
+    static quint64 value(Event event);
+    static qint64 value(Gauge gauge);
+
+private:
+    static std::atomic_int s_consumers;
+    static std::array<std::atomic<quint64>, EventCount> s_events;
+    static std::array<std::atomic<qint64>, GaugeCount> s_gauges;
+};
+
+}
+}
@@ -7,12 +7,183 @@
 #include "platformpluginfactory.h"
 
 #include <QCoreApplication>
+#include <QDataStream>
+#include <QDateTime>
 #include <QDebug>
 #include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include <QPluginLoader>
 #include <QQuickStyle>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
 
 #include "kirigamiplatform_logging.h"
+#include "kirigamiplatform_startup_logging.h"
+#include "tracescope_p.h"
+
+#ifndef KIRIGAMI_BUILD_TYPE_STATIC
+// Increase when the format of the plugin index changes.
+static constexpr quint32 pluginIndexVersion = 2;
+// Pinned so that the format doesn't depend on the version of Qt.
+static constexpr QDataStream::Version pluginIndexStreamVersion = QDataStream::Qt_6_5;
+
+// A library in a plugin directory, and whether it is a platform plugin.
+struct PluginFile {
+    QString fileName;
+    // Plugins replaced in place keep the modification time of their
+    // directory, so the files are checked too.
+    qint64 modified = 0;
+    qint64 size = 0;
+    bool isPlugin = false;
+};
+
+// The libraries found in a single plugin directory.
+struct PluginDirectory {
+    // The modification time of the directory when it was indexed, which
+    // changes whenever plugins are added or removed.
+    qint64 modified = 0;
+    QList<PluginFile> files;
+};
+
+static QString pluginIndexFile()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/kirigami/platformplugins");
+}
+
+static QHash<QString, PluginDirectory> readPluginIndex()
+{
+    QHash<QString, PluginDirectory> index;
+
+    QFile file(pluginIndexFile());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return index;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(pluginIndexStreamVersion);
+    quint32 version = 0;
+    stream >> version;
+    if (version != pluginIndexVersion) {
+        return index;
+    }
+
+    qint64 count = 0;
+    stream >> count;
+    for (qint64 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString path;
+        PluginDirectory directory;
+        qint64 fileCount = 0;
+        stream >> path >> directory.modified >> fileCount;
+        for (qint64 j = 0; j < fileCount && stream.status() == QDataStream::Ok; ++j) {
+            PluginFile pluginFile;
+            stream >> pluginFile.fileName >> pluginFile.modified >> pluginFile.size >> pluginFile.isPlugin;
+            directory.files.append(pluginFile);
+        }
+        index.insert(path, directory);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        return {};
+    }
+    return index;
+}
+
+static void writePluginIndex(const QHash<QString, PluginDirectory> &index)
+{
+    const QString fileName = pluginIndexFile();
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCDebug(KirigamiPlatform) << "Could not write platform plugin index" << fileName;
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(pluginIndexStreamVersion);
+    stream << pluginIndexVersion << qint64(index.size());
+    for (auto it = index.cbegin(); it != index.cend(); ++it) {
+        stream << it.key() << it->modified << qint64(it->files.size());
+        for (const PluginFile &pluginFile : it->files) {
+            stream << pluginFile.fileName << pluginFile.modified << pluginFile.size << pluginFile.isPlugin;
+        }
+    }
+    file.commit();
+}
+
+static bool isUnchanged(const PluginFile &pluginFile, const QFileInfo &info)
+{
+    return info.size() == pluginFile.size && info.lastModified().toMSecsSinceEpoch() == pluginFile.modified;
+}
+
+static QStringList pluginNames(const QList<PluginFile> &files)
+{
+    QStringList plugins;
+    for (const PluginFile &pluginFile : files) {
+        if (pluginFile.isPlugin) {
+            plugins.append(pluginFile.fileName);
+        }
+    }
+    return plugins;
+}
+
+// Returns the names of the files in dir that are platform plugins. Which
+// files are plugins is determined from their metadata, without loading
+// them, and remembered until the directory or the files change.
+static QStringList platformPlugins(const QDir &dir, QHash<QString, PluginDirectory> &index, bool &indexChanged)
+{
+    const QString path = dir.absolutePath();
+    const QFileInfo info(path);
+    if (!info.isDir()) {
+        return {};
+    }
+
+    const qint64 modified = info.lastModified().toMSecsSinceEpoch();
+    QHash<QString, PluginFile> previousFiles;
+    if (auto it = index.constFind(path); it != index.constEnd()) {
+        if (it->modified == modified && std::all_of(it->files.cbegin(), it->files.cend(), [&dir](const PluginFile &pluginFile) {
+                return isUnchanged(pluginFile, QFileInfo(dir.absoluteFilePath(pluginFile.fileName)));
+            })) {
+            return pluginNames(it->files);
+        }
+
+        for (const PluginFile &pluginFile : it->files) {
+            previousFiles.insert(pluginFile.fileName, pluginFile);
+        }
+    }
+
+    QList<PluginFile> files;
+    const auto fileNames = dir.entryList(QDir::Files);
+    for (const QString &fileName : fileNames) {
+#ifdef Q_OS_ANDROID
+        if (!fileName.startsWith(QStringLiteral("libplugins_kf6_kirigami_platform_"))) {
+            continue;
+        }
+#endif
+        if (!QLibrary::isLibrary(fileName)) {
+            continue;
+        }
+
+        // Only the metadata of new or changed files needs to be read again.
+        const QFileInfo fileInfo(dir.absoluteFilePath(fileName));
+        if (auto it = previousFiles.constFind(fileName); it != previousFiles.constEnd() && isUnchanged(*it, fileInfo)) {
+            files.append(*it);
+            continue;
+        }
+
+        const QPluginLoader loader(fileInfo.absoluteFilePath());
+        const bool isPlugin = loader.metaData().value(QStringLiteral("IID")).toString() == QLatin1String(PlatformPluginFactory_iid);
+        files.append(PluginFile{fileName, fileInfo.lastModified().toMSecsSinceEpoch(), fileInfo.size(), isPlugin});
+    }
+
+    index.insert(path, PluginDirectory{modified, files});
+    indexChanged = true;
+    return pluginNames(files);
+}
+#endif
 
 namespace Kirigami
 {
@@ -36,6 +207,9 @@ PlatformPluginFactory *PlatformPluginFactory::findPlugin(const QString &preferre
         return it.value();
     }
 
+    TraceScope trace(KirigamiPlatformStartup(), "PlatformPluginFactory::findPlugin");
+    trace.addArgument("plugin", pluginName);
+
     // Even plugins that aren't found are in the map, so we know we shouldn't check again withthis expensive operation
     factories[pluginName] = nullptr;
 
@@ -48,6 +222,9 @@ PlatformPluginFactory *PlatformPluginFactory::findPlugin(const QString &preferre
         }
     }
 #else
+    static QHash<QString, PluginDirectory> index = readPluginIndex();
+    bool indexChanged = false;
+
     const auto libraryPaths = QCoreApplication::libraryPaths();
     for (const QString &path : libraryPaths) {
 
@@ -57,29 +234,22 @@ PlatformPluginFactory *PlatformPluginFactory::findPlugin(const QString &preferre
         const QDir dir(path + QStringLiteral("/kf6/kirigami/platform"));
 #endif
 
-        const auto fileNames = dir.entryList(QDir::Files);
+        const auto fileNames = platformPlugins(dir, index, indexChanged);
 
         for (const QString &fileName : fileNames) {
+            if (!pluginName.isEmpty() && fileName.contains(pluginName)) {
+                // TODO: env variable too?
+                QPluginLoader loader(dir.absoluteFilePath(fileName));
+                QObject *plugin = loader.instance();
+                // TODO: load actually a factory as plugin
 
-#ifdef Q_OS_ANDROID
-            if (fileName.startsWith(QStringLiteral("libplugins_kf6_kirigami_platform_")) && QLibrary::isLibrary(fileName)) {
-#endif
-                if (!pluginName.isEmpty() && fileName.contains(pluginName)) {
-                    // TODO: env variable too?
-                    QPluginLoader loader(dir.absoluteFilePath(fileName));
-                    QObject *plugin = loader.instance();
-                    // TODO: load actually a factory as plugin
-
-                    qCDebug(KirigamiPlatform) << "Loading style plugin from" << dir.absoluteFilePath(fileName);
-
-                    if (auto factory = qobject_cast<PlatformPluginFactory *>(plugin)) {
-                        factories[pluginName] = factory;
-                        break;
-                    }
+                qCDebug(KirigamiPlatform) << "Loading style plugin from" << dir.absoluteFilePath(fileName);
+
+                if (auto factory = qobject_cast<PlatformPluginFactory *>(plugin)) {
+                    factories[pluginName] = factory;
+                    break;
                 }
-#ifdef Q_OS_ANDROID
             }
-#endif
         }
 
         // Ensure we only load the first plugin from the first plugin location.
@@ -89,6 +259,10 @@ PlatformPluginFactory *PlatformPluginFactory::findPlugin(const QString &preferre
             break;
         }
     }
+
+    if (indexChanged) {
+        writePluginIndex(index);
+    }
 #endif
 
     PlatformPluginFactory *factory = factories.value(pluginName);
@@ -7,22 +7,28 @@
 
 #include "platformtheme.h"
 #include "basictheme_p.h"
+#include "kirigamiplatform_trace_logging.h"
+#include "performancecounters_p.h"
 #include "platformpluginfactory.h"
+#include "tracescope_p.h"
 #include <QDebug>
 #include <QDir>
 #include <QGuiApplication>
+#include <QHash>
 #include <QPluginLoader>
 #include <QPointer>
 #include <QQmlContext>
 #include <QQmlEngine>
 #include <QQuickStyle>
 #include <QQuickWindow>
+#include <QVarLengthArray>
 
+#include <algorithm>
 #include <array>
 #include <cinttypes>
 #include <functional>
 #include <memory>
-#include <unordered_map>
+#include <utility>
 
 namespace Kirigami
 {
@@ -95,7 +101,119 @@ public:
         ColorRoleCount,
     };
 
-    using ColorMap = std::unordered_map<std::underlying_type<ColorRole>::type, QColor>;
+    // The colors of all roles. These are stored as QRgba64, which takes half
+    // the space of a QColor, and only converted to QColor when they are read.
+    // Colors that have not been set are invalid.
+    class PackedColors
+    {
+    public:
+        inline QColor at(ColorRole role) const
+        {
+            return isValid(role) ? QColor::fromRgba64(m_values[role]) : QColor{};
+        }
+
+        inline bool isValid(ColorRole role) const
+        {
+            return m_valid & (1u << role);
+        }
+
+        // Whether the color of role is color, regardless of the spec color uses.
+        inline bool equals(ColorRole role, const QColor &color) const
+        {
+            return isValid(role) == color.isValid() && (!color.isValid() || m_values[role] == color.rgba64());
+        }
+
+        inline void set(ColorRole role, const QColor &color)
+        {
+            if (color.isValid()) {
+                m_values[role] = color.rgba64();
+                m_valid |= 1u << role;
+            } else {
+                m_values[role] = QRgba64{};
+                m_valid &= ~(1u << role);
+            }
+        }
+
+        inline size_t hash(size_t seed) const
+        {
+            seed = qHashMulti(seed, m_valid);
+            for (const auto &value : m_values) {
+                seed = qHashMulti(seed, quint64(value));
+            }
+            return seed;
+        }
+
+        inline bool operator==(const PackedColors &other) const
+        {
+            return m_valid == other.m_valid && m_values == other.m_values;
+        }
+
+    private:
+        std::array<QRgba64, ColorRoleCount> m_values{};
+        uint32_t m_valid = 0;
+
+        static_assert(ColorRoleCount <= 32, "PlatformThemeData::ColorRole contains more elements than can be stored in PackedColors");
+    };
+
+    // Colors overridden locally by a theme that inherits its data. Usually
+    // only a few colors are overridden, so these are kept in a small array.
+    class ColorOverrides
+    {
+    public:
+        struct Entry {
+            ColorRole role;
+            QRgba64 color;
+        };
+
+        inline const Entry *find(ColorRole role) const
+        {
+            auto itr = std::find_if(m_entries.cbegin(), m_entries.cend(), [role](const Entry &entry) {
+                return entry.role == role;
+            });
+            return itr != m_entries.cend() ? &*itr : nullptr;
+        }
+
+        inline void insert(ColorRole role, const QColor &color)
+        {
+            if (auto entry = const_cast<Entry *>(find(role))) {
+                entry->color = color.rgba64();
+            } else {
+                m_entries.append(Entry{role, color.rgba64()});
+            }
+        }
+
+        inline bool remove(ColorRole role)
+        {
+            if (auto entry = find(role)) {
+                m_entries.erase(m_entries.cbegin() + (entry - m_entries.cbegin()));
+                return true;
+            }
+            return false;
+        }
+
+        inline auto begin() const
+        {
+            return m_entries.cbegin();
+        }
+
+        inline auto end() const
+        {
+            return m_entries.cend();
+        }
+
+    private:
+        QVarLengthArray<Entry, 4> m_entries;
+    };
+
+    PlatformThemeData()
+    {
+        PerformanceCounters::adjust(PerformanceCounters::ThemeDataBytes, sizeof(PlatformThemeData));
+    }
+
+    ~PlatformThemeData() override
+    {
+        PerformanceCounters::adjust(PerformanceCounters::ThemeDataBytes, -qint64(sizeof(PlatformThemeData)));
+    }
 
     // Which PlatformTheme instance "owns" this data object. Only the owner is
     // allowed to make changes to data.
@@ -104,13 +222,37 @@ public:
     PlatformTheme::ColorSet colorSet = PlatformTheme::Window;
     PlatformTheme::ColorGroup colorGroup = PlatformTheme::Active;
 
-    std::array<QColor, ColorRoleCount> colors;
+    // The colors and the palette built from them. Many themes end up with
+    // exactly the same colors, for example all non-inheriting themes using
+    // the same color set, so once a batch of changes is done these are shared
+    // with other data objects that have identical colors, see internColors().
+    // Shared colors are copied when they are changed.
+    struct Colors {
+        PackedColors colors;
+        QPalette palette;
+        bool interned = false;
+    };
+
+    std::shared_ptr<Colors> colorData = std::make_shared<Colors>();
+
+    inline const PackedColors &colors() const
+    {
+        return colorData->colors;
+    }
+
+    inline const QPalette &palette() const
+    {
+        return colorData->palette;
+    }
+
+    // Changed whenever the palette changes. This is unique among all data
+    // objects, so themes can compare it to the version they last emitted a
+    // change signal for, even if their data object was replaced since then.
+    uint32_t paletteVersion = nextPaletteVersion();
 
     QFont defaultFont;
     QFont smallFont;
 
-    QPalette palette;
-
     // A list of PlatformTheme instances that want to be notified when the data
     // changes. This is used instead of signal/slots as this way we only store
     // a little bit of data and that data is shared among instances, whereas
@@ -128,7 +270,11 @@ public:
 
         colorSet = set;
 
-        notifyWatchers<PlatformTheme::ColorSet>(sender, oldValue, set);
+        notifyWatchers(sender, PlatformThemeChangeTracker::PropertyChange::ColorSet, oldValue, set, [this, oldValue](bool pending) {
+            if (!pending) {
+                previousColorSet = oldValue;
+            }
+        });
     }
 
     inline void setColorGroup(PlatformTheme *sender, PlatformTheme::ColorGroup group)
@@ -140,25 +286,48 @@ public:
         auto oldValue = colorGroup;
 
         colorGroup = group;
-        palette.setCurrentColorGroup(QPalette::ColorGroup(group));
+        writableColors().palette.setCurrentColorGroup(QPalette::ColorGroup(group));
+        paletteVersion = nextPaletteVersion();
 
-        notifyWatchers<PlatformTheme::ColorGroup>(sender, oldValue, group);
+        notifyWatchers(sender, PlatformThemeChangeTracker::PropertyChange::ColorGroup, oldValue, group, [this, oldValue](bool pending) {
+            if (!pending) {
+                previousColorGroup = oldValue;
+            }
+        });
     }
 
     inline void setColor(PlatformTheme *sender, ColorRole role, const QColor &color)
     {
-        if (sender != owner || colors[role] == color) {
+        if (sender != owner || colors().equals(role, color)) {
             return;
         }
 
-        auto oldValue = colors[role];
+        auto oldValue = colors().at(role);
 
-        colors[role] = color;
-        updatePalette(palette, colors);
+        auto &data = writableColors();
+        data.colors.set(role, color);
+        // Only the palette roles that use this color need to change.
+        if (setPaletteColor(data.palette, role, color)) {
+            paletteVersion = nextPaletteVersion();
+        }
+
+        notifyWatchers(sender, PlatformThemeChangeTracker::PropertyChange::Color, oldValue, color, [this, role, oldValue, color](bool) {
+            pendingColors[role].record(oldValue, color);
+        });
+    }
 
-        notifyWatchers<QColor>(sender, oldValue, colors[role]);
+    inline Colors &writableColors()
+    {
+        if (colorData->interned) {
+            auto copy = std::make_shared<Colors>(*colorData);
+            copy->interned = false;
+            colorData = copy;
+        }
+        return *colorData;
     }
 
+    inline void internColors();
+
     inline void setDefaultFont(PlatformTheme *sender, const QFont &font)
     {
         if (sender != owner || font == defaultFont) {
@@ -169,7 +338,9 @@ public:
 
         defaultFont = font;
 
-        notifyWatchers<QFont>(sender, oldValue, font);
+        notifyWatchers(sender, PlatformThemeChangeTracker::PropertyChange::Font, oldValue, font, [this, oldValue, font](bool) {
+            pendingDefaultFont.record(oldValue, font);
+        });
     }
 
     inline void setSmallFont(PlatformTheme *sender, const QFont &font)
@@ -182,7 +353,9 @@ public:
 
         smallFont = font;
 
-        notifyWatchers<QFont>(sender, oldValue, smallFont);
+        notifyWatchers(sender, PlatformThemeChangeTracker::PropertyChange::Font, oldValue, font, [this, oldValue, font](bool) {
+            pendingSmallFont.record(oldValue, font);
+        });
     }
 
     inline void addChangeWatcher(PlatformTheme *object)
@@ -195,32 +368,120 @@ public:
         watchers.removeOne(object);
     }
 
+    // Changes that have not yet been delivered to the watchers that inherit
+    // this data, together with the values from before the first of those
+    // changes.
+    PlatformThemeChangeTracker::PropertyChanges pendingChanges;
+    PlatformTheme::ColorSet previousColorSet = PlatformTheme::Window;
+    PlatformTheme::ColorGroup previousColorGroup = PlatformTheme::Active;
+
+    // A value that changed, possibly several times, since the changes were
+    // last delivered.
     template<typename T>
-    inline void notifyWatchers(PlatformTheme *sender, const T &oldValue, const T &newValue)
+    struct PendingValue {
+        T oldValue;
+        T newValue;
+        bool changed = false;
+
+        inline void record(const T &previous, const T &current)
+        {
+            if (!changed) {
+                oldValue = previous;
+                changed = true;
+            }
+            newValue = current;
+        }
+    };
+    std::array<PendingValue<QColor>, ColorRoleCount> pendingColors;
+    PendingValue<QFont> pendingDefaultFont;
+    PendingValue<QFont> pendingSmallFont;
+
+    // The owner is notified immediately, as it may need to update other
+    // properties in response to a change. All other watchers only need to
+    // emit change signals, so their notifications are collected and delivered
+    // once the outermost change tracker of the owner finishes, see
+    // ~PlatformThemeChangeTracker(). Changing the color set of a theme with
+    // many inheriting children would otherwise send an event to each of those
+    // children for every single color that changes.
+    template<typename T, typename Record>
+    inline void notifyWatchers(PlatformTheme *sender, PlatformThemeChangeTracker::PropertyChange change, const T &oldValue, const T &newValue, Record record)
     {
-        for (auto object : std::as_const(watchers)) {
+        PlatformThemeChangeTracker tracker(sender);
+
+        const bool ownerIsWatching = watchers.contains(sender);
+        if (ownerIsWatching) {
             PlatformThemeEvents::PropertyChangedEvent<T> event(sender, oldValue, newValue);
-            QCoreApplication::sendEvent(object, &event);
+            QCoreApplication::sendEvent(sender, &event);
         }
+
+        if (watchers.size() == (ownerIsWatching ? 1 : 0)) {
+            return;
+        }
+
+        record(bool(pendingChanges & change));
+        pendingChanges |= change;
     }
 
-    // Update a palette from a list of colors.
-    inline static void updatePalette(QPalette &palette, const std::array<QColor, ColorRoleCount> &colors)
+    inline void deliverPendingChanges()
     {
-        for (std::size_t i = 0; i < colors.size(); ++i) {
-            setPaletteColor(palette, ColorRole(i), colors.at(i));
+        const auto changes = std::exchange(pendingChanges, PlatformThemeChangeTracker::PropertyChange::None);
+        const auto colors = std::exchange(pendingColors, {});
+        const auto defaultFontChange = std::exchange(pendingDefaultFont, {});
+        const auto smallFontChange = std::exchange(pendingSmallFont, {});
+
+        // Event handlers may end up changing the list of watchers, so iterate
+        // over a copy.
+        const auto currentWatchers = watchers;
+        for (auto watcher : currentWatchers) {
+            if (watcher == owner) {
+                continue;
+            }
+
+            // Ensure each watcher emits its change signals only once.
+            PlatformThemeChangeTracker tracker(watcher);
+
+            if (changes & PlatformThemeChangeTracker::PropertyChange::ColorSet) {
+                PlatformThemeEvents::ColorSetChangedEvent event(owner, previousColorSet, colorSet);
+                QCoreApplication::sendEvent(watcher, &event);
+            }
+
+            if (changes & PlatformThemeChangeTracker::PropertyChange::ColorGroup) {
+                PlatformThemeEvents::ColorGroupChangedEvent event(owner, previousColorGroup, colorGroup);
+                QCoreApplication::sendEvent(watcher, &event);
+            }
+
+            // One event for each color and font that changed, with the value
+            // from before the first change and the current one.
+            if (changes & PlatformThemeChangeTracker::PropertyChange::Color) {
+                for (const auto &color : colors) {
+                    if (color.changed) {
+                        PlatformThemeEvents::ColorChangedEvent event(owner, color.oldValue, color.newValue);
+                        QCoreApplication::sendEvent(watcher, &event);
+                    }
+                }
+            }
+
+            if (changes & PlatformThemeChangeTracker::PropertyChange::Font) {
+                for (const auto &font : {defaultFontChange, smallFontChange}) {
+                    if (font.changed) {
+                        PlatformThemeEvents::FontChangedEvent event(owner, font.oldValue, font.newValue);
+                        QCoreApplication::sendEvent(watcher, &event);
+                    }
+                }
+            }
         }
     }
 
-    // Update a palette from a hash of colors.
-    inline static void updatePalette(QPalette &palette, const ColorMap &colors)
+    // Update a palette from a set of overridden colors.
+    inline static void updatePalette(QPalette &palette, const ColorOverrides &colors)
     {
-        for (auto entry : colors) {
-            setPaletteColor(palette, ColorRole(entry.first), entry.second);
+        for (const auto &entry : colors) {
+            setPaletteColor(palette, entry.role, QColor::fromRgba64(entry.color));
         }
     }
 
-    inline static void setPaletteColor(QPalette &palette, ColorRole role, const QColor &color)
+    // Returns whether the palette uses the color role.
+    inline static bool setPaletteColor(QPalette &palette, ColorRole role, const QColor &color)
     {
         switch (role) {
         case TextColor:
@@ -251,11 +512,61 @@ public:
             break;
 
         default:
-            break;
+            return false;
         }
+
+        return true;
+    }
+
+    inline static uint32_t nextPaletteVersion()
+    {
+        static uint32_t version = 0;
+        return ++version;
     }
 };
 
+static size_t hashColors(const PlatformThemeData::Colors &colors)
+{
+    return colors.colors.hash(qHash(int(colors.palette.currentColorGroup())));
+}
+
+// All currently shared color data, by hash of its contents.
+using ColorRegistry = QMultiHash<size_t, std::weak_ptr<PlatformThemeData::Colors>>;
+Q_GLOBAL_STATIC(ColorRegistry, s_colorRegistry)
+
+void PlatformThemeData::internColors()
+{
+    if (colorData->interned) {
+        return;
+    }
+
+    const size_t hash = hashColors(*colorData);
+    for (auto itr = s_colorRegistry->constFind(hash); itr != s_colorRegistry->constEnd() && itr.key() == hash; ++itr) {
+        auto existing = itr->lock();
+        if (existing && existing->colors == colorData->colors && existing->palette == colorData->palette) {
+            colorData = existing;
+            return;
+        }
+    }
+
+    auto shared = std::shared_ptr<Colors>(new Colors(*colorData), [hash](Colors *colors) {
+        if (!s_colorRegistry.isDestroyed()) {
+            auto itr = s_colorRegistry->find(hash);
+            while (itr != s_colorRegistry->end() && itr.key() == hash) {
+                if (itr->expired()) {
+                    itr = s_colorRegistry->erase(itr);
+                } else {
+                    ++itr;
+                }
+            }
+        }
+        delete colors;
+    });
+    shared->interned = true;
+    s_colorRegistry->insert(hash, shared);
+    colorData = shared;
+}
+
 class PlatformThemePrivate
 {
 public:
@@ -264,42 +575,53 @@ public:
         , supportsIconColoring(false)
         , pendingColorChange(false)
         , pendingChildUpdate(false)
+        , pendingUpdate(false)
         , useAlternateBackgroundColor(false)
         , colorSet(PlatformTheme::Window)
         , colorGroup(PlatformTheme::Active)
     {
     }
 
+    // When the parent of a theme changes, resolving inheritance is delayed
+    // until the theme is used, see PlatformTheme::invalidate(). Make sure it
+    // is up to date before accessing data.
+    inline void resolve(const PlatformTheme *theme) const
+    {
+        if (pendingUpdate) {
+            const_cast<PlatformTheme *>(theme)->update();
+        }
+    }
+
     inline QColor color(const PlatformTheme *theme, PlatformThemeData::ColorRole color) const
     {
+        resolve(theme);
+
         if (!data) {
             return QColor{};
         }
 
-        QColor value = data->colors.at(color);
-
         if (data->owner != theme && localOverrides) {
-            auto itr = localOverrides->find(color);
-            if (itr != localOverrides->end()) {
-                value = itr->second;
+            if (auto entry = localOverrides->find(color)) {
+                return QColor::fromRgba64(entry->color);
             }
         }
 
-        return value;
+        return data->colors().at(color);
     }
 
     inline void setColor(PlatformTheme *theme, PlatformThemeData::ColorRole color, const QColor &value)
     {
+        resolve(theme);
+
         if (!localOverrides) {
-            localOverrides = std::make_unique<PlatformThemeData::ColorMap>();
+            localOverrides = std::make_unique<PlatformThemeData::ColorOverrides>();
         }
 
         if (!value.isValid()) {
             // Invalid color, assume we are resetting the value.
-            auto itr = localOverrides->find(color);
-            if (itr != localOverrides->end()) {
+            if (localOverrides->find(color)) {
                 PlatformThemeChangeTracker tracker(theme, PlatformThemeChangeTracker::PropertyChange::Color);
-                localOverrides->erase(itr);
+                localOverrides->remove(color);
 
                 if (data) {
                     // TODO: Find a better way to determine "default" color.
@@ -313,14 +635,14 @@ public:
             return;
         }
 
-        auto itr = localOverrides->find(color);
-        if (itr != localOverrides->end() && itr->second == value && (data && data->owner != theme)) {
+        auto entry = localOverrides->find(color);
+        if (entry && entry->color == value.rgba64() && (data && data->owner != theme)) {
             return;
         }
 
         PlatformThemeChangeTracker tracker(theme, PlatformThemeChangeTracker::PropertyChange::Color);
 
-        (*localOverrides)[color] = value;
+        localOverrides->insert(color, value);
 
         if (data) {
             data->setColor(theme, color, value);
@@ -333,13 +655,12 @@ public:
         // This is done because colorSet/colorGroup changes will trigger most
         // subclasses to reevaluate and reset the colors, breaking any local
         // overrides we have.
-        if (localOverrides) {
-            auto itr = localOverrides->find(color);
-            if (itr != localOverrides->end()) {
-                return;
-            }
+        if (localOverrides && localOverrides->find(color)) {
+            return;
         }
 
+        resolve(theme);
+
         PlatformThemeChangeTracker tracker(theme, PlatformThemeChangeTracker::PropertyChange::Color);
 
         if (data) {
@@ -360,12 +681,13 @@ public:
     std::shared_ptr<PlatformThemeData> data;
     // Used to store color overrides of inherited data. This is created on
     // demand and will only exist if we actually have local overrides.
-    std::unique_ptr<PlatformThemeData::ColorMap> localOverrides;
+    std::unique_ptr<PlatformThemeData::ColorOverrides> localOverrides;
 
     bool inherit : 1;
     bool supportsIconColoring : 1; // TODO KF6: Remove in favour of virtual method
     bool pendingColorChange : 1;
     bool pendingChildUpdate : 1;
+    bool pendingUpdate : 1;
     bool useAlternateBackgroundColor : 1;
 
     // Note: We use these to store local values of PlatformTheme::ColorSet and
@@ -375,6 +697,16 @@ public:
     uint8_t colorSet : 4;
     uint8_t colorGroup : 4;
 
+    // State of PlatformThemeChangeTracker: the number of trackers that are
+    // currently alive for this theme and the changes they collected.
+    uint8_t pendingChanges = 0;
+    uint16_t changeTrackerCount = 0;
+
+    // The PlatformThemeData::paletteVersion that paletteChanged() was last
+    // emitted for. Used to avoid emitting that signal for color changes that
+    // do not affect the palette.
+    uint32_t paletteVersion = 0;
+
     // Ensure the above assumption holds. Should this static assert fail, the
     // bit size above needs to be adjusted.
     static_assert(PlatformTheme::ColorGroupCount <= 16, "PlatformTheme::ColorGroup contains more elements than can be stored in PlatformThemePrivate");
@@ -390,15 +722,15 @@ PlatformTheme::PlatformTheme(QObject *parent)
     if (QQuickItem *item = qobject_cast<QQuickItem *>(parent)) {
         connect(item, &QQuickItem::windowChanged, this, [this](QQuickWindow *window) {
             if (window) {
-                update();
+                invalidate();
             }
         });
-        connect(item, &QQuickItem::parentChanged, this, &PlatformTheme::update);
+        connect(item, &QQuickItem::parentChanged, this, &PlatformTheme::invalidate);
         // Needs to be connected to enabledChanged twice to correctly fully update when a
         // Theme that does inherit becomes temporarly non-inherit and back due to
         // the item being enabled or disabled
-        connect(item, &QQuickItem::enabledChanged, this, &PlatformTheme::update);
-        connect(item, &QQuickItem::enabledChanged, this, &PlatformTheme::update, Qt::QueuedConnection);
+        connect(item, &QQuickItem::enabledChanged, this, &PlatformTheme::invalidate);
+        connect(item, &QQuickItem::enabledChanged, this, &PlatformTheme::invalidate, Qt::QueuedConnection);
     }
 
     update();
@@ -415,6 +747,8 @@ PlatformTheme::~PlatformTheme()
 
 void PlatformTheme::setColorSet(PlatformTheme::ColorSet colorSet)
 {
+    d->resolve(this);
+
     PlatformThemeChangeTracker tracker(this, PlatformThemeChangeTracker::PropertyChange::ColorSet);
     d->colorSet = colorSet;
 
@@ -425,11 +759,14 @@ void PlatformTheme::setColorSet(PlatformTheme::ColorSet colorSet)
 
 PlatformTheme::ColorSet PlatformTheme::colorSet() const
 {
+    d->resolve(this);
     return d->data ? d->data->colorSet : Window;
 }
 
 void PlatformTheme::setColorGroup(PlatformTheme::ColorGroup colorGroup)
 {
+    d->resolve(this);
+
     PlatformThemeChangeTracker tracker(this, PlatformThemeChangeTracker::PropertyChange::ColorGroup);
     d->colorGroup = colorGroup;
 
@@ -440,6 +777,7 @@ void PlatformTheme::setColorGroup(PlatformTheme::ColorGroup colorGroup)
 
 PlatformTheme::ColorGroup PlatformTheme::colorGroup() const
 {
+    d->resolve(this);
     return d->data ? d->data->colorGroup : Active;
 }
 
@@ -663,11 +1001,14 @@ void PlatformTheme::setFocusColor(const QColor &color)
 
 QFont PlatformTheme::defaultFont() const
 {
+    d->resolve(this);
     return d->data ? d->data->defaultFont : QFont{};
 }
 
 void PlatformTheme::setDefaultFont(const QFont &font)
 {
+    d->resolve(this);
+
     PlatformThemeChangeTracker tracker(this, PlatformThemeChangeTracker::PropertyChange::Font);
     if (d->data) {
         d->data->setDefaultFont(this, font);
@@ -676,11 +1017,14 @@ void PlatformTheme::setDefaultFont(const QFont &font)
 
 QFont PlatformTheme::smallFont() const
 {
+    d->resolve(this);
     return d->data ? d->data->smallFont : QFont{};
 }
 
 void PlatformTheme::setSmallFont(const QFont &font)
 {
+    d->resolve(this);
+
     PlatformThemeChangeTracker tracker(this, PlatformThemeChangeTracker::PropertyChange::Font);
     if (d->data) {
         d->data->setSmallFont(this, font);
@@ -820,11 +1164,13 @@ void PlatformTheme::setUseAlternateBackgroundColor(bool alternate)
 
 QPalette PlatformTheme::palette() const
 {
+    d->resolve(this);
+
     if (!d->data) {
         return QPalette{};
     }
 
-    auto palette = d->data->palette;
+    auto palette = d->data->palette();
 
     if (d->localOverrides) {
         PlatformThemeData::updatePalette(palette, *d->localOverrides);
@@ -873,6 +1219,31 @@ PlatformTheme *PlatformTheme::qmlAttachedProperties(QObject *object)
     return new BasicTheme(object);
 }
 
+PlatformTheme *PlatformTheme::themeForReading(QObject *object)
+{
+    if (auto theme = static_cast<PlatformTheme *>(qmlAttachedPropertiesObject<PlatformTheme>(object, false))) {
+        return theme;
+    }
+
+    // Disabled items use their own data, see update().
+    auto item = qobject_cast<QQuickItem *>(object);
+    if (!item || item->isEnabled()) {
+        for (QObject *candidate = determineParent(object); candidate; candidate = determineParent(candidate)) {
+            auto t = static_cast<PlatformTheme *>(qmlAttachedPropertiesObject<PlatformTheme>(candidate, false));
+            if (!t) {
+                continue;
+            }
+
+            t->d->resolve(t);
+            if (t->d->data && t->d->data->owner == t) {
+                return t;
+            }
+        }
+    }
+
+    return static_cast<PlatformTheme *>(qmlAttachedPropertiesObject<PlatformTheme>(object, true));
+}
+
 void PlatformTheme::emitSignalsForChanges(int changes)
 {
     if (!d->data) {
@@ -893,8 +1264,9 @@ void PlatformTheme::emitSignalsForChanges(int changes)
         Q_EMIT colorsChanged();
     }
 
-    if (propertyChanges & PlatformThemeChangeTracker::PropertyChange::Palette) {
-        Q_EMIT paletteChanged(d->data->palette);
+    if ((propertyChanges & PlatformThemeChangeTracker::PropertyChange::Palette) && d->paletteVersion != d->data->paletteVersion) {
+        d->paletteVersion = d->data->paletteVersion;
+        Q_EMIT paletteChanged(d->data->palette());
     }
 
     if (propertyChanges & PlatformThemeChangeTracker::PropertyChange::Font) {
@@ -954,8 +1326,45 @@ bool PlatformTheme::event(QEvent *event)
     return QObject::event(event);
 }
 
+bool PlatformTheme::invalidate()
+{
+    d->pendingUpdate = true;
+
+    // Themes that nothing depends on can wait until the next time one of their
+    // properties is read. Otherwise, update right away so that change signals
+    // get emitted.
+    static const std::array<QMetaMethod, 6> signalMethods = {
+        QMetaMethod::fromSignal(&PlatformTheme::colorsChanged),
+        QMetaMethod::fromSignal(&PlatformTheme::defaultFontChanged),
+        QMetaMethod::fromSignal(&PlatformTheme::smallFontChanged),
+        QMetaMethod::fromSignal(&PlatformTheme::colorSetChanged),
+        QMetaMethod::fromSignal(&PlatformTheme::colorGroupChanged),
+        QMetaMethod::fromSignal(&PlatformTheme::paletteChanged),
+    };
+
+    bool observed = d->data && d->data->owner == this && d->data->watchers.size() > 1;
+    for (auto it = signalMethods.begin(); !observed && it != signalMethods.end(); ++it) {
+        observed = isSignalConnected(*it);
+    }
+
+    if (!observed) {
+        return false;
+    }
+
+    update();
+    return true;
+}
+
 void PlatformTheme::update()
 {
+    TraceScope trace(KirigamiPlatformTrace(), "PlatformTheme::update");
+    if (trace.isEnabled()) {
+        trace.addArgument("item", parent());
+    }
+
+    d->pendingUpdate = false;
+    PerformanceCounters::count(PerformanceCounters::ThemeUpdate);
+
     auto oldData = d->data;
 
     bool actualInherit = d->inherit;
@@ -975,6 +1384,10 @@ void PlatformTheme::update()
             }
 
             auto t = static_cast<PlatformTheme *>(qmlAttachedPropertiesObject<PlatformTheme>(candidate, false));
+            if (t) {
+                t->d->resolve(t);
+            }
+
             if (t && t->d->data && t->d->data->owner == t) {
                 if (d->data == t->d->data) {
                     // Inheritance is already correct, do nothing.
@@ -1003,8 +1416,8 @@ void PlatformTheme::update()
     }
 
     if (d->localOverrides) {
-        for (auto entry : *d->localOverrides) {
-            d->data->setColor(this, PlatformThemeData::ColorRole(entry.first), entry.second);
+        for (const auto &entry : *d->localOverrides) {
+            d->data->setColor(this, entry.role, QColor::fromRgba64(entry.color));
         }
     }
 
@@ -1021,9 +1434,10 @@ void PlatformTheme::updateChildren(QObject *object)
     const auto children = object->children();
     for (auto child : children) {
         auto t = static_cast<PlatformTheme *>(qmlAttachedPropertiesObject<PlatformTheme>(child, false));
-        if (t) {
-            t->update();
-        } else {
+        // If the theme is updated, it will update its own children if needed.
+        // Otherwise, its children may still depend on this theme through the
+        // data they share, so continue with them.
+        if (!t || !t->invalidate()) {
             updateChildren(child);
         }
     }
@@ -1049,33 +1463,32 @@ QObject *PlatformTheme::determineParent(QObject *object)
 PlatformThemeChangeTracker::PlatformThemeChangeTracker(PlatformTheme *theme, PropertyChanges changes)
     : m_theme(theme)
 {
-    auto itr = s_blockedChanges.constFind(theme);
-    if (itr == s_blockedChanges.constEnd() || (*itr).expired()) {
-        m_data = std::make_shared<Data>();
-        s_blockedChanges.insert(theme, m_data);
-    } else {
-        m_data = (*itr).lock();
-    }
-
-    m_data->changes |= changes;
+    ++m_theme->d->changeTrackerCount;
+    markDirty(changes);
 }
 
 PlatformThemeChangeTracker::~PlatformThemeChangeTracker() noexcept
 {
-    std::weak_ptr<Data> dataWatcher = m_data;
+    if (--m_theme->d->changeTrackerCount > 0) {
+        return;
+    }
 
-    auto changes = m_data->changes;
-    m_data.reset();
+    const auto changes = std::exchange(m_theme->d->pendingChanges, 0);
 
-    if (dataWatcher.use_count() <= 0) {
-        m_theme->emitSignalsForChanges(changes);
-        s_blockedChanges.remove(m_theme);
+    auto data = m_theme->d->data;
+    if (data && data->owner == m_theme) {
+        data->internColors();
+        if (data->pendingChanges) {
+            data->deliverPendingChanges();
+        }
     }
+
+    m_theme->emitSignalsForChanges(changes);
 }
 
 void PlatformThemeChangeTracker::markDirty(PropertyChanges changes)
 {
-    m_data->changes |= changes;
+    m_theme->d->pendingChanges |= uint8_t(changes.toInt());
 }
 }
 }
@@ -314,6 +314,23 @@ public:
     // QML attached property
     static PlatformTheme *qmlAttachedProperties(QObject *object);
 
+    /**
+     * The theme to read the colors of @p object from.
+     *
+     * Creating the attached theme of an object makes it watch the theme it
+     * inherits from. When the object only needs to read its colors once, this
+     * returns the theme it would inherit from instead, as long as the object
+     * has no attached theme yet and would inherit all colors unchanged.
+     * Otherwise, the attached theme of the object is returned, creating it if
+     * needed.
+     *
+     * The returned theme is not necessarily attached to @p object, so use
+     * the attached theme instead to be notified of changes.
+     *
+     * @since 6.12
+     */
+    static PlatformTheme *themeForReading(QObject *object);
+
 Q_SIGNALS:
     void colorsChanged();
     void defaultFontChanged(const QFont &font);
@@ -361,8 +378,9 @@ protected:
 
 private:
     KIRIGAMIPLATFORM_NO_EXPORT void update();
+    KIRIGAMIPLATFORM_NO_EXPORT bool invalidate();
     KIRIGAMIPLATFORM_NO_EXPORT void updateChildren(QObject *item);
-    KIRIGAMIPLATFORM_NO_EXPORT QObject *determineParent(QObject *object);
+    KIRIGAMIPLATFORM_NO_EXPORT static QObject *determineParent(QObject *object);
     KIRIGAMIPLATFORM_NO_EXPORT void emitSignalsForChanges(int changes);
 
     PlatformThemePrivate *d;
@@ -407,13 +425,12 @@ public:
     void markDirty(PropertyChanges changes);
 
 private:
+    // The changes themselves are stored in the theme, so nesting trackers
+    // only increases a counter there.
     PlatformTheme *m_theme;
 
-    // Per-PlatformTheme data that we need for PlatformThemeChangeBlocker.
-    // We don't want to store this in PlatformTheme since that would increase the
-    // size of every instance of PlatformTheme while it's only used when we want to
-    // block property change signal emissions. So instead we store it in a separate
-    // hash using the PlatformTheme as key.
+    // Unused, kept for binary compatibility with the size and layout of the
+    // class before the changes were moved into the theme.
     struct Data {
         PropertyChanges changes;
     };
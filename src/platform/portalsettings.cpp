@@ -0,0 +1,104 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "portalsettings_p.h"
+
+#include <QDBusConnection>
+#include <QDBusPendingCallWatcher>
+#include <QTimer>
+
+#include "kirigamiplatform_logging.h"
+#include "settings_interface.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+namespace Kirigami
+{
+namespace Platform
+{
+
+Q_GLOBAL_STATIC(PortalSettings, portalSettingsSelf)
+
+// All groups used by any of the watchers, so they can be read at once.
+static const QStringList groups = {u"org.kde.TabletMode"_s, u"org.kde.VirtualKeyboard"_s};
+
+PortalSettings::PortalSettings()
+{
+    // Connecting to the session bus for the first time waits for the bus,
+    // so do not do that while the application is still being set up.
+    QTimer::singleShot(0, this, &PortalSettings::connectToPortal);
+}
+
+PortalSettings::~PortalSettings() = default;
+
+PortalSettings *PortalSettings::self()
+{
+    return portalSettingsSelf();
+}
+
+bool PortalSettings::isReady() const
+{
+    return m_ready;
+}
+
+QVariantMap PortalSettings::values(const QString &group) const
+{
+    return m_values.value(group);
+}
+
+OrgFreedesktopPortalSettingsInterface *PortalSettings::interface() const
+{
+    return m_interface;
+}
+
+void PortalSettings::connectToPortal()
+{
+    qDBusRegisterMetaType<VariantMapMap>();
+    m_interface = new OrgFreedesktopPortalSettingsInterface(u"org.freedesktop.portal.Desktop"_s,
+                                                            u"/org/freedesktop/portal/desktop"_s,
+                                                            QDBusConnection::sessionBus(),
+                                                            this);
+
+    connect(m_interface,
+            &OrgFreedesktopPortalSettingsInterface::SettingChanged,
+            this,
+            [this](const QString &group, const QString &key, const QDBusVariant &value) {
+                if (!groups.contains(group)) {
+                    return;
+                }
+                m_values[group][key] = value.variant();
+                Q_EMIT settingChanged(group, key, value.variant());
+            });
+
+    auto call = new QDBusPendingCallWatcher(m_interface->ReadAll(groups), this);
+    connect(call, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *call) {
+        call->deleteLater();
+
+        QDBusPendingReply<VariantMapMap> reply = *call;
+        if (reply.isError()) {
+            qCDebug(KirigamiPlatform) << reply.error().message();
+        } else {
+            // Changes received while waiting for the reply are newer.
+            const auto values = reply.value();
+            for (auto it = values.cbegin(); it != values.cend(); ++it) {
+                auto &group = m_values[it.key()];
+                for (auto keyIt = it->cbegin(); keyIt != it->cend(); ++keyIt) {
+                    if (!group.contains(keyIt.key())) {
+                        group.insert(keyIt.key(), keyIt.value());
+                    }
+                }
+            }
+        }
+
+        m_ready = true;
+        Q_EMIT ready();
+    });
+}
+
+}
+}
+
+#include "moc_portalsettings_p.cpp"
@@ -0,0 +1,75 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QVariantMap>
+
+#include "dbustypes.h"
+
+class OrgFreedesktopPortalSettingsInterface;
+
+namespace Kirigami
+{
+namespace Platform
+{
+
+/**
+ * The settings portal client shared by all of Kirigami's watchers.
+ *
+ * The portal is only contacted once the event loop runs, after which all
+ * groups used by Kirigami are read using a single asynchronous ReadAll call.
+ * Nothing in here ever blocks, watchers use their default values until
+ * ready() is emitted.
+ *
+ * @internal
+ */
+class PortalSettings : public QObject
+{
+    Q_OBJECT
+
+public:
+    PortalSettings();
+    ~PortalSettings() override;
+
+    static PortalSettings *self();
+
+    /**
+     * Whether the initial values have been read from the portal.
+     */
+    bool isReady() const;
+
+    /**
+     * @returns the values of all keys in @p group, which is empty until the
+     * portal has replied.
+     */
+    QVariantMap values(const QString &group) const;
+
+    /**
+     * @returns the interface to the portal, or nullptr if the portal has
+     * not been contacted yet.
+     */
+    OrgFreedesktopPortalSettingsInterface *interface() const;
+
+Q_SIGNALS:
+    /**
+     * Emitted once the initial values have been read.
+     */
+    void ready();
+
+    void settingChanged(const QString &group, const QString &key, const QVariant &value);
+
+private:
+    void connectToPortal();
+
+    OrgFreedesktopPortalSettingsInterface *m_interface = nullptr;
+    VariantMapMap m_values;
+    bool m_ready = false;
+};
+
+}
+}
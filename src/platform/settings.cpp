@@ -8,6 +8,7 @@
 
 #include <QDebug>
 #include <QFile>
+#include <QFutureWatcher>
 #include <QGuiApplication>
 #include <QIcon>
 #include <QInputDevice>
@@ -15,6 +16,7 @@
 #include <QSettings>
 #include <QStandardPaths>
 #include <QWindow>
+#include <QtConcurrentRun>
 
 #include <QtGui/private/qguiapplication_p.h>
 #include <QtGui/qpa/qplatformmenu.h>
@@ -35,10 +37,38 @@ public:
     Settings self;
 };
 
+namespace
+{
+struct GlobalSettings {
+    int scrollLines = 3;
+    bool smoothScroll = true;
+};
+
+GlobalSettings readGlobalSettings()
+{
+    GlobalSettings settings;
+
+    const QString configPath = QStandardPaths::locate(QStandardPaths::ConfigLocation, QStringLiteral("kdeglobals"));
+    if (QFile::exists(configPath)) {
+        QSettings globals(configPath, QSettings::IniFormat);
+        globals.beginGroup(QStringLiteral("KDE"));
+        settings.scrollLines = qMax(1, globals.value(QStringLiteral("WheelScrollLines"), 3).toInt());
+        settings.smoothScroll = globals.value(QStringLiteral("SmoothScroll"), true).toBool();
+    }
+
+    return settings;
+}
+}
+
 Settings::Settings(QObject *parent)
     : QObject(parent)
+    , m_scrollLines(GlobalSettings{}.scrollLines)
+    , m_smoothScroll(GlobalSettings{}.smoothScroll)
     , m_hasTouchScreen(false)
     , m_hasTransientTouchInput(false)
+    , m_smoothScrollWatched(false)
+    , m_hasPlatformMenuBar(false)
+    , m_platformMenuBarChecked(false)
 {
     m_tabletModeAvailable = TabletModeWatcher::self()->isTabletModeAvailable();
     connect(TabletModeWatcher::self(), &TabletModeWatcher::tabletModeAvailableChanged, this, [this](bool tabletModeAvailable) {
@@ -79,29 +109,36 @@ Settings::Settings(QObject *parent)
     }
 #endif
 
-    auto bar = QGuiApplicationPrivate::platformTheme()->createPlatformMenuBar();
-    m_hasPlatformMenuBar = bar != nullptr;
-    if (bar != nullptr) {
-        bar->deleteLater();
-    }
-
-    const QString configPath = QStandardPaths::locate(QStandardPaths::ConfigLocation, QStringLiteral("kdeglobals"));
-    if (QFile::exists(configPath)) {
-        QSettings globals(configPath, QSettings::IniFormat);
-        globals.beginGroup(QStringLiteral("KDE"));
-        m_scrollLines = qMax(1, globals.value(QStringLiteral("WheelScrollLines"), 3).toInt());
-        m_smoothScroll = globals.value(QStringLiteral("SmoothScroll"), true).toBool();
-    } else {
-        m_scrollLines = 3;
-        m_smoothScroll = true;
-    }
+    loadGlobalSettings();
 
     connect(SmoothScrollWatcher::self(), &SmoothScrollWatcher::enabledChanged, this, [this](bool enabled) {
+        m_smoothScrollWatched = true;
         m_smoothScroll = enabled;
         Q_EMIT smoothScrollChanged();
     });
 }
 
+void Settings::loadGlobalSettings()
+{
+    // Parsing kdeglobals is slow enough to be noticeable at startup, so it is
+    // read from a worker thread and the defaults are used until it's done.
+    auto watcher = new QFutureWatcher<GlobalSettings>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher]() {
+        const GlobalSettings globals = watcher->result();
+        watcher->deleteLater();
+
+        if (globals.scrollLines != m_scrollLines) {
+            m_scrollLines = globals.scrollLines;
+            Q_EMIT mouseWheelScrollLinesChanged();
+        }
+        if (!m_smoothScrollWatched && globals.smoothScroll != m_smoothScroll) {
+            m_smoothScroll = globals.smoothScroll;
+            Q_EMIT smoothScrollChanged();
+        }
+    });
+    watcher->setFuture(QtConcurrent::run(readGlobalSettings));
+}
+
 Settings::~Settings()
 {
 }
@@ -233,6 +270,14 @@ QVariant Settings::applicationWindowIcon() const
 
 bool Settings::hasPlatformMenuBar() const
 {
+    if (!m_platformMenuBarChecked) {
+        m_platformMenuBarChecked = true;
+        auto bar = QGuiApplicationPrivate::platformTheme()->createPlatformMenuBar();
+        m_hasPlatformMenuBar = bar != nullptr;
+        if (bar != nullptr) {
+            bar->deleteLater();
+        }
+    }
     return m_hasPlatformMenuBar;
 }
 
@@ -74,8 +74,11 @@ class KIRIGAMIPLATFORM_EXPORT Settings : public QObject
     // TODO: make this adapt without file watchers?
     /**
      * This property holds the number of lines of text the mouse wheel should scroll.
+     *
+     * The system configuration is read in the background on startup, so this
+     * may change once after the application started.
      */
-    Q_PROPERTY(int mouseWheelScrollLines READ mouseWheelScrollLines CONSTANT FINAL)
+    Q_PROPERTY(int mouseWheelScrollLines READ mouseWheelScrollLines NOTIFY mouseWheelScrollLinesChanged FINAL)
 
     /**
      * This property holds whether to display animated transitions when scrolling with a
@@ -138,8 +141,14 @@ Q_SIGNALS:
     void isMobileChanged();
     void hasTransientTouchInputChanged();
     void smoothScrollChanged();
+    /**
+     * @since 6.12
+     */
+    void mouseWheelScrollLinesChanged();
 
 private:
+    void loadGlobalSettings();
+
     QString m_style;
     int m_scrollLines = 0;
     bool m_smoothScroll : 1;
@@ -148,7 +157,12 @@ private:
     bool m_tabletMode : 1;
     bool m_hasTouchScreen : 1;
     bool m_hasTransientTouchInput : 1;
-    bool m_hasPlatformMenuBar : 1;
+    // Whether SmoothScrollWatcher reported a value, which takes precedence
+    // over the one read from the configuration.
+    bool m_smoothScrollWatched : 1;
+    // Determined on first use, as it needs creating a platform menu bar.
+    mutable bool m_hasPlatformMenuBar : 1;
+    mutable bool m_platformMenuBarChecked : 1;
 };
 
 }
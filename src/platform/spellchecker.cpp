@@ -0,0 +1,45 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "spellchecker.h"
+
+#include "platformpluginfactory.h"
+
+namespace Kirigami
+{
+namespace Platform
+{
+
+static SpellCheckerFactory *s_applicationFactory = nullptr;
+
+SpellChecker::~SpellChecker() = default;
+
+SpellCheckerFactory::~SpellCheckerFactory()
+{
+    if (s_applicationFactory == this) {
+        s_applicationFactory = nullptr;
+    }
+}
+
+SpellCheckerFactory *SpellCheckerFactory::instance()
+{
+    if (s_applicationFactory) {
+        return s_applicationFactory;
+    }
+
+    // The plugin lookup is cached, and the platform plugin lives as long as
+    // the application.
+    static SpellCheckerFactory *const platformFactory = qobject_cast<SpellCheckerFactory *>(PlatformPluginFactory::findPlugin());
+    return platformFactory;
+}
+
+void SpellCheckerFactory::setInstance(SpellCheckerFactory *factory)
+{
+    s_applicationFactory = factory;
+}
+
+}
+}
@@ -0,0 +1,100 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef KIRIGAMI_SPELLCHECKER_H
+#define KIRIGAMI_SPELLCHECKER_H
+
+#include <QObject>
+#include <QStringView>
+
+#include <memory>
+
+#include "kirigamiplatform_export.h"
+
+namespace Kirigami
+{
+namespace Platform
+{
+
+/**
+ * @class SpellChecker spellchecker.h <Kirigami/SpellChecker>
+ *
+ * Checks the spelling of words of a single language, for text fields using
+ * `Kirigami.SpellCheck`.
+ *
+ * Spell checkers are only used from the worker thread shared by all the text
+ * fields of the process, so they don't need to be thread safe.
+ *
+ * @since 6.12
+ */
+class KIRIGAMIPLATFORM_EXPORT SpellChecker
+{
+public:
+    virtual ~SpellChecker();
+
+    /**
+     * Whether @p word is spelled correctly.
+     */
+    virtual bool isCorrect(QStringView word) = 0;
+};
+
+/**
+ * @class SpellCheckerFactory spellchecker.h <Kirigami/SpellChecker>
+ *
+ * Creates the spell checkers used by `Kirigami.SpellCheck`.
+ *
+ * Kirigami doesn't provide spell checking by itself. A platform plugin can
+ * provide it by implementing this interface in addition to
+ * PlatformPluginFactory, and declaring it with Q_INTERFACES. Applications
+ * can also install their own factory with setInstance().
+ *
+ * The dictionary of each language is loaded only once per process, on the
+ * worker thread, by calling createSpellChecker().
+ *
+ * @since 6.12
+ */
+class KIRIGAMIPLATFORM_EXPORT SpellCheckerFactory
+{
+public:
+    virtual ~SpellCheckerFactory();
+
+    /**
+     * Creates a spell checker for @p language, a locale name like `en_US`,
+     * or returns nullptr if no dictionary is available for it.
+     *
+     * This is called on the spell checking worker thread.
+     */
+    virtual std::unique_ptr<SpellChecker> createSpellChecker(const QString &language) = 0;
+
+    /**
+     * The factory used for spell checking: the one installed by the
+     * application if any, otherwise the platform plugin for the current
+     * style if it implements SpellCheckerFactory, or nullptr.
+     *
+     * This needs to be called on the GUI thread.
+     */
+    static SpellCheckerFactory *instance();
+
+    /**
+     * Installs @p factory for the whole application, replacing the one of
+     * the platform plugin. The factory is not owned and has to outlive all
+     * spell checking.
+     *
+     * This should be called before any text field using spell checking is
+     * created.
+     */
+    static void setInstance(SpellCheckerFactory *factory);
+};
+
+}
+}
+
+QT_BEGIN_NAMESPACE
+#define SpellCheckerFactory_iid "org.kde.kirigami.SpellCheckerFactory"
+Q_DECLARE_INTERFACE(Kirigami::Platform::SpellCheckerFactory, SpellCheckerFactory_iid)
+QT_END_NAMESPACE
+
+#endif // KIRIGAMI_SPELLCHECKER_H
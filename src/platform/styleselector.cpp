@@ -7,9 +7,11 @@
 #include "styleselector.h"
 
 #include <QDir>
-#include <QFile>
 #include <QQuickStyle>
 #include <kirigamiplatform_logging.h>
+#include <kirigamiplatform_startup_logging.h>
+
+#include "tracescope_p.h"
 
 namespace Kirigami
 {
@@ -35,13 +37,15 @@ QStringList StyleSelector::styleChain()
         return s_styleChain;
     }
 
+    TraceScope trace(KirigamiPlatformStartup(), "StyleSelector::styleChain");
+
     auto style = QQuickStyle::name();
 
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
     // org.kde.desktop.plasma is a couple of files that fall back to desktop by purpose
     if (style.isEmpty() || style == QStringLiteral("org.kde.desktop.plasma")) {
         auto path = resolveFilePath(QStringLiteral("/styles/org.kde.desktop"));
-        if (QFile::exists(path)) {
+        if (fileExists(path)) {
             s_styleChain.prepend(QStringLiteral("org.kde.desktop"));
         }
     }
@@ -52,11 +56,11 @@ QStringList StyleSelector::styleChain()
 #endif
 
     auto stylePath = resolveFilePath(QStringLiteral("/styles/") + style);
-    if (!style.isEmpty() && QFile::exists(stylePath) && !s_styleChain.contains(style)) {
+    if (!style.isEmpty() && fileExists(stylePath) && !s_styleChain.contains(style)) {
         s_styleChain.prepend(style);
         // if we have plasma deps installed, use them for extra integration
         auto plasmaPath = resolveFilePath(QStringLiteral("/styles/org.kde.desktop.plasma"));
-        if (style == QStringLiteral("org.kde.desktop") && QFile::exists(plasmaPath)) {
+        if (style == QStringLiteral("org.kde.desktop") && fileExists(plasmaPath)) {
             s_styleChain.prepend(QStringLiteral("org.kde.desktop.plasma"));
         }
     } else {
@@ -70,23 +74,61 @@ QStringList StyleSelector::styleChain()
 
 QUrl StyleSelector::componentUrl(const QString &fileName)
 {
-    const auto chain = styleChain();
-    for (const QString &style : chain) {
-        const QString candidate = QStringLiteral("styles/") + style + QLatin1Char('/') + fileName;
-        if (QFile::exists(resolveFilePath(candidate))) {
-            return QUrl(resolveFileUrl(candidate));
-        }
+    if (auto it = s_componentUrls.constFind(fileName); it != s_componentUrls.constEnd()) {
+        return it.value();
     }
 
-    if (!QFile::exists(resolveFilePath(fileName))) {
-        qCWarning(KirigamiPlatform) << "Requested an unexisting component" << fileName;
+    auto resolve = [&fileName]() {
+        const auto chain = styleChain();
+        for (const QString &style : chain) {
+            const QString candidate = QStringLiteral("styles/") + style + QLatin1Char('/') + fileName;
+            if (fileExists(resolveFilePath(candidate))) {
+                return QUrl(resolveFileUrl(candidate));
+            }
+        }
+
+        if (!fileExists(resolveFilePath(fileName))) {
+            qCWarning(KirigamiPlatform) << "Requested an unexisting component" << fileName;
+        }
+        return QUrl(resolveFileUrl(fileName));
+    };
+
+    const QUrl url = resolve();
+    // The chain can change per call when the style is forced, so only cache
+    // the result when it cannot.
+    if (qEnvironmentVariableIntValue("KIRIGAMI_FORCE_STYLE") != 1) {
+        s_componentUrls.insert(fileName, url);
     }
-    return QUrl(resolveFileUrl(fileName));
+    return url;
 }
 
 void StyleSelector::setBaseUrl(const QUrl &baseUrl)
 {
+    if (baseUrl == s_baseUrl) {
+        return;
+    }
+
     s_baseUrl = baseUrl;
+    s_componentUrls.clear();
+    s_directoryEntries.clear();
+}
+
+bool StyleSelector::fileExists(const QString &path)
+{
+    // Every component is looked up in each style of the chain, which used to
+    // mean several stat calls per component. Instead, list each directory
+    // once and answer all lookups from memory.
+    const QString cleanPath = QDir::cleanPath(path);
+    const qsizetype separator = cleanPath.lastIndexOf(QLatin1Char('/'));
+    const QString directory = cleanPath.left(separator);
+    const QString name = cleanPath.mid(separator + 1);
+
+    auto it = s_directoryEntries.find(directory);
+    if (it == s_directoryEntries.end()) {
+        const QStringList entries = QDir(directory).entryList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden);
+        it = s_directoryEntries.insert(directory, QSet<QString>(entries.begin(), entries.end()));
+    }
+    return it->contains(name);
 }
 
 QString StyleSelector::resolveFilePath(const QString &path)
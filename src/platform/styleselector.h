@@ -7,6 +7,8 @@
 #ifndef STYLESELECTOR_H
 #define STYLESELECTOR_H
 
+#include <QHash>
+#include <QSet>
 #include <QStringList>
 #include <QUrl>
 
@@ -33,8 +35,12 @@ public:
     static QString resolveFileUrl(const QString &path);
 
 private:
+    KIRIGAMIPLATFORM_NO_EXPORT static bool fileExists(const QString &path);
+
     inline static QUrl s_baseUrl;
     inline static QStringList s_styleChain;
+    inline static QHash<QString, QUrl> s_componentUrls;
+    inline static QHash<QString, QSet<QString>> s_directoryEntries;
 };
 
 }
@@ -9,8 +9,7 @@
 #include <QCoreApplication>
 
 #if defined(KIRIGAMI_ENABLE_DBUS)
-#include "settings_interface.h"
-#include <QDBusConnection>
+#include "portalsettings_p.h"
 #endif
 
 using namespace Qt::Literals::StringLiterals;
@@ -58,41 +57,36 @@ public:
         } else if (qEnvironmentVariableIsSet("QT_NO_XDG_DESKTOP_PORTAL")) {
             isTabletMode = false;
         } else {
-            qDBusRegisterMetaType<VariantMapMap>();
-            auto portal = new OrgFreedesktopPortalSettingsInterface(u"org.freedesktop.portal.Desktop"_s,
-                                                                    u"/org/freedesktop/portal/desktop"_s,
-                                                                    QDBusConnection::sessionBus(),
-                                                                    q);
-
-            QObject::connect(portal,
-                             &OrgFreedesktopPortalSettingsInterface::SettingChanged,
-                             q,
-                             [this](const QString &group, const QString &key, const QDBusVariant &value) {
-                                 if (group != PORTAL_GROUP) {
-                                     return;
-                                 }
-                                 if (key == KEY_AVAILABLE) {
-                                     Q_EMIT q->tabletModeAvailableChanged(value.variant().toBool());
-                                 } else if (key == KEY_ENABLED) {
-                                     setIsTablet(value.variant().toBool());
-                                 }
-                             });
-
-            const auto reply = portal->ReadAll({PORTAL_GROUP});
-            auto watcher = new QDBusPendingCallWatcher(reply, q);
-            QObject::connect(watcher, &QDBusPendingCallWatcher::finished, q, [this, watcher]() {
-                watcher->deleteLater();
-                QDBusPendingReply<VariantMapMap> reply = *watcher;
-                const auto properties = reply.value().value(PORTAL_GROUP);
-                Q_EMIT q->tabletModeAvailableChanged(properties[KEY_AVAILABLE].toBool());
-                setIsTablet(properties[KEY_ENABLED].toBool());
+            auto settings = PortalSettings::self();
+
+            QObject::connect(settings, &PortalSettings::settingChanged, q, [this](const QString &group, const QString &key, const QVariant &value) {
+                if (group != PORTAL_GROUP) {
+                    return;
+                }
+                if (key == KEY_AVAILABLE) {
+                    setIsTabletModeAvailable(value.toBool());
+                } else if (key == KEY_ENABLED) {
+                    setIsTablet(value.toBool());
+                }
             });
+
+            auto readValues = [this]() {
+                const auto properties = PortalSettings::self()->values(PORTAL_GROUP);
+                setIsTabletModeAvailable(properties[KEY_AVAILABLE].toBool());
+                setIsTablet(properties[KEY_ENABLED].toBool());
+            };
+            if (settings->isReady()) {
+                readValues();
+            } else {
+                QObject::connect(settings, &PortalSettings::ready, q, readValues);
+            }
         }
 // TODO: case for Windows
 #endif
     }
     ~TabletModeWatcherPrivate() = default;
     void setIsTablet(bool tablet);
+    void setIsTabletModeAvailable(bool available);
 
     TabletModeWatcher *q;
     QList<QObject *> watchers;
@@ -114,6 +108,16 @@ void TabletModeWatcherPrivate::setIsTablet(bool tablet)
     }
 }
 
+void TabletModeWatcherPrivate::setIsTabletModeAvailable(bool available)
+{
+    if (isTabletModeAvailable == available) {
+        return;
+    }
+
+    isTabletModeAvailable = available;
+    Q_EMIT q->tabletModeAvailableChanged(available);
+}
+
 TabletModeWatcher::TabletModeWatcher(QObject *parent)
     : QObject(parent)
     , d(new TabletModeWatcherPrivate(this))
@@ -0,0 +1,110 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "themeiconcache_p.h"
+
+#include <QHash>
+
+#include "platformtheme.h"
+
+namespace Kirigami
+{
+namespace Platform
+{
+
+// Enough for the icons of a few pages, the cache is cleared once it is full.
+static constexpr qsizetype maximumCachedIcons = 1024;
+
+struct ThemeIconKey {
+    // Platform plugins provide their own theme types, which may load icons differently.
+    const QMetaObject *themeType = nullptr;
+    QString name;
+    quint64 color = 0;
+    size_t themeColors = 0;
+    int colorSet = 0;
+    int colorGroup = 0;
+
+    bool operator==(const ThemeIconKey &other) const
+    {
+        return themeType == other.themeType && name == other.name && color == other.color && themeColors == other.themeColors
+            && colorSet == other.colorSet && colorGroup == other.colorGroup;
+    }
+};
+
+static size_t qHash(const ThemeIconKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.themeType, key.name, key.color, key.themeColors, key.colorSet, key.colorGroup);
+}
+
+// The key covers everything the icons depend on, so palette changes don't
+// need to clear the cache: they only lead to new keys.
+struct ThemeIconStorage {
+    QHash<ThemeIconKey, QIcon> icons;
+    QString iconThemeName;
+};
+
+Q_GLOBAL_STATIC(ThemeIconStorage, s_storage)
+
+size_t ThemeIconCache::colorsKey(const PlatformTheme *theme)
+{
+    return qHashMulti(0,
+                      theme->textColor().rgba(),
+                      theme->backgroundColor().rgba(),
+                      theme->highlightColor().rgba(),
+                      theme->highlightedTextColor().rgba(),
+                      theme->positiveTextColor().rgba(),
+                      theme->neutralTextColor().rgba(),
+                      theme->negativeTextColor().rgba());
+}
+
+QIcon ThemeIconCache::icon(PlatformTheme *theme, const QString &name, const QColor &customColor)
+{
+    if (!theme) {
+        return QIcon::fromTheme(name);
+    }
+
+    // The icon theme can change without any change to the colors, for
+    // instance when the application or the platform theme sets it.
+    if (const QString themeName = QIcon::themeName(); themeName != s_storage->iconThemeName) {
+        s_storage->icons.clear();
+        s_storage->iconThemeName = themeName;
+    }
+
+    const ThemeIconKey key{
+        theme->metaObject(),
+        name,
+        customColor.rgba64(),
+        colorsKey(theme),
+        theme->colorSet(),
+        theme->colorGroup(),
+    };
+
+    if (auto itr = s_storage->icons.constFind(key); itr != s_storage->icons.cend()) {
+        return *itr;
+    }
+
+    const QIcon icon = theme->iconFromTheme(name, customColor);
+    if (s_storage->icons.size() >= maximumCachedIcons) {
+        s_storage->icons.clear();
+    }
+    s_storage->icons.insert(key, icon);
+    return icon;
+}
+
+void ThemeIconCache::clear()
+{
+    if (!s_storage.isDestroyed()) {
+        s_storage->icons.clear();
+    }
+}
+
+int ThemeIconCache::count()
+{
+    return s_storage.isDestroyed() ? 0 : s_storage->icons.size();
+}
+
+}
+}
@@ -0,0 +1,58 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QColor>
+#include <QIcon>
+
+#include "kirigamiplatform_export.h"
+
+namespace Kirigami
+{
+namespace Platform
+{
+class PlatformTheme;
+
+/**
+ * Caches the icons returned by PlatformTheme::iconFromTheme().
+ *
+ * Platform plugins may recolor themed icons to match the colors of a theme,
+ * which is expensive and would otherwise happen for every icon instance. The
+ * icons are cached by name, color, color set, color group and colors of the
+ * theme, and the cache is cleared whenever the icon theme changes. Must only
+ * be used from the GUI thread.
+ */
+class KIRIGAMIPLATFORM_EXPORT ThemeIconCache
+{
+public:
+    /**
+     * The icon @p theme returns for @p name and @p customColor, loading it
+     * through PlatformTheme::iconFromTheme() if it is not cached yet.
+     */
+    static QIcon icon(PlatformTheme *theme, const QString &name, const QColor &customColor = Qt::transparent);
+
+    /**
+     * A hash of the colors of @p theme that platform plugins use to recolor
+     * icons. Unlike QPalette::cacheKey() of PlatformTheme::palette(), this
+     * stays the same as long as the colors do, also for themes with local
+     * color overrides.
+     */
+    static size_t colorsKey(const PlatformTheme *theme);
+
+    /**
+     * Remove all cached icons.
+     */
+    static void clear();
+
+    /**
+     * The number of cached icons.
+     */
+    static int count();
+};
+
+}
+}
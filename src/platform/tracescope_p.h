@@ -0,0 +1,84 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QDebug>
+#include <QLoggingCategory>
+
+#include <chrono>
+
+/**
+ * Traces the time spent in a scope.
+ *
+ * When debug output for @p category is enabled, a begin event is logged on
+ * construction and an end event, including the duration and any arguments
+ * added in the meantime, on destruction. Both carry a timestamp in
+ * nanoseconds of the monotonic clock, which is also used by Qt's own timing
+ * output such as the `qt.scenegraph.time.*` categories, so the events can be
+ * lined up with the frames they belong to.
+ *
+ * When the category is disabled, this costs a single check on construction.
+ *
+ * Each library has its own `kf.kirigami.trace` category, for example
+ * `kf.kirigami.trace.layouts`. Enable all of them with
+ * `QT_LOGGING_RULES="kf.kirigami.trace*.debug=true"`. The startup steps are
+ * traced in the `kf.kirigami.startup` categories instead.
+ */
+class TraceScope
+{
+public:
+    TraceScope(const QLoggingCategory &category, const char *name)
+        : m_category(category.isDebugEnabled() ? &category : nullptr)
+        , m_name(name)
+    {
+        if (m_category) {
+            m_start = std::chrono::steady_clock::now();
+            QMessageLogger().debug(*m_category).nospace() << "begin " << m_name << " @" << timestamp(m_start);
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (m_category) {
+            const auto end = std::chrono::steady_clock::now();
+            const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - m_start).count();
+            QMessageLogger().debug(*m_category).nospace().noquote()
+                << "end " << m_name << " @" << timestamp(end) << " duration: " << duration << "us" << m_arguments;
+        }
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+    bool isEnabled() const
+    {
+        return m_category != nullptr;
+    }
+
+    /**
+     * Add an argument to the end event. This does nothing when tracing is
+     * disabled, check isEnabled() first if computing @p value is expensive.
+     */
+    template<typename T>
+    void addArgument(const char *name, const T &value)
+    {
+        if (m_category) {
+            QDebug(&m_arguments).nospace() << ", " << name << ": " << value;
+        }
+    }
+
+private:
+    static qint64 timestamp(std::chrono::steady_clock::time_point time)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+
+    const QLoggingCategory *const m_category;
+    const char *const m_name;
+    std::chrono::steady_clock::time_point m_start;
+    QString m_arguments;
+};
@@ -17,23 +17,94 @@
 
 #include <chrono>
 #include <cmath>
+#include <optional>
 
 #include "kirigamiplatform_logging.h"
+#include "kirigamiplatform_startup_logging.h"
 #include "platformpluginfactory.h"
+#include "tracescope_p.h"
 
 namespace Kirigami
 {
 namespace Platform
 {
 
+/**
+ * Notifies about application font changes.
+ *
+ * Only a single application wide event filter is installed, shared by the
+ * Units of all engines.
+ */
+class ApplicationFontWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    ApplicationFontWatcher()
+    {
+        qGuiApp->installEventFilter(this);
+    }
+
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        // The event is sent to the application object and every window, only
+        // react to it once.
+        if (event->type() == QEvent::ApplicationFontChange && watched == qGuiApp) {
+            Q_EMIT fontChanged();
+        }
+        return false;
+    }
+
+Q_SIGNALS:
+    void fontChanged();
+};
+
+Q_GLOBAL_STATIC(ApplicationFontWatcher, applicationFontWatcher)
+
+static int roundedIconSize(int size)
+{
+    if (size < 16) {
+        return size;
+    }
+
+    if (size < 22) {
+        return 16;
+    }
+
+    if (size < 32) {
+        return 22;
+    }
+
+    if (size < 48) {
+        return 32;
+    }
+
+    if (size < 64) {
+        return 48;
+    }
+
+    return size;
+}
+
+static bool platformReducedMotionDefault()
+{
+    return QByteArrayList{"1", "true"}.contains(qgetenv("KIRIGAMI_REDUCED_MOTION").toLower());
+}
+
+static int sizeForLabels(const QFont &font)
+{
+    // TextMetrics uses QFontMetricsF internally, so this should do the same
+    return roundedIconSize(QFontMetricsF(font).height());
+}
+
 class UnitsPrivate
 {
     Q_DISABLE_COPY(UnitsPrivate)
 
 public:
     explicit UnitsPrivate(Units *units)
-        // Cache font so we don't have to go through QVariant and property every time
-        : fontMetrics(QFontMetricsF(QGuiApplication::font()))
+        // Computed once per font change, as many bindings read the icon sizes
+        : sizeForLabels(Platform::sizeForLabels(QGuiApplication::font()))
         , gridUnit(18)
         , smallSpacing(4)
         , mediumSpacing(6)
@@ -49,9 +120,8 @@ public:
     {
     }
 
-    // Font metrics used for Units.
-    // TextMetrics uses QFontMetricsF internally, so this should do the same
-    QFontMetricsF fontMetrics;
+    // Icon size matching the height of the application font.
+    int sizeForLabels;
 
     // units
     int gridUnit;
@@ -69,9 +139,21 @@ public:
     qreal cornerRadius;
 
     IconSizes *const iconSizes;
+    // Created on first use, after platform plugins have set up the units
+    FrozenUnits *frozen = nullptr;
 
     // To prevent overriding custom set units if the font changes
     bool customUnitsSet = false;
+
+    // Whether the platform asks for reduced motion, and the value set by the
+    // application, which takes precedence.
+    bool platformReducedMotion = platformReducedMotionDefault();
+    std::optional<bool> reducedMotion;
+
+    bool isReducedMotion() const
+    {
+        return reducedMotion.value_or(platformReducedMotion);
+    }
 };
 
 Units::~Units() = default;
@@ -80,7 +162,20 @@ Units::Units(QObject *parent)
     : QObject(parent)
     , d(std::make_unique<UnitsPrivate>(this))
 {
-    qGuiApp->installEventFilter(this);
+    connect(applicationFontWatcher(), &ApplicationFontWatcher::fontChanged, this, [this]() {
+        const int sizeForLabels = Platform::sizeForLabels(qGuiApp->font());
+        if (d->sizeForLabels == sizeForLabels) {
+            return;
+        }
+
+        d->sizeForLabels = sizeForLabels;
+
+        if (d->customUnitsSet) {
+            return;
+        }
+
+        Q_EMIT d->iconSizes->sizeForLabelsChanged();
+    });
 }
 
 int Units::gridUnit() const
@@ -149,7 +244,7 @@ void Units::setLargeSpacing(int size)
 
 int Units::veryLongDuration() const
 {
-    return d->veryLongDuration;
+    return d->isReducedMotion() ? 0 : d->veryLongDuration;
 }
 
 void Units::setVeryLongDuration(int duration)
@@ -164,7 +259,7 @@ void Units::setVeryLongDuration(int duration)
 
 int Units::longDuration() const
 {
-    return d->longDuration;
+    return d->isReducedMotion() ? 0 : d->longDuration;
 }
 
 void Units::setLongDuration(int duration)
@@ -179,7 +274,7 @@ void Units::setLongDuration(int duration)
 
 int Units::shortDuration() const
 {
-    return d->shortDuration;
+    return d->isReducedMotion() ? 0 : d->shortDuration;
 }
 
 void Units::setShortDuration(int duration)
@@ -194,7 +289,7 @@ void Units::setShortDuration(int duration)
 
 int Units::veryShortDuration() const
 {
-    return d->veryShortDuration;
+    return d->isReducedMotion() ? 0 : d->veryShortDuration;
 }
 
 void Units::setVeryShortDuration(int duration)
@@ -252,8 +347,61 @@ void Units::setcornerRadius(qreal cornerRadius)
     Q_EMIT cornerRadiusChanged();
 }
 
+bool Units::reducedMotion() const
+{
+    return d->isReducedMotion();
+}
+
+void Units::setReducedMotion(bool reduced)
+{
+    if (d->reducedMotion == reduced) {
+        return;
+    }
+
+    const bool wasReduced = d->isReducedMotion();
+    d->reducedMotion = reduced;
+    notifyReducedMotionChanged(wasReduced);
+}
+
+void Units::resetReducedMotion()
+{
+    if (!d->reducedMotion.has_value()) {
+        return;
+    }
+
+    const bool wasReduced = d->isReducedMotion();
+    d->reducedMotion.reset();
+    notifyReducedMotionChanged(wasReduced);
+}
+
+void Units::setPlatformReducedMotion(bool reduced)
+{
+    if (d->platformReducedMotion == reduced) {
+        return;
+    }
+
+    const bool wasReduced = d->isReducedMotion();
+    d->platformReducedMotion = reduced;
+    notifyReducedMotionChanged(wasReduced);
+}
+
+void Units::notifyReducedMotionChanged(bool wasReduced)
+{
+    if (d->isReducedMotion() == wasReduced) {
+        return;
+    }
+
+    Q_EMIT reducedMotionChanged();
+    Q_EMIT veryLongDurationChanged();
+    Q_EMIT longDurationChanged();
+    Q_EMIT shortDurationChanged();
+    Q_EMIT veryShortDurationChanged();
+}
+
 Units *Units::create(QQmlEngine *qmlEngine, [[maybe_unused]] QJSEngine *jsEngine)
 {
+    TraceScope trace(KirigamiPlatformStartup(), "Units::create");
+
 #ifndef KIRIGAMI_BUILD_TYPE_STATIC
     const QString pluginName = qmlEngine->property("_kirigamiTheme").toString();
 
@@ -270,23 +418,39 @@ Units *Units::create(QQmlEngine *qmlEngine, [[maybe_unused]] QJSEngine *jsEngine
     return new Units(qmlEngine);
 }
 
-bool Units::eventFilter([[maybe_unused]] QObject *watched, QEvent *event)
+bool Units::eventFilter(QObject *watched, QEvent *event)
 {
-    if (event->type() == QEvent::ApplicationFontChange) {
-        d->fontMetrics = QFontMetricsF(qGuiApp->font());
+    // Font changes are handled through ApplicationFontWatcher, this is only kept for compatibility.
+    return QObject::eventFilter(watched, event);
+}
 
-        if (d->customUnitsSet) {
-            return false;
-        }
+IconSizes *Units::iconSizes() const
+{
+    return d->iconSizes;
+}
 
-        Q_EMIT d->iconSizes->sizeForLabelsChanged();
+FrozenUnits *Units::frozen() const
+{
+    if (!d->frozen) {
+        d->frozen = new FrozenUnits(const_cast<Units *>(this));
     }
-    return false;
+    return d->frozen;
 }
 
-IconSizes *Units::iconSizes() const
+FrozenUnits::FrozenUnits(Units *units)
+    : QObject(units)
+    , m_gridUnit(units->gridUnit())
+    , m_smallSpacing(units->smallSpacing())
+    , m_mediumSpacing(units->mediumSpacing())
+    , m_largeSpacing(units->largeSpacing())
+    , m_veryLongDuration(units->veryLongDuration())
+    , m_longDuration(units->longDuration())
+    , m_shortDuration(units->shortDuration())
+    , m_veryShortDuration(units->veryShortDuration())
+    , m_humanMoment(units->humanMoment())
+    , m_toolTipDelay(units->toolTipDelay())
+    , m_cornerRadius(units->cornerRadius())
 {
-    return d->iconSizes;
 }
 
 IconSizes::IconSizes(Units *units)
@@ -297,33 +461,12 @@ IconSizes::IconSizes(Units *units)
 
 int IconSizes::roundedIconSize(int size) const
 {
-    if (size < 16) {
-        return size;
-    }
-
-    if (size < 22) {
-        return 16;
-    }
-
-    if (size < 32) {
-        return 22;
-    }
-
-    if (size < 48) {
-        return 32;
-    }
-
-    if (size < 64) {
-        return 48;
-    }
-
-    return size;
+    return Platform::roundedIconSize(size);
 }
 
 int IconSizes::sizeForLabels() const
 {
-    // gridUnit is the height of textMetrics
-    return roundedIconSize(m_units->d->fontMetrics.height());
+    return m_units->d->sizeForLabels;
 }
 
 int IconSizes::small() const
@@ -359,3 +502,4 @@ int IconSizes::enormous() const
 }
 
 #include "moc_units.cpp"
+#include "units.moc"
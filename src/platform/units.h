@@ -71,6 +71,54 @@ Q_SIGNALS:
     void enormousChanged();
 };
 
+/**
+ * @class FrozenUnits units.h <Kirigami/Units>
+ *
+ * A snapshot of the values of Units that never changes.
+ *
+ * All properties are constant, so bindings that only read these values don't
+ * need to track any changes and are only evaluated once. This can be used in
+ * delegates or other items that are created many times, in applications that
+ * don't need to follow changes to the units at runtime, such as a change of
+ * the application font or the platform settings.
+ *
+ * @since 6.12
+ */
+class KIRIGAMIPLATFORM_EXPORT FrozenUnits : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("Grouped Property")
+
+    Q_PROPERTY(int gridUnit MEMBER m_gridUnit CONSTANT FINAL)
+    Q_PROPERTY(int smallSpacing MEMBER m_smallSpacing CONSTANT FINAL)
+    Q_PROPERTY(int mediumSpacing MEMBER m_mediumSpacing CONSTANT FINAL)
+    Q_PROPERTY(int largeSpacing MEMBER m_largeSpacing CONSTANT FINAL)
+    Q_PROPERTY(int veryLongDuration MEMBER m_veryLongDuration CONSTANT FINAL)
+    Q_PROPERTY(int longDuration MEMBER m_longDuration CONSTANT FINAL)
+    Q_PROPERTY(int shortDuration MEMBER m_shortDuration CONSTANT FINAL)
+    Q_PROPERTY(int veryShortDuration MEMBER m_veryShortDuration CONSTANT FINAL)
+    Q_PROPERTY(int humanMoment MEMBER m_humanMoment CONSTANT FINAL)
+    Q_PROPERTY(int toolTipDelay MEMBER m_toolTipDelay CONSTANT FINAL)
+    Q_PROPERTY(qreal cornerRadius MEMBER m_cornerRadius CONSTANT FINAL)
+
+public:
+    explicit FrozenUnits(Units *units);
+
+private:
+    int m_gridUnit;
+    int m_smallSpacing;
+    int m_mediumSpacing;
+    int m_largeSpacing;
+    int m_veryLongDuration;
+    int m_longDuration;
+    int m_shortDuration;
+    int m_veryShortDuration;
+    int m_humanMoment;
+    int m_toolTipDelay;
+    qreal m_cornerRadius;
+};
+
 /**
  * @class Units units.h <Kirigami/Units>
  *
@@ -197,6 +245,36 @@ class KIRIGAMIPLATFORM_EXPORT Units : public QObject
      */
     Q_PROPERTY(qreal cornerRadius READ cornerRadius NOTIFY cornerRadiusChanged FINAL)
 
+    /**
+     * A constant snapshot of the units, taken when this is first used.
+     *
+     * Bindings using for example `Kirigami.Units.frozen.smallSpacing` don't
+     * subscribe to any change signals, which saves memory and binding
+     * evaluations in items that are created often. They also don't update
+     * when the units change later on.
+     *
+     * @see FrozenUnits
+     * @since 6.12
+     */
+    Q_PROPERTY(Kirigami::Platform::FrozenUnits *frozen READ frozen CONSTANT FINAL)
+
+    /**
+     * Whether animations should be skipped, for example because the user
+     * asked for reduced motion or the device is saving power.
+     *
+     * While this is true, veryShortDuration, shortDuration, longDuration and
+     * veryLongDuration are 0, so animations using them jump straight to
+     * their end state, and Kirigami's own animations implemented in C++ are
+     * skipped as well.
+     *
+     * By default this follows the platform, which can be forced with the
+     * `KIRIGAMI_REDUCED_MOTION` environment variable. Applications can set
+     * it to override the platform, and reset it to follow the platform again.
+     *
+     * @since 6.12
+     */
+    Q_PROPERTY(bool reducedMotion READ reducedMotion WRITE setReducedMotion RESET resetReducedMotion NOTIFY reducedMotionChanged FINAL)
+
 public:
     ~Units() override;
 
@@ -235,6 +313,23 @@ public:
 
     IconSizes *iconSizes() const;
 
+    FrozenUnits *frozen() const;
+
+    bool reducedMotion() const;
+    void setReducedMotion(bool reduced);
+    void resetReducedMotion();
+
+    /**
+     * Sets whether the platform asks for reduced motion, which is used for
+     * reducedMotion unless the application set it.
+     *
+     * This is meant to be called by platform plugins, for instance when the
+     * device enters a power saving mode.
+     *
+     * @since 6.12
+     */
+    void setPlatformReducedMotion(bool reduced);
+
     static Units *create(QQmlEngine *qmlEngine, QJSEngine *jsEngine);
 
 Q_SIGNALS:
@@ -250,12 +345,15 @@ Q_SIGNALS:
     void toolTipDelayChanged();
     void wheelScrollLinesChanged();
     void cornerRadiusChanged();
+    void reducedMotionChanged();
 
 protected:
     explicit Units(QObject *parent = nullptr);
     bool eventFilter(QObject *watched, QEvent *event) override;
 
 private:
+    void notifyReducedMotionChanged(bool wasReduced);
+
     std::unique_ptr<UnitsPrivate> d;
 };
 
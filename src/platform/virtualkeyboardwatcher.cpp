@@ -9,8 +9,8 @@
 #include "virtualkeyboardwatcher.h"
 
 #ifdef KIRIGAMI_ENABLE_DBUS
+#include "portalsettings_p.h"
 #include "settings_interface.h"
-#include <QDBusConnection>
 #include <QDBusPendingCallWatcher>
 #endif
 
@@ -26,10 +26,6 @@ Q_GLOBAL_STATIC(VirtualKeyboardWatcher, virtualKeyboardWatcherSelf)
 
 class KIRIGAMIPLATFORM_NO_EXPORT VirtualKeyboardWatcher::Private
 {
-    static constexpr auto serviceName = "org.freedesktop.portal.Desktop"_L1;
-    static constexpr auto objectName = "/org/freedesktop/portal/desktop"_L1;
-    static constexpr auto interfaceName = "org.kde.kwin.VirtualKeyboard"_L1;
-
     static constexpr auto GROUP = "org.kde.VirtualKeyboard"_L1;
     static constexpr auto KEY_AVAILABLE = "available"_L1;
     static constexpr auto KEY_ENABLED = "enabled"_L1;
@@ -42,46 +38,46 @@ public:
         : q(qq)
     {
 #ifdef KIRIGAMI_ENABLE_DBUS
-        qDBusRegisterMetaType<VariantMapMap>();
-        settingsInterface = new OrgFreedesktopPortalSettingsInterface(serviceName, objectName, QDBusConnection::sessionBus(), q);
-
-        QObject::connect(settingsInterface,
-                         &OrgFreedesktopPortalSettingsInterface::SettingChanged,
-                         q,
-                         [this](const QString &group, const QString &key, const QDBusVariant &value) {
-                             if (group != GROUP) {
-                                 return;
-                             }
-
-                             if (key == KEY_AVAILABLE) {
-                                 available = value.variant().toBool();
-                                 Q_EMIT q->availableChanged();
-                             } else if (key == KEY_ENABLED) {
-                                 enabled = value.variant().toBool();
-                                 Q_EMIT q->enabledChanged();
-                             } else if (key == KEY_ACTIVE) {
-                                 active = value.variant().toBool();
-                                 Q_EMIT q->activeChanged();
-                             } else if (key == KEY_VISIBLE) {
-                                 visible = value.variant().toBool();
-                                 Q_EMIT q->visibleChanged();
-                             } else if (key == KEY_WILL_SHOW_ON_ACTIVE) {
-                                 willShowOnActive = value.variant().toBool();
-                             }
-                         });
-
-        getAllProperties();
+        auto settings = PortalSettings::self();
+
+        QObject::connect(settings, &PortalSettings::settingChanged, q, [this](const QString &group, const QString &key, const QVariant &value) {
+            if (group != GROUP) {
+                return;
+            }
+
+            if (key == KEY_AVAILABLE) {
+                available = value.toBool();
+                Q_EMIT q->availableChanged();
+            } else if (key == KEY_ENABLED) {
+                enabled = value.toBool();
+                Q_EMIT q->enabledChanged();
+            } else if (key == KEY_ACTIVE) {
+                active = value.toBool();
+                Q_EMIT q->activeChanged();
+            } else if (key == KEY_VISIBLE) {
+                visible = value.toBool();
+                Q_EMIT q->visibleChanged();
+            } else if (key == KEY_WILL_SHOW_ON_ACTIVE) {
+                willShowOnActive = value.toBool();
+            }
+        });
+
+        if (settings->isReady()) {
+            readAllProperties();
+        } else {
+            QObject::connect(settings, &PortalSettings::ready, q, [this]() {
+                readAllProperties();
+            });
+        }
 #endif
     }
 
     VirtualKeyboardWatcher *q;
 
 #ifdef KIRIGAMI_ENABLE_DBUS
-    void getAllProperties();
+    void readAllProperties();
     void updateWillShowOnActive();
 
-    OrgFreedesktopPortalSettingsInterface *settingsInterface = nullptr;
-
     QDBusPendingCallWatcher *willShowOnActiveCall = nullptr;
 #endif
 
@@ -137,7 +133,9 @@ VirtualKeyboardWatcher *VirtualKeyboardWatcher::self()
 
 void VirtualKeyboardWatcher::Private::updateWillShowOnActive()
 {
-    if (willShowOnActiveCall) {
+    // Before the portal has been contacted, the initial ReadAll still includes this value.
+    auto settingsInterface = PortalSettings::self()->interface();
+    if (willShowOnActiveCall || !settingsInterface) {
         return;
     }
 
@@ -157,28 +155,19 @@ void VirtualKeyboardWatcher::Private::updateWillShowOnActive()
     });
 }
 
-void VirtualKeyboardWatcher::Private::getAllProperties()
+void VirtualKeyboardWatcher::Private::readAllProperties()
 {
-    auto call = new QDBusPendingCallWatcher(settingsInterface->ReadAll({GROUP}), q);
-    connect(call, &QDBusPendingCallWatcher::finished, q, [this](auto call) {
-        QDBusPendingReply<VariantMapMap> reply = *call;
-        if (reply.isError()) {
-            qCDebug(KirigamiPlatform) << reply.error().message();
-        } else {
-            const auto groupValues = reply.value().value(GROUP);
-            available = groupValues.value(KEY_AVAILABLE).toBool();
-            enabled = groupValues.value(KEY_ENABLED).toBool();
-            active = groupValues.value(KEY_ACTIVE).toBool();
-            visible = groupValues.value(KEY_VISIBLE).toBool();
-            willShowOnActive = groupValues.value(KEY_WILL_SHOW_ON_ACTIVE).toBool();
-        }
-        call->deleteLater();
-
-        Q_EMIT q->availableChanged();
-        Q_EMIT q->enabledChanged();
-        Q_EMIT q->activeChanged();
-        Q_EMIT q->visibleChanged();
-    });
+    const auto groupValues = PortalSettings::self()->values(GROUP);
+    available = groupValues.value(KEY_AVAILABLE).toBool();
+    enabled = groupValues.value(KEY_ENABLED).toBool();
+    active = groupValues.value(KEY_ACTIVE).toBool();
+    visible = groupValues.value(KEY_VISIBLE).toBool();
+    willShowOnActive = groupValues.value(KEY_WILL_SHOW_ON_ACTIVE).toBool();
+
+    Q_EMIT q->availableChanged();
+    Q_EMIT q->enabledChanged();
+    Q_EMIT q->activeChanged();
+    Q_EMIT q->visibleChanged();
 }
 
 #endif
@@ -0,0 +1,81 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+import QtQuick
+
+import org.kde.kirigami.platform as Platform
+
+/**
+ * @brief An overlay showing what Kirigami is doing while rendering a window.
+ *
+ * The overlay shows the frame time and rate, how many icons were polished,
+ * layouts were arranged and themes were updated per frame, the icon cache hit
+ * rate, the size of the icon textures and the number of pages held by page
+ * pools. This helps triaging performance issues on devices that cannot be
+ * profiled.
+ *
+ * Kirigami only collects these numbers while an overlay or
+ * PerformanceStatistics exists, so it is fine to create it conditionally, for
+ * instance based on an environment variable or a hidden setting.
+ *
+ * @code
+ * Kirigami.ApplicationWindow {
+ *     Kirigami.PerformanceOverlay {
+ *         parent: Overlay.overlay
+ *         anchors.top: parent.top
+ *         anchors.right: parent.right
+ *     }
+ * }
+ * @endcode
+ *
+ * @see PerformanceStatistics
+ * @since 6.12
+ */
+Rectangle {
+    id: root
+
+    /**
+     * @brief The statistics shown by this overlay.
+     */
+    readonly property PerformanceStatistics statistics: PerformanceStatistics {
+        window: root.Window.window
+    }
+
+    implicitWidth: layout.implicitWidth + Platform.Units.smallSpacing * 2
+    implicitHeight: layout.implicitHeight + Platform.Units.smallSpacing * 2
+    z: 999999
+
+    color: Qt.rgba(0, 0, 0, 0.7)
+    radius: Platform.Units.cornerRadius
+
+    Column {
+        id: layout
+
+        x: Platform.Units.smallSpacing
+        y: Platform.Units.smallSpacing
+
+        Repeater {
+            model: [
+                `Frame time: ${root.statistics.frameTime.toFixed(1)} ms (${root.statistics.framesPerSecond.toFixed(0)} fps)`,
+                `Polishes per frame: ${root.statistics.polishesPerFrame.toFixed(1)}`,
+                `Layouts per frame: ${root.statistics.layoutPassesPerFrame.toFixed(1)}`,
+                `Theme updates per frame: ${root.statistics.themeUpdatesPerFrame.toFixed(1)}`,
+                `Icon cache hit rate: ${root.statistics.iconCacheHitRate < 0 ? "-" : Math.round(root.statistics.iconCacheHitRate * 100) + " %"}`,
+                `Icon textures: ${Math.round(root.statistics.textureBytes / 1024)} KiB`,
+                `Pooled pages: ${root.statistics.poolPages}`,
+            ]
+
+            delegate: Text {
+                required property string modelData
+
+                text: modelData
+                color: "white"
+                font.family: "monospace"
+                font.pointSize: Platform.Theme.smallFont.pointSize
+            }
+        }
+    }
+}
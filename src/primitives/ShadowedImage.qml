@@ -115,6 +115,11 @@ Item {
     /**
      * @brief This property holds whether the image uses mipmap filtering when scaled
      * or transformed.
+     *
+     * This also builds mipmaps for the texture the image is drawn from, which
+     * keeps the image smooth when it is scaled down, for example during
+     * animations.
+     *
      * @see QtQuick.Image::mipmap
      * @property bool mipmap
      */
@@ -122,6 +127,13 @@ Item {
 
     /**
      * @brief This property holds the scaled width and height of the full-frame image.
+     *
+     * Unless this is set, images that are scaled to the item are decoded at
+     * the size they are displayed at, in device pixels, instead of their full
+     * size. This saves memory and upload time for large pictures shown small,
+     * like photos used as avatars. As the item grows, the image is decoded
+     * again at the larger size, but it is not decoded again when it shrinks.
+     *
      * @see QtQuick.Image::sourceSize
      */
     property alias sourceSize: image.sourceSize
@@ -132,17 +144,96 @@ Item {
      * @since 6.5
      */
     readonly property alias status: image.status
+
+    /**
+     * @brief This property holds whether the image is rendered into its texture
+     * whenever it changes.
+     *
+     * The image is drawn through an intermediate texture, which normally gets
+     * rendered again whenever the image is updated. When this is false, the
+     * image is only rendered into the texture when it is loaded, when the
+     * image or the item changes size, or when refresh() is called. This saves
+     * an offscreen render pass for images that do not change by themselves,
+     * like avatars.
+     *
+     * default: ``true``
+     *
+     * @since 6.12
+     */
+    property bool live: true
 //END properties
 
+    /**
+     * @brief Render the image into its texture again.
+     *
+     * This is only needed when live is false and the image changed in a way
+     * that is not picked up automatically.
+     *
+     * @since 6.12
+     */
+    function refresh(): void {
+        textureSource.scheduleUpdate();
+    }
+
     Image {
         id: image
         anchors.fill: parent
+
+        readonly property real devicePixelRatio: Screen.devicePixelRatio
+
+        sourceSize: _private.decodeSize
+
+        onStatusChanged: _private.refreshSnapshot()
+        onPaintedWidthChanged: _private.refreshSnapshot()
+        onPaintedHeightChanged: _private.refreshSnapshot()
+        onWidthChanged: {
+            _private.updateDecodeSize();
+            _private.refreshSnapshot();
+        }
+        onHeightChanged: {
+            _private.updateDecodeSize();
+            _private.refreshSnapshot();
+        }
+        onDevicePixelRatioChanged: _private.updateDecodeSize()
+        Component.onCompleted: _private.updateDecodeSize()
+    }
+
+    QtObject {
+        id: _private
+
+        // Other fill modes show the image at its own size, so it needs to be
+        // decoded at full size.
+        readonly property bool scalesToItem: image.fillMode === Image.Stretch
+            || image.fillMode === Image.PreserveAspectFit
+            || image.fillMode === Image.PreserveAspectCrop
+
+        // Rounded up, and only ever grown, so that resizing the item, for
+        // example during an animation, does not decode the image every frame.
+        property int decodeWidth: 0
+        property int decodeHeight: 0
+
+        // undefined resets the source size, loading the image at full size.
+        readonly property var decodeSize: scalesToItem && decodeWidth > 0 && decodeHeight > 0 ? Qt.size(decodeWidth, decodeHeight) : undefined
+
+        function updateDecodeSize(): void {
+            const step = 32;
+            decodeWidth = Math.max(decodeWidth, Math.ceil(image.width * image.devicePixelRatio / step) * step);
+            decodeHeight = Math.max(decodeHeight, Math.ceil(image.height * image.devicePixelRatio / step) * step);
+        }
+
+        function refreshSnapshot(): void {
+            if (!root.live) {
+                textureSource.scheduleUpdate();
+            }
+        }
     }
 
     ShaderEffectSource {
         id: textureSource
         sourceItem: image
         hideSource: !shadowRectangle.softwareRendering
+        live: root.live
+        mipmap: image.mipmap
     }
 
     Kirigami.ShadowedTexture {
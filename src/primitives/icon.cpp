@@ -6,27 +6,96 @@
  */
 
 #include "icon.h"
+#include "remoteimagerequest.h"
+#include "scenegraph/iconatlas.h"
 #include "scenegraph/managedtexturenode.h"
 
+#include "platform/performancecounters_p.h"
 #include "platform/platformtheme.h"
+#include "platform/themeiconcache_p.h"
+#include "platform/tracescope_p.h"
 #include "platform/units.h"
+#include "tracelogging.h"
 
 #include <QBitmap>
 #include <QDebug>
+#include <QFileInfo>
+#include <QFutureWatcher>
 #include <QGuiApplication>
 #include <QIcon>
-#include <QNetworkReply>
+#include <QImageReader>
+#include <QNetworkAccessManager>
 #include <QPainter>
 #include <QPropertyAnimation>
 #include <QQuickImageProvider>
 #include <QQuickWindow>
+#include <QSGRendererInterface>
 #include <QSGSimpleTextureNode>
 #include <QSGTexture>
 #include <QScreen>
+#include <QSet>
+#include <QtConcurrentRun>
 #include <cstdlib>
+#include <optional>
 
 Q_GLOBAL_STATIC(ImageTexturesCache, s_iconImageCache)
 
+// Asynchronous loads that are currently running, shared between all Icon
+// instances requesting the same image. Only accessed from the GUI thread.
+using PendingIconLoads = QHash<IconImageCacheKey, QFuture<IconImageCache::Entry>>;
+Q_GLOBAL_STATIC(PendingIconLoads, s_pendingLoads)
+
+static void tintImage(QImage &image, const QColor &tintColor)
+{
+    if (tintColor.alpha() <= 0 || image.isNull()) {
+        return;
+    }
+
+    QPainter p(&image);
+    p.setCompositionMode(QPainter::CompositionMode_SourceIn);
+    p.fillRect(image.rect(), tintColor);
+    p.end();
+}
+
+// Converts a url or string source to something QIcon and QImageReader can load.
+static QString localIconSource(const QString &iconSource)
+{
+    if (iconSource.startsWith(QLatin1String("qrc:/"))) {
+        return iconSource.mid(3);
+    } else if (iconSource.startsWith(QLatin1String("file:/"))) {
+        return QUrl(iconSource).path();
+    }
+    return iconSource;
+}
+
+// Decodes an image file at a size that fits in iconSize and tints it if needed.
+// This only uses QImage and is thus safe to run in a thread.
+static IconImageCache::Entry decodeIconFile(const QString &path, const QSize &iconSize, qreal devicePixelRatio, const QColor &tintColor, bool isMask)
+{
+    QImageReader reader(path);
+    const QSize targetSize = iconSize * devicePixelRatio;
+    QSize size = reader.size();
+    if (size.isValid()) {
+        // Scalable images are rendered at the requested size, raster images are
+        // only scaled down, which matches what QIcon::actualSize() would do.
+        if (reader.format() == "svg" || reader.format() == "svgz" || size.width() > targetSize.width() || size.height() > targetSize.height()) {
+            size = size.scaled(targetSize, Qt::KeepAspectRatio);
+        }
+        reader.setScaledSize(size);
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        return IconImageCache::Entry{QImage(), true};
+    }
+
+    image.setDevicePixelRatio(devicePixelRatio);
+    if (isMask) {
+        tintImage(image, tintColor);
+    }
+    return IconImageCache::Entry{image, false};
+}
+
 Icon::Icon(QQuickItem *parent)
     : QQuickItem(parent)
     , m_active(false)
@@ -37,6 +106,12 @@ Icon::Icon(QQuickItem *parent)
     // Using 32 because Icon used to redefine implicitWidth and implicitHeight and hardcode them to 32
     setImplicitSize(32, 32);
 
+    m_nextIcon = s_firstIcon;
+    if (m_nextIcon) {
+        m_nextIcon->m_previousIcon = this;
+    }
+    s_firstIcon = this;
+
     connect(this, &QQuickItem::smoothChanged, this, &QQuickItem::polish);
     connect(this, &QQuickItem::enabledChanged, this, [this]() {
         polish();
@@ -45,6 +120,38 @@ Icon::Icon(QQuickItem *parent)
 
 Icon::~Icon()
 {
+    if (m_previousIcon) {
+        m_previousIcon->m_nextIcon = m_nextIcon;
+    } else {
+        s_firstIcon = m_nextIcon;
+    }
+    if (m_nextIcon) {
+        m_nextIcon->m_previousIcon = m_previousIcon;
+    }
+}
+
+const ImageTexturesCache *Icon::texturesCache()
+{
+    return s_iconImageCache;
+}
+
+qsizetype Icon::imageBytes()
+{
+    QSet<qint64> counted;
+    qsizetype bytes = 0;
+    auto add = [&counted, &bytes](const QImage &image) {
+        if (!image.isNull() && !counted.contains(image.cacheKey())) {
+            counted.insert(image.cacheKey());
+            bytes += image.sizeInBytes();
+        }
+    };
+
+    for (const Icon *icon = s_firstIcon; icon; icon = icon->m_nextIcon) {
+        add(icon->m_icon);
+        add(icon->m_loadedImage);
+        add(icon->m_scaledLoadedImage);
+    }
+    return bytes;
 }
 
 void Icon::componentComplete()
@@ -58,7 +165,7 @@ void Icon::componentComplete()
     m_animation = new QPropertyAnimation(this);
     connect(m_animation, &QPropertyAnimation::valueChanged, this, &Icon::valueChanged);
     connect(m_animation, &QPropertyAnimation::finished, this, [this]() {
-        m_oldIcon = QImage();
+        m_hasOldIcon = false;
         m_textureChanged = true;
         update();
     });
@@ -82,14 +189,24 @@ void Icon::setSource(const QVariant &icon)
         m_theme = static_cast<Kirigami::Platform::PlatformTheme *>(qmlAttachedPropertiesObject<Kirigami::Platform::PlatformTheme>(this, true));
         Q_ASSERT(m_theme);
 
-        connect(m_theme, &Kirigami::Platform::PlatformTheme::colorsChanged, this, &QQuickItem::polish);
+        connect(m_theme, &Kirigami::Platform::PlatformTheme::colorsChanged, this, [this]() {
+            if (m_gpuTint && m_isMask) {
+                updateMaskColor();
+            } else {
+                polish();
+            }
+        });
     }
 
-    if (m_networkReply) {
-        // if there was a network query going on, interrupt it
-        m_networkReply->close();
+    if (m_remoteRequest) {
+        // if there was a network query going on, interrupt it unless other
+        // icons are waiting for it as well
+        disconnect(m_remoteRequest, nullptr, this, nullptr);
+        m_remoteRequest->releaseIfUnused();
+        m_remoteRequest = nullptr;
     }
     m_loadedImage = QImage();
+    m_scaledLoadedImage = QImage();
     setStatus(Loading);
 
     polish();
@@ -166,7 +283,12 @@ void Icon::setColor(const QColor &color)
     }
 
     m_color = color;
-    polish();
+    if (m_gpuTint && m_isMask) {
+        // The color is only applied while rendering, no need to reload the image.
+        updateMaskColor();
+    } else {
+        polish();
+    }
     Q_EMIT colorChanged();
 }
 
@@ -183,20 +305,32 @@ QSGNode *Icon::createSubtree(qreal initialOpacity)
 
     auto *mNode = new ManagedTextureNode;
 
-    mNode->setTexture(s_iconImageCache->loadTexture(window(), m_icon, QQuickWindow::TextureCanUseAtlas));
+    updateTexture(mNode);
 
     opacityNode->appendChildNode(mNode);
 
     return opacityNode;
 }
 
+void Icon::updateTexture(ManagedTextureNode *node)
+{
+    if (m_atlasRegion) {
+        node->setTexture(m_atlasRegion->page->texture(window()));
+        node->setSourceRect(m_atlasRegion->rect);
+    } else {
+        node->setTexture(s_iconImageCache->loadTexture(window(), m_icon, QQuickWindow::TextureCanUseAtlas));
+        node->setSourceRect(QRectF());
+    }
+    node->setMaskColor(m_maskColor);
+}
+
 void Icon::updateSubtree(QSGNode *node, qreal opacity)
 {
     auto opacityNode = static_cast<QSGOpacityNode *>(node);
     opacityNode->setOpacity(opacity);
 
     auto textureNode = static_cast<ManagedTextureNode *>(opacityNode->firstChild());
-    textureNode->setFiltering(smooth() ? QSGTexture::Linear : QSGTexture::Nearest);
+    textureNode->setMaskedFiltering(smooth() ? QSGTexture::Linear : QSGTexture::Nearest);
 }
 
 QSGNode *Icon::updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData * /*data*/)
@@ -239,9 +373,14 @@ QSGNode *Icon::updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData *
 
     if (m_textureChanged) {
         auto mNode = static_cast<ManagedTextureNode *>(node->lastChild()->firstChild());
-        mNode->setTexture(s_iconImageCache->loadTexture(window(), m_icon, QQuickWindow::TextureCanUseAtlas));
+        updateTexture(mNode);
         m_textureChanged = false;
+        m_maskColorChanged = false;
         m_sizeChanged = true;
+    } else if (m_maskColorChanged) {
+        auto mNode = static_cast<ManagedTextureNode *>(node->lastChild()->firstChild());
+        mNode->setMaskColor(m_maskColor);
+        m_maskColorChanged = false;
     }
 
     if (m_sizeChanged) {
@@ -282,50 +421,25 @@ void Icon::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
     if (newGeometry.size() != oldGeometry.size()) {
         m_sizeChanged = true;
         updatePaintedGeometry();
-        polish();
-    }
-}
 
-void Icon::handleRedirect(QNetworkReply *reply)
-{
-    QNetworkAccessManager *qnam = reply->manager();
-    if (reply->error() != QNetworkReply::NoError) {
-        return;
-    }
-    const QUrl possibleRedirectUrl = reply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl();
-    if (!possibleRedirectUrl.isEmpty()) {
-        const QUrl redirectUrl = reply->url().resolved(possibleRedirectUrl);
-        if (redirectUrl == reply->url()) {
-            // no infinite redirections thank you very much
-            reply->deleteLater();
+        // Icons from the theme or from files only depend on the rounded icon
+        // size, so while that stays the same, for instance during most frames
+        // of a resize animation, the current image is reused and only placed
+        // differently by the scene graph.
+        if (m_status == Ready && !m_icon.isNull() && !m_rasterSize.isEmpty() && isCacheable() && iconSizeHint() == m_rasterSize) {
+            update();
             return;
         }
-        reply->deleteLater();
-        QNetworkRequest request(possibleRedirectUrl);
-        request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
-        m_networkReply = qnam->get(request);
-        connect(m_networkReply.data(), &QNetworkReply::finished, this, [this]() {
-            handleFinished(m_networkReply);
-        });
+        polish();
     }
 }
 
-void Icon::handleFinished(QNetworkReply *reply)
+void Icon::handleRemoteImage(const QImage &image)
 {
-    if (!reply) {
-        return;
-    }
-
-    reply->deleteLater();
-    if (!reply->attribute(QNetworkRequest::RedirectionTargetAttribute).isNull()) {
-        handleRedirect(reply);
-        return;
-    }
+    m_remoteRequest = nullptr;
+    m_loadedImage = image;
 
-    m_loadedImage = QImage();
-
-    const QString filename = reply->url().fileName();
-    if (!m_loadedImage.load(reply, filename.mid(filename.indexOf(QLatin1Char('.'))).toLatin1().constData())) {
+    if (m_loadedImage.isNull()) {
         // broken image from data, inform the user of this with some useful broken-image thing...
         m_loadedImage = iconPixmap(QIcon::fromTheme(m_fallback));
     }
@@ -335,10 +449,18 @@ void Icon::handleFinished(QNetworkReply *reply)
 
 void Icon::updatePolish()
 {
+    TraceScope trace(KirigamiPrimitivesTrace(), "Icon::updatePolish");
+    if (trace.isEnabled()) {
+        trace.addArgument("source", m_source);
+        trace.addArgument("size", size());
+    }
+
     QQuickItem::updatePolish();
+    Kirigami::Platform::PerformanceCounters::count(Kirigami::Platform::PerformanceCounters::Polish);
 
     if (window()) {
         m_devicePixelRatio = window()->effectiveDevicePixelRatio();
+        m_gpuTint = QSGRendererInterface::isApiRhiBased(window()->rendererInterface()->graphicsApi());
     }
 
     if (m_source.isNull()) {
@@ -354,9 +476,17 @@ void Icon::updatePolish()
 
         if (m_animation) {
             m_animation->stop();
-            m_oldIcon = m_icon;
+            // The old image stays visible through the texture of its node
+            // while cross fading, so the image itself is not kept.
+            m_hasOldIcon = !m_icon.isNull();
         }
 
+        const QColor tintColor = imageTintColor();
+
+        // Images coming from the cache have already been tinted.
+        bool fromCache = false;
+        std::optional<IconImageCacheKey> cacheKey;
+
         switch (m_source.userType()) {
         case QMetaType::QPixmap:
             m_icon = m_source.value<QPixmap>().toImage();
@@ -373,6 +503,30 @@ void Icon::updatePolish()
         }
         case QMetaType::QUrl:
         case QMetaType::QString:
+            if (isCacheable()) {
+                cacheKey = iconCacheKey(tintColor);
+                if (m_asyncResult && m_asyncKey == *cacheKey) {
+                    m_icon = m_asyncResult->image;
+                    setStatus(m_asyncResult->error ? Error : Ready);
+                    m_asyncResult.reset();
+                    fromCache = true;
+                    break;
+                }
+                m_asyncResult.reset();
+
+                if (auto entry = IconImageCache::instance()->find(*cacheKey)) {
+                    m_icon = entry->image;
+                    setStatus(entry->error ? Error : Ready);
+                    fromCache = true;
+                    break;
+                }
+
+                if (m_asynchronous && loadAsynchronously(*cacheKey, tintColor)) {
+                    // Temporary icon while we wait for the real image to load...
+                    m_icon = iconPixmap(QIcon::fromTheme(m_placeholder));
+                    break;
+                }
+            }
             m_icon = findIcon(size);
             break;
         case QMetaType::QBrush:
@@ -390,22 +544,36 @@ void Icon::updatePolish()
             m_icon.fill(Qt::transparent);
         }
 
-        const QColor tintColor = //
-            !m_color.isValid() || m_color == Qt::transparent //
-            ? (m_selected ? m_theme->highlightedTextColor() : m_theme->textColor())
-            : m_color;
+        // Identifies the image before tinting, so that deduplicating an image
+        // that was seen before doesn't need to read all of its pixels.
+        const qint64 sourceImageKey = m_icon.cacheKey();
 
         // TODO: initialize m_isMask with icon.isMask()
-        if (tintColor.alpha() > 0 && isMask()) {
-            QPainter p(&m_icon);
-            p.setCompositionMode(QPainter::CompositionMode_SourceIn);
-            p.fillRect(m_icon.rect(), tintColor);
-            p.end();
+        if (!fromCache && isMask()) {
+            tintImage(m_icon, tintColor);
+        }
+
+        if (!fromCache) {
+            if (cacheKey && m_status != Loading) {
+                IconImageCache::instance()->insert(*cacheKey, m_icon, m_status == Error);
+            } else {
+                m_icon = IconImageCache::instance()->deduplicate(m_icon, sourceImageKey, isMask() ? tintColor.rgba() : QRgb(0));
+            }
+        }
+
+        m_rasterSize = iconSizeHint();
+
+        if (IconAtlas::isEnabled() && m_isMask) {
+            m_atlasRegion = IconAtlas::region(window(), m_icon);
+        } else {
+            m_atlasRegion.reset();
         }
+
+        updateMaskColor();
     }
 
-    // don't animate initial setting
-    bool animated = m_animated && !m_oldIcon.isNull() && !m_sizeChanged && !m_blockNextAnimation;
+    // don't animate initial setting, nor when animations should be skipped
+    bool animated = m_animated && m_hasOldIcon && !m_sizeChanged && !m_blockNextAnimation && !(m_units && m_units->reducedMotion());
 
     if (animated && m_animation) {
         m_animValue = 0.0;
@@ -460,7 +628,7 @@ QImage Icon::findIcon(const QSize &size)
         case QQmlImageProviderBase::ImageResponse: {
             if (!m_loadedImage.isNull()) {
                 setStatus(Ready);
-                return m_loadedImage.scaled(size, Qt::KeepAspectRatio, smooth() ? Qt::SmoothTransformation : Qt::FastTransformation);
+                return scaledLoadedImage(size);
             }
             QQuickAsyncImageProvider *provider = dynamic_cast<QQuickAsyncImageProvider *>(imageProvider);
             auto response = provider->requestImageResponse(iconId, size);
@@ -508,27 +676,25 @@ QImage Icon::findIcon(const QSize &size)
     } else if (iconSource.startsWith(QLatin1String("http://")) || iconSource.startsWith(QLatin1String("https://"))) {
         if (!m_loadedImage.isNull()) {
             setStatus(Ready);
-            return m_loadedImage.scaled(size, Qt::KeepAspectRatio, smooth() ? Qt::SmoothTransformation : Qt::FastTransformation);
+            return scaledLoadedImage(size);
         }
         const auto url = m_source.toUrl();
+        // Other icons may have received the same image already.
+        if (const auto image = RemoteImageRequest::cachedImage(url)) {
+            m_loadedImage = *image;
+            setStatus(Ready);
+            return scaledLoadedImage(size);
+        }
         QQmlEngine *engine = qmlEngine(this);
         QNetworkAccessManager *qnam;
-        if (engine && (qnam = engine->networkAccessManager()) && (!m_networkReply || m_networkReply->url() != url)) {
-            QNetworkRequest request(url);
-            request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
-            m_networkReply = qnam->get(request);
-            connect(m_networkReply.data(), &QNetworkReply::finished, this, [this]() {
-                handleFinished(m_networkReply);
-            });
+        if (engine && (qnam = engine->networkAccessManager()) && (!m_remoteRequest || m_remoteRequest->url() != url)) {
+            m_remoteRequest = RemoteImageRequest::get(qnam, url);
+            connect(m_remoteRequest.data(), &RemoteImageRequest::finished, this, &Icon::handleRemoteImage);
         }
         // Temporary icon while we wait for the real image to load...
         img = iconPixmap(QIcon::fromTheme(m_placeholder));
     } else {
-        if (iconSource.startsWith(QLatin1String("qrc:/"))) {
-            iconSource = iconSource.mid(3);
-        } else if (iconSource.startsWith(QLatin1String("file:/"))) {
-            iconSource = QUrl(iconSource).path();
-        }
+        iconSource = localIconSource(iconSource);
 
         const QIcon icon = loadFromTheme(iconSource);
 
@@ -545,6 +711,63 @@ QImage Icon::findIcon(const QSize &size)
     return img;
 }
 
+bool Icon::loadAsynchronously(const IconImageCacheKey &key, const QColor &tintColor)
+{
+    if (m_asyncLoad && m_asyncKey == key) {
+        // Already loading, keep showing the placeholder.
+        return true;
+    }
+
+    // Only image files are decoded in a thread. Icon theme lookups go through
+    // the platform's icon engine, which is not guaranteed to be thread safe.
+    // Bare icon names are never looked up on disk: it would cost a stat()
+    // for every themed icon, and load a file of the working directory that
+    // happens to be named like the icon instead of the icon.
+    const QString path = localIconSource(key.source);
+    const QFileInfo fileInfo(path);
+    if (!fileInfo.isAbsolute() || !fileInfo.isFile()) {
+        return false;
+    }
+
+    if (m_asyncLoad) {
+        m_asyncLoad->disconnect(this);
+        m_asyncLoad->deleteLater();
+        m_asyncLoad = nullptr;
+    }
+
+    m_asyncKey = key;
+
+    QFuture<IconImageCache::Entry> future = s_pendingLoads->value(key);
+    if (!future.isValid()) {
+        future = QtConcurrent::run(decodeIconFile, path, iconSizeHint(), m_devicePixelRatio, tintColor, m_isMask);
+        s_pendingLoads->insert(key, future);
+    }
+
+    m_asyncLoad = new QFutureWatcher<IconImageCache::Entry>(this);
+    connect(m_asyncLoad, &QFutureWatcher<IconImageCache::Entry>::finished, this, [this]() {
+        IconImageCache::Entry entry = m_asyncLoad->future().result();
+        s_pendingLoads->remove(m_asyncKey);
+        m_asyncLoad->deleteLater();
+        m_asyncLoad = nullptr;
+
+        if (entry.image.isNull()) {
+            // broken image from data, inform the user of this with some useful broken-image thing...
+            entry.image = iconPixmap(QIcon::fromTheme(m_fallback));
+            if (m_isMask) {
+                tintImage(entry.image, imageTintColor());
+            }
+        }
+
+        IconImageCache::instance()->insert(m_asyncKey, entry.image, entry.error);
+        m_asyncResult = entry;
+        polish();
+    });
+    m_asyncLoad->setFuture(future);
+
+    setStatus(Loading);
+    return true;
+}
+
 QIcon::Mode Icon::iconMode() const
 {
     if (!isEnabled()) {
@@ -639,8 +862,118 @@ QImage Icon::iconPixmap(const QIcon &icon) const
 
 QIcon Icon::loadFromTheme(const QString &iconName) const
 {
-    const QColor tintColor = !m_color.isValid() || m_color == Qt::transparent ? (m_selected ? m_theme->highlightedTextColor() : m_theme->textColor()) : m_color;
-    return m_theme->iconFromTheme(iconName, tintColor);
+    return Kirigami::Platform::ThemeIconCache::icon(m_theme, iconName, imageTintColor());
+}
+
+QColor Icon::tintColor() const
+{
+    if (!m_color.isValid() || m_color == Qt::transparent) {
+        return m_selected ? m_theme->highlightedTextColor() : m_theme->textColor();
+    }
+    return m_color;
+}
+
+QColor Icon::imageTintColor() const
+{
+    // With GPU tinting, mask images are kept untinted so that all colors
+    // share the same image and texture.
+    if (m_gpuTint && m_isMask) {
+        return Qt::transparent;
+    }
+    return tintColor();
+}
+
+void Icon::updateMaskColor()
+{
+    const QColor color = m_gpuTint && m_isMask ? tintColor() : QColor();
+    if (color == m_maskColor) {
+        return;
+    }
+
+    m_maskColor = color;
+    m_maskColorChanged = true;
+    update();
+}
+
+QImage Icon::scaledLoadedImage(const QSize &size)
+{
+    const bool smoothScale = smooth();
+    const qint64 key = m_loadedImage.cacheKey();
+    const bool sameImage = !m_scaledLoadedImage.isNull() && m_scaledLoadedKey == key && m_scaledLoadedSmooth == smoothScale;
+    if (sameImage && m_scaledLoadedSize == size) {
+        return m_scaledLoadedImage;
+    }
+
+    // Smoothly scaling an image is slow, so when the size changes a lot, like
+    // when resizing a window, the image is scaled in a thread and a quickly
+    // scaled one is shown in the meantime.
+    const qreal areaRatio = qreal(size.width() * size.height()) / std::max(1, m_scaledLoadedSize.width() * m_scaledLoadedSize.height());
+    if (smoothScale && sameImage && (areaRatio > 2.0 || areaRatio < 0.5)) {
+        if (!m_asyncScale || m_asyncScaleSize != size) {
+            delete m_asyncScale;
+            m_asyncScale = new QFutureWatcher<QImage>(this);
+            m_asyncScaleSize = size;
+            connect(m_asyncScale, &QFutureWatcher<QImage>::finished, this, [this, key, size]() {
+                auto watcher = m_asyncScale;
+                m_asyncScale = nullptr;
+                watcher->deleteLater();
+
+                if (key != m_loadedImage.cacheKey()) {
+                    return;
+                }
+                m_scaledLoadedImage = watcher->result();
+                m_scaledLoadedSize = size;
+                m_scaledLoadedKey = key;
+                m_scaledLoadedSmooth = true;
+                polish();
+            });
+            m_asyncScale->setFuture(QtConcurrent::run([image = m_loadedImage, size]() {
+                return image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            }));
+        }
+        return m_loadedImage.scaled(size, Qt::KeepAspectRatio, Qt::FastTransformation);
+    }
+
+    m_scaledLoadedImage = m_loadedImage.scaled(size, Qt::KeepAspectRatio, smoothScale ? Qt::SmoothTransformation : Qt::FastTransformation);
+    m_scaledLoadedSize = size;
+    m_scaledLoadedKey = key;
+    m_scaledLoadedSmooth = smoothScale;
+    return m_scaledLoadedImage;
+}
+
+bool Icon::isCacheable() const
+{
+    // Remote and image provider sources are loaded through their own
+    // mechanisms and may change independently of the source url, so only
+    // cache things that come from the icon theme or the filesystem.
+    const QString iconSource = m_source.toString();
+    return !iconSource.isEmpty() && m_loadedImage.isNull() //
+        && !iconSource.startsWith(QLatin1String("image://")) //
+        && !iconSource.startsWith(QLatin1String("http://")) //
+        && !iconSource.startsWith(QLatin1String("https://"));
+}
+
+IconImageCacheKey Icon::iconCacheKey(const QColor &tintColor) const
+{
+    IconImageCacheKey key;
+    key.source = m_source.toString();
+    key.fallback = m_fallback;
+    key.themeName = QIcon::themeName();
+    // Cacheable sources are rasterized at the size hint, so this lets icons
+    // of slightly different sizes share an image.
+    key.size = iconSizeHint();
+    key.devicePixelRatio = m_devicePixelRatio;
+    key.mode = iconMode();
+    key.tintColor = tintColor.rgba();
+    // Masks tinted on the GPU are cached untinted.
+    if (m_theme && !(m_gpuTint && m_isMask)) {
+        key.themeColors = Kirigami::Platform::ThemeIconCache::colorsKey(m_theme);
+        key.colorSet = m_theme->colorSet();
+        key.colorGroup = m_theme->colorGroup();
+    }
+    key.isMask = m_isMask;
+    key.roundToIconSize = m_roundToIconSize;
+    return key;
 }
 
 void Icon::updatePaintedGeometry()
@@ -703,6 +1036,21 @@ void Icon::setAnimated(bool animated)
     Q_EMIT animatedChanged();
 }
 
+bool Icon::asynchronous() const
+{
+    return m_asynchronous;
+}
+
+void Icon::setAsynchronous(bool asynchronous)
+{
+    if (m_asynchronous == asynchronous) {
+        return;
+    }
+
+    m_asynchronous = asynchronous;
+    Q_EMIT asynchronousChanged();
+}
+
 bool Icon::roundToIconSize() const
 {
     return m_roundToIconSize;
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <QFutureWatcher>
 #include <QIcon>
 #include <QPointer>
 #include <QQuickItem>
@@ -15,9 +16,17 @@
 
 #include <QQmlEngine>
 
-class QNetworkReply;
+#include <memory>
+#include <optional>
+
+#include "iconimagecache.h"
+
+class ImageTexturesCache;
+class ManagedTextureNode;
+class RemoteImageRequest;
 class QQuickWindow;
 class QPropertyAnimation;
+struct IconAtlasRegion;
 
 namespace Kirigami
 {
@@ -172,6 +181,18 @@ class Icon : public QQuickItem
      */
     Q_PROPERTY(bool roundToIconSize READ roundToIconSize WRITE setRoundToIconSize NOTIFY roundToIconSizeChanged FINAL)
 
+    /**
+     * If set, icons loaded from image files, including `file:/` and `qrc:/` urls,
+     * will be decoded and tinted in a background thread. The `placeholder` icon is
+     * shown while the image is being loaded. Default is false.
+     *
+     * @note Icons from the icon theme are always loaded synchronously, as the icon
+     * engine provided by the platform is not guaranteed to be thread safe.
+     *
+     * @since 6.12
+     */
+    Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous NOTIFY asynchronousChanged FINAL)
+
 public:
     enum Status {
         Null = 0, /// No icon has been set
@@ -184,6 +205,17 @@ public:
     Icon(QQuickItem *parent = nullptr);
     ~Icon() override;
 
+    /**
+     * The cache of the textures used by all icons.
+     */
+    static const ImageTexturesCache *texturesCache();
+
+    /**
+     * The size of the images held by all icons, in bytes. Images shared by
+     * several icons are only counted once.
+     */
+    static qsizetype imageBytes();
+
     void componentComplete() override;
 
     void setSource(const QVariant &source);
@@ -220,6 +252,9 @@ public:
     bool roundToIconSize() const;
     void setRoundToIconSize(bool roundToIconSize);
 
+    bool asynchronous() const;
+    void setAsynchronous(bool asynchronous);
+
     QSGNode *updatePaintNode(QSGNode *node, UpdatePaintNodeData *data) override;
 
 Q_SIGNALS:
@@ -235,12 +270,12 @@ Q_SIGNALS:
     void paintedAreaChanged();
     void animatedChanged();
     void roundToIconSizeChanged();
+    void asynchronousChanged();
 
 protected:
     void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
     QImage findIcon(const QSize &size);
-    void handleFinished(QNetworkReply *reply);
-    void handleRedirect(QNetworkReply *reply);
+    void handleRemoteImage(const QImage &image);
     QIcon::Mode iconMode() const;
     bool guessMonochrome(const QImage &img);
     void setStatus(Status status);
@@ -254,13 +289,21 @@ private:
     void windowVisibleChanged(bool visible);
     QSGNode *createSubtree(qreal initialOpacity);
     void updateSubtree(QSGNode *node, qreal opacity);
+    void updateTexture(ManagedTextureNode *node);
     QSize iconSizeHint() const;
     inline QImage iconPixmap(const QIcon &icon) const;
     QIcon loadFromTheme(const QString &iconName) const;
+    QColor tintColor() const;
+    QColor imageTintColor() const;
+    void updateMaskColor();
+    bool isCacheable() const;
+    IconImageCacheKey iconCacheKey(const QColor &tintColor) const;
+    bool loadAsynchronously(const IconImageCacheKey &key, const QColor &tintColor);
+    QImage scaledLoadedImage(const QSize &size);
 
     Kirigami::Platform::PlatformTheme *m_theme = nullptr;
     Kirigami::Platform::Units *m_units = nullptr;
-    QPointer<QNetworkReply> m_networkReply;
+    QPointer<RemoteImageRequest> m_remoteRequest;
     QHash<int, bool> m_monochromeHeuristics;
     QVariant m_source;
     qreal m_devicePixelRatio = 1.0;
@@ -277,8 +320,17 @@ private:
     QString m_placeholder = QStringLiteral("image-png");
     QSizeF m_paintedSize;
 
-    QImage m_oldIcon;
+    bool m_hasOldIcon = false;
     QImage m_icon;
+    // The size hint m_icon was created for
+    QSize m_rasterSize;
+    // Mask icons are tinted by the scene graph when rendering through the RHI,
+    // in which case m_icon only contains the shape of the icon.
+    bool m_gpuTint = false;
+    bool m_maskColorChanged = false;
+    QColor m_maskColor;
+    // Only set when the icon is drawn from the opt-in IconAtlas.
+    std::shared_ptr<IconAtlasRegion> m_atlasRegion;
 
     // animation on image change
     QPropertyAnimation *m_animation = nullptr;
@@ -287,4 +339,24 @@ private:
     bool m_roundToIconSize = true;
     bool m_blockNextAnimation = false;
     QPointer<QQuickWindow> m_window;
+
+    // asynchronous loading of image files
+    bool m_asynchronous = false;
+    QFutureWatcher<IconImageCache::Entry> *m_asyncLoad = nullptr;
+    IconImageCacheKey m_asyncKey;
+    std::optional<IconImageCache::Entry> m_asyncResult;
+
+    // m_loadedImage scaled to the size it was last shown at
+    QImage m_scaledLoadedImage;
+    QSize m_scaledLoadedSize;
+    qint64 m_scaledLoadedKey = 0;
+    bool m_scaledLoadedSmooth = false;
+    QFutureWatcher<QImage> *m_asyncScale = nullptr;
+    QSize m_asyncScaleSize;
+
+    // All instances form a list for imageBytes(), which costs creating an
+    // Icon no more than updating a few pointers.
+    Icon *m_previousIcon = nullptr;
+    Icon *m_nextIcon = nullptr;
+    inline static Icon *s_firstIcon = nullptr;
 };
@@ -0,0 +1,146 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "iconimagecache.h"
+
+#include <QGuiApplication>
+#include <QHashFunctions>
+
+// 16 MiB is enough for several hundred distinct icons at typical sizes.
+static constexpr qsizetype defaultMaxBytes = 16 * 1024 * 1024;
+
+Q_GLOBAL_STATIC(IconImageCache, s_iconImageCache)
+
+size_t qHash(const IconImageCacheKey &key, size_t seed)
+{
+    return qHashMulti(seed,
+                      key.source,
+                      key.fallback,
+                      key.themeName,
+                      key.size.width(),
+                      key.size.height(),
+                      key.devicePixelRatio,
+                      int(key.mode),
+                      key.tintColor,
+                      key.themeColors,
+                      key.colorSet,
+                      key.colorGroup,
+                      int(key.isMask),
+                      int(key.roundToIconSize));
+}
+
+IconImageCache::IconImageCache()
+{
+    bool ok = false;
+    const int kiloBytes = qEnvironmentVariableIntValue("KIRIGAMI_ICON_CACHE_SIZE", &ok);
+    setMaxBytes(ok && kiloBytes >= 0 ? qsizetype(kiloBytes) * 1024 : defaultMaxBytes);
+
+    // Mobile platforms expect applications to release memory when they are
+    // moved to the background, in which case nothing is being shown anyway.
+    if (qGuiApp) {
+        QObject::connect(qGuiApp, &QGuiApplication::applicationStateChanged, qGuiApp, [](Qt::ApplicationState state) {
+            if (state == Qt::ApplicationSuspended && !s_iconImageCache.isDestroyed()) {
+                s_iconImageCache->clear();
+            }
+        });
+    }
+}
+
+IconImageCache *IconImageCache::instance()
+{
+    return s_iconImageCache;
+}
+
+const IconImageCache::Entry *IconImageCache::find(const IconImageCacheKey &key)
+{
+    // QCache::object() also marks the entry as most recently used.
+    const Entry *entry = m_cache.object(key);
+    if (entry) {
+        ++m_hits;
+    } else {
+        ++m_misses;
+    }
+    return entry;
+}
+
+void IconImageCache::insert(const IconImageCacheKey &key, const QImage &image, bool error)
+{
+    if (image.isNull()) {
+        return;
+    }
+
+    // Images larger than the cache limit are rejected (and deleted) by QCache.
+    m_cache.insert(key, new Entry{image, error}, image.sizeInBytes());
+}
+
+QImage IconImageCache::deduplicate(const QImage &image, qint64 sourceKey, QRgb tintColor)
+{
+    if (image.isNull()) {
+        return image;
+    }
+
+    const std::pair<qint64, QRgb> source(sourceKey, tintColor);
+    if (const QImage *known = m_sourceCache.object(source)) {
+        return *known;
+    }
+
+    const size_t hash = qHashMulti(qHashBits(image.constBits(), image.sizeInBytes()), image.width(), image.height(), int(image.format()));
+    if (const QImage *existing = m_contentCache.object(hash)) {
+        // Guard against hash collisions, comparing is still much cheaper than
+        // uploading a new texture.
+        if (*existing == image) {
+            m_sourceCache.insert(source, new QImage(*existing), existing->sizeInBytes());
+            return *existing;
+        }
+    }
+
+    m_contentCache.insert(hash, new QImage(image), image.sizeInBytes());
+    m_sourceCache.insert(source, new QImage(image), image.sizeInBytes());
+    return image;
+}
+
+void IconImageCache::clear()
+{
+    m_cache.clear();
+    m_contentCache.clear();
+    m_sourceCache.clear();
+}
+
+qsizetype IconImageCache::maxBytes() const
+{
+    return m_cache.maxCost() + m_contentCache.maxCost();
+}
+
+void IconImageCache::setMaxBytes(qsizetype bytes)
+{
+    // Content deduplication only holds on to images that are in use by some
+    // Icon most of the time, so it gets a smaller part of the budget.
+    m_contentCache.setMaxCost(bytes / 4);
+    // Mostly shares its images with m_contentCache, but still needs to be
+    // bounded for images that were evicted from it.
+    m_sourceCache.setMaxCost(m_contentCache.maxCost());
+    m_cache.setMaxCost(bytes - m_contentCache.maxCost());
+}
+
+qsizetype IconImageCache::bytes() const
+{
+    return m_cache.totalCost() + m_contentCache.totalCost();
+}
+
+qsizetype IconImageCache::count() const
+{
+    return m_cache.count();
+}
+
+quint64 IconImageCache::hits() const
+{
+    return m_hits;
+}
+
+quint64 IconImageCache::misses() const
+{
+    return m_misses;
+}
@@ -0,0 +1,127 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QCache>
+#include <QColor>
+#include <QIcon>
+#include <QImage>
+#include <QSize>
+#include <QString>
+
+#include <utility>
+
+/**
+ * The key identifying a decoded and tinted icon image.
+ *
+ * Every property that influences the final pixels of an Icon is part of the
+ * key, so two Icon instances with equal keys are guaranteed to produce the
+ * same image.
+ */
+struct IconImageCacheKey {
+    QString source;
+    QString fallback;
+    QString themeName;
+    QSize size;
+    qreal devicePixelRatio = 1.0;
+    QIcon::Mode mode = QIcon::Normal;
+    QRgb tintColor = 0;
+    // Platform plugins recolor theme icons according to the colors of the
+    // theme of the item, so they are part of the key too.
+    size_t themeColors = 0;
+    int colorSet = 0;
+    int colorGroup = 0;
+    bool isMask = false;
+    bool roundToIconSize = true;
+
+    bool operator==(const IconImageCacheKey &other) const
+    {
+        return source == other.source && fallback == other.fallback && themeName == other.themeName && size == other.size
+            && devicePixelRatio == other.devicePixelRatio && mode == other.mode && tintColor == other.tintColor && themeColors == other.themeColors
+            && colorSet == other.colorSet && colorGroup == other.colorGroup && isMask == other.isMask
+            && roundToIconSize == other.roundToIconSize;
+    }
+};
+
+size_t qHash(const IconImageCacheKey &key, size_t seed = 0);
+
+/**
+ * A process-wide cache of decoded icon images.
+ *
+ * Icons are decoded, rasterized and tinted only once per key, after which all
+ * Icon instances share the same implicitly shared QImage. Besides saving the
+ * decoding work this also means the image data is only kept in memory once.
+ *
+ * The cache is bounded by the amount of bytes used by the stored images and
+ * evicts the least recently used images first. The limit can be changed with
+ * the `KIRIGAMI_ICON_CACHE_SIZE` environment variable, in kilobytes.
+ *
+ * @note This cache is not thread safe and should only be used from the GUI thread.
+ */
+class IconImageCache
+{
+public:
+    struct Entry {
+        QImage image;
+        // Stores whether the image is the requested icon or a fallback.
+        bool error = false;
+    };
+
+    IconImageCache();
+
+    static IconImageCache *instance();
+
+    /**
+     * @returns the cached entry for @p key, or nullptr if there is none.
+     *
+     * This counts as a hit or miss for the purpose of the statistics below.
+     */
+    const Entry *find(const IconImageCacheKey &key);
+
+    void insert(const IconImageCacheKey &key, const QImage &image, bool error);
+
+    /**
+     * @returns an image with the same contents as @p image.
+     *
+     * Images that cannot be cached by key, like those coming from QIcon
+     * objects, image providers or the network, are deduplicated by their
+     * contents instead. If an identical image was seen before, that image is
+     * returned so that identical images share both their pixel data and their
+     * QImage::cacheKey(), which in turn lets ImageTexturesCache share a single
+     * texture between all of them.
+     *
+     * @p image is the result of tinting an image with QImage::cacheKey()
+     * @p sourceKey with @p tintColor, if any. The contents are only hashed the
+     * first time a source image and tint are seen.
+     */
+    QImage deduplicate(const QImage &image, qint64 sourceKey, QRgb tintColor);
+
+    void clear();
+
+    /**
+     * The maximum size of all images in the cache, in bytes.
+     */
+    qsizetype maxBytes() const;
+    void setMaxBytes(qsizetype bytes);
+
+    /**
+     * The size of all images currently in the cache, in bytes.
+     */
+    qsizetype bytes() const;
+    qsizetype count() const;
+
+    quint64 hits() const;
+    quint64 misses() const;
+
+private:
+    QCache<IconImageCacheKey, Entry> m_cache;
+    QCache<size_t, QImage> m_contentCache;
+    // The deduplicated image of each source image and tint.
+    QCache<std::pair<qint64, QRgb>, QImage> m_sourceCache;
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+};
@@ -0,0 +1,71 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "memorystatistics.h"
+
+#include "icon.h"
+#include "iconimagecache.h"
+#include "scenegraph/cachedshadownode.h"
+#include "scenegraph/managedtexturenode.h"
+
+#include "platform/performancecounters_p.h"
+
+using Kirigami::Platform::PerformanceCounters;
+
+MemoryStatistics::MemoryStatistics(QObject *parent)
+    : QObject(parent)
+{
+    refresh();
+}
+
+qint64 MemoryStatistics::iconImageBytes() const
+{
+    return m_iconImageBytes;
+}
+
+qint64 MemoryStatistics::iconCacheBytes() const
+{
+    return m_iconCacheBytes;
+}
+
+qint64 MemoryStatistics::textureBytes() const
+{
+    return m_textureBytes;
+}
+
+qint64 MemoryStatistics::themeDataBytes() const
+{
+    return m_themeDataBytes;
+}
+
+qint64 MemoryStatistics::imageColorsBytes() const
+{
+    return m_imageColorsBytes;
+}
+
+int MemoryStatistics::poolPages() const
+{
+    return m_poolPages;
+}
+
+qint64 MemoryStatistics::totalBytes() const
+{
+    return m_iconImageBytes + m_iconCacheBytes + m_textureBytes + m_themeDataBytes + m_imageColorsBytes;
+}
+
+void MemoryStatistics::refresh()
+{
+    m_iconImageBytes = Icon::imageBytes();
+    m_iconCacheBytes = IconImageCache::instance()->bytes();
+    m_textureBytes = Icon::texturesCache()->bytes() + CachedShadowNode::texturesCache()->bytes();
+    m_themeDataBytes = PerformanceCounters::value(PerformanceCounters::ThemeDataBytes);
+    m_imageColorsBytes = PerformanceCounters::value(PerformanceCounters::ImageColorsBytes);
+    m_poolPages = PerformanceCounters::value(PerformanceCounters::PoolPages);
+
+    Q_EMIT updated();
+}
+
+#include "moc_memorystatistics.cpp"
@@ -0,0 +1,88 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QQmlEngine>
+
+/**
+ * Approximate memory held by Kirigami, per subsystem.
+ *
+ * The values are estimates meant for setting memory budgets and spotting
+ * leaks in long running sessions, not exact accounting: images assume their
+ * decoded size and textures four bytes per pixel. Memory shared between
+ * subsystems, such as an icon image that is also in the icon cache, is
+ * counted by each of them.
+ *
+ * The values are computed when accessing this singleton for the first time
+ * and whenever refresh() is called.
+ *
+ * @since 6.12
+ */
+class MemoryStatistics : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+    /**
+     * The decoded images displayed by Icon items, in bytes.
+     */
+    Q_PROPERTY(qint64 iconImageBytes READ iconImageBytes NOTIFY updated FINAL)
+    /**
+     * The decoded images in the icon cache, in bytes.
+     */
+    Q_PROPERTY(qint64 iconCacheBytes READ iconCacheBytes NOTIFY updated FINAL)
+    /**
+     * The icon and shadow textures of all windows, in bytes.
+     */
+    Q_PROPERTY(qint64 textureBytes READ textureBytes NOTIFY updated FINAL)
+    /**
+     * The data shared between PlatformTheme instances, in bytes.
+     */
+    Q_PROPERTY(qint64 themeDataBytes READ themeDataBytes NOTIFY updated FINAL)
+    /**
+     * The samples and clusters kept by ImageColors instances, in bytes.
+     */
+    Q_PROPERTY(qint64 imageColorsBytes READ imageColorsBytes NOTIFY updated FINAL)
+    /**
+     * The number of pages held by all PagePool instances. Their memory cannot
+     * be estimated, as it depends on the pages.
+     */
+    Q_PROPERTY(int poolPages READ poolPages NOTIFY updated FINAL)
+    /**
+     * The sum of all sizes above, in bytes.
+     */
+    Q_PROPERTY(qint64 totalBytes READ totalBytes NOTIFY updated FINAL)
+
+public:
+    explicit MemoryStatistics(QObject *parent = nullptr);
+
+    qint64 iconImageBytes() const;
+    qint64 iconCacheBytes() const;
+    qint64 textureBytes() const;
+    qint64 themeDataBytes() const;
+    qint64 imageColorsBytes() const;
+    int poolPages() const;
+    qint64 totalBytes() const;
+
+    /**
+     * Compute all values again.
+     */
+    Q_INVOKABLE void refresh();
+
+Q_SIGNALS:
+    void updated();
+
+private:
+    qint64 m_iconImageBytes = 0;
+    qint64 m_iconCacheBytes = 0;
+    qint64 m_textureBytes = 0;
+    qint64 m_themeDataBytes = 0;
+    qint64 m_imageColorsBytes = 0;
+    int m_poolPages = 0;
+};
@@ -0,0 +1,160 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "performancestatistics.h"
+
+#include "icon.h"
+#include "iconimagecache.h"
+#include "scenegraph/managedtexturenode.h"
+
+#include "platform/performancecounters_p.h"
+
+#include <algorithm>
+
+using Kirigami::Platform::PerformanceCounters;
+
+static constexpr int updateInterval = 500;
+// Longer intervals are pauses between animations rather than slow frames.
+static constexpr qint64 maximumFrameInterval = 100;
+
+PerformanceStatistics::PerformanceStatistics(QObject *parent)
+    : QObject(parent)
+{
+    PerformanceCounters::acquire();
+
+    m_lastSnapshot = snapshot();
+    m_intervalTimer.start();
+
+    m_updateTimer.setInterval(updateInterval);
+    connect(&m_updateTimer, &QTimer::timeout, this, &PerformanceStatistics::updateStatistics);
+    m_updateTimer.start();
+}
+
+PerformanceStatistics::~PerformanceStatistics()
+{
+    PerformanceCounters::release();
+}
+
+QQuickWindow *PerformanceStatistics::window() const
+{
+    return m_window;
+}
+
+void PerformanceStatistics::setWindow(QQuickWindow *window)
+{
+    if (window == m_window) {
+        return;
+    }
+
+    if (m_window) {
+        disconnect(m_window, nullptr, this, nullptr);
+    }
+
+    m_window = window;
+    m_frameTimer.invalidate();
+
+    if (m_window) {
+        // Emitted on the GUI thread once per frame, after polishing the items.
+        connect(m_window, &QQuickWindow::afterAnimating, this, &PerformanceStatistics::frameStarted);
+    }
+
+    Q_EMIT windowChanged();
+}
+
+qreal PerformanceStatistics::frameTime() const
+{
+    return m_frameTime;
+}
+
+qreal PerformanceStatistics::framesPerSecond() const
+{
+    return m_framesPerSecond;
+}
+
+qreal PerformanceStatistics::polishesPerFrame() const
+{
+    return m_polishesPerFrame;
+}
+
+qreal PerformanceStatistics::layoutPassesPerFrame() const
+{
+    return m_layoutPassesPerFrame;
+}
+
+qreal PerformanceStatistics::themeUpdatesPerFrame() const
+{
+    return m_themeUpdatesPerFrame;
+}
+
+qreal PerformanceStatistics::iconCacheHitRate() const
+{
+    return m_iconCacheHitRate;
+}
+
+qint64 PerformanceStatistics::textureBytes() const
+{
+    return m_textureBytes;
+}
+
+int PerformanceStatistics::poolPages() const
+{
+    return m_poolPages;
+}
+
+PerformanceStatistics::Snapshot PerformanceStatistics::snapshot()
+{
+    Snapshot result;
+    result.polishes = PerformanceCounters::value(PerformanceCounters::Polish);
+    result.layoutPasses = PerformanceCounters::value(PerformanceCounters::LayoutPass);
+    result.themeUpdates = PerformanceCounters::value(PerformanceCounters::ThemeUpdate);
+    result.iconCacheHits = IconImageCache::instance()->hits();
+    result.iconCacheMisses = IconImageCache::instance()->misses();
+    return result;
+}
+
+void PerformanceStatistics::frameStarted()
+{
+    m_frames++;
+
+    if (m_frameTimer.isValid()) {
+        const qint64 interval = m_frameTimer.restart();
+        if (interval <= maximumFrameInterval) {
+            m_continuousFrames++;
+            m_continuousFrameTime += interval;
+        }
+    } else {
+        m_frameTimer.start();
+    }
+}
+
+void PerformanceStatistics::updateStatistics()
+{
+    const Snapshot current = snapshot();
+    const qint64 elapsed = m_intervalTimer.restart();
+    const qreal frames = std::max(m_frames, 1);
+
+    m_frameTime = m_continuousFrames > 0 ? qreal(m_continuousFrameTime) / m_continuousFrames : 0.0;
+    m_framesPerSecond = elapsed > 0 ? m_frames * 1000.0 / elapsed : 0.0;
+    m_polishesPerFrame = (current.polishes - m_lastSnapshot.polishes) / frames;
+    m_layoutPassesPerFrame = (current.layoutPasses - m_lastSnapshot.layoutPasses) / frames;
+    m_themeUpdatesPerFrame = (current.themeUpdates - m_lastSnapshot.themeUpdates) / frames;
+
+    const quint64 hits = current.iconCacheHits - m_lastSnapshot.iconCacheHits;
+    const quint64 lookups = hits + current.iconCacheMisses - m_lastSnapshot.iconCacheMisses;
+    m_iconCacheHitRate = lookups > 0 ? qreal(hits) / lookups : -1.0;
+
+    m_textureBytes = m_window ? Icon::texturesCache()->bytes(m_window) : 0;
+    m_poolPages = PerformanceCounters::value(PerformanceCounters::PoolPages);
+
+    m_lastSnapshot = current;
+    m_frames = 0;
+    m_continuousFrames = 0;
+    m_continuousFrameTime = 0;
+
+    Q_EMIT updated();
+}
+
+#include "moc_performancestatistics.cpp"
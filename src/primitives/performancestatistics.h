@@ -0,0 +1,122 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+#include <QQmlEngine>
+#include <QQuickWindow>
+#include <QTimer>
+
+/**
+ * Statistics about the work done by Kirigami while rendering a window.
+ *
+ * The statistics are updated twice per second, averaged over the frames
+ * rendered in that time. Kirigami only counts events while at least one
+ * instance of this type exists.
+ *
+ * @see PerformanceOverlay
+ * @since 6.12
+ */
+class PerformanceStatistics : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    /**
+     * The window to measure the frames of.
+     */
+    Q_PROPERTY(QQuickWindow *window READ window WRITE setWindow NOTIFY windowChanged FINAL)
+
+    /**
+     * The average time between two frames while the window renders
+     * continuously, in milliseconds. This is 0 when no frames were rendered.
+     */
+    Q_PROPERTY(qreal frameTime READ frameTime NOTIFY updated FINAL)
+    /**
+     * The number of frames rendered per second.
+     */
+    Q_PROPERTY(qreal framesPerSecond READ framesPerSecond NOTIFY updated FINAL)
+    /**
+     * The average number of icons polished per frame.
+     */
+    Q_PROPERTY(qreal polishesPerFrame READ polishesPerFrame NOTIFY updated FINAL)
+    /**
+     * The average number of times a layout arranged its items per frame.
+     */
+    Q_PROPERTY(qreal layoutPassesPerFrame READ layoutPassesPerFrame NOTIFY updated FINAL)
+    /**
+     * The average number of theme updates per frame, which includes themes
+     * propagating changes to their children.
+     */
+    Q_PROPERTY(qreal themeUpdatesPerFrame READ themeUpdatesPerFrame NOTIFY updated FINAL)
+    /**
+     * The ratio of icon images found in the icon cache since the last update,
+     * between 0 and 1, or -1 if no icon was loaded.
+     */
+    Q_PROPERTY(qreal iconCacheHitRate READ iconCacheHitRate NOTIFY updated FINAL)
+    /**
+     * The estimated size of the icon textures of the window, in bytes.
+     */
+    Q_PROPERTY(qint64 textureBytes READ textureBytes NOTIFY updated FINAL)
+    /**
+     * The number of pages held by all PagePool instances.
+     */
+    Q_PROPERTY(int poolPages READ poolPages NOTIFY updated FINAL)
+
+public:
+    explicit PerformanceStatistics(QObject *parent = nullptr);
+    ~PerformanceStatistics() override;
+
+    QQuickWindow *window() const;
+    void setWindow(QQuickWindow *window);
+    Q_SIGNAL void windowChanged();
+
+    qreal frameTime() const;
+    qreal framesPerSecond() const;
+    qreal polishesPerFrame() const;
+    qreal layoutPassesPerFrame() const;
+    qreal themeUpdatesPerFrame() const;
+    qreal iconCacheHitRate() const;
+    qint64 textureBytes() const;
+    int poolPages() const;
+
+Q_SIGNALS:
+    void updated();
+
+private:
+    struct Snapshot {
+        quint64 polishes = 0;
+        quint64 layoutPasses = 0;
+        quint64 themeUpdates = 0;
+        quint64 iconCacheHits = 0;
+        quint64 iconCacheMisses = 0;
+    };
+
+    static Snapshot snapshot();
+    void frameStarted();
+    void updateStatistics();
+
+    QPointer<QQuickWindow> m_window;
+    QTimer m_updateTimer;
+    QElapsedTimer m_intervalTimer;
+    QElapsedTimer m_frameTimer;
+    Snapshot m_lastSnapshot;
+    int m_frames = 0;
+    int m_continuousFrames = 0;
+    qint64 m_continuousFrameTime = 0;
+
+    qreal m_frameTime = 0.0;
+    qreal m_framesPerSecond = 0.0;
+    qreal m_polishesPerFrame = 0.0;
+    qreal m_layoutPassesPerFrame = 0.0;
+    qreal m_themeUpdatesPerFrame = 0.0;
+    qreal m_iconCacheHitRate = -1.0;
+    qint64 m_textureBytes = 0;
+    int m_poolPages = 0;
+};
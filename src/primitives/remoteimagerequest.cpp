@@ -0,0 +1,139 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "remoteimagerequest.h"
+
+#include <QCache>
+#include <QGuiApplication>
+#include <QHash>
+#include <QMetaMethod>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+
+// The size of the decoded images that are kept, in kilobytes, which fits a
+// few hundred avatars.
+static constexpr qsizetype maximumCacheCost = 16 * 1024;
+
+namespace
+{
+struct RemoteImages {
+    RemoteImages()
+    {
+        images.setMaxCost(maximumCacheCost);
+
+        // Like IconImageCache, release the images when moved to the background.
+        if (qGuiApp) {
+            QObject::connect(qGuiApp, &QGuiApplication::applicationStateChanged, qGuiApp, [this](Qt::ApplicationState state) {
+                if (state == Qt::ApplicationSuspended) {
+                    images.clear();
+                }
+            });
+        }
+    }
+
+    QHash<std::pair<QNetworkAccessManager *, QUrl>, RemoteImageRequest *> pending;
+    QCache<QUrl, QImage> images;
+};
+}
+
+Q_GLOBAL_STATIC(RemoteImages, s_remoteImages)
+
+RemoteImageRequest *RemoteImageRequest::get(QNetworkAccessManager *manager, const QUrl &url)
+{
+    const auto key = std::make_pair(manager, url);
+    if (auto request = s_remoteImages->pending.value(key)) {
+        return request;
+    }
+
+    auto request = new RemoteImageRequest(manager, url);
+    s_remoteImages->pending.insert(key, request);
+    request->start(url);
+    return request;
+}
+
+std::optional<QImage> RemoteImageRequest::cachedImage(const QUrl &url)
+{
+    if (auto image = s_remoteImages->images.object(url)) {
+        return *image;
+    }
+    return std::nullopt;
+}
+
+RemoteImageRequest::RemoteImageRequest(QNetworkAccessManager *manager, const QUrl &url)
+    : QObject(manager)
+    , m_manager(manager)
+    , m_url(url)
+{
+}
+
+RemoteImageRequest::~RemoteImageRequest()
+{
+    if (s_remoteImages.exists()) {
+        s_remoteImages->pending.remove(std::make_pair(m_manager, m_url));
+    }
+    if (m_reply) {
+        m_reply->disconnect(this);
+        m_reply->abort();
+        m_reply->deleteLater();
+    }
+}
+
+QUrl RemoteImageRequest::url() const
+{
+    return m_url;
+}
+
+void RemoteImageRequest::releaseIfUnused()
+{
+    if (!isSignalConnected(QMetaMethod::fromSignal(&RemoteImageRequest::finished))) {
+        s_remoteImages->pending.remove(std::make_pair(m_manager, m_url));
+        deleteLater();
+    }
+}
+
+void RemoteImageRequest::start(const QUrl &url)
+{
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
+    m_reply = m_manager->get(request);
+    connect(m_reply.data(), &QNetworkReply::finished, this, &RemoteImageRequest::handleFinished);
+}
+
+void RemoteImageRequest::handleFinished()
+{
+    QNetworkReply *reply = m_reply;
+    if (!reply) {
+        return;
+    }
+    m_reply = nullptr;
+    reply->deleteLater();
+
+    const QUrl possibleRedirectUrl = reply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl();
+    if (!possibleRedirectUrl.isEmpty()) {
+        const QUrl redirectUrl = reply->url().resolved(possibleRedirectUrl);
+        // no infinite redirections thank you very much
+        if (reply->error() == QNetworkReply::NoError && redirectUrl != reply->url()) {
+            start(redirectUrl);
+            return;
+        }
+    }
+
+    QImage image;
+    if (reply->error() == QNetworkReply::NoError) {
+        const QString filename = reply->url().fileName();
+        if (image.load(reply, filename.mid(filename.indexOf(QLatin1Char('.'))).toLatin1().constData())) {
+            s_remoteImages->images.insert(m_url, new QImage(image), std::max<qsizetype>(1, image.sizeInBytes() / 1024));
+        } else {
+            image = QImage();
+        }
+    }
+
+    s_remoteImages->pending.remove(std::make_pair(m_manager, m_url));
+    Q_EMIT finished(image);
+    deleteLater();
+}
+
+#include "moc_remoteimagerequest.cpp"
@@ -0,0 +1,72 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QImage>
+#include <QObject>
+#include <QPointer>
+#include <QUrl>
+
+#include <optional>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+/**
+ * A network request for a remote image, shared between everything that shows
+ * the same url.
+ *
+ * Only a single request is made for any url at a time, no matter how many
+ * Icon instances are waiting for it, and the received image is decoded once.
+ * Decoded images are kept in a small cache afterwards, so that images showing
+ * up repeatedly, like avatars in a chat, do not need to be requested again.
+ *
+ * @note This is not thread safe and should only be used from the GUI thread.
+ */
+class RemoteImageRequest : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @returns the request for @p url, which is started using @p manager if
+     * it is not running already.
+     */
+    static RemoteImageRequest *get(QNetworkAccessManager *manager, const QUrl &url);
+
+    /**
+     * @returns the decoded image for @p url if it has been received before.
+     */
+    static std::optional<QImage> cachedImage(const QUrl &url);
+
+    ~RemoteImageRequest() override;
+
+    QUrl url() const;
+
+    /**
+     * Stop the request if nothing is connected to finished() anymore.
+     */
+    void releaseIfUnused();
+
+Q_SIGNALS:
+    /**
+     * Emitted once the image has been received and decoded. @p image is null
+     * if the request failed or the data could not be decoded.
+     */
+    void finished(const QImage &image);
+
+private:
+    RemoteImageRequest(QNetworkAccessManager *manager, const QUrl &url);
+
+    void start(const QUrl &url);
+    void handleFinished();
+
+    // The request is owned by the manager, so this is valid for as long as we are.
+    QNetworkAccessManager *const m_manager;
+    const QUrl m_url;
+    QPointer<QNetworkReply> m_reply;
+};
@@ -0,0 +1,137 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "renderquality.h"
+
+#include <QScreen>
+
+// Longer intervals are pauses between animations rather than slow frames.
+static constexpr qint64 maximumFrameInterval = 100;
+// Weight of a single frame in the average interval.
+static constexpr double averageWeight = 0.1;
+// Ratios of the refresh interval above which frames count as slow and below
+// which they count as fast.
+static constexpr double slowFrameRatio = 1.5;
+static constexpr double fastFrameRatio = 1.1;
+// Number of consecutive slow or fast frames needed to switch.
+static constexpr int slowFramesToSwitch = 60;
+static constexpr int fastFramesToSwitch = 600;
+
+bool RenderQuality::isAdaptive()
+{
+    static const bool adaptive = qEnvironmentVariableIntValue("KIRIGAMI_ADAPTIVE_QUALITY") == 1;
+    return adaptive;
+}
+
+bool RenderQuality::isLowPowerHardware()
+{
+    static const bool lowPower = QByteArrayList{"1", "true"}.contains(qgetenv("KIRIGAMI_LOWPOWER_HARDWARE").toLower());
+    return lowPower;
+}
+
+RenderQuality *RenderQuality::forWindow(QQuickWindow *window)
+{
+    if (!window || !isAdaptive()) {
+        return nullptr;
+    }
+
+    auto quality = window->findChild<RenderQuality *>(QString{}, Qt::FindDirectChildrenOnly);
+    if (!quality) {
+        quality = new RenderQuality(window);
+    }
+    return quality;
+}
+
+RenderQuality::RenderQuality(QQuickWindow *window)
+    : QObject(window)
+    , m_window(window)
+{
+    // Frames are measured on the thread rendering them, so the measurements
+    // are not delayed by a busy GUI thread.
+    connect(window, &QQuickWindow::frameSwapped, this, &RenderQuality::frameSwapped, Qt::DirectConnection);
+
+    // The screen of the window is only accessible on the GUI thread.
+    connect(window, &QWindow::screenChanged, this, &RenderQuality::updateRefreshInterval);
+    updateRefreshInterval();
+}
+
+void RenderQuality::updateRefreshInterval()
+{
+    disconnect(m_screenConnection);
+
+    const QScreen *screen = m_window->screen();
+    if (screen) {
+        m_screenConnection = connect(screen, &QScreen::refreshRateChanged, this, &RenderQuality::updateRefreshInterval);
+    }
+
+    const double refreshRate = screen && screen->refreshRate() > 0.0 ? screen->refreshRate() : 60.0;
+    m_refreshInterval.store(1000.0 / refreshRate, std::memory_order_relaxed);
+}
+
+bool RenderQuality::isLowPower() const
+{
+    return m_lowPower;
+}
+
+void RenderQuality::frameSwapped()
+{
+    if (!m_frameTimer.isValid()) {
+        m_frameTimer.start();
+        return;
+    }
+
+    const qint64 interval = m_frameTimer.restart();
+    if (interval > maximumFrameInterval) {
+        m_averageInterval = 0.0;
+        return;
+    }
+
+    m_averageInterval = m_averageInterval == 0.0 ? interval : m_averageInterval + (interval - m_averageInterval) * averageWeight;
+
+    const double refreshInterval = m_refreshInterval.load(std::memory_order_relaxed);
+
+    if (m_averageInterval > refreshInterval * slowFrameRatio) {
+        m_slowFrames++;
+        m_fastFrames = 0;
+    } else if (m_averageInterval < refreshInterval * fastFrameRatio) {
+        m_fastFrames++;
+        m_slowFrames = 0;
+    } else {
+        m_slowFrames = 0;
+        m_fastFrames = 0;
+    }
+
+    bool lowPower = m_renderLowPower;
+    if (!lowPower && m_slowFrames >= slowFramesToSwitch) {
+        lowPower = true;
+    } else if (lowPower && m_fastFrames >= fastFramesToSwitch) {
+        lowPower = false;
+    }
+
+    if (lowPower != m_renderLowPower) {
+        m_renderLowPower = lowPower;
+        m_slowFrames = 0;
+        m_fastFrames = 0;
+        QMetaObject::invokeMethod(
+            this,
+            [this, lowPower]() {
+                setLowPower(lowPower);
+            },
+            Qt::QueuedConnection);
+    }
+}
+
+void RenderQuality::setLowPower(bool lowPower)
+{
+    if (lowPower == m_lowPower) {
+        return;
+    }
+
+    m_lowPower = lowPower;
+    Q_EMIT lowPowerChanged();
+}
+
+#include "moc_renderquality.cpp"
@@ -0,0 +1,74 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QQuickWindow>
+
+#include <atomic>
+
+/**
+ * Switches the primitives of a window to their low power shaders when the
+ * window cannot keep up with the display's refresh rate.
+ *
+ * The time between consecutive frames is tracked while the window renders
+ * continuously, for instance during an animation. Once frames took
+ * noticeably longer than the refresh interval for about a second, the window
+ * switches to low power rendering. It only switches back after several
+ * seconds of rendering in time, so that a window does not switch back and
+ * forth on every animation.
+ *
+ * Adaptive quality is opt-in and enabled by setting the
+ * `KIRIGAMI_ADAPTIVE_QUALITY` environment variable to 1. Setting
+ * `KIRIGAMI_LOWPOWER_HARDWARE` instead switches all windows to low power
+ * rendering unconditionally.
+ */
+class RenderQuality : public QObject
+{
+    Q_OBJECT
+
+public:
+    static bool isAdaptive();
+    static bool isLowPowerHardware();
+
+    /**
+     * @returns the controller for @p window, or nullptr if adaptive quality
+     * is disabled.
+     */
+    static RenderQuality *forWindow(QQuickWindow *window);
+
+    /**
+     * Whether the window currently uses low power rendering.
+     *
+     * This can be read on the render thread while synchronizing.
+     */
+    bool isLowPower() const;
+    Q_SIGNAL void lowPowerChanged();
+
+private:
+    explicit RenderQuality(QQuickWindow *window);
+
+    void frameSwapped();
+    void setLowPower(bool lowPower);
+    void updateRefreshInterval();
+
+    QQuickWindow *const m_window;
+    bool m_lowPower = false;
+
+    // The refresh interval of the screen of the window in milliseconds,
+    // updated on the GUI thread and read on the render thread.
+    std::atomic<double> m_refreshInterval = 1000.0 / 60.0;
+    QMetaObject::Connection m_screenConnection;
+
+    // Only used on the thread rendering the window.
+    QElapsedTimer m_frameTimer;
+    double m_averageInterval = 0.0;
+    int m_slowFrames = 0;
+    int m_fastFrames = 0;
+    bool m_renderLowPower = false;
+};
@@ -0,0 +1,91 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "cachedshadownode.h"
+
+#include "managedtexturenode.h"
+
+#include <array>
+#include <cstring>
+
+Q_GLOBAL_STATIC(ImageTexturesCache, s_shadowTexturesCache)
+
+CachedShadowNode::CachedShadowNode()
+    : m_geometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 16, 54)
+{
+    m_geometry.setDrawingMode(QSGGeometry::DrawTriangles);
+
+    // Two triangles for each of the nine slices of a four by four grid.
+    auto indices = m_geometry.indexDataAsUShort();
+    for (quint16 row = 0; row < 3; ++row) {
+        for (quint16 column = 0; column < 3; ++column) {
+            const quint16 topLeft = row * 4 + column;
+            const quint16 sliceIndices[] = {topLeft, quint16(topLeft + 1), quint16(topLeft + 4), quint16(topLeft + 1), quint16(topLeft + 5), quint16(topLeft + 4)};
+            memcpy(indices, sliceIndices, sizeof(sliceIndices));
+            indices += 6;
+        }
+    }
+
+    m_material.setFiltering(QSGTexture::Linear);
+
+    setGeometry(&m_geometry);
+    setMaterial(&m_material);
+}
+
+const ImageTexturesCache *CachedShadowNode::texturesCache()
+{
+    return s_shadowTexturesCache;
+}
+
+bool CachedShadowNode::isSubtreeBlocked() const
+{
+    return m_blocked;
+}
+
+void CachedShadowNode::update(QQuickWindow *window, const QRectF &rect, const ShadowParameters &parameters)
+{
+    const auto shadow = ShadowImageCache::instance()->image(parameters);
+    const bool blocked = shadow.isNull();
+    if (blocked != m_blocked) {
+        m_blocked = blocked;
+        markDirty(QSGNode::DirtySubtreeBlocked);
+    }
+    if (blocked) {
+        m_texture.reset();
+        m_material.setTexture(nullptr);
+        return;
+    }
+
+    auto texture = s_shadowTexturesCache->loadTexture(window, shadow.image, QQuickWindow::TextureCanUseAtlas);
+    if (texture != m_texture) {
+        m_texture = texture;
+        m_material.setTexture(m_texture.get());
+        markDirty(QSGNode::DirtyMaterial);
+    }
+
+    const auto outer = rect.marginsAdded(shadow.margins);
+    const std::array<qreal, 4> x = {outer.left(), outer.left() + shadow.slices.left(), outer.right() - shadow.slices.right(), outer.right()};
+    const std::array<qreal, 4> y = {outer.top(), outer.top() + shadow.slices.top(), outer.bottom() - shadow.slices.bottom(), outer.bottom()};
+
+    // The center slices map to a single line of the image, any part of that
+    // line gives the same result when stretched.
+    const auto subRect = m_texture->normalizedTextureSubRect();
+    const qreal centerU = shadow.slices.left() / (shadow.slices.left() + shadow.slices.right());
+    const qreal centerV = shadow.slices.top() / (shadow.slices.top() + shadow.slices.bottom());
+    const std::array<qreal, 4> u = {0.0, centerU, centerU, 1.0};
+    const std::array<qreal, 4> v = {0.0, centerV, centerV, 1.0};
+
+    auto vertices = m_geometry.vertexDataAsTexturedPoint2D();
+    for (std::size_t row = 0; row < 4; ++row) {
+        for (std::size_t column = 0; column < 4; ++column) {
+            vertices[row * 4 + column].set(x[column],
+                                           y[row],
+                                           subRect.x() + u[column] * subRect.width(),
+                                           subRect.y() + v[row] * subRect.height());
+        }
+    }
+    markDirty(QSGNode::DirtyGeometry);
+}
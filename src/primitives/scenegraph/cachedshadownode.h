@@ -0,0 +1,50 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGTextureMaterial>
+
+#include <memory>
+
+#include "shadowimagecache.h"
+
+class ImageTexturesCache;
+
+/**
+ * Scene graph node drawing a shadow from a ShadowImageCache image.
+ *
+ * The image is drawn as a nine-slice around the rectangle. Its texture is
+ * shared between all nodes drawing the same shadow in a window.
+ */
+class CachedShadowNode : public QSGGeometryNode
+{
+public:
+    CachedShadowNode();
+
+    /**
+     * Update the node to draw the shadow for @p parameters around @p rect.
+     *
+     * If there is no visible shadow, the node is kept but not rendered, so it
+     * can be reused once the shadow becomes visible again.
+     */
+    void update(QQuickWindow *window, const QRectF &rect, const ShadowParameters &parameters);
+
+    bool isSubtreeBlocked() const override;
+
+    /**
+     * The cache of the textures used by all shadows.
+     */
+    static const ImageTexturesCache *texturesCache();
+
+private:
+    QSGGeometry m_geometry;
+    QSGTextureMaterial m_material;
+    std::shared_ptr<QSGTexture> m_texture;
+    bool m_blocked = false;
+};
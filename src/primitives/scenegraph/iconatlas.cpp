@@ -0,0 +1,312 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "iconatlas.h"
+#include "windowresources.h"
+
+#include <QPainter>
+#include <QPointer>
+#include <QRunnable>
+#include <QThread>
+
+#include <rhi/qrhi.h>
+
+#include <algorithm>
+
+static constexpr int pageSize = 512;
+static constexpr int maximumIconSize = 128;
+// Transparent border around each icon to avoid neighbouring icons bleeding
+// into each other with linear filtering.
+static constexpr int padding = 1;
+
+/**
+ * The texture of an IconAtlasPage.
+ *
+ * Only the parts of the page that changed are uploaded, so the texture, and
+ * thus its comparison key, stays the same and the nodes using it keep being
+ * batched together.
+ */
+class IconAtlasTexture : public QSGTexture
+{
+public:
+    ~IconAtlasTexture() override
+    {
+        delete m_rhiTexture;
+    }
+
+    qint64 comparisonKey() const override
+    {
+        return qint64(quintptr(this));
+    }
+
+    QRhiTexture *rhiTexture() const override
+    {
+        return m_rhiTexture;
+    }
+
+    QSize textureSize() const override
+    {
+        return QSize(pageSize, pageSize);
+    }
+
+    bool hasAlphaChannel() const override
+    {
+        return true;
+    }
+
+    bool hasMipmaps() const override
+    {
+        return false;
+    }
+
+    void commitTextureOperations(QRhi *rhi, QRhiResourceUpdateBatch *resourceUpdates) override
+    {
+        if (!m_rhiTexture) {
+            m_rhiTexture = rhi->newTexture(QRhiTexture::RGBA8, textureSize());
+            if (!m_rhiTexture->create()) {
+                delete m_rhiTexture;
+                m_rhiTexture = nullptr;
+                return;
+            }
+        }
+
+        if (m_uploads.isEmpty()) {
+            return;
+        }
+
+        QList<QRhiTextureUploadEntry> entries;
+        entries.reserve(m_uploads.size());
+        for (const auto &upload : std::as_const(m_uploads)) {
+            QRhiTextureSubresourceUploadDescription description(upload.image);
+            description.setDestinationTopLeft(upload.position);
+            entries.append(QRhiTextureUploadEntry(0, 0, description));
+        }
+        m_uploads.clear();
+
+        QRhiTextureUploadDescription description;
+        description.setEntries(entries.cbegin(), entries.cend());
+        resourceUpdates->uploadTexture(m_rhiTexture, description);
+    }
+
+    /**
+     * Upload @p image at @p position with the next frame.
+     */
+    void queueUpload(const QImage &image, const QPoint &position)
+    {
+        m_uploads.append(Upload{image, position});
+    }
+
+    void releaseRhiTexture()
+    {
+        delete m_rhiTexture;
+        m_rhiTexture = nullptr;
+        m_uploads.clear();
+    }
+
+private:
+    struct Upload {
+        QImage image;
+        QPoint position;
+    };
+
+    QRhiTexture *m_rhiTexture = nullptr;
+    QList<Upload> m_uploads;
+};
+
+// Deletes a texture once it is destroyed, which happens on the render thread
+// whether the job is run or dropped with the render loop.
+class DeleteTextureJob : public QRunnable
+{
+public:
+    explicit DeleteTextureJob(QSGTexture *texture)
+        : m_texture(texture)
+    {
+    }
+
+    ~DeleteTextureJob() override
+    {
+        delete m_texture;
+    }
+
+    void run() override
+    {
+    }
+
+private:
+    QSGTexture *m_texture;
+};
+
+IconAtlasPage::IconAtlasPage()
+    // This is the layout of QRhiTexture::RGBA8, so parts can be uploaded as they are.
+    : m_image(pageSize, pageSize, QImage::Format_RGBA8888_Premultiplied)
+{
+    m_image.fill(Qt::transparent);
+}
+
+IconAtlasPage::~IconAtlasPage() = default;
+
+QRect IconAtlasPage::add(const QImage &image)
+{
+    const int width = image.width() + padding * 2;
+    const int height = image.height() + padding * 2;
+
+    if (m_cursorX + width > pageSize) {
+        m_shelfY += m_shelfHeight;
+        m_cursorX = 0;
+        m_shelfHeight = 0;
+    }
+
+    if (m_shelfY + height > pageSize) {
+        return QRect{};
+    }
+
+    const QRect rect(m_cursorX + padding, m_shelfY + padding, image.width(), image.height());
+    m_cursorX += width;
+    m_shelfHeight = std::max(m_shelfHeight, height);
+
+    QPainter painter(&m_image);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.drawImage(rect.topLeft(), image);
+    painter.end();
+
+    m_dirtyRects.append(rect);
+    return rect;
+}
+
+std::shared_ptr<QSGTexture> IconAtlasPage::texture(QQuickWindow *window)
+{
+    if (!m_texture) {
+        // Pages are released from the GUI thread, the texture needs to be
+        // destroyed on the render thread it was created on.
+        m_texture = std::shared_ptr<IconAtlasTexture>(new IconAtlasTexture, [window = QPointer<QQuickWindow>(window)](IconAtlasTexture *texture) {
+            if (window && texture->thread() != QThread::currentThread()) {
+                window->scheduleRenderJob(new DeleteTextureJob(texture), QQuickWindow::NoStage);
+            } else {
+                // Without a window its scene graph has stopped, which
+                // released the graphics resources already.
+                delete texture;
+            }
+        });
+        m_fullUpload = true;
+    }
+
+    if (m_fullUpload) {
+        m_texture->queueUpload(m_image, QPoint());
+        m_fullUpload = false;
+    } else {
+        for (const QRect &rect : std::as_const(m_dirtyRects)) {
+            m_texture->queueUpload(m_image.copy(rect), rect.topLeft());
+        }
+    }
+    m_dirtyRects.clear();
+
+    return m_texture;
+}
+
+void IconAtlasPage::releaseTexture()
+{
+    if (m_texture) {
+        m_texture->releaseRhiTexture();
+    }
+    m_fullUpload = true;
+    m_dirtyRects.clear();
+}
+
+bool IconAtlas::isEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("KIRIGAMI_ICON_ATLAS") == 1;
+    return enabled;
+}
+
+bool IconAtlas::accepts(const QImage &image)
+{
+    return !image.isNull() && image.width() <= maximumIconSize && image.height() <= maximumIconSize;
+}
+
+std::shared_ptr<IconAtlasRegion> IconAtlas::region(QQuickWindow *window, const QImage &image)
+{
+    if (!window || !accepts(image)) {
+        return nullptr;
+    }
+
+    static const int releaseFunction = WindowResources::addReleaseFunction(&IconAtlas::release);
+    Q_UNUSED(releaseFunction);
+
+    QMutexLocker locker(&s_mutex);
+
+    const auto key = qMakePair(window, window->effectiveDevicePixelRatio());
+    auto itr = s_atlases.find(key);
+    if (itr == s_atlases.end()) {
+        itr = s_atlases.insert(key, WindowAtlas{});
+        WindowResources::watch(window);
+    }
+
+    WindowAtlas &atlas = *itr;
+
+    if (auto region = atlas.regions.value(image.cacheKey()).lock()) {
+        return region;
+    }
+
+    // Drop pages that are no longer used by anything.
+    atlas.pages.erase(std::remove_if(atlas.pages.begin(),
+                                     atlas.pages.end(),
+                                     [](const std::weak_ptr<IconAtlasPage> &page) {
+                                         return page.expired();
+                                     }),
+                      atlas.pages.end());
+
+    std::shared_ptr<IconAtlasPage> page;
+    QRect rect;
+    for (const auto &candidate : atlas.pages) {
+        page = candidate.lock();
+        rect = page->add(image);
+        if (!rect.isNull()) {
+            break;
+        }
+    }
+
+    if (rect.isNull()) {
+        page = std::make_shared<IconAtlasPage>();
+        rect = page->add(image);
+        atlas.pages.push_back(page);
+    }
+
+    const qint64 cacheKey = image.cacheKey();
+    auto region = std::shared_ptr<IconAtlasRegion>(new IconAtlasRegion{page, rect}, [key, cacheKey](IconAtlasRegion *region) {
+        QMutexLocker locker(&s_mutex);
+        auto itr = s_atlases.find(key);
+        if (itr != s_atlases.end()) {
+            // The atlas may have been released and have a new region for the image since.
+            auto region = itr->regions.find(cacheKey);
+            if (region != itr->regions.end() && region->expired()) {
+                itr->regions.erase(region);
+            }
+        }
+        delete region;
+    });
+    atlas.regions.insert(cacheKey, region);
+    return region;
+}
+
+void IconAtlas::release(QWindow *window)
+{
+    // Icons keep the pages they use, which create their texture again once
+    // the window is shown again. New icons are placed in new pages.
+    QMutexLocker locker(&s_mutex);
+    for (auto itr = s_atlases.begin(); itr != s_atlases.end();) {
+        if (itr.key().first != window) {
+            ++itr;
+            continue;
+        }
+
+        for (const auto &candidate : itr->pages) {
+            if (auto page = candidate.lock()) {
+                page->releaseTexture();
+            }
+        }
+        itr = s_atlases.erase(itr);
+    }
+}
@@ -0,0 +1,122 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QMutex>
+#include <QQuickWindow>
+#include <QSGTexture>
+
+#include <memory>
+#include <vector>
+
+class IconAtlasPage;
+class IconAtlasTexture;
+
+/**
+ * A part of an IconAtlasPage containing a single icon image.
+ *
+ * The region stays reserved for as long as a reference to it exists.
+ */
+struct IconAtlasRegion {
+    std::shared_ptr<IconAtlasPage> page;
+    QRect rect;
+};
+
+/**
+ * A single texture containing several icons.
+ *
+ * Pages are filled on the GUI thread while polishing items. The page keeps a
+ * single texture for its whole lifetime, into which only the parts that
+ * changed are uploaded, at most once per frame when new icons have been
+ * added.
+ */
+class IconAtlasPage
+{
+public:
+    IconAtlasPage();
+    ~IconAtlasPage();
+
+    /**
+     * Copy @p image into a free part of the page.
+     *
+     * @returns the rectangle, in pixels, that contains the image or a null
+     * rectangle if the page is full.
+     */
+    QRect add(const QImage &image);
+
+    /**
+     * @returns the texture of the page, which is the same for as long as the
+     * page exists. Images added since the last call are uploaded to it with
+     * the next frame.
+     *
+     * This should only be called from the render thread during synchronization.
+     */
+    std::shared_ptr<QSGTexture> texture(QQuickWindow *window);
+
+    /**
+     * Destroy the graphics resources of the texture of the page. The whole
+     * page is uploaded again with the next call to texture().
+     *
+     * This should only be called from the render thread.
+     */
+    void releaseTexture();
+
+private:
+    QImage m_image;
+    int m_cursorX = 0;
+    int m_shelfY = 0;
+    int m_shelfHeight = 0;
+    // The parts of m_image that were added since the last upload.
+    QList<QRect> m_dirtyRects;
+    bool m_fullUpload = true;
+    std::shared_ptr<IconAtlasTexture> m_texture;
+};
+
+/**
+ * Packs small icons into shared textures.
+ *
+ * The default scene graph atlas is shared with every other small texture in
+ * the window, so icons that are drawn next to each other are often spread
+ * over several textures and end up in separate batches. This atlas only
+ * contains icons, so icons that share a page can be drawn with a single draw
+ * call.
+ *
+ * The atlas is opt-in and enabled by setting the `KIRIGAMI_ICON_ATLAS`
+ * environment variable to 1. Only mask icons smaller than 128 device pixels
+ * are placed in the atlas.
+ *
+ * Space in a page is not reused once allocated; pages are released once
+ * nothing references any of their regions anymore.
+ */
+class IconAtlas
+{
+public:
+    static bool isEnabled();
+    static bool accepts(const QImage &image);
+
+    /**
+     * @returns a region for @p image in one of the pages for @p window.
+     *
+     * Identical images share the same region.
+     */
+    static std::shared_ptr<IconAtlasRegion> region(QQuickWindow *window, const QImage &image);
+
+private:
+    static void release(QWindow *window);
+
+    struct WindowAtlas {
+        std::vector<std::weak_ptr<IconAtlasPage>> pages;
+        QHash<qint64, std::weak_ptr<IconAtlasRegion>> regions;
+    };
+
+    // Used from the GUI thread, and from the render threads when releasing.
+    inline static QMutex s_mutex;
+    inline static QHash<QPair<QQuickWindow *, qreal>, WindowAtlas> s_atlases;
+};
@@ -0,0 +1,104 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "iconmaskmaterial.h"
+
+QSGMaterialType IconMaskMaterial::staticType;
+
+IconMaskMaterial::IconMaskMaterial()
+{
+    setFlag(QSGMaterial::Blending, true);
+}
+
+QSGMaterialShader *IconMaskMaterial::createShader(QSGRendererInterface::RenderMode) const
+{
+    return new IconMaskShader{};
+}
+
+QSGMaterialType *IconMaskMaterial::type() const
+{
+    return &staticType;
+}
+
+int IconMaskMaterial::compare(const QSGMaterial *other) const
+{
+    auto material = static_cast<const IconMaskMaterial *>(other);
+
+    // Textures are compared by what they sample from, like the scene graph
+    // does, so that icons in the same atlas texture are batched together.
+    const qint64 key = texture ? texture->comparisonKey() : 0;
+    const qint64 otherKey = material->texture ? material->texture->comparisonKey() : 0;
+    if (otherKey != key) {
+        return otherKey < key ? 1 : -1;
+    }
+
+    if (material->filtering != filtering) {
+        return material->filtering < filtering ? 1 : -1;
+    }
+
+    if (material->color != color) {
+        return material->color.rgba() < color.rgba() ? 1 : -1;
+    }
+
+    return 0;
+}
+
+IconMaskShader::IconMaskShader()
+{
+    const auto shaderRoot = QStringLiteral(":/qt/qml/org/kde/kirigami/primitives/shaders/");
+    setShaderFileName(QSGMaterialShader::VertexStage, shaderRoot + QStringLiteral("iconmask.vert.qsb"));
+    setShaderFileName(QSGMaterialShader::FragmentStage, shaderRoot + QStringLiteral("iconmask.frag.qsb"));
+}
+
+bool IconMaskShader::updateUniformData(RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial)
+{
+    bool changed = false;
+    QByteArray *buf = state.uniformData();
+    Q_ASSERT(buf->size() >= 96);
+
+    if (state.isMatrixDirty()) {
+        const QMatrix4x4 m = state.combinedMatrix();
+        memcpy(buf->data(), m.constData(), 64);
+        changed = true;
+    }
+
+    if (state.isOpacityDirty()) {
+        const float opacity = state.opacity();
+        memcpy(buf->data() + 64, &opacity, 4);
+        changed = true;
+    }
+
+    if (!oldMaterial || newMaterial->compare(oldMaterial) != 0) {
+        const auto material = static_cast<IconMaskMaterial *>(newMaterial);
+        // Premultiplied, to match the rest of the scene graph.
+        float c[4];
+        material->color.getRgbF(&c[0], &c[1], &c[2], &c[3]);
+        c[0] *= c[3];
+        c[1] *= c[3];
+        c[2] *= c[3];
+        memcpy(buf->data() + 80, c, 16);
+        changed = true;
+    }
+
+    return changed;
+}
+
+void IconMaskShader::updateSampledImage(QSGMaterialShader::RenderState &state,
+                                        int binding,
+                                        QSGTexture **texture,
+                                        QSGMaterial *newMaterial,
+                                        QSGMaterial *oldMaterial)
+{
+    Q_UNUSED(state);
+    Q_UNUSED(oldMaterial);
+    if (binding == 1) {
+        auto material = static_cast<IconMaskMaterial *>(newMaterial);
+        if (material->texture) {
+            material->texture->setFiltering(material->filtering);
+        }
+        *texture = material->texture;
+    }
+}
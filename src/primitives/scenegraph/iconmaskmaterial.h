@@ -0,0 +1,45 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QColor>
+#include <QSGMaterial>
+#include <QSGMaterialShader>
+#include <QSGTexture>
+
+/**
+ * A material rendering a texture as a mask filled with a single color.
+ *
+ * Only the alpha channel of the texture is used, the color is applied in the
+ * shader. This means changing the color only changes a uniform rather than
+ * requiring the image to be recolored and uploaded again.
+ */
+class IconMaskMaterial : public QSGMaterial
+{
+public:
+    IconMaskMaterial();
+
+    QSGMaterialShader *createShader(QSGRendererInterface::RenderMode) const override;
+    QSGMaterialType *type() const override;
+    int compare(const QSGMaterial *other) const override;
+
+    QSGTexture *texture = nullptr;
+    QColor color = Qt::black;
+    QSGTexture::Filtering filtering = QSGTexture::Linear;
+
+    static QSGMaterialType staticType;
+};
+
+class IconMaskShader : public QSGMaterialShader
+{
+public:
+    IconMaskShader();
+
+    bool updateUniformData(QSGMaterialShader::RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial) override;
+    void
+    updateSampledImage(QSGMaterialShader::RenderState &state, int binding, QSGTexture **texture, QSGMaterial *newMaterial, QSGMaterial *oldMaterial) override;
+};
@@ -8,41 +8,145 @@
 
 #include "managedtexturenode.h"
 
+#include "iconmaskmaterial.h"
+#include "windowresources.h"
+
 ManagedTextureNode::ManagedTextureNode()
+    : m_defaultMaterial(material())
+    , m_defaultOpaqueMaterial(opaqueMaterial())
+{
+}
+
+ManagedTextureNode::~ManagedTextureNode()
 {
+    // Make sure the node does not refer to the mask material once it's gone.
+    setMaterial(m_defaultMaterial);
+    setOpaqueMaterial(m_defaultOpaqueMaterial);
 }
 
 void ManagedTextureNode::setTexture(std::shared_ptr<QSGTexture> texture)
 {
     m_texture = texture;
     QSGSimpleTextureNode::setTexture(texture.get());
+
+    if (m_maskMaterial) {
+        m_maskMaterial->texture = texture.get();
+        markDirty(QSGNode::DirtyMaterial);
+    }
+}
+
+void ManagedTextureNode::setMaskColor(const QColor &color)
+{
+    if (!color.isValid()) {
+        if (m_maskMaterial) {
+            setMaterial(m_defaultMaterial);
+            setOpaqueMaterial(m_defaultOpaqueMaterial);
+            m_maskMaterial.reset();
+            markDirty(QSGNode::DirtyMaterial);
+        }
+        return;
+    }
+
+    if (!m_maskMaterial) {
+        m_maskMaterial = std::make_unique<IconMaskMaterial>();
+        m_maskMaterial->texture = m_texture.get();
+        m_maskMaterial->filtering = filtering();
+        setMaterial(m_maskMaterial.get());
+        setOpaqueMaterial(nullptr);
+    } else if (m_maskMaterial->color == color) {
+        return;
+    }
+
+    m_maskMaterial->color = color;
+    markDirty(QSGNode::DirtyMaterial);
+}
+
+void ManagedTextureNode::setMaskedFiltering(QSGTexture::Filtering filtering)
+{
+    setFiltering(filtering);
+
+    if (m_maskMaterial && m_maskMaterial->filtering != filtering) {
+        m_maskMaterial->filtering = filtering;
+        markDirty(QSGNode::DirtyMaterial);
+    }
 }
 
 ImageTexturesCache::ImageTexturesCache()
     : d(new ImageTexturesCachePrivate)
 {
+    // Textures that are still alive keep their shard, so forgetting it is enough.
+    d->releaseFunction = WindowResources::addReleaseFunction([d = d.get()](QWindow *window) {
+        QWriteLocker locker(&d->shardsLock);
+        d->shards.remove(window);
+    });
 }
 
 ImageTexturesCache::~ImageTexturesCache()
 {
+    WindowResources::removeReleaseFunction(d->releaseFunction);
+}
+
+std::shared_ptr<TexturesCacheShard> ImageTexturesCachePrivate::shard(QWindow *window)
+{
+    {
+        QReadLocker locker(&shardsLock);
+        if (auto shard = shards.value(window)) {
+            return shard;
+        }
+    }
+
+    std::shared_ptr<TexturesCacheShard> shard;
+    {
+        QWriteLocker locker(&shardsLock);
+        auto &existing = shards[window];
+        if (!existing) {
+            existing = std::make_shared<TexturesCacheShard>();
+        }
+        shard = existing;
+    }
+
+    WindowResources::watch(qobject_cast<QQuickWindow *>(window));
+    return shard;
 }
 
 std::shared_ptr<QSGTexture> ImageTexturesCache::loadTexture(QQuickWindow *window, const QImage &image, QQuickWindow::CreateTextureOptions options)
 {
     qint64 id = image.cacheKey();
-    std::shared_ptr<QSGTexture> texture = d->cache.value(id).value(window).lock();
-
-    if (!texture) {
-        auto cleanAndDelete = [this, window, id](QSGTexture *texture) {
-            QHash<QWindow *, std::weak_ptr<QSGTexture>> &textures = (d->cache)[id];
-            textures.remove(window);
-            if (textures.isEmpty()) {
-                d->cache.remove(id);
+    const std::shared_ptr<TexturesCacheShard> shard = d->shard(window);
+
+    std::shared_ptr<QSGTexture> texture;
+    {
+        QMutexLocker locker(&shard->mutex);
+        texture = shard->textures.value(id).texture.lock();
+    }
+
+    if (texture) {
+        ++d->hits;
+    } else {
+        ++d->misses;
+
+        const qsizetype bytes = qsizetype(image.width()) * image.height() * 4;
+        // The deleter keeps the shard alive rather than referring to the
+        // cache, as the last texture may be released after the cache is gone.
+        auto cleanAndDelete = [shard, id, bytes](QSGTexture *texture) {
+            {
+                QMutexLocker locker(&shard->mutex);
+                auto itr = shard->textures.find(id);
+                // Another texture for the same image may have replaced this one.
+                if (itr != shard->textures.end() && itr->texture.expired()) {
+                    shard->textures.erase(itr);
+                }
+                --shard->count;
+                shard->bytes -= bytes;
             }
             delete texture;
         };
         texture = std::shared_ptr<QSGTexture>(window->createTextureFromImage(image, options), cleanAndDelete);
-        (d->cache)[id][window] = texture;
+
+        QMutexLocker locker(&shard->mutex);
+        shard->textures.insert(id, CachedTexture{texture, bytes});
+        ++shard->count;
+        shard->bytes += bytes;
     }
 
     // if we have a cache in an atlas but our request cannot use an atlassed texture
@@ -59,3 +163,39 @@ std::shared_ptr<QSGTexture> ImageTexturesCache::loadTexture(QQuickWindow *window
 {
     return loadTexture(window, image, {});
 }
+
+qsizetype ImageTexturesCache::count() const
+{
+    QReadLocker locker(&d->shardsLock);
+
+    qsizetype total = 0;
+    for (const auto &shard : std::as_const(d->shards)) {
+        QMutexLocker shardLocker(&shard->mutex);
+        total += shard->count;
+    }
+    return total;
+}
+
+qsizetype ImageTexturesCache::bytes(QWindow *window) const
+{
+    QReadLocker locker(&d->shardsLock);
+
+    qsizetype total = 0;
+    for (auto itr = d->shards.cbegin(); itr != d->shards.cend(); ++itr) {
+        if (!window || itr.key() == window) {
+            QMutexLocker shardLocker(&itr.value()->mutex);
+            total += itr.value()->bytes;
+        }
+    }
+    return total;
+}
+
+quint64 ImageTexturesCache::hits() const
+{
+    return d->hits;
+}
+
+quint64 ImageTexturesCache::misses() const
+{
+    return d->misses;
+}
@@ -8,29 +8,84 @@
 
 #pragma once
 #include <QImage>
+#include <QMutex>
 #include <QQuickWindow>
+#include <QReadWriteLock>
 #include <QSGSimpleTextureNode>
 #include <QSGTexture>
+#include <atomic>
 #include <memory>
 
+class IconMaskMaterial;
+
 class ManagedTextureNode : public QSGSimpleTextureNode
 {
     Q_DISABLE_COPY(ManagedTextureNode)
 public:
     ManagedTextureNode();
+    ~ManagedTextureNode() override;
 
     void setTexture(std::shared_ptr<QSGTexture> texture);
 
+    /**
+     * Render only the alpha channel of the texture, filled with @p color.
+     *
+     * This tints the texture in the shader, so that changing the color does
+     * not require a new texture. Passing an invalid color restores normal
+     * rendering of the texture.
+     */
+    void setMaskColor(const QColor &color);
+
+    /**
+     * Set the filtering used by the texture, including when it is drawn as a mask.
+     */
+    void setMaskedFiltering(QSGTexture::Filtering filtering);
+
 private:
     std::shared_ptr<QSGTexture> m_texture;
+    std::unique_ptr<IconMaskMaterial> m_maskMaterial;
+    QSGMaterial *m_defaultMaterial = nullptr;
+    QSGMaterial *m_defaultOpaqueMaterial = nullptr;
+};
+
+struct CachedTexture {
+    std::weak_ptr<QSGTexture> texture;
+    qsizetype bytes = 0;
 };
 
-typedef QHash<qint64, QHash<QWindow *, std::weak_ptr<QSGTexture>>> TexturesCache;
+// The textures of a single window. Every window is rendered by a single
+// thread, but with the threaded render loop different windows may use
+// different threads, so each shard is locked separately.
+struct TexturesCacheShard {
+    QMutex mutex;
+    QHash<qint64, CachedTexture> textures;
+    qsizetype count = 0;
+    qsizetype bytes = 0;
+};
 
 struct ImageTexturesCachePrivate {
-    TexturesCache cache;
+    QReadWriteLock shardsLock;
+    QHash<QWindow *, std::shared_ptr<TexturesCacheShard>> shards;
+    std::atomic<quint64> hits{0};
+    std::atomic<quint64> misses{0};
+    int releaseFunction = 0;
+
+    std::shared_ptr<TexturesCacheShard> shard(QWindow *window);
 };
 
+/**
+ * Shares textures between items showing the same image in a window.
+ *
+ * Textures are only referenced weakly, and are destroyed when the last node
+ * using them goes away, so the cache itself never keeps any texture alive.
+ *
+ * The cache can be used from any thread. Finding the textures of a window only
+ * takes a shared lock and each window has a lock of its own, so the render
+ * threads of different windows do not wait for each other.
+ *
+ * The statistics are an estimate of the memory used by textures that are
+ * currently alive, assuming four bytes per pixel.
+ */
 class ImageTexturesCache
 {
 public:
@@ -47,6 +102,23 @@ public:
 
     std::shared_ptr<QSGTexture> loadTexture(QQuickWindow *window, const QImage &image);
 
+    /**
+     * The number of textures currently alive, for all windows.
+     */
+    qsizetype count() const;
+
+    /**
+     * The estimated size of the textures currently alive for @p window, in bytes,
+     * or for all windows if @p window is null.
+     */
+    qsizetype bytes(QWindow *window = nullptr) const;
+
+    /**
+     * The number of times a texture was reused or had to be created.
+     */
+    quint64 hits() const;
+    quint64 misses() const;
+
 private:
     std::unique_ptr<ImageTexturesCachePrivate> d;
 };
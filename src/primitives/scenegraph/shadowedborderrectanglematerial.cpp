@@ -17,11 +17,20 @@ ShadowedBorderRectangleMaterial::ShadowedBorderRectangleMaterial()
 
 QSGMaterialShader *ShadowedBorderRectangleMaterial::createShader(QSGRendererInterface::RenderMode) const
 {
-    return new ShadowedBorderRectangleShader{shaderType};
+    return new ShadowedBorderRectangleShader{shaderType, variant};
 }
 
 QSGMaterialType *ShadowedBorderRectangleMaterial::type() const
 {
+    static QSGMaterialType lowPowerType;
+    static QSGMaterialType variantTypes[3];
+
+    if (shaderType == ShaderType::LowPower) {
+        return &lowPowerType;
+    }
+    if (variant != Variant::Full) {
+        return &variantTypes[int(variant) - 1];
+    }
     return &staticType;
 }
 
@@ -40,10 +49,10 @@ int ShadowedBorderRectangleMaterial::compare(const QSGMaterial *other) const
     return QSGMaterial::compare(other);
 }
 
-ShadowedBorderRectangleShader::ShadowedBorderRectangleShader(ShadowedRectangleMaterial::ShaderType shaderType)
-    : ShadowedRectangleShader(shaderType)
+ShadowedBorderRectangleShader::ShadowedBorderRectangleShader(ShadowedRectangleMaterial::ShaderType shaderType, ShadowedRectangleMaterial::Variant variant)
+    : ShadowedRectangleShader(shaderType, variant)
 {
-    setShader(shaderType, QStringLiteral("shadowedborderrectangle"));
+    setShader(shaderType, QStringLiteral("shadowedborderrectangle"), variant);
 }
 
 bool ShadowedBorderRectangleShader::updateUniformData(QSGMaterialShader::RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial)
@@ -32,7 +32,8 @@ public:
 class ShadowedBorderRectangleShader : public ShadowedRectangleShader
 {
 public:
-    ShadowedBorderRectangleShader(ShadowedRectangleMaterial::ShaderType shaderType);
+    ShadowedBorderRectangleShader(ShadowedRectangleMaterial::ShaderType shaderType,
+                                  ShadowedRectangleMaterial::Variant variant = ShadowedRectangleMaterial::Variant::Full);
 
     bool updateUniformData(QSGMaterialShader::RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial) override;
 };
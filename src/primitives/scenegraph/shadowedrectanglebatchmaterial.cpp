@@ -0,0 +1,80 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "shadowedrectanglebatchmaterial.h"
+
+QSGMaterialType ShadowedRectangleBatchMaterial::staticType;
+
+bool ShadowedRectangleBatchMaterial::isEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("KIRIGAMI_BATCHED_SHADOWED_RECTANGLES") == 1;
+    return enabled;
+}
+
+const QSGGeometry::AttributeSet &ShadowedRectangleBatchMaterial::attributes()
+{
+    static const QSGGeometry::Attribute data[] = {
+        QSGGeometry::Attribute::createWithAttributeType(0, 2, QSGGeometry::FloatType, QSGGeometry::PositionAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(1, 2, QSGGeometry::FloatType, QSGGeometry::TexCoordAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(2, 4, QSGGeometry::FloatType, QSGGeometry::UnknownAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(3, 4, QSGGeometry::FloatType, QSGGeometry::UnknownAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(4, 2, QSGGeometry::FloatType, QSGGeometry::UnknownAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(5, 4, QSGGeometry::UnsignedByteType, QSGGeometry::ColorAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(6, 4, QSGGeometry::UnsignedByteType, QSGGeometry::ColorAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(7, 4, QSGGeometry::UnsignedByteType, QSGGeometry::ColorAttribute),
+    };
+    static const QSGGeometry::AttributeSet attributes = {8, sizeof(Vertex), data};
+    return attributes;
+}
+
+QSGMaterialShader *ShadowedRectangleBatchMaterial::createShader(QSGRendererInterface::RenderMode) const
+{
+    return new ShadowedRectangleBatchShader{};
+}
+
+QSGMaterialType *ShadowedRectangleBatchMaterial::type() const
+{
+    return &staticType;
+}
+
+int ShadowedRectangleBatchMaterial::compare(const QSGMaterial *other) const
+{
+    // All parameters are part of the geometry, so any two instances can be
+    // rendered with the same state.
+    Q_UNUSED(other)
+    return 0;
+}
+
+ShadowedRectangleBatchShader::ShadowedRectangleBatchShader()
+{
+    const auto shaderRoot = QStringLiteral(":/qt/qml/org/kde/kirigami/primitives/shaders/");
+    setShaderFileName(QSGMaterialShader::VertexStage, shaderRoot + QStringLiteral("shadowedrectanglebatch.vert.qsb"));
+    setShaderFileName(QSGMaterialShader::FragmentStage, shaderRoot + QStringLiteral("shadowedrectanglebatch.frag.qsb"));
+}
+
+bool ShadowedRectangleBatchShader::updateUniformData(RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial)
+{
+    Q_UNUSED(newMaterial)
+    Q_UNUSED(oldMaterial)
+
+    bool changed = false;
+    QByteArray *buf = state.uniformData();
+    Q_ASSERT(buf->size() >= 68);
+
+    if (state.isMatrixDirty()) {
+        const QMatrix4x4 m = state.combinedMatrix();
+        memcpy(buf->data(), m.constData(), 64);
+        changed = true;
+    }
+
+    if (state.isOpacityDirty()) {
+        const float opacity = state.opacity();
+        memcpy(buf->data() + 64, &opacity, 4);
+        changed = true;
+    }
+
+    return changed;
+}
@@ -0,0 +1,63 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QSGGeometry>
+
+#include "shadowedborderrectanglematerial.h"
+
+/**
+ * A material rendering a shadowed rectangle that can be batched.
+ *
+ * Unlike ShadowedRectangleMaterial and ShadowedBorderRectangleMaterial, which
+ * pass all parameters as uniforms, this material expects them to be provided
+ * as vertex attributes, see Vertex. This makes all instances of this material
+ * compare equal, so the scene graph renderer can merge many rectangles into a
+ * single draw call.
+ *
+ * The properties inherited from ShadowedBorderRectangleMaterial are not used
+ * for rendering but only store the values that ShadowedRectangleNode writes
+ * to the vertices. A border width of zero disables the border.
+ *
+ * Batching is opt-in and enabled by setting the
+ * `KIRIGAMI_BATCHED_SHADOWED_RECTANGLES` environment variable to 1.
+ */
+class ShadowedRectangleBatchMaterial : public ShadowedBorderRectangleMaterial
+{
+public:
+    struct Vertex {
+        float x;
+        float y;
+        float u;
+        float v;
+        float aspect[2];
+        float size;
+        float borderWidth;
+        float radius[4];
+        float offset[2];
+        uchar color[4];
+        uchar shadowColor[4];
+        uchar borderColor[4];
+    };
+
+    static bool isEnabled();
+    static const QSGGeometry::AttributeSet &attributes();
+
+    QSGMaterialShader *createShader(QSGRendererInterface::RenderMode) const override;
+    QSGMaterialType *type() const override;
+    int compare(const QSGMaterial *other) const override;
+
+    static QSGMaterialType staticType;
+};
+
+class ShadowedRectangleBatchShader : public QSGMaterialShader
+{
+public:
+    ShadowedRectangleBatchShader();
+
+    bool updateUniformData(QSGMaterialShader::RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial) override;
+};
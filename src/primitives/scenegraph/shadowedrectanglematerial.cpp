@@ -17,14 +17,33 @@ ShadowedRectangleMaterial::ShadowedRectangleMaterial()
 
 QSGMaterialShader *ShadowedRectangleMaterial::createShader(QSGRendererInterface::RenderMode) const
 {
-    return new ShadowedRectangleShader{shaderType};
+    return new ShadowedRectangleShader{shaderType, variant};
 }
 
 QSGMaterialType *ShadowedRectangleMaterial::type() const
 {
+    // Shaders are created once per material type, so every shader needs a
+    // type of its own.
+    static QSGMaterialType lowPowerType;
+    static QSGMaterialType variantTypes[3];
+
+    if (shaderType == ShaderType::LowPower) {
+        return &lowPowerType;
+    }
+    if (variant != Variant::Full) {
+        return &variantTypes[int(variant) - 1];
+    }
     return &staticType;
 }
 
+ShadowedRectangleMaterial::Variant ShadowedRectangleMaterial::variantFor(bool hasShadow, bool uniformRadius)
+{
+    if (hasShadow) {
+        return uniformRadius ? Variant::UniformRadius : Variant::Full;
+    }
+    return uniformRadius ? Variant::NoShadowUniformRadius : Variant::NoShadow;
+}
+
 int ShadowedRectangleMaterial::compare(const QSGMaterial *other) const
 {
     auto material = static_cast<const ShadowedRectangleMaterial *>(other);
@@ -41,9 +60,9 @@ int ShadowedRectangleMaterial::compare(const QSGMaterial *other) const
     return QSGMaterial::compare(other);
 }
 
-ShadowedRectangleShader::ShadowedRectangleShader(ShadowedRectangleMaterial::ShaderType shaderType)
+ShadowedRectangleShader::ShadowedRectangleShader(ShadowedRectangleMaterial::ShaderType shaderType, ShadowedRectangleMaterial::Variant variant)
 {
-    setShader(shaderType, QStringLiteral("shadowedrectangle"));
+    setShader(shaderType, QStringLiteral("shadowedrectangle"), variant);
 }
 
 bool ShadowedRectangleShader::updateUniformData(RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial)
@@ -81,7 +100,9 @@ bool ShadowedRectangleShader::updateUniformData(RenderState &state, QSGMaterial
     return changed;
 }
 
-void ShadowedRectangleShader::setShader(ShadowedRectangleMaterial::ShaderType shaderType, const QString &shader)
+void ShadowedRectangleShader::setShader(ShadowedRectangleMaterial::ShaderType shaderType,
+                                        const QString &shader,
+                                        ShadowedRectangleMaterial::Variant variant)
 {
     const auto shaderRoot = QStringLiteral(":/qt/qml/org/kde/kirigami/primitives/shaders/");
 
@@ -90,6 +111,20 @@ void ShadowedRectangleShader::setShader(ShadowedRectangleMaterial::ShaderType sh
     auto shaderFile = shader;
     if (shaderType == ShadowedRectangleMaterial::ShaderType::LowPower) {
         shaderFile += QStringLiteral("_lowpower");
+    } else if (shaderType == ShadowedRectangleMaterial::ShaderType::Standard) {
+        switch (variant) {
+        case ShadowedRectangleMaterial::Variant::Full:
+            break;
+        case ShadowedRectangleMaterial::Variant::NoShadow:
+            shaderFile += QStringLiteral("_noshadow");
+            break;
+        case ShadowedRectangleMaterial::Variant::UniformRadius:
+            shaderFile += QStringLiteral("_uniformradius");
+            break;
+        case ShadowedRectangleMaterial::Variant::NoShadowUniformRadius:
+            shaderFile += QStringLiteral("_noshadow_uniformradius");
+            break;
+        }
     }
     setShaderFileName(QSGMaterialShader::FragmentStage, shaderRoot + shaderFile + QStringLiteral(".frag.qsb"));
 }
@@ -22,8 +22,26 @@ public:
     enum class ShaderType {
         Standard,
         LowPower,
+        // The standard shader, with parameters stored in the geometry so it
+        // can be batched. See ShadowedRectangleBatchMaterial.
+        Batched,
     };
 
+    /**
+     * Specializations of the standard shader, which leave out the parts of
+     * the shader that would not change the result.
+     */
+    enum class Variant {
+        Full,
+        // The shadow is not drawn, as its size is 0.
+        NoShadow,
+        // All corners use the same radius.
+        UniformRadius,
+        NoShadowUniformRadius,
+    };
+
+    static Variant variantFor(bool hasShadow, bool uniformRadius);
+
     ShadowedRectangleMaterial();
 
     QSGMaterialShader *createShader(QSGRendererInterface::RenderMode) const override;
@@ -37,6 +55,8 @@ public:
     QColor shadowColor = Qt::black;
     QVector2D offset;
     ShaderType shaderType = ShaderType::Standard;
+    // Only used by the standard shader type.
+    Variant variant = Variant::Full;
 
     static QSGMaterialType staticType;
 };
@@ -44,10 +64,13 @@ public:
 class ShadowedRectangleShader : public QSGMaterialShader
 {
 public:
-    ShadowedRectangleShader(ShadowedRectangleMaterial::ShaderType shaderType);
+    ShadowedRectangleShader(ShadowedRectangleMaterial::ShaderType shaderType,
+                            ShadowedRectangleMaterial::Variant variant = ShadowedRectangleMaterial::Variant::Full);
 
     bool updateUniformData(QSGMaterialShader::RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial) override;
 
 protected:
-    void setShader(ShadowedRectangleMaterial::ShaderType shaderType, const QString &shader);
+    void setShader(ShadowedRectangleMaterial::ShaderType shaderType,
+                   const QString &shader,
+                   ShadowedRectangleMaterial::Variant variant = ShadowedRectangleMaterial::Variant::Full);
 };
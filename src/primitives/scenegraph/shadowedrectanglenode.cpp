@@ -6,6 +6,16 @@
 
 #include "shadowedrectanglenode.h"
 #include "shadowedborderrectanglematerial.h"
+#include "shadowedrectanglebatchmaterial.h"
+
+#include <QSGRectangleNode>
+
+#include <algorithm>
+#include <array>
+
+// Below this size, the ring covers most of the rectangle anyway so drawing the
+// interior separately is not worth the extra node.
+static constexpr qreal minimumInteriorSize = 32.0;
 
 QColor premultiply(const QColor &color)
 {
@@ -30,27 +40,67 @@ void ShadowedRectangleNode::setBorderEnabled(bool enabled)
     // borderWidth is increased to something where the border should be visible,
     // switch to the with-border material. Otherwise use the no-border version.
 
-    if (enabled) {
-        if (!m_material || m_material->type() == borderlessMaterialType()) {
-            auto newMaterial = createBorderMaterial();
-            newMaterial->shaderType = m_shaderType;
-            setMaterial(newMaterial);
-            m_material = newMaterial;
-            m_rect = QRectF{};
-            markDirty(QSGNode::DirtyMaterial);
-        }
-    } else {
-        if (!m_material || m_material->type() == borderMaterialType()) {
-            auto newMaterial = createBorderlessMaterial();
-            newMaterial->shaderType = m_shaderType;
-            setMaterial(newMaterial);
-            m_material = newMaterial;
-            m_rect = QRectF{};
+    m_borderEnabled = enabled;
+
+    // The batched material handles both cases, see updateGeometry().
+    if (m_shaderType == ShadowedRectangleMaterial::ShaderType::Batched) {
+        if (!m_material) {
+            m_material = new ShadowedRectangleBatchMaterial{};
+            setMaterial(m_material);
             markDirty(QSGNode::DirtyMaterial);
         }
+        return;
+    }
+
+    if (!m_material || enabled != m_hasBorderMaterial) {
+        replaceMaterial(enabled ? createBorderMaterial() : createBorderlessMaterial(), enabled);
+        m_rect = QRectF{};
     }
 }
 
+void ShadowedRectangleNode::replaceMaterial(ShadowedRectangleMaterial *material, bool border)
+{
+    material->shaderType = m_shaderType;
+    QSGGeometryNode::setMaterial(material);
+    m_material = material;
+    m_hasBorderMaterial = border;
+    markDirty(QSGNode::DirtyMaterial);
+}
+
+void ShadowedRectangleNode::updateVariant()
+{
+    if (m_shaderType != ShadowedRectangleMaterial::ShaderType::Standard || !hasShaderVariants()) {
+        return;
+    }
+
+    const auto &radius = m_material->radius;
+    const bool uniformRadius = radius.x() == radius.y() && radius.x() == radius.z() && radius.x() == radius.w();
+    const auto variant = ShadowedRectangleMaterial::variantFor(m_material->size > 0.0f, uniformRadius);
+    if (variant == m_material->variant) {
+        return;
+    }
+
+    // Each variant has a material type of its own, so switch to a new
+    // material rather than changing the type of the current one.
+    auto oldMaterial = m_material;
+    auto newMaterial = m_hasBorderMaterial ? createBorderMaterial() : createBorderlessMaterial();
+    newMaterial->aspect = oldMaterial->aspect;
+    newMaterial->size = oldMaterial->size;
+    newMaterial->radius = oldMaterial->radius;
+    newMaterial->color = oldMaterial->color;
+    newMaterial->shadowColor = oldMaterial->shadowColor;
+    newMaterial->offset = oldMaterial->offset;
+    newMaterial->variant = variant;
+    if (m_hasBorderMaterial) {
+        auto oldBorderMaterial = static_cast<ShadowedBorderRectangleMaterial *>(oldMaterial);
+        auto newBorderMaterial = static_cast<ShadowedBorderRectangleMaterial *>(newMaterial);
+        newBorderMaterial->borderWidth = oldBorderMaterial->borderWidth;
+        newBorderMaterial->borderColor = oldBorderMaterial->borderColor;
+    }
+    // Deletes the old material, as the node owns it.
+    replaceMaterial(newMaterial, m_hasBorderMaterial);
+}
+
 void ShadowedRectangleNode::setRect(const QRectF &rect)
 {
     if (rect == m_rect) {
@@ -132,7 +182,7 @@ void ShadowedRectangleNode::setOffset(const QVector2D &offset)
 
 void ShadowedRectangleNode::setBorderWidth(qreal width)
 {
-    if (m_material->type() != borderMaterialType()) {
+    if (!m_hasBorderMaterial && m_material->type() != &ShadowedRectangleBatchMaterial::staticType) {
         return;
     }
 
@@ -149,7 +199,7 @@ void ShadowedRectangleNode::setBorderWidth(qreal width)
 
 void ShadowedRectangleNode::setBorderColor(const QColor &color)
 {
-    if (m_material->type() != borderMaterialType()) {
+    if (!m_hasBorderMaterial && m_material->type() != &ShadowedRectangleBatchMaterial::staticType) {
         return;
     }
 
@@ -163,13 +213,44 @@ void ShadowedRectangleNode::setBorderColor(const QColor &color)
 
 void ShadowedRectangleNode::setShaderType(ShadowedRectangleMaterial::ShaderType type)
 {
+    if (type == ShadowedRectangleMaterial::ShaderType::Batched && m_shaderType != type) {
+        // Indexed triangles rather than a strip, so that the renderer can
+        // merge the geometry of several nodes.
+        m_geometry = new QSGGeometry{ShadowedRectangleBatchMaterial::attributes(), 4, 6};
+        m_geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        const quint16 indices[] = {0, 1, 2, 1, 3, 2};
+        memcpy(m_geometry->indexDataAsUShort(), indices, sizeof(indices));
+        setGeometry(m_geometry);
+    }
+
     m_shaderType = type;
 }
 
+ShadowedRectangleMaterial::ShaderType ShadowedRectangleNode::shaderType() const
+{
+    return m_shaderType;
+}
+
+void ShadowedRectangleNode::setInteriorNode(QSGRectangleNode *node)
+{
+    if (m_interiorNode) {
+        removeChildNode(m_interiorNode);
+        delete m_interiorNode;
+    }
+
+    m_interiorNode = node;
+
+    if (m_interiorNode) {
+        appendChildNode(m_interiorNode);
+    }
+}
+
 void ShadowedRectangleNode::updateGeometry()
 {
+    updateVariant();
+
     auto rect = m_rect;
-    if (m_shaderType == ShadowedRectangleMaterial::ShaderType::Standard) {
+    if (m_shaderType != ShadowedRectangleMaterial::ShaderType::LowPower) {
         rect = rect.adjusted(-m_size * m_aspect.x(), //
                              -m_size * m_aspect.y(),
                              m_size * m_aspect.x(),
@@ -182,10 +263,124 @@ void ShadowedRectangleNode::updateGeometry()
                              offsetLength * m_aspect.y());
     }
 
-    QSGGeometry::updateTexturedRectGeometry(m_geometry, rect, QRectF{0.0, 0.0, 1.0, 1.0});
+    if (m_shaderType == ShadowedRectangleMaterial::ShaderType::Batched) {
+        updateBatchedGeometry(rect);
+        markDirty(QSGNode::DirtyGeometry);
+        return;
+    }
+
+    const auto interior = interiorRect();
+    if (m_interiorNode) {
+        m_interiorNode->setRect(interior);
+        m_interiorNode->setColor(m_material->color);
+    }
+
+    if (interior.isEmpty()) {
+        if (m_geometry->indexCount() != 0) {
+            m_geometry->allocate(4);
+            m_geometry->setDrawingMode(QSGGeometry::DrawTriangleStrip);
+        }
+        QSGGeometry::updateTexturedRectGeometry(m_geometry, rect, QRectF{0.0, 0.0, 1.0, 1.0});
+    } else {
+        updateRingGeometry(rect, interior);
+    }
     markDirty(QSGNode::DirtyGeometry);
 }
 
+QRectF ShadowedRectangleNode::interiorRect() const
+{
+    // Color is premultiplied, so anything not fully opaque would let the
+    // shadow below shine through.
+    if (!m_interiorNode || m_material->color.alpha() != 255) {
+        return QRectF{};
+    }
+
+    const qreal radius = std::max({m_radius.x(), m_radius.y(), m_radius.z(), m_radius.w()});
+    const qreal border = m_borderEnabled ? m_borderWidth : 0.0;
+    // Keep an extra pixel for the antialiased edge.
+    const qreal inset = radius + border + 1.0;
+
+    const auto interior = m_rect.adjusted(inset, inset, -inset, -inset);
+    if (interior.width() < minimumInteriorSize || interior.height() < minimumInteriorSize) {
+        return QRectF{};
+    }
+    return interior;
+}
+
+void ShadowedRectangleNode::updateRingGeometry(const QRectF &rect, const QRectF &interior)
+{
+    if (m_geometry->indexCount() != 24) {
+        m_geometry->allocate(8, 24);
+        m_geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+
+        // Two triangles for each side, between the outer corners 0 to 3 and
+        // the inner corners 4 to 7.
+        auto indices = m_geometry->indexDataAsUShort();
+        for (quint16 side = 0; side < 4; ++side) {
+            const quint16 next = (side + 1) % 4;
+            const quint16 sideIndices[] = {side, next, quint16(next + 4), side, quint16(next + 4), quint16(side + 4)};
+            memcpy(indices + side * 6, sideIndices, sizeof(sideIndices));
+        }
+    }
+
+    const std::array<QPointF, 8> points = {
+        rect.topLeft(),
+        rect.topRight(),
+        rect.bottomRight(),
+        rect.bottomLeft(),
+        interior.topLeft(),
+        interior.topRight(),
+        interior.bottomRight(),
+        interior.bottomLeft(),
+    };
+
+    auto vertices = m_geometry->vertexDataAsTexturedPoint2D();
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const auto &point = points[i];
+        vertices[i].set(point.x(), point.y(), (point.x() - rect.x()) / rect.width(), (point.y() - rect.y()) / rect.height());
+    }
+}
+
+static void storeColor(uchar *target, const QColor &color)
+{
+    target[0] = color.red();
+    target[1] = color.green();
+    target[2] = color.blue();
+    target[3] = color.alpha();
+}
+
+void ShadowedRectangleNode::updateBatchedGeometry(const QRectF &rect)
+{
+    auto material = static_cast<ShadowedRectangleBatchMaterial *>(m_material);
+
+    ShadowedRectangleBatchMaterial::Vertex vertex;
+    vertex.aspect[0] = material->aspect.x();
+    vertex.aspect[1] = material->aspect.y();
+    vertex.size = material->size;
+    vertex.borderWidth = m_borderEnabled ? material->borderWidth : 0.0f;
+    vertex.radius[0] = material->radius.x();
+    vertex.radius[1] = material->radius.y();
+    vertex.radius[2] = material->radius.z();
+    vertex.radius[3] = material->radius.w();
+    vertex.offset[0] = material->offset.x();
+    vertex.offset[1] = material->offset.y();
+    storeColor(vertex.color, material->color);
+    storeColor(vertex.shadowColor, material->shadowColor);
+    storeColor(vertex.borderColor, material->borderColor);
+
+    const std::array<QPointF, 4> corners = {rect.topLeft(), rect.topRight(), rect.bottomLeft(), rect.bottomRight()};
+    const std::array<QPointF, 4> uvs = {QPointF{0.0, 0.0}, QPointF{1.0, 0.0}, QPointF{0.0, 1.0}, QPointF{1.0, 1.0}};
+
+    auto vertices = static_cast<ShadowedRectangleBatchMaterial::Vertex *>(m_geometry->vertexData());
+    for (std::size_t i = 0; i < corners.size(); ++i) {
+        vertex.x = corners[i].x();
+        vertex.y = corners[i].y();
+        vertex.u = uvs[i].x();
+        vertex.v = uvs[i].y();
+        vertices[i] = vertex;
+    }
+}
+
 ShadowedRectangleMaterial *ShadowedRectangleNode::createBorderlessMaterial()
 {
     return new ShadowedRectangleMaterial{};
@@ -196,12 +391,7 @@ ShadowedBorderRectangleMaterial *ShadowedRectangleNode::createBorderMaterial()
     return new ShadowedBorderRectangleMaterial{};
 }
 
-QSGMaterialType *ShadowedRectangleNode::borderlessMaterialType()
-{
-    return &ShadowedRectangleMaterial::staticType;
-}
-
-QSGMaterialType *ShadowedRectangleNode::borderMaterialType()
+bool ShadowedRectangleNode::hasShaderVariants() const
 {
-    return &ShadowedBorderRectangleMaterial::staticType;
+    return true;
 }
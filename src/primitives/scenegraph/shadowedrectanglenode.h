@@ -13,7 +13,7 @@
 
 #include "shadowedrectanglematerial.h"
 
-struct QSGMaterialType;
+class QSGRectangleNode;
 class ShadowedBorderRectangleMaterial;
 
 /**
@@ -49,6 +49,21 @@ public:
     void setBorderWidth(qreal width);
     void setBorderColor(const QColor &color);
     void setShaderType(ShadowedRectangleMaterial::ShaderType type);
+    ShadowedRectangleMaterial::ShaderType shaderType() const;
+
+    /**
+     * Set a node used to draw the interior of the rectangle.
+     *
+     * When the rectangle's color is opaque, its interior looks the same no
+     * matter the shadow or border. If an interior node is set, the distance
+     * field shader is then only used for the ring containing the shadow,
+     * border and rounded corners, while the interior is drawn by @p node,
+     * which is much cheaper to render for large rectangles.
+     *
+     * The node becomes a child of this node. This is not supported for the
+     * batched shader type.
+     */
+    void setInteriorNode(QSGRectangleNode *node);
 
     /**
      * Update the geometry for this node.
@@ -61,14 +76,25 @@ public:
 protected:
     virtual ShadowedRectangleMaterial *createBorderlessMaterial();
     virtual ShadowedBorderRectangleMaterial *createBorderMaterial();
-    virtual QSGMaterialType *borderMaterialType();
-    virtual QSGMaterialType *borderlessMaterialType();
+    /**
+     * Whether the materials support the specialized variants of the standard
+     * shader type. See ShadowedRectangleMaterial::Variant.
+     */
+    virtual bool hasShaderVariants() const;
 
     QSGGeometry *m_geometry;
     ShadowedRectangleMaterial *m_material = nullptr;
     ShadowedRectangleMaterial::ShaderType m_shaderType = ShadowedRectangleMaterial::ShaderType::Standard;
+    // Whether m_material is the material with border.
+    bool m_hasBorderMaterial = false;
 
 private:
+    void replaceMaterial(ShadowedRectangleMaterial *material, bool border);
+    void updateVariant();
+    void updateBatchedGeometry(const QRectF &rect);
+    void updateRingGeometry(const QRectF &rect, const QRectF &interior);
+    QRectF interiorRect() const;
+
     QRectF m_rect;
     qreal m_size = 0.0;
     QVector4D m_radius = QVector4D{0.0, 0.0, 0.0, 0.0};
@@ -76,4 +102,6 @@ private:
     QVector2D m_aspect = QVector2D{1.0, 1.0};
     qreal m_borderWidth = 0.0;
     QColor m_borderColor;
+    bool m_borderEnabled = false;
+    QSGRectangleNode *m_interiorNode = nullptr;
 };
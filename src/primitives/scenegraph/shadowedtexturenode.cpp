@@ -57,7 +57,7 @@ void ShadowedTextureNode::setTextureSource(QSGTextureProvider *source)
 void ShadowedTextureNode::preprocess()
 {
     if (m_textureSource && m_material && m_textureSource->texture()) {
-        if (m_material->type() == borderlessMaterialType()) {
+        if (!m_hasBorderMaterial) {
             preprocessTexture<ShadowedTextureMaterial>(m_material, m_textureSource);
         } else {
             preprocessTexture<ShadowedBorderTextureMaterial>(m_material, m_textureSource);
@@ -75,12 +75,8 @@ ShadowedBorderRectangleMaterial *ShadowedTextureNode::createBorderMaterial()
     return new ShadowedBorderTextureMaterial{};
 }
 
-QSGMaterialType *ShadowedTextureNode::borderlessMaterialType()
+bool ShadowedTextureNode::hasShaderVariants() const
 {
-    return &ShadowedTextureMaterial::staticType;
-}
-
-QSGMaterialType *ShadowedTextureNode::borderMaterialType()
-{
-    return &ShadowedBorderTextureMaterial::staticType;
+    // There are no specialized texture shaders.
+    return false;
 }
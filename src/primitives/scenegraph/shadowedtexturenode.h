@@ -36,8 +36,7 @@ public:
 private:
     ShadowedRectangleMaterial *createBorderlessMaterial() override;
     ShadowedBorderRectangleMaterial *createBorderMaterial() override;
-    QSGMaterialType *borderlessMaterialType() override;
-    QSGMaterialType *borderMaterialType() override;
+    bool hasShaderVariants() const override;
 
     QPointer<QSGTextureProvider> m_textureSource;
     QMetaObject::Connection m_textureChangeConnectionHandle;
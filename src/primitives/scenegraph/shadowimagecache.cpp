@@ -0,0 +1,240 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "shadowimagecache.h"
+
+#include <QHashFunctions>
+
+#include <algorithm>
+#include <cmath>
+
+// Shadow images are small, so this fits a lot of different shadows.
+static constexpr qsizetype maxBytes = 4 * 1024 * 1024;
+
+Q_GLOBAL_STATIC(ShadowImageCache, s_shadowImageCache)
+
+// These are the same as the functions with the same names in sdf.glsl.
+static float smoothstep(float edge0, float edge1, float x)
+{
+    const float t = std::clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+static float sdf_rounded_rectangle(QVector2D point, QVector2D rect, QVector4D radius)
+{
+    const float cornerRadius = point.x() > 0.0f ? (point.y() > 0.0f ? radius.x() : radius.y()) : (point.y() > 0.0f ? radius.z() : radius.w());
+    const float dx = std::abs(point.x()) - rect.x() + cornerRadius;
+    const float dy = std::abs(point.y()) - rect.y() + cornerRadius;
+    return std::min(std::max(dx, dy), 0.0f) + std::hypot(std::max(dx, 0.0f), std::max(dy, 0.0f)) - cornerRadius;
+}
+
+bool ShadowImageCache::Key::operator==(const Key &other) const
+{
+    return size == other.size && margins == other.margins && radius == other.radius && falloff == other.falloff && offset == other.offset
+        && shadowColor == other.shadowColor && devicePixelRatio == other.devicePixelRatio && rectangleRadius == other.rectangleRadius
+        && color == other.color && borderWidth == other.borderWidth && borderColor == other.borderColor;
+}
+
+size_t qHash(const ShadowImageCache::Key &key, size_t seed)
+{
+    return qHashMulti(seed,
+                      key.size.width(),
+                      key.size.height(),
+                      key.margins.left(),
+                      key.margins.top(),
+                      key.margins.right(),
+                      key.margins.bottom(),
+                      key.radius.x(),
+                      key.radius.y(),
+                      key.radius.z(),
+                      key.radius.w(),
+                      key.falloff,
+                      key.offset.x(),
+                      key.offset.y(),
+                      key.shadowColor,
+                      key.devicePixelRatio,
+                      key.rectangleRadius.x(),
+                      key.rectangleRadius.y(),
+                      key.rectangleRadius.z(),
+                      key.rectangleRadius.w(),
+                      key.color,
+                      key.borderWidth,
+                      key.borderColor);
+}
+
+ShadowImageCache::ShadowImageCache()
+{
+    m_cache.setMaxCost(maxBytes);
+}
+
+ShadowImageCache *ShadowImageCache::instance()
+{
+    return s_shadowImageCache;
+}
+
+ShadowImage ShadowImageCache::image(const ShadowParameters &parameters)
+{
+    const qreal width = parameters.size.width();
+    const qreal height = parameters.size.height();
+    const qreal minDimension = std::min(width, height);
+    const qreal size = parameters.shadowSize;
+
+    const bool hasShadow = size > 0.0 && parameters.shadowColor.alpha() > 0;
+    const qreal borderWidth = parameters.borderColor.alpha() > 0 ? std::max(parameters.borderWidth, 0.0) : 0.0;
+    const bool hasRectangle = parameters.color.alpha() > 0 || borderWidth > 0.0;
+
+    if (minDimension <= 0.0 || (!hasShadow && !hasRectangle)) {
+        return ShadowImage{};
+    }
+
+    // See ShadowedRectangleNode::setRadius().
+    auto clampRadius = [&](float radius) {
+        return float(std::min(radius * 2.0 / minDimension, 1.0) * minDimension / 2.0);
+    };
+    const QVector4D rectangleRadius = hasRectangle ? QVector4D{clampRadius(parameters.radius.x()),
+                                                               clampRadius(parameters.radius.y()),
+                                                               clampRadius(parameters.radius.z()),
+                                                               clampRadius(parameters.radius.w())}
+                                                   : QVector4D{};
+    const qreal maxRectangleRadius = std::max({rectangleRadius.x(), rectangleRadius.y(), rectangleRadius.z(), rectangleRadius.w()});
+
+    qreal falloff = 0.0;
+    QVector4D radius;
+    QVector2D offset;
+    QMarginsF margins;
+    if (hasShadow) {
+        const qreal offsetLength = parameters.offset.length();
+
+        // The shader works in coordinates scaled to the size of the geometry,
+        // which in turn depends on the shadow size and offset. Convert
+        // everything to pixels so the result does not depend on that scale.
+        falloff = size * (minDimension + 2.0 * size + 2.0 * offsetLength) / (2.0 * minDimension);
+
+        // See the shadow_radius calculation in shadowedrectangle.frag.
+        auto shadowRadius = [&](float radius) {
+            const qreal uniformRadius = std::min(radius * 2.0 / minDimension, 1.0);
+            const qreal sizeFactor = 0.5 * (0.05 / std::max(uniformRadius, 0.05));
+            return float(uniformRadius * minDimension / 2.0 + size * sizeFactor);
+        };
+        radius = QVector4D{shadowRadius(parameters.radius.x()),
+                           shadowRadius(parameters.radius.y()),
+                           shadowRadius(parameters.radius.z()),
+                           shadowRadius(parameters.radius.w())};
+
+        // The shader only draws inside its geometry, see ShadowedRectangleNode::updateGeometry().
+        QVector2D aspect{1.0, 1.0};
+        if (width >= height) {
+            aspect.setX(width / height);
+        } else {
+            aspect.setY(height / width);
+        }
+        const qreal expandX = (size + offsetLength) * aspect.x();
+        const qreal expandY = (size + offsetLength) * aspect.y();
+
+        offset = parameters.offset;
+        margins = QMarginsF{std::clamp(std::ceil(falloff - offset.x()), 0.0, std::ceil(expandX)),
+                            std::clamp(std::ceil(falloff - offset.y()), 0.0, std::ceil(expandY)),
+                            std::clamp(std::ceil(falloff + offset.x()), 0.0, std::ceil(expandX)),
+                            std::clamp(std::ceil(falloff + offset.y()), 0.0, std::ceil(expandY))};
+    }
+    const qreal maxRadius = std::max({radius.x(), radius.y(), radius.z(), radius.w()});
+
+    // The center lines of the image need to be outside of the corners of both
+    // the shadow and the rectangle so that stretching them does not change
+    // the result. Larger rectangles are drawn by stretching a smaller one,
+    // smaller rectangles are rendered at their actual size.
+    const qreal cornerSize = std::max(hasShadow ? maxRadius + falloff : 0.0, maxRectangleRadius + borderWidth) + 1.0;
+    const QSizeF canonicalSize{std::min(width, 2.0 * std::ceil(cornerSize + std::abs(offset.x()))),
+                               std::min(height, 2.0 * std::ceil(cornerSize + std::abs(offset.y())))};
+
+    const Key key{canonicalSize,
+                  margins,
+                  radius,
+                  falloff,
+                  offset,
+                  hasShadow ? parameters.shadowColor.rgba() : 0,
+                  parameters.devicePixelRatio,
+                  rectangleRadius,
+                  hasRectangle ? parameters.color.rgba() : 0,
+                  borderWidth,
+                  borderWidth > 0.0 ? parameters.borderColor.rgba() : 0};
+
+    QImage image;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (auto cached = m_cache.object(key)) {
+            image = *cached;
+        }
+    }
+
+    if (image.isNull()) {
+        image = rasterize(key);
+        QMutexLocker locker(&m_mutex);
+        if (auto cached = m_cache.object(key)) {
+            // Another thread got there first, share its image instead.
+            image = *cached;
+        } else {
+            m_cache.insert(key, new QImage(image), image.sizeInBytes());
+        }
+    }
+
+    const qreal halfWidth = canonicalSize.width() / 2.0;
+    const qreal halfHeight = canonicalSize.height() / 2.0;
+    return ShadowImage{image, margins, QMarginsF{margins.left() + halfWidth, margins.top() + halfHeight, margins.right() + halfWidth, margins.bottom() + halfHeight}};
+}
+
+QImage ShadowImageCache::rasterize(const Key &key)
+{
+    const QSizeF logicalSize{key.margins.left() + key.size.width() + key.margins.right(), key.margins.top() + key.size.height() + key.margins.bottom()};
+    const QSize pixelSize = (logicalSize * key.devicePixelRatio).toSize().expandedTo(QSize{1, 1});
+
+    QImage image(pixelSize, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(key.devicePixelRatio);
+
+    // Everything is blended in premultiplied colors, like the shader does.
+    auto premultipliedColor = [](QRgb rgba) {
+        const float alpha = qAlpha(rgba) / 255.0f;
+        return QVector4D{qRed(rgba) / 255.0f * alpha, qGreen(rgba) / 255.0f * alpha, qBlue(rgba) / 255.0f * alpha, alpha};
+    };
+    const QVector4D shadowColor = premultipliedColor(key.shadowColor);
+    const QVector4D color = premultipliedColor(key.color);
+    const QVector4D borderColor = premultipliedColor(key.borderColor);
+    const bool hasShadow = qAlpha(key.shadowColor) > 0;
+    const bool hasRectangle = qAlpha(key.color) > 0 || qAlpha(key.borderColor) > 0;
+
+    // The smoothing sdf_render() applies to the edges, converted to pixels.
+    const float smoothing = 0.625f / key.devicePixelRatio;
+
+    const QVector2D halfSize{float(key.size.width() / 2.0), float(key.size.height() / 2.0)};
+    // The center of the rectangle, in logical pixels from the top left of the image.
+    const QVector2D center = QVector2D{float(key.margins.left()), float(key.margins.top())} + halfSize;
+
+    for (int y = 0; y < pixelSize.height(); ++y) {
+        auto line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < pixelSize.width(); ++x) {
+            const QVector2D point = QVector2D{float((x + 0.5) / key.devicePixelRatio), float((y + 0.5) / key.devicePixelRatio)} - center;
+
+            QVector4D result;
+            if (hasShadow) {
+                const float distance = sdf_rounded_rectangle(point - key.offset, halfSize, key.radius);
+                result = shadowColor * (1.0f - smoothstep(-key.falloff, key.falloff, distance));
+            }
+
+            if (hasRectangle) {
+                const float outer = sdf_rounded_rectangle(point, halfSize, key.rectangleRadius);
+                const float inner = outer + key.borderWidth;
+                const float outerAlpha = 1.0f - smoothstep(-smoothing, smoothing, outer);
+                const float innerAlpha = 1.0f - smoothstep(-smoothing, smoothing, inner);
+                result += (borderColor - result) * outerAlpha;
+                result += (color - result) * innerAlpha;
+            }
+
+            line[x] = qRgba(qRound(result.x() * 255.0f), qRound(result.y() * 255.0f), qRound(result.z() * 255.0f), qRound(result.w() * 255.0f));
+        }
+    }
+
+    return image;
+}
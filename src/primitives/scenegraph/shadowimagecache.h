@@ -0,0 +1,102 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QCache>
+#include <QColor>
+#include <QImage>
+#include <QMarginsF>
+#include <QMutex>
+#include <QSizeF>
+#include <QVector2D>
+#include <QVector4D>
+
+/**
+ * The parameters describing a ShadowedRectangle.
+ *
+ * Sizes are in logical pixels, radius uses the corner order of
+ * CornersGroup::toVector4D(). The rectangle itself is only rendered if either
+ * color or borderColor are set, otherwise only its shadow is.
+ */
+struct ShadowParameters {
+    QSizeF size;
+    QVector4D radius;
+    qreal shadowSize = 0.0;
+    QVector2D offset;
+    QColor shadowColor;
+    qreal devicePixelRatio = 1.0;
+    QColor color = Qt::transparent;
+    qreal borderWidth = 0.0;
+    QColor borderColor = Qt::transparent;
+};
+
+/**
+ * A shadowed rectangle rendered as a nine-slice image.
+ *
+ * The image should be drawn over the rectangle of the item expanded by
+ * margins. The parts of the image within slices of its edges are drawn
+ * without scaling, while the center, which has a constant color along each
+ * axis, is stretched to fill the rest.
+ */
+struct ShadowImage {
+    QImage image;
+    QMarginsF margins;
+    QMarginsF slices;
+
+    bool isNull() const
+    {
+        return image.isNull();
+    }
+};
+
+/**
+ * A process-wide cache of pre-rendered shadowed rectangles.
+ *
+ * Images are rasterized on the CPU with the same distance field functions as
+ * shaders/shadowedborderrectangle.frag, once per distinct set of parameters.
+ * Since the images are nine-slices, rectangles of different sizes can share
+ * the same image as long as the results of the shadow computation are
+ * identical, and the images themselves stay small.
+ *
+ * Rasterizing happens on the render thread, so the cache is thread safe.
+ */
+class ShadowImageCache
+{
+public:
+    ShadowImageCache();
+
+    static ShadowImageCache *instance();
+
+    /**
+     * @returns the image for @p parameters, or a null image if nothing would
+     * be visible.
+     */
+    ShadowImage image(const ShadowParameters &parameters);
+
+private:
+    struct Key {
+        QSizeF size;
+        QMarginsF margins;
+        QVector4D radius;
+        qreal falloff;
+        QVector2D offset;
+        QRgb shadowColor;
+        qreal devicePixelRatio;
+        QVector4D rectangleRadius;
+        QRgb color;
+        qreal borderWidth;
+        QRgb borderColor;
+
+        bool operator==(const Key &other) const;
+    };
+    friend size_t qHash(const Key &key, size_t seed);
+
+    static QImage rasterize(const Key &key);
+
+    QMutex m_mutex;
+    QCache<Key, QImage> m_cache;
+};
@@ -0,0 +1,68 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "softwarerectanglenode.h"
+
+#include "managedtexturenode.h"
+
+#include <algorithm>
+#include <cmath>
+
+Q_GLOBAL_STATIC(ImageTexturesCache, s_softwareTexturesCache)
+
+void SoftwareRectangleNode::update(QQuickWindow *window, const QRectF &rect, const ShadowParameters &parameters)
+{
+    const auto image = ShadowImageCache::instance()->image(parameters);
+    if (image.isNull()) {
+        removeAllChildNodes();
+        qDeleteAll(m_slices);
+        m_slices = {};
+        m_texture.reset();
+        return;
+    }
+
+    if (!m_slices[0]) {
+        for (auto &slice : m_slices) {
+            slice = window->createImageNode();
+            slice->setFiltering(QSGTexture::Linear);
+            appendChildNode(slice);
+        }
+    }
+
+    auto texture = s_softwareTexturesCache->loadTexture(window, image.image);
+    if (texture != m_texture) {
+        m_texture = texture;
+        for (auto slice : m_slices) {
+            slice->setTexture(m_texture.get());
+        }
+    }
+
+    // Split the image in pixels, with a single row and column of pixels in
+    // the middle that is stretched to fill the center.
+    const qreal devicePixelRatio = image.image.devicePixelRatio();
+    const QSize size = image.image.size();
+    const int left = std::clamp(int(std::round(image.slices.left() * devicePixelRatio)), 0, size.width() - 1);
+    const int top = std::clamp(int(std::round(image.slices.top() * devicePixelRatio)), 0, size.height() - 1);
+    const int right = size.width() - left - 1;
+    const int bottom = size.height() - top - 1;
+
+    const std::array<qreal, 4> u = {0.0, qreal(left), left + 1.0, qreal(size.width())};
+    const std::array<qreal, 4> v = {0.0, qreal(top), top + 1.0, qreal(size.height())};
+
+    const auto outer = rect.marginsAdded(image.margins);
+    const qreal centerRight = std::max(outer.left() + left / devicePixelRatio, outer.right() - right / devicePixelRatio);
+    const qreal centerBottom = std::max(outer.top() + top / devicePixelRatio, outer.bottom() - bottom / devicePixelRatio);
+    const std::array<qreal, 4> x = {outer.left(), outer.left() + left / devicePixelRatio, centerRight, outer.right()};
+    const std::array<qreal, 4> y = {outer.top(), outer.top() + top / devicePixelRatio, centerBottom, outer.bottom()};
+
+    for (std::size_t row = 0; row < 3; ++row) {
+        for (std::size_t column = 0; column < 3; ++column) {
+            auto slice = m_slices[row * 3 + column];
+            slice->setSourceRect(QRectF{QPointF{u[column], v[row]}, QPointF{u[column + 1], v[row + 1]}});
+            slice->setRect(QRectF{QPointF{x[column], y[row]}, QPointF{x[column + 1], y[row + 1]}});
+        }
+    }
+}
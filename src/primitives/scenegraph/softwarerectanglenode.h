@@ -0,0 +1,39 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QQuickWindow>
+#include <QSGImageNode>
+#include <QSGNode>
+
+#include <array>
+#include <memory>
+
+#include "shadowimagecache.h"
+
+/**
+ * Scene graph node drawing a ShadowedRectangle from a ShadowImageCache image.
+ *
+ * This is used when our shaders cannot be used, like with the software
+ * renderer. Rather than painting the rectangle for every change, the
+ * rectangle and its shadow are rasterized once for each set of parameters
+ * and shared with all other rectangles using the same parameters. The image
+ * is drawn as nine image nodes, so only the backend's image blitting is
+ * involved in rendering it.
+ */
+class SoftwareRectangleNode : public QSGNode
+{
+public:
+    /**
+     * Update the node to draw the rectangle described by @p parameters at @p rect.
+     */
+    void update(QQuickWindow *window, const QRectF &rect, const ShadowParameters &parameters);
+
+private:
+    std::array<QSGImageNode *, 9> m_slices = {};
+    std::shared_ptr<QSGTexture> m_texture;
+};
@@ -0,0 +1,92 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "windowresources.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+
+struct WindowResourcesData {
+    QMutex mutex;
+    QHash<int, WindowResources::ReleaseFunction> functions;
+    int nextId = 0;
+    QSet<QWindow *> windows;
+};
+
+Q_GLOBAL_STATIC(WindowResourcesData, s_data)
+
+int WindowResources::addReleaseFunction(const ReleaseFunction &function)
+{
+    QMutexLocker locker(&s_data->mutex);
+    const int id = ++s_data->nextId;
+    s_data->functions.insert(id, function);
+    return id;
+}
+
+void WindowResources::removeReleaseFunction(int id)
+{
+    if (s_data.isDestroyed()) {
+        return;
+    }
+
+    QMutexLocker locker(&s_data->mutex);
+    s_data->functions.remove(id);
+}
+
+void WindowResources::watch(QQuickWindow *window)
+{
+    if (!window) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&s_data->mutex);
+        if (s_data->windows.contains(window)) {
+            return;
+        }
+        s_data->windows.insert(window);
+    }
+
+    // This is emitted on the render thread, which is the thread the caches
+    // use the resources of the window on, while the graphics resources still
+    // exist and the GUI thread waits for the render thread.
+    QObject::connect(
+        window,
+        &QQuickWindow::sceneGraphAboutToStop,
+        window,
+        [window]() {
+            release(window);
+        },
+        Qt::DirectConnection);
+
+    QObject::connect(window, &QObject::destroyed, [window]() {
+        release(window);
+        if (!s_data.isDestroyed()) {
+            QMutexLocker locker(&s_data->mutex);
+            s_data->windows.remove(window);
+        }
+    });
+}
+
+void WindowResources::release(QWindow *window)
+{
+    if (s_data.isDestroyed()) {
+        return;
+    }
+
+    // Call the functions without holding the lock, as they take locks of
+    // their own, which may be held while watching a window.
+    QList<ReleaseFunction> functions;
+    {
+        QMutexLocker locker(&s_data->mutex);
+        functions = s_data->functions.values();
+    }
+
+    for (const auto &function : std::as_const(functions)) {
+        function(window);
+    }
+}
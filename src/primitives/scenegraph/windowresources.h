@@ -0,0 +1,48 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QQuickWindow>
+
+#include <functional>
+
+/**
+ * Releases the resources that caches keep for a window once it no longer needs them.
+ *
+ * Caches register a release function, which is called for a window when its
+ * scene graph is about to stop, right before all graphics resources of the
+ * window are destroyed, and when the window is destroyed. Caches only need to forget about
+ * the window, they create new resources on demand, for instance once the
+ * window is shown again. Hiding a window does not release anything by
+ * itself, so that showing it again does not need to upload everything again.
+ *
+ * Release functions may be called from the render thread of the window and
+ * must be thread-safe.
+ */
+class WindowResources
+{
+public:
+    using ReleaseFunction = std::function<void(QWindow *window)>;
+
+    /**
+     * Register @p function to be called for every watched window that
+     * releases its resources. Returns an id for removeReleaseFunction().
+     */
+    static int addReleaseFunction(const ReleaseFunction &function);
+    static void removeReleaseFunction(int id);
+
+    /**
+     * Watch @p window, so that its resources are released when its scene
+     * graph stops or it is destroyed. Watching a window again does nothing.
+     */
+    static void watch(QQuickWindow *window);
+
+    /**
+     * Call all release functions for @p window.
+     */
+    static void release(QWindow *window);
+};
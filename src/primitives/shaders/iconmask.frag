@@ -0,0 +1,25 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#version 440
+
+// This shader renders the alpha channel of a texture filled with a single color.
+
+layout(std140, binding = 0) uniform buf {
+    highp mat4 matrix; // offset 0
+    lowp float opacity; // offset 64
+    lowp vec4 color; // offset 80
+} ubuf; // size 96
+
+layout(binding = 1) uniform sampler2D textureSource;
+
+layout(location = 0) in mediump vec2 uv;
+layout(location = 0) out lowp vec4 out_color;
+
+void main()
+{
+    out_color = ubuf.color * texture(textureSource, uv).a * ubuf.opacity;
+}
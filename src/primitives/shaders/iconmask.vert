@@ -0,0 +1,25 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#version 440
+
+layout(std140, binding = 0) uniform buf {
+    highp mat4 matrix; // offset 0
+    lowp float opacity; // offset 64
+    lowp vec4 color; // offset 80
+} ubuf; // size 96
+
+layout(location = 0) in highp vec4 in_vertex;
+layout(location = 1) in mediump vec2 in_uv;
+
+layout(location = 0) out mediump vec2 uv;
+
+out gl_PerVertex { vec4 gl_Position; };
+
+void main() {
+    uv = in_uv;
+    gl_Position = ubuf.matrix * in_vertex;
+}
@@ -96,6 +96,18 @@ lowp float sdf_rounded_rectangle(in lowp vec2 point, in lowp vec2 rect, in lowp
     return min(max(d.x, d.y), 0.0) + length(max(d, 0.0)) - radius.x;
 }
 
+// Distance field for a rectangle with the same radius for all corners.
+//
+// This is an overload of sdf_rounded_rectangle(vec2, vec2, vec4) that avoids
+// selecting the radius of the corner closest to point.
+//
+// \param radius The radius of all corners.
+lowp float sdf_rounded_rectangle(in lowp vec2 point, in lowp vec2 rect, in lowp float radius)
+{
+    lowp vec2 d = abs(point) - rect + radius;
+    return min(max(d.x, d.y), 0.0) + length(max(d, 0.0)) - radius;
+}
+
 /*********************
     Operators
 *********************/
@@ -13,6 +13,19 @@
 // This shader renders a rectangle with rounded corners and a shadow below it.
 // In addition it renders a border around it.
 
+// This shader is also compiled with the following defines, which leave out
+// work that does not change the result:
+// - NO_SHADOW: the shadow's size is 0, so there is no shadow to render.
+// - UNIFORM_RADIUS: all corners have the same radius, which is stored in ubuf.radius.x.
+
+#ifdef UNIFORM_RADIUS
+#define radius_t float
+#define RADIUS ubuf.radius.x
+#else
+#define radius_t vec4
+#define RADIUS ubuf.radius
+#endif
+
 #include "uniforms.glsl"
 
 layout(location = 0) in lowp vec2 uv;
@@ -25,21 +38,23 @@ void main()
     // Scaling factor that is the inverse of the amount of scaling applied to the geometry.
     lowp float inverse_scale = 1.0 / (1.0 + ubuf.size + length(ubuf.offset) * 2.0);
 
+    lowp vec4 col = vec4(0.0);
+
+#ifndef NO_SHADOW
     // Correction factor to round the corners of a larger shadow.
     // We want to account for size in regards to shadow radius, so that a larger shadow is
     // more rounded, but only if we are not already rounding the corners due to corner radius.
-    lowp vec4 size_factor = 0.5 * (minimum_shadow_radius / max(ubuf.radius, minimum_shadow_radius));
-    lowp vec4 shadow_radius = ubuf.radius + ubuf.size * size_factor;
-
-    lowp vec4 col = vec4(0.0);
+    lowp radius_t size_factor = 0.5 * (minimum_shadow_radius / max(RADIUS, minimum_shadow_radius));
+    lowp radius_t shadow_radius = RADIUS + ubuf.size * size_factor;
 
     // Calculate the shadow's distance field.
     lowp float shadow = sdf_rounded_rectangle(uv - ubuf.offset * 2.0 * inverse_scale, ubuf.aspect * inverse_scale, shadow_radius * inverse_scale);
     // Render it, interpolating the color over the distance.
     col = mix(col, ubuf.shadowColor * sign(ubuf.size), 1.0 - smoothstep(-ubuf.size * 0.5, ubuf.size * 0.5, shadow));
+#endif
 
     // Scale corrected corner radius
-    lowp vec4 corner_radius = ubuf.radius * inverse_scale;
+    lowp radius_t corner_radius = RADIUS * inverse_scale;
 
     // Calculate the outer rectangle distance field and render it.
     lowp float outer_rect = sdf_rounded_rectangle(uv, ubuf.aspect * inverse_scale, corner_radius);
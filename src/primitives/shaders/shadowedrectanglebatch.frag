@@ -0,0 +1,71 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#version 440
+
+#extension GL_GOOGLE_include_directive: enable
+#include "sdf.glsl"
+// See sdf.glsl for the SDF related functions.
+
+// This is a version of shadowedborderrectangle.frag that reads its parameters
+// from vertex attributes rather than uniforms, so that many rectangles can be
+// drawn in a single batch. A border width of zero disables the border.
+
+layout(std140, binding = 0) uniform buf {
+    highp mat4 matrix; // offset 0
+    lowp float opacity; // offset 64
+} ubuf; // size 68
+
+layout(location = 0) in lowp vec2 uv;
+// Aspect ratio in xy, shadow size in z and border width in w.
+layout(location = 1) in mediump vec4 aspectSize;
+layout(location = 2) in mediump vec4 radius;
+layout(location = 3) in mediump vec2 shadowOffset;
+layout(location = 4) in lowp vec4 color;
+layout(location = 5) in lowp vec4 shadowColor;
+layout(location = 6) in lowp vec4 borderColor;
+
+layout(location = 0) out lowp vec4 out_color;
+
+const lowp float minimum_shadow_radius = 0.05;
+
+void main()
+{
+    lowp vec2 aspect = aspectSize.xy;
+    lowp float size = aspectSize.z;
+    lowp float borderWidth = aspectSize.w;
+
+    // Scaling factor that is the inverse of the amount of scaling applied to the geometry.
+    lowp float inverse_scale = 1.0 / (1.0 + size + length(shadowOffset) * 2.0);
+
+    // Correction factor to round the corners of a larger shadow.
+    // We want to account for size in regards to shadow radius, so that a larger shadow is
+    // more rounded, but only if we are not already rounding the corners due to corner radius.
+    lowp vec4 size_factor = 0.5 * (minimum_shadow_radius / max(radius, minimum_shadow_radius));
+    lowp vec4 shadow_radius = radius + size * size_factor;
+
+    lowp vec4 col = vec4(0.0);
+
+    // Calculate the shadow's distance field.
+    lowp float shadow = sdf_rounded_rectangle(uv - shadowOffset * 2.0 * inverse_scale, aspect * inverse_scale, shadow_radius * inverse_scale);
+    // Render it, interpolating the color over the distance.
+    col = mix(col, shadowColor * sign(size), 1.0 - smoothstep(-size * 0.5, size * 0.5, shadow));
+
+    // Calculate the outer rectangle distance field.
+    lowp float outer_rect = sdf_rounded_rectangle(uv, aspect * inverse_scale, radius * inverse_scale);
+
+    if (borderWidth > 0.0) {
+        // Render the border, then the inner rectangle which is the outer
+        // rectangle reduced by twice the border size.
+        col = sdf_render(outer_rect, col, borderColor);
+        lowp float inner_rect = outer_rect + (borderWidth * inverse_scale) * 2.0;
+        col = sdf_render(inner_rect, col, color);
+    } else {
+        col = sdf_render(outer_rect, col, color);
+    }
+
+    out_color = col * ubuf.opacity;
+}
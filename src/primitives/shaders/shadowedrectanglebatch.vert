@@ -0,0 +1,42 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#version 440
+
+layout(std140, binding = 0) uniform buf {
+    highp mat4 matrix; // offset 0
+    lowp float opacity; // offset 64
+} ubuf; // size 68
+
+layout(location = 0) in highp vec4 in_vertex;
+layout(location = 1) in mediump vec2 in_uv;
+layout(location = 2) in mediump vec4 in_aspectSize;
+layout(location = 3) in mediump vec4 in_radius;
+layout(location = 4) in mediump vec2 in_offset;
+layout(location = 5) in lowp vec4 in_color;
+layout(location = 6) in lowp vec4 in_shadowColor;
+layout(location = 7) in lowp vec4 in_borderColor;
+
+layout(location = 0) out mediump vec2 uv;
+layout(location = 1) out mediump vec4 aspectSize;
+layout(location = 2) out mediump vec4 radius;
+layout(location = 3) out mediump vec2 shadowOffset;
+layout(location = 4) out lowp vec4 color;
+layout(location = 5) out lowp vec4 shadowColor;
+layout(location = 6) out lowp vec4 borderColor;
+
+out gl_PerVertex { vec4 gl_Position; };
+
+void main() {
+    uv = (-1.0 + 2.0 * in_uv) * in_aspectSize.xy;
+    aspectSize = in_aspectSize;
+    radius = in_radius;
+    shadowOffset = in_offset;
+    color = in_color;
+    shadowColor = in_shadowColor;
+    borderColor = in_borderColor;
+    gl_Position = ubuf.matrix * in_vertex;
+}
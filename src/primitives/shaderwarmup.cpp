@@ -0,0 +1,105 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "shaderwarmup.h"
+
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QSGRendererInterface>
+
+#include <atomic>
+#include <memory>
+
+#include "shadowedrectangle.h"
+
+static const char *warmedUpProperty = "_kirigami_shaderWarmup";
+
+bool ShaderWarmup::isEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("KIRIGAMI_SHADER_WARMUP") == 1;
+    return enabled;
+}
+
+void ShaderWarmup::warmUp(QQuickWindow *window)
+{
+    if (!window || !window->contentItem() || window->property(warmedUpProperty).toBool()) {
+        return;
+    }
+    window->setProperty(warmedUpProperty, true);
+
+    if (QQuickWindow::sceneGraphBackend() == QLatin1String("software")
+        || (window->rendererInterface() && window->rendererInterface()->graphicsApi() == QSGRendererInterface::Software)) {
+        return;
+    }
+
+    // All rectangles share a container, so they can be removed at once.
+    auto container = new QQuickItem(window->contentItem());
+    container->setZ(-1);
+
+    int index = 0;
+    for (auto renderType : {ShadowedRectangle::RenderType::HighQuality, ShadowedRectangle::RenderType::LowQuality}) {
+        // Every combination selects a different shader variant, see
+        // ShadowedRectangleMaterial::Variant.
+        for (int variant = 0; variant < 8; ++variant) {
+            // A single, nearly transparent pixel each. Using opacity instead
+            // would make the scene graph skip rendering them entirely.
+            auto rectangle = new ShadowedRectangle(container);
+            rectangle->setSize(QSizeF{1.0, 1.0});
+            rectangle->setX(index++);
+            rectangle->setRenderType(renderType);
+            rectangle->setColor(QColor(0, 0, 0, 1));
+            if (variant & 1) {
+                rectangle->border()->setWidth(1.0);
+                rectangle->border()->setColor(QColor(0, 0, 0, 1));
+            }
+            if (variant & 2) {
+                rectangle->shadow()->setSize(1.0);
+                rectangle->shadow()->setColor(QColor(0, 0, 0, 1));
+            }
+            if (variant & 4) {
+                rectangle->corners()->setTopLeft(0.5);
+            }
+        }
+    }
+
+    // A frame may be in flight already, so only remove the rectangles once a
+    // frame which has synchronized them has been presented.
+    auto synchronized = std::make_shared<std::atomic_bool>(false);
+    QObject::connect(
+        window,
+        &QQuickWindow::afterSynchronizing,
+        container,
+        [synchronized]() {
+            synchronized->store(true);
+        },
+        Qt::DirectConnection);
+    QObject::connect(
+        window,
+        &QQuickWindow::frameSwapped,
+        container,
+        [container, synchronized]() {
+            if (synchronized->load()) {
+                container->deleteLater();
+            }
+        },
+        Qt::QueuedConnection);
+}
+
+static void installShaderWarmup()
+{
+    if (!ShaderWarmup::isEnabled() || !qGuiApp) {
+        return;
+    }
+
+    QObject::connect(qGuiApp, &QGuiApplication::focusWindowChanged, qGuiApp, [](QWindow *window) {
+        ShaderWarmup::warmUp(qobject_cast<QQuickWindow *>(window));
+    });
+
+    if (auto window = qobject_cast<QQuickWindow *>(QGuiApplication::focusWindow())) {
+        ShaderWarmup::warmUp(window);
+    }
+}
+Q_COREAPP_STARTUP_FUNCTION(installShaderWarmup)
@@ -0,0 +1,36 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QQuickWindow>
+
+/**
+ * Creates the graphics pipelines used by ShadowedRectangle ahead of time.
+ *
+ * The pipeline for a material is only created the first time something using
+ * it is rendered, which can take several milliseconds per pipeline on some
+ * drivers. Without warming up, this happens in the frame that first shows,
+ * for instance, a page of cards. Warming up renders a single frame containing
+ * an invisible rectangle for each variant of the rectangle shaders, so the
+ * pipelines already exist once they are needed. Qt stores the pipelines in
+ * its automatic pipeline cache, which makes later starts cheaper as well.
+ *
+ * Warming up is opt-in and enabled by setting the `KIRIGAMI_SHADER_WARMUP`
+ * environment variable to 1. When enabled, every window is warmed up once it
+ * receives focus for the first time.
+ */
+class ShaderWarmup
+{
+public:
+    static bool isEnabled();
+
+    /**
+     * Render the shader variants into @p window once. This does nothing if
+     * the window has been warmed up before or uses software rendering.
+     */
+    static void warmUp(QQuickWindow *window);
+};
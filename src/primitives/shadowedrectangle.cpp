@@ -10,8 +10,23 @@
 #include <QSGRectangleNode>
 #include <QSGRendererInterface>
 
-#include "scenegraph/paintedrectangleitem.h"
+#include "renderquality.h"
+#include "scenegraph/cachedshadownode.h"
+#include "scenegraph/shadowedrectanglebatchmaterial.h"
 #include "scenegraph/shadowedrectanglenode.h"
+#include "scenegraph/softwarerectanglenode.h"
+
+static ShadowedRectangleMaterial::ShaderType shaderTypeFor(ShadowedRectangle::RenderType renderType, bool lowPower)
+{
+    using RenderType = ShadowedRectangle::RenderType;
+    if (renderType == RenderType::LowQuality || ((renderType == RenderType::Auto || renderType == RenderType::CachedShadow) && lowPower)) {
+        return ShadowedRectangleMaterial::ShaderType::LowPower;
+    }
+    if (ShadowedRectangleBatchMaterial::isEnabled()) {
+        return ShadowedRectangleMaterial::ShaderType::Batched;
+    }
+    return ShadowedRectangleMaterial::ShaderType::Standard;
+}
 
 BorderGroup::BorderGroup(QObject *parent)
     : QObject(parent)
@@ -230,9 +245,7 @@ void ShadowedRectangle::setRadius(qreal newRadius)
     }
 
     m_radius = newRadius;
-    if (!isSoftwareRendering()) {
-        update();
-    }
+    update();
     Q_EMIT radiusChanged();
 }
 
@@ -248,9 +261,7 @@ void ShadowedRectangle::setColor(const QColor &newColor)
     }
 
     m_color = newColor;
-    if (!isSoftwareRendering()) {
-        update();
-    }
+    update();
     Q_EMIT colorChanged();
 }
 
@@ -269,27 +280,30 @@ void ShadowedRectangle::setRenderType(RenderType renderType)
     Q_EMIT renderTypeChanged();
 }
 
-void ShadowedRectangle::componentComplete()
-{
-    QQuickItem::componentComplete();
-
-    checkSoftwareItem();
-}
-
 bool ShadowedRectangle::isSoftwareRendering() const
 {
     return (window() && window()->rendererInterface()->graphicsApi() == QSGRendererInterface::Software) || m_renderType == RenderType::Software;
 }
 
-PaintedRectangleItem *ShadowedRectangle::softwareItem() const
+bool ShadowedRectangle::isWindowLowPower() const
 {
-    return m_softwareItem;
+    return RenderQuality::isLowPowerHardware() || (m_renderQuality && m_renderQuality->isLowPower());
 }
 
 void ShadowedRectangle::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value)
 {
+    if (change == QQuickItem::ItemSceneChange) {
+        if (m_renderQuality) {
+            disconnect(m_renderQuality, nullptr, this, nullptr);
+        }
+        // The nodes are recreated with the right shaders on the next update.
+        m_renderQuality = RenderQuality::forWindow(value.window);
+        if (m_renderQuality) {
+            connect(m_renderQuality, &RenderQuality::lowPowerChanged, this, &ShadowedRectangle::update);
+        }
+    }
+
     if (change == QQuickItem::ItemSceneChange && value.window) {
-        checkSoftwareItem();
         // TODO: only conditionally emit?
         Q_EMIT softwareRenderingChanged();
     }
@@ -306,23 +320,106 @@ QSGNode *ShadowedRectangle::updatePaintNode(QSGNode *node, QQuickItem::UpdatePai
         return nullptr;
     }
 
-    auto shadowNode = static_cast<ShadowedRectangleNode *>(node);
+    // Both the software and cached shadow nodes are containers for other
+    // nodes, so make sure to recreate the node whenever the kind of node
+    // changes. ShadowedTexture creates its own nodes for the default case.
+    PaintNodeType nodeType = PaintNodeType::Rectangle;
+    if (isSoftwareRendering()) {
+        nodeType = PaintNodeType::Software;
+    } else if (m_renderType == RenderType::CachedShadow) {
+        nodeType = PaintNodeType::CachedShadow;
+    }
+
+    if (node) {
+        const bool isRectangleNode = node->type() == QSGNode::GeometryNodeType;
+        if (isRectangleNode != (nodeType == PaintNodeType::Rectangle) || (!isRectangleNode && nodeType != m_paintNodeType)) {
+            delete node;
+            node = nullptr;
+        }
+    }
+    m_paintNodeType = nodeType;
+
+    // The shaders of a node cannot be changed once created, which happens
+    // when adaptive quality changes the low power state of the window.
+    const auto shaderType = shaderTypeFor(m_renderType, isWindowLowPower());
+    if (nodeType == PaintNodeType::Rectangle && node && static_cast<ShadowedRectangleNode *>(node)->shaderType() != shaderType) {
+        delete node;
+        node = nullptr;
+    }
+
+    if (nodeType == PaintNodeType::Rectangle) {
+        return updateRectangleNode(static_cast<ShadowedRectangleNode *>(node), true);
+    }
+
+    if (nodeType == PaintNodeType::Software) {
+        auto softwareNode = node ? static_cast<SoftwareRectangleNode *>(node) : new SoftwareRectangleNode{};
+        auto parameters = shadowParameters();
+        parameters.color = m_color;
+        if (m_border->isEnabled()) {
+            parameters.borderWidth = m_border->width();
+            parameters.borderColor = m_border->color();
+        }
+        softwareNode->update(window(), boundingRect(), parameters);
+        return softwareNode;
+    }
+
+    if (!node) {
+        node = new QSGNode{};
+    }
+
+    auto rectangleNode = static_cast<ShadowedRectangleNode *>(node->lastChild());
+    if (rectangleNode && rectangleNode->shaderType() != shaderType) {
+        node->removeChildNode(rectangleNode);
+        delete rectangleNode;
+        rectangleNode = nullptr;
+    }
+    if (!rectangleNode) {
+        rectangleNode = updateRectangleNode(nullptr, false);
+        node->appendChildNode(rectangleNode);
+    } else {
+        updateRectangleNode(rectangleNode, false);
+    }
 
+    // The shadow node is kept when there is no shadow, it just isn't rendered.
+    auto shadowNode = node->childCount() > 1 ? static_cast<CachedShadowNode *>(node->firstChild()) : nullptr;
+    if (!shadowNode) {
+        shadowNode = new CachedShadowNode{};
+        node->prependChildNode(shadowNode);
+    }
+    shadowNode->update(window(), boundingRect(), shadowParameters());
+
+    return node;
+}
+
+ShadowParameters ShadowedRectangle::shadowParameters() const
+{
+    return ShadowParameters{
+        size(),
+        m_corners->toVector4D(m_radius),
+        m_shadow->size(),
+        QVector2D{float(m_shadow->xOffset()), float(m_shadow->yOffset())},
+        m_shadow->color(),
+        window()->effectiveDevicePixelRatio(),
+    };
+}
+
+ShadowedRectangleNode *ShadowedRectangle::updateRectangleNode(ShadowedRectangleNode *shadowNode, bool drawShadow)
+{
     if (!shadowNode) {
         shadowNode = new ShadowedRectangleNode{};
+        shadowNode->setShaderType(shaderTypeFor(m_renderType, isWindowLowPower()));
 
-        // Cache lowPower state so we only execute the full check once.
-        static bool lowPower = QByteArrayList{"1", "true"}.contains(qgetenv("KIRIGAMI_LOWPOWER_HARDWARE").toLower());
-        if (m_renderType == RenderType::LowQuality || (m_renderType == RenderType::Auto && lowPower)) {
-            shadowNode->setShaderType(ShadowedRectangleMaterial::ShaderType::LowPower);
+        // Batched rectangles are cheap enough as they are.
+        if (shadowNode->shaderType() != ShadowedRectangleMaterial::ShaderType::Batched) {
+            shadowNode->setInteriorNode(window()->createRectangleNode());
         }
     }
 
     shadowNode->setBorderEnabled(m_border->isEnabled());
     shadowNode->setRect(boundingRect());
-    shadowNode->setSize(m_shadow->size());
+    shadowNode->setSize(drawShadow ? m_shadow->size() : 0.0);
     shadowNode->setRadius(m_corners->toVector4D(m_radius));
-    shadowNode->setOffset(QVector2D{float(m_shadow->xOffset()), float(m_shadow->yOffset())});
+    shadowNode->setOffset(drawShadow ? QVector2D{float(m_shadow->xOffset()), float(m_shadow->yOffset())} : QVector2D{});
     shadowNode->setColor(m_color);
     shadowNode->setShadowColor(m_shadow->color());
     shadowNode->setBorderWidth(m_border->width());
@@ -331,35 +428,4 @@ QSGNode *ShadowedRectangle::updatePaintNode(QSGNode *node, QQuickItem::UpdatePai
     return shadowNode;
 }
 
-void ShadowedRectangle::checkSoftwareItem()
-{
-    if (!m_softwareItem && isSoftwareRendering()) {
-        m_softwareItem = new PaintedRectangleItem{this};
-        // The software item is added as a "normal" child item, this means it
-        // will be part of the normal item sort order. Since there is no way to
-        // control the ordering of children, just make sure to have a very low Z
-        // value for the child, to force it to be the lowest item.
-        m_softwareItem->setZ(-99.0);
-
-        auto updateItem = [this]() {
-            auto borderWidth = m_border->width();
-            auto rect = boundingRect();
-            m_softwareItem->setSize(rect.size());
-            m_softwareItem->setColor(m_color);
-            m_softwareItem->setRadius(m_radius);
-            m_softwareItem->setBorderWidth(borderWidth);
-            m_softwareItem->setBorderColor(m_border->color());
-        };
-
-        updateItem();
-
-        connect(this, &ShadowedRectangle::widthChanged, m_softwareItem, updateItem);
-        connect(this, &ShadowedRectangle::heightChanged, m_softwareItem, updateItem);
-        connect(this, &ShadowedRectangle::colorChanged, m_softwareItem, updateItem);
-        connect(this, &ShadowedRectangle::radiusChanged, m_softwareItem, updateItem);
-        connect(m_border.get(), &BorderGroup::changed, m_softwareItem, updateItem);
-        setFlag(QQuickItem::ItemHasContents, false);
-    }
-}
-
 #include "moc_shadowedrectangle.cpp"
@@ -6,12 +6,15 @@
 
 #pragma once
 
+#include <QPointer>
 #include <QQuickItem>
 #include <memory>
 
 #include <QQmlEngine>
 
-class PaintedRectangleItem;
+class RenderQuality;
+class ShadowedRectangleNode;
+struct ShadowParameters;
 
 /**
  * @brief Grouped property for rectangle border.
@@ -323,10 +326,26 @@ public:
          * @brief Always use software rendering for this rectangle.
          *
          * Software rendering is intended as a fallback when the QtQuick scene
-         * graph is configured to use software rendering. It will result in
-         * a number of missing features, like shadows and multiple corner radii.
+         * graph is configured to use software rendering. The rectangle and its
+         * shadow are rendered into an image once and shared between all
+         * rectangles with the same parameters, which is then drawn as a
+         * nine-slice. Changes to the rectangle require rendering a new image.
          */
-        Software
+        Software,
+
+        /**
+         * @brief Draw the shadow from a pre-rendered image.
+         *
+         * The shadow is rendered once for each distinct set of shadow
+         * parameters and shared between all rectangles using them, rather
+         * than being computed for every pixel in every frame. This is useful
+         * for large numbers of mostly static rectangles. The rectangle itself
+         * is rendered as with Auto, which means this also provides shadows on
+         * hardware that would otherwise use low quality rendering.
+         *
+         * @since 6.12
+         */
+        CachedShadow,
     };
     Q_ENUM(RenderType)
 
@@ -346,7 +365,6 @@ public:
     void setRenderType(RenderType renderType);
     Q_SIGNAL void renderTypeChanged();
 
-    void componentComplete() override;
 
     bool isSoftwareRendering() const;
 
@@ -354,17 +372,27 @@ Q_SIGNALS:
     void softwareRenderingChanged();
 
 protected:
-    PaintedRectangleItem *softwareItem() const;
     void itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &value) override;
     QSGNode *updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData *data) override;
 
+    // Whether the window currently renders using the low power shaders.
+    bool isWindowLowPower() const;
+
 private:
-    void checkSoftwareItem();
+    enum class PaintNodeType {
+        Rectangle,
+        CachedShadow,
+        Software,
+    };
+
+    ShadowParameters shadowParameters() const;
+    ShadowedRectangleNode *updateRectangleNode(ShadowedRectangleNode *shadowNode, bool drawShadow);
     const std::unique_ptr<BorderGroup> m_border;
     const std::unique_ptr<ShadowGroup> m_shadow;
     const std::unique_ptr<CornersGroup> m_corners;
     qreal m_radius = 0.0;
     QColor m_color = Qt::white;
     RenderType m_renderType = RenderType::Auto;
-    PaintedRectangleItem *m_softwareItem = nullptr;
+    PaintNodeType m_paintNodeType = PaintNodeType::Rectangle;
+    QPointer<RenderQuality> m_renderQuality;
 };
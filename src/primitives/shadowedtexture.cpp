@@ -46,16 +46,28 @@ void ShadowedTexture::setSource(QQuickItem *newSource)
 
 QSGNode *ShadowedTexture::updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeData *data)
 {
-    Q_UNUSED(data)
-
     if (boundingRect().isEmpty()) {
         delete node;
         return nullptr;
     }
 
+    // Textures cannot be drawn without our shaders, draw a plain rectangle instead.
+    if (isSoftwareRendering()) {
+        return ShadowedRectangle::updatePaintNode(node, data);
+    }
+
+    // Any other node was created for software rendering.
+    if (node && node->type() != QSGNode::GeometryNodeType) {
+        delete node;
+        node = nullptr;
+    }
+
     auto shadowNode = static_cast<ShadowedRectangleNode *>(node);
 
-    if (!shadowNode || m_sourceChanged) {
+    const bool lowPower = qEnvironmentVariableIsSet("KIRIGAMI_LOWPOWER_HARDWARE") || isWindowLowPower();
+    const auto shaderType = lowPower ? ShadowedRectangleMaterial::ShaderType::LowPower : ShadowedRectangleMaterial::ShaderType::Standard;
+
+    if (!shadowNode || m_sourceChanged || shadowNode->shaderType() != shaderType) {
         m_sourceChanged = false;
         delete shadowNode;
         if (m_source) {
@@ -64,9 +76,7 @@ QSGNode *ShadowedTexture::updatePaintNode(QSGNode *node, QQuickItem::UpdatePaint
             shadowNode = new ShadowedRectangleNode{};
         }
 
-        if (qEnvironmentVariableIsSet("KIRIGAMI_LOWPOWER_HARDWARE")) {
-            shadowNode->setShaderType(ShadowedRectangleMaterial::ShaderType::LowPower);
-        }
+        shadowNode->setShaderType(shaderType);
     }
 
     shadowNode->setBorderEnabled(border()->isEnabled());
@@ -22,28 +22,28 @@ ScenePositionAttached::~ScenePositionAttached()
 
 qreal ScenePositionAttached::x() const
 {
-    qreal x = 0.0;
-    QQuickItem *item = m_item;
-
-    while (item) {
-        x += item->x();
-        item = item->parentItem();
+    if (!m_xValid) {
+        m_x = m_ancestorPosition ? m_ancestorPosition->x() : 0.0;
+        for (QQuickItem *item : m_ancestors) {
+            m_x += item->x();
+        }
+        m_xValid = true;
     }
 
-    return x;
+    return m_x;
 }
 
 qreal ScenePositionAttached::y() const
 {
-    qreal y = 0.0;
-    QQuickItem *item = m_item;
-
-    while (item) {
-        y += item->y();
-        item = item->parentItem();
+    if (!m_yValid) {
+        m_y = m_ancestorPosition ? m_ancestorPosition->y() : 0.0;
+        for (QQuickItem *item : m_ancestors) {
+            m_y += item->y();
+        }
+        m_yValid = true;
     }
 
-    return y;
+    return m_y;
 }
 
 void ScenePositionAttached::connectAncestors(QQuickItem *item)
@@ -54,11 +54,25 @@ void ScenePositionAttached::connectAncestors(QQuickItem *item)
 
     QQuickItem *ancestor = item;
     while (ancestor) {
+        // Once an ancestor tracks its scene position already, reuse that
+        // instead of walking and connecting to the rest of the tree again.
+        if (ancestor != m_item) {
+            auto position = qobject_cast<ScenePositionAttached *>(qmlAttachedPropertiesObject<ScenePositionAttached>(ancestor, false));
+            if (position) {
+                m_ancestorPosition = position;
+                connect(position, &ScenePositionAttached::xChanged, this, &ScenePositionAttached::invalidateX);
+                connect(position, &ScenePositionAttached::yChanged, this, &ScenePositionAttached::invalidateY);
+                break;
+            }
+        }
+
         m_ancestors << ancestor;
 
-        connect(ancestor, &QQuickItem::xChanged, this, &ScenePositionAttached::xChanged);
-        connect(ancestor, &QQuickItem::yChanged, this, &ScenePositionAttached::yChanged);
+        connect(ancestor, &QQuickItem::xChanged, this, &ScenePositionAttached::invalidateX);
+        connect(ancestor, &QQuickItem::yChanged, this, &ScenePositionAttached::invalidateY);
         connect(ancestor, &QQuickItem::parentChanged, this, [this, ancestor]() {
+            disconnectAncestorPosition();
+
             while (!m_ancestors.isEmpty()) {
                 QQuickItem *last = m_ancestors.takeLast();
                 // Disconnect the item which had its parent changed too,
@@ -71,14 +85,34 @@ void ScenePositionAttached::connectAncestors(QQuickItem *item)
 
             connectAncestors(ancestor);
 
-            Q_EMIT xChanged();
-            Q_EMIT yChanged();
+            invalidateX();
+            invalidateY();
         });
 
         ancestor = ancestor->parentItem();
     }
 }
 
+void ScenePositionAttached::disconnectAncestorPosition()
+{
+    if (m_ancestorPosition) {
+        disconnect(m_ancestorPosition, nullptr, this, nullptr);
+    }
+    m_ancestorPosition = nullptr;
+}
+
+void ScenePositionAttached::invalidateX()
+{
+    m_xValid = false;
+    Q_EMIT xChanged();
+}
+
+void ScenePositionAttached::invalidateY()
+{
+    m_yValid = false;
+    Q_EMIT yChanged();
+}
+
 ScenePositionAttached *ScenePositionAttached::qmlAttachedProperties(QObject *object)
 {
     return new ScenePositionAttached(object);
@@ -8,6 +8,7 @@
 #define SCENEPOSITIONATTACHED_H
 
 #include <QObject>
+#include <QPointer>
 #include <QQmlEngine>
 
 class QQuickItem;
@@ -56,9 +57,20 @@ Q_SIGNALS:
 
 private:
     void connectAncestors(QQuickItem *item);
+    void disconnectAncestorPosition();
+    void invalidateX();
+    void invalidateY();
 
     QQuickItem *m_item = nullptr;
+    // The item and its ancestors up to the closest ancestor that has a
+    // ScenePosition of its own, which is m_ancestorPosition.
     QList<QQuickItem *> m_ancestors;
+    QPointer<ScenePositionAttached> m_ancestorPosition;
+
+    mutable qreal m_x = 0.0;
+    mutable qreal m_y = 0.0;
+    mutable bool m_xValid = false;
+    mutable bool m_yValid = false;
 };
 
 QML_DECLARE_TYPEINFO(ScenePositionAttached, QML_HAS_ATTACHED_PROPERTIES)
@@ -2,8 +2,29 @@
 // SPDX-License-Identifier: LGPL-2.0-or-later
 
 #include "spellcheckattached.h"
+#include "spellcheckservice.h"
+
+#include <QLocale>
 #include <QQuickItem>
 
+// Checking waits for this long after the last change of the text, so it
+// doesn't run for every typed character.
+static constexpr int s_checkDelay = 200;
+
+// The text as displayed to the user. The text property holds HTML when the
+// item shows rich text, which getText() converts.
+static QString plainText(QObject *item)
+{
+    if (item->property("textFormat").toInt() != Qt::PlainText) {
+        QString text;
+        const int length = item->property("length").toInt();
+        if (QMetaObject::invokeMethod(item, "getText", Q_RETURN_ARG(QString, text), Q_ARG(int, 0), Q_ARG(int, length))) {
+            return text;
+        }
+    }
+    return item->property("text").toString();
+}
+
 SpellCheckAttached::SpellCheckAttached(QObject *parent)
     : QObject(parent)
 {
@@ -11,6 +32,7 @@ SpellCheckAttached::SpellCheckAttached(QObject *parent)
 
 SpellCheckAttached::~SpellCheckAttached()
 {
+    cancelCheck();
 }
 
 void SpellCheckAttached::setEnabled(bool enabled)
@@ -20,6 +42,7 @@ void SpellCheckAttached::setEnabled(bool enabled)
     }
 
     m_enabled = enabled;
+    updateChecking();
     Q_EMIT enabledChanged();
 }
 
@@ -28,6 +51,117 @@ bool SpellCheckAttached::enabled() const
     return m_enabled;
 }
 
+QString SpellCheckAttached::language() const
+{
+    return m_language.isEmpty() ? QLocale().name() : m_language;
+}
+
+void SpellCheckAttached::setLanguage(const QString &language)
+{
+    if (language == m_language) {
+        return;
+    }
+
+    m_language = language;
+    scheduleCheck();
+    Q_EMIT languageChanged();
+}
+
+void SpellCheckAttached::resetLanguage()
+{
+    setLanguage(QString());
+}
+
+QList<SpellCheckRange> SpellCheckAttached::misspellings() const
+{
+    return m_misspellings;
+}
+
+void SpellCheckAttached::updateChecking()
+{
+    // Only watch the text while it can be checked, as styles read this
+    // attached object for every text field.
+    if (!m_enabled || !parent() || !SpellCheckService::instance()) {
+        disconnect(m_textConnection);
+        m_textConnection = {};
+        if (m_checkTimer) {
+            m_checkTimer->stop();
+        }
+        cancelCheck();
+        setMisspellings({});
+        return;
+    }
+
+    if (!m_textConnection) {
+        const QMetaObject *metaObject = parent()->metaObject();
+        const QMetaProperty textProperty = metaObject->property(metaObject->indexOfProperty("text"));
+        if (!textProperty.hasNotifySignal()) {
+            return;
+        }
+
+        const QMetaMethod slot = staticMetaObject.method(staticMetaObject.indexOfSlot("scheduleCheck()"));
+        m_textConnection = connect(parent(), textProperty.notifySignal(), this, slot);
+    }
+
+    scheduleCheck();
+}
+
+void SpellCheckAttached::scheduleCheck()
+{
+    if (!m_textConnection) {
+        return;
+    }
+
+    if (!m_checkTimer) {
+        m_checkTimer = new QTimer(this);
+        m_checkTimer->setSingleShot(true);
+        m_checkTimer->setInterval(s_checkDelay);
+        connect(m_checkTimer, &QTimer::timeout, this, &SpellCheckAttached::check);
+    }
+    // The result of a check in progress would be for outdated text.
+    cancelCheck();
+    m_checkTimer->start();
+}
+
+void SpellCheckAttached::check()
+{
+    SpellCheckService *service = SpellCheckService::instance();
+    if (!service || !parent()) {
+        return;
+    }
+
+    cancelCheck();
+
+    const QString text = plainText(parent());
+    if (text.isEmpty()) {
+        setMisspellings({});
+        return;
+    }
+
+    m_canceled = std::make_shared<std::atomic_bool>(false);
+    service->check(language(), text, this, m_canceled, [this](const QList<SpellCheckRange> &misspellings) {
+        setMisspellings(misspellings);
+    });
+}
+
+void SpellCheckAttached::cancelCheck()
+{
+    if (m_canceled) {
+        *m_canceled = true;
+        m_canceled.reset();
+    }
+}
+
+void SpellCheckAttached::setMisspellings(const QList<SpellCheckRange> &misspellings)
+{
+    if (misspellings == m_misspellings) {
+        return;
+    }
+
+    m_misspellings = misspellings;
+    Q_EMIT misspellingsChanged();
+}
+
 SpellCheckAttached *SpellCheckAttached::qmlAttachedProperties(QObject *object)
 {
     return new SpellCheckAttached(object);
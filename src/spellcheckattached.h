@@ -6,17 +6,56 @@
 
 #include <QObject>
 #include <QQmlEngine>
+#include <QTimer>
 
 #include <qqmlregistration.h>
 
+#include <atomic>
+#include <memory>
+
+/**
+ * A misspelled word in the text of a text field using SpellCheck.
+ *
+ * @since 6.12
+ */
+struct SpellCheckRange {
+    Q_GADGET
+    QML_VALUE_TYPE(spellCheckRange)
+
+    /**
+     * The position of the first character of the word in the text.
+     */
+    Q_PROPERTY(int start MEMBER start FINAL)
+    /**
+     * The number of characters of the word.
+     */
+    Q_PROPERTY(int length MEMBER length FINAL)
+
+public:
+    int start = 0;
+    int length = 0;
+
+    bool operator==(const SpellCheckRange &other) const
+    {
+        return start == other.start && length == other.length;
+    }
+};
+
 /**
  * @brief This attached property contains hints for spell checker.
  *
- * @warning Kirigami doesn't provide any spell checker per se, this is just a
- * hint for QQC2 style implementation and other downstream components. If you
+ * @warning Kirigami doesn't provide any spell checker per se, this is mostly
+ * a hint for QQC2 style implementation and other downstream components. If you
  * want to  add spell checking to your custom application theme checkout
  * \ref Sonnet.
  *
+ * When the platform plugin or the application provides a
+ * Kirigami::Platform::SpellCheckerFactory, the text of the item is also
+ * checked by a service shared by the whole process, and the misspelled words
+ * are reported through misspellings. The dictionary of every language is
+ * only loaded once, and the text is checked on a worker thread after the
+ * user stops typing, so checking doesn't block the user interface.
+ *
  * @code
  * import QtQuick.Controls as QQC2
  * import org.kde.kirigami as Kirigami
@@ -47,6 +86,26 @@ class SpellCheckAttached : public QObject
      * @since 2.18
      */
     Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged FINAL)
+
+    /**
+     * The language the text is checked in, as a locale name like `en_US`.
+     *
+     * default: the name of the default locale
+     *
+     * @since 6.12
+     */
+    Q_PROPERTY(QString language READ language WRITE setLanguage RESET resetLanguage NOTIFY languageChanged FINAL)
+
+    /**
+     * The misspelled words of the text, in the order they appear in it.
+     *
+     * This is updated asynchronously after the text changes, and is always
+     * empty when no spell checker is available or spell checking is disabled.
+     *
+     * @since 6.12
+     */
+    Q_PROPERTY(QList<SpellCheckRange> misspellings READ misspellings NOTIFY misspellingsChanged FINAL)
+
 public:
     explicit SpellCheckAttached(QObject *parent = nullptr);
     ~SpellCheckAttached() override;
@@ -54,14 +113,38 @@ public:
     void setEnabled(bool enabled);
     bool enabled() const;
 
+    QString language() const;
+    void setLanguage(const QString &language);
+    void resetLanguage();
+
+    QList<SpellCheckRange> misspellings() const;
+
     // QML attached property
     static SpellCheckAttached *qmlAttachedProperties(QObject *object);
 
 Q_SIGNALS:
     void enabledChanged();
+    void languageChanged();
+    void misspellingsChanged();
+
+private Q_SLOTS:
+    void scheduleCheck();
 
 private:
+    void updateChecking();
+    void check();
+    void cancelCheck();
+    void setMisspellings(const QList<SpellCheckRange> &misspellings);
+
     bool m_enabled = false;
+    QString m_language;
+    QList<SpellCheckRange> m_misspellings;
+
+    // Waits for typing to pause before checking the text.
+    QTimer *m_checkTimer = nullptr;
+    QMetaObject::Connection m_textConnection;
+    // Set to cancel the check in progress, when the text changed again.
+    std::shared_ptr<std::atomic_bool> m_canceled;
 };
 
 QML_DECLARE_TYPEINFO(SpellCheckAttached, QML_HAS_ATTACHED_PROPERTIES)
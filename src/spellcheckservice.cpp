@@ -0,0 +1,170 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "spellcheckservice.h"
+
+#include <QHash>
+#include <QPointer>
+#include <QTextBoundaryFinder>
+
+#include <algorithm>
+#include <map>
+
+#include <platform/spellchecker.h>
+
+using Kirigami::Platform::SpellChecker;
+using Kirigami::Platform::SpellCheckerFactory;
+
+// The cache of checked words of a language is cleared when it grows above
+// this, to bound its memory.
+static constexpr int s_maximumCachedWords = 20000;
+
+static bool containsLetter(QStringView word)
+{
+    return std::any_of(word.begin(), word.end(), [](QChar c) {
+        return c.isLetter();
+    });
+}
+
+class SpellCheckWorker : public QObject
+{
+public:
+    explicit SpellCheckWorker(SpellCheckerFactory *factory)
+        : m_factory(factory)
+    {
+    }
+
+    QList<SpellCheckRange> check(const QString &language, const QString &text, const std::atomic_bool &canceled)
+    {
+        Language &checked = languageFor(language);
+        if (!checked.checker) {
+            return {};
+        }
+
+        QList<SpellCheckRange> misspellings;
+
+        QTextBoundaryFinder finder(QTextBoundaryFinder::Word, text);
+        qsizetype start = (finder.boundaryReasons() & QTextBoundaryFinder::StartOfItem) ? 0 : -1;
+
+        while (finder.toNextBoundary() != -1) {
+            const QTextBoundaryFinder::BoundaryReasons reasons = finder.boundaryReasons();
+            const qsizetype position = finder.position();
+
+            if (start >= 0 && (reasons & QTextBoundaryFinder::EndOfItem)) {
+                if (canceled) {
+                    return {};
+                }
+
+                const QStringView word = QStringView(text).mid(start, position - start);
+                if (containsLetter(word) && !isCorrect(checked, word)) {
+                    misspellings.append(SpellCheckRange{int(start), int(word.size())});
+                }
+                start = -1;
+            }
+
+            if (reasons & QTextBoundaryFinder::StartOfItem) {
+                start = position;
+            }
+        }
+
+        return misspellings;
+    }
+
+private:
+    struct Language {
+        // Null when there is no dictionary for the language.
+        std::unique_ptr<SpellChecker> checker;
+        QHash<QString, bool> words;
+    };
+
+    Language &languageFor(const QString &name)
+    {
+        auto it = m_languages.find(name);
+        if (it == m_languages.end()) {
+            // Dictionaries are loaded once, even when they are not available.
+            it = m_languages.emplace(name, Language{m_factory->createSpellChecker(name), {}}).first;
+        }
+        return it->second;
+    }
+
+    static bool isCorrect(Language &language, QStringView word)
+    {
+        const QString key = word.toString();
+        const auto it = language.words.constFind(key);
+        if (it != language.words.constEnd()) {
+            return it.value();
+        }
+
+        if (language.words.size() >= s_maximumCachedWords) {
+            language.words.clear();
+        }
+
+        const bool correct = language.checker->isCorrect(word);
+        language.words.insert(key, correct);
+        return correct;
+    }
+
+    SpellCheckerFactory *const m_factory;
+    std::map<QString, Language> m_languages;
+};
+
+Q_GLOBAL_STATIC(SpellCheckService, s_service)
+
+SpellCheckService::SpellCheckService()
+    : m_worker(new SpellCheckWorker(SpellCheckerFactory::instance()))
+{
+    m_worker->moveToThread(&m_thread);
+    m_thread.setObjectName(QStringLiteral("Kirigami spell checking"));
+    m_thread.start(QThread::LowPriority);
+}
+
+SpellCheckService::~SpellCheckService()
+{
+    m_thread.quit();
+    m_thread.wait();
+    // There are no events left to process for the worker once its thread stopped.
+    delete m_worker;
+}
+
+SpellCheckService *SpellCheckService::instance()
+{
+    if (!SpellCheckerFactory::instance() || s_service.isDestroyed()) {
+        return nullptr;
+    }
+    return s_service;
+}
+
+void SpellCheckService::check(const QString &language,
+                              const QString &text,
+                              QObject *context,
+                              const std::shared_ptr<std::atomic_bool> &canceled,
+                              const Callback &callback)
+{
+    QMetaObject::invokeMethod(
+        m_worker,
+        [this, language, text, context = QPointer<QObject>(context), canceled, callback]() {
+            if (*canceled) {
+                return;
+            }
+
+            const QList<SpellCheckRange> misspellings = m_worker->check(language, text, *canceled);
+            if (*canceled) {
+                return;
+            }
+
+            QMetaObject::invokeMethod(
+                this,
+                [context, canceled, callback, misspellings]() {
+                    if (context && !*canceled) {
+                        callback(misspellings);
+                    }
+                },
+                Qt::QueuedConnection);
+        },
+        Qt::QueuedConnection);
+}
+
+#include "moc_spellcheckservice.cpp"
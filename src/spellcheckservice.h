@@ -0,0 +1,70 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QThread>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "spellcheckattached.h"
+
+namespace Kirigami
+{
+namespace Platform
+{
+class SpellCheckerFactory;
+}
+}
+
+class SpellCheckWorker;
+
+/**
+ * Checks the spelling of the text of all the SpellCheckAttached objects of
+ * the process on a single worker thread.
+ *
+ * The worker loads the dictionary of every language only once, and caches
+ * the result for every word it checked, so checking a text again after a few
+ * characters were typed only asks the spell checker about the words that
+ * changed.
+ *
+ * \internal This is private API, do not use.
+ */
+class SpellCheckService : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Callback = std::function<void(const QList<SpellCheckRange> &misspellings)>;
+
+    SpellCheckService();
+    ~SpellCheckService() override;
+
+    /**
+     * The service of the process, which needs to be used on the GUI thread,
+     * or nullptr if no spell checker is available.
+     */
+    static SpellCheckService *instance();
+
+    /**
+     * Checks @p text in @p language, and calls @p callback with the
+     * misspelled words on the GUI thread, unless @p context was
+     * destroyed or @p canceled was set in the meantime.
+     */
+    void check(const QString &language,
+               const QString &text,
+               QObject *context,
+               const std::shared_ptr<std::atomic_bool> &canceled,
+               const Callback &callback);
+
+private:
+    QThread m_thread;
+    // Lives on m_thread.
+    SpellCheckWorker *m_worker = nullptr;
+};
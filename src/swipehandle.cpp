@@ -0,0 +1,384 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "swipehandle.h"
+
+#include <QGuiApplication>
+#include <QHash>
+#include <QMouseEvent>
+#include <QStyleHints>
+
+using HandlesHash = QHash<QQuickItem *, SwipeHandle *>;
+Q_GLOBAL_STATIC(HandlesHash, s_handles)
+
+static bool exceedsDragDistance(qreal delta)
+{
+    return qAbs(delta) > QGuiApplication::styleHints()->startDragDistance();
+}
+
+SwipeHandle::SwipeHandle(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setAcceptedMouseButtons(Qt::LeftButton);
+}
+
+SwipeHandle::~SwipeHandle()
+{
+    if (m_registeredTarget && !s_handles.isDestroyed()) {
+        s_handles->remove(m_registeredTarget);
+    }
+}
+
+QQuickItem *SwipeHandle::target() const
+{
+    return m_target;
+}
+
+void SwipeHandle::setTarget(QQuickItem *target)
+{
+    if (target == m_target) {
+        return;
+    }
+
+    if (m_registeredTarget) {
+        s_handles->remove(m_registeredTarget);
+    }
+
+    m_target = target;
+    m_registeredTarget = target;
+    m_swipe = nullptr;
+    m_positionProperty = QMetaProperty();
+
+    if (m_target) {
+        s_handles->insert(m_target, this);
+
+        m_swipe = m_target->property("swipe").value<QObject *>();
+        if (m_swipe) {
+            const QMetaObject *metaObject = m_swipe->metaObject();
+            m_positionProperty = metaObject->property(metaObject->indexOfProperty("position"));
+        }
+    }
+
+    Q_EMIT targetChanged();
+}
+
+qreal SwipeHandle::openPosition() const
+{
+    return m_openPosition;
+}
+
+void SwipeHandle::setOpenPosition(qreal position)
+{
+    if (qFuzzyCompare(position, m_openPosition)) {
+        return;
+    }
+
+    m_openPosition = position;
+    Q_EMIT openPositionChanged();
+}
+
+bool SwipeHandle::isMirrored() const
+{
+    return m_mirrored;
+}
+
+void SwipeHandle::setMirrored(bool mirrored)
+{
+    if (mirrored == m_mirrored) {
+        return;
+    }
+
+    m_mirrored = mirrored;
+    Q_EMIT mirroredChanged();
+}
+
+bool SwipeHandle::isPressed() const
+{
+    return m_pressed;
+}
+
+SwipeHandle *SwipeHandle::handleFor(QQuickItem *item)
+{
+    if (!item || s_handles.isDestroyed()) {
+        return nullptr;
+    }
+
+    // Delegates of a ListView are often wrappers around the SwipeListItem.
+    // A target can be destroyed before its handle, and its address reused by
+    // another item, so check that the handle still belongs to the item.
+    SwipeHandle *handle = s_handles->value(item);
+    if (handle && handle->target() == item) {
+        return handle;
+    }
+
+    const auto children = item->childItems();
+    for (QQuickItem *child : children) {
+        handle = s_handles->value(child);
+        if (handle && handle->target() == child) {
+            return handle;
+        }
+    }
+
+    return nullptr;
+}
+
+void SwipeHandle::beginSwipe()
+{
+    if (!m_target) {
+        return;
+    }
+
+    m_lastPosition = position();
+    m_openIntention = false;
+    m_rightPadding = m_target->property("rightPadding").toReal();
+    setPressed(true);
+}
+
+void SwipeHandle::swipeTo(qreal peek)
+{
+    updatePosition(m_mirrored ? peek : -peek);
+}
+
+void SwipeHandle::endSwipe(bool toggle)
+{
+    if (!m_pressed) {
+        return;
+    }
+
+    setPressed(false);
+
+    const qreal current = position();
+    qreal to = 0.0;
+    if (toggle) {
+        if (m_mirrored) {
+            to = current < 0.5 ? m_openPosition : 0.0;
+        } else {
+            to = current > -0.5 ? -m_openPosition : 0.0;
+        }
+    } else if (m_openIntention) {
+        to = m_mirrored ? m_openPosition : -m_openPosition;
+    }
+
+    Q_EMIT settleRequested(to);
+}
+
+void SwipeHandle::close()
+{
+    setPressed(false);
+    Q_EMIT settleRequested(0.0);
+}
+
+qreal SwipeHandle::position() const
+{
+    if (!m_swipe || !m_positionProperty.isValid()) {
+        return 0.0;
+    }
+    return m_positionProperty.read(m_swipe).toReal();
+}
+
+void SwipeHandle::setPosition(qreal position)
+{
+    if (m_swipe && m_positionProperty.isValid()) {
+        m_positionProperty.write(m_swipe, position);
+    }
+}
+
+void SwipeHandle::updatePosition(qreal position)
+{
+    if (!m_pressed) {
+        return;
+    }
+
+    if (m_mirrored) {
+        position = qBound(0.0, position, m_openPosition);
+        m_openIntention = position > m_lastPosition;
+    } else {
+        position = qBound(-m_openPosition, position, 0.0);
+        m_openIntention = position < m_lastPosition;
+    }
+
+    setPosition(position);
+    m_lastPosition = position;
+}
+
+void SwipeHandle::setPressed(bool pressed)
+{
+    if (pressed == m_pressed) {
+        return;
+    }
+
+    m_pressed = pressed;
+    Q_EMIT pressedChanged();
+}
+
+void SwipeHandle::mousePressEvent(QMouseEvent *event)
+{
+    if (!m_target || !m_swipe || m_openPosition <= 0.0) {
+        event->ignore();
+        return;
+    }
+
+    m_pressX = event->scenePosition().x();
+    m_dragging = false;
+    setKeepMouseGrab(true);
+    beginSwipe();
+    event->accept();
+}
+
+void SwipeHandle::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!m_pressed || !m_target) {
+        return;
+    }
+
+    m_dragging = m_dragging || exceedsDragDistance(event->scenePosition().x() - m_pressX);
+
+    const qreal width = m_target->width();
+    if (width <= 0.0) {
+        return;
+    }
+
+    const qreal x = m_target->mapFromScene(event->scenePosition()).x();
+    if (m_mirrored) {
+        updatePosition(x / width);
+    } else {
+        updatePosition(x / (width - m_rightPadding) - 1.0);
+    }
+}
+
+void SwipeHandle::mouseReleaseEvent(QMouseEvent *event)
+{
+    setKeepMouseGrab(false);
+    // A release without a drag is a click, which toggles the actions.
+    endSwipe(!m_dragging);
+    m_dragging = false;
+    event->accept();
+}
+
+void SwipeHandle::mouseUngrabEvent()
+{
+    setKeepMouseGrab(false);
+    endSwipe(false);
+    m_dragging = false;
+}
+
+SwipeEdgeArea::SwipeEdgeArea(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setAcceptedMouseButtons(Qt::LeftButton);
+}
+
+QQuickItem *SwipeEdgeArea::flickable() const
+{
+    return m_flickable;
+}
+
+void SwipeEdgeArea::setFlickable(QQuickItem *flickable)
+{
+    if (flickable == m_flickable) {
+        return;
+    }
+
+    m_flickable = flickable;
+    Q_EMIT flickableChanged();
+}
+
+QQuickItem *SwipeEdgeArea::currentItem() const
+{
+    return m_currentItem;
+}
+
+QQuickItem *SwipeEdgeArea::contentItem() const
+{
+    if (!m_flickable) {
+        return nullptr;
+    }
+    return m_flickable->property("contentItem").value<QQuickItem *>();
+}
+
+QPointF SwipeEdgeArea::updateCurrentItem(const QPointF &scenePos)
+{
+    QQuickItem *content = contentItem();
+    if (!content) {
+        return QPointF();
+    }
+
+    const QPointF pos = content->mapFromScene(scenePos);
+    QQuickItem *item = content->childAt(pos.x(), pos.y());
+    if (item != m_currentItem) {
+        SwipeHandle *handle = SwipeHandle::handleFor(item);
+        if (m_handle && m_handle != handle) {
+            m_handle->close();
+        }
+        if (handle && handle != m_handle) {
+            handle->beginSwipe();
+        }
+
+        m_currentItem = item;
+        m_handle = handle;
+        Q_EMIT currentItemChanged();
+    }
+
+    return pos;
+}
+
+void SwipeEdgeArea::finish(bool toggle)
+{
+    setKeepMouseGrab(false);
+    m_dragging = false;
+
+    if (m_handle) {
+        m_handle->endSwipe(toggle);
+    }
+}
+
+void SwipeEdgeArea::mousePressEvent(QMouseEvent *event)
+{
+    m_pressX = event->scenePosition().x();
+    m_dragging = false;
+    setKeepMouseGrab(true);
+
+    updateCurrentItem(event->scenePosition());
+    if (m_handle && !m_handle->isPressed()) {
+        m_handle->beginSwipe();
+    }
+
+    event->accept();
+}
+
+void SwipeEdgeArea::mouseMoveEvent(QMouseEvent *event)
+{
+    m_dragging = m_dragging || exceedsDragDistance(event->scenePosition().x() - m_pressX);
+
+    const QPointF pos = updateCurrentItem(event->scenePosition());
+    QQuickItem *content = contentItem();
+    // The handle is hidden when the item has no visible actions.
+    if (!m_handle || !m_handle->isVisible() || !content || content->width() <= 0.0) {
+        return;
+    }
+
+    m_handle->swipeTo(1.0 - pos.x() / content->width());
+}
+
+void SwipeEdgeArea::mouseReleaseEvent(QMouseEvent *event)
+{
+    // Clicking the edge of a closed item toggles its actions like clicking
+    // its handle does.
+    bool toggle = false;
+    if (!m_dragging && m_handle && m_handle->target()) {
+        toggle = qAbs(m_handle->position() * m_handle->target()->width()) < width();
+    }
+
+    finish(toggle);
+    event->accept();
+}
+
+void SwipeEdgeArea::mouseUngrabEvent()
+{
+    finish(false);
+}
+
+#include "moc_swipehandle.cpp"
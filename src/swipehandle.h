@@ -0,0 +1,207 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Kirigami contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QMetaProperty>
+#include <QPointer>
+#include <QQuickItem>
+
+/**
+ * The drag handle of a SwipeListItem in tablet mode.
+ *
+ * Dragging the handle moves the `swipe.position` of the `target`
+ * SwipeDelegate to reveal its actions, clamped to `openPosition`. When the
+ * gesture ends, settleRequested() is emitted with the position the item should
+ * animate to: open if the last movement was towards opening it, closed
+ * otherwise, or toggled if the handle was clicked.
+ *
+ * The gesture is tracked here rather than in QML so that dragging does not
+ * run any JavaScript or evaluate bindings per move event.
+ *
+ * \internal This is private API, do not use.
+ */
+class SwipeHandle : public QQuickItem
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    /**
+     * The SwipeDelegate whose swipe position is driven by the handle.
+     */
+    Q_PROPERTY(QQuickItem *target READ target WRITE setTarget NOTIFY targetChanged FINAL)
+
+    /**
+     * The swipe position at which the actions are fully revealed, as a
+     * fraction of the width of `target`, without sign.
+     */
+    Q_PROPERTY(qreal openPosition READ openPosition WRITE setOpenPosition NOTIFY openPositionChanged FINAL)
+
+    /**
+     * Whether the actions are revealed on the left side, for right to left
+     * layouts.
+     */
+    Q_PROPERTY(bool mirrored READ isMirrored WRITE setMirrored NOTIFY mirroredChanged FINAL)
+
+    /**
+     * Whether a swipe gesture is in progress, on the handle or on a
+     * SwipeEdgeArea.
+     */
+    Q_PROPERTY(bool pressed READ isPressed NOTIFY pressedChanged FINAL)
+
+    // Makes ColumnView leave horizontal drags over the handle alone, as it
+    // does for MouseArea.
+    Q_PROPERTY(bool preventStealing READ preventStealing CONSTANT FINAL)
+
+public:
+    explicit SwipeHandle(QQuickItem *parent = nullptr);
+    ~SwipeHandle() override;
+
+    QQuickItem *target() const;
+    void setTarget(QQuickItem *target);
+
+    qreal openPosition() const;
+    void setOpenPosition(qreal position);
+
+    bool isMirrored() const;
+    void setMirrored(bool mirrored);
+
+    bool isPressed() const;
+
+    bool preventStealing() const
+    {
+        return true;
+    }
+
+    /**
+     * The handle of the SwipeListItem @p item, or of one of its direct
+     * children, if any.
+     */
+    static SwipeHandle *handleFor(QQuickItem *item);
+
+    /**
+     * Gestures driven by a SwipeEdgeArea. @p peek is the fraction of the width
+     * of the view the pointer moved away from its trailing edge.
+     */
+    void beginSwipe();
+    void swipeTo(qreal peek);
+    void endSwipe(bool toggle);
+
+    /**
+     * Requests the item to animate back to its closed position.
+     */
+    void close();
+
+    /**
+     * The current swipe position of `target`.
+     */
+    qreal position() const;
+
+Q_SIGNALS:
+    void targetChanged();
+    void openPositionChanged();
+    void mirroredChanged();
+    void pressedChanged();
+
+    /**
+     * Emitted when a gesture ended and `target` should animate to the swipe
+     * @p position.
+     */
+    void settleRequested(qreal position);
+
+protected:
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseUngrabEvent() override;
+
+private:
+    void setPressed(bool pressed);
+    void setPosition(qreal position);
+    void updatePosition(qreal position);
+
+    QPointer<QQuickItem> m_target;
+    // The key of the handle in the registry used by handleFor(), which stays
+    // valid to be removed even once the target is destroyed.
+    QQuickItem *m_registeredTarget = nullptr;
+    // target.swipe, and its position property, resolved once when target is set.
+    QPointer<QObject> m_swipe;
+    QMetaProperty m_positionProperty;
+
+    qreal m_openPosition = 0.0;
+    qreal m_lastPosition = 0.0;
+    qreal m_pressX = 0.0;
+    qreal m_rightPadding = 0.0;
+    bool m_mirrored = false;
+    bool m_pressed = false;
+    bool m_dragging = false;
+    bool m_openIntention = false;
+};
+
+/**
+ * An area along the trailing edge of a ScrollablePage that allows swiping
+ * the SwipeListItems of its view from the edge, without reaching for their
+ * handles.
+ *
+ * The item under the pointer is looked up natively on every move; its
+ * SwipeHandle is then driven directly, and the item that was swiped before is
+ * closed.
+ *
+ * \internal This is private API, do not use.
+ */
+class SwipeEdgeArea : public QQuickItem
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    /**
+     * The Flickable whose delegates are swiped.
+     */
+    Q_PROPERTY(QQuickItem *flickable READ flickable WRITE setFlickable NOTIFY flickableChanged FINAL)
+
+    /**
+     * The delegate of `flickable` under the pointer during a gesture.
+     */
+    Q_PROPERTY(QQuickItem *currentItem READ currentItem NOTIFY currentItemChanged FINAL)
+
+    Q_PROPERTY(bool preventStealing READ preventStealing CONSTANT FINAL)
+
+public:
+    explicit SwipeEdgeArea(QQuickItem *parent = nullptr);
+
+    QQuickItem *flickable() const;
+    void setFlickable(QQuickItem *flickable);
+
+    QQuickItem *currentItem() const;
+
+    bool preventStealing() const
+    {
+        return true;
+    }
+
+Q_SIGNALS:
+    void flickableChanged();
+    void currentItemChanged();
+
+protected:
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseUngrabEvent() override;
+
+private:
+    QQuickItem *contentItem() const;
+    // Updates currentItem for the scene position @p scenePos and returns its
+    // position in the content item of flickable.
+    QPointF updateCurrentItem(const QPointF &scenePos);
+    void finish(bool toggle);
+
+    QPointer<QQuickItem> m_flickable;
+    QPointer<QQuickItem> m_currentItem;
+    QPointer<SwipeHandle> m_handle;
+    qreal m_pressX = 0.0;
+    bool m_dragging = false;
+};
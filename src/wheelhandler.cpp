@@ -12,6 +12,8 @@
 #include <QQuickWindow>
 #include <QWheelEvent>
 
+#include <cmath>
+
 KirigamiWheelEvent::KirigamiWheelEvent(QObject *parent)
     : QObject(parent)
 {
@@ -86,6 +88,104 @@ WheelFilterItem::WheelFilterItem(QQuickItem *parent)
     setEnabled(false);
 }
 
+void WheelFilterItem::updatePolish()
+{
+    Q_EMIT polishing();
+}
+
+///////////////////////////////
+
+KineticScrollAnimation::KineticScrollAnimation(QObject *parent)
+    : QAbstractAnimation(parent)
+{
+}
+
+void KineticScrollAnimation::setTarget(QObject *target, const QMetaProperty &property)
+{
+    stop();
+    m_target = target;
+    m_property = property;
+}
+
+void KineticScrollAnimation::setSettleDuration(int duration)
+{
+    m_settleDuration = duration;
+}
+
+qreal KineticScrollAnimation::endValue() const
+{
+    return m_endValue;
+}
+
+void KineticScrollAnimation::scrollTo(qreal value)
+{
+    if (!m_target) {
+        return;
+    }
+
+    m_endValue = value;
+
+    if (m_settleDuration <= 0) {
+        stop();
+        write(value);
+        return;
+    }
+
+    if (state() != QAbstractAnimation::Running) {
+        start();
+    }
+}
+
+int KineticScrollAnimation::duration() const
+{
+    // Runs until the end value is reached.
+    return -1;
+}
+
+void KineticScrollAnimation::updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState)
+{
+    Q_UNUSED(oldState)
+
+    if (newState == QAbstractAnimation::Running && m_target) {
+        m_position = m_property.read(m_target).toReal();
+        m_lastTime = 0;
+    }
+}
+
+void KineticScrollAnimation::updateCurrentTime(int currentTime)
+{
+    if (!m_target) {
+        stop();
+        return;
+    }
+
+    // Something else moved the content, stop fighting it.
+    if (std::abs(m_property.read(m_target).toReal() - m_position) >= 1.0) {
+        stop();
+        return;
+    }
+
+    const int elapsed = currentTime - m_lastTime;
+    m_lastTime = currentTime;
+
+    // The remaining distance drops below 1% after five time constants.
+    const qreal timeConstant = m_settleDuration / 5.0;
+    const qreal remaining = (m_endValue - m_position) * std::exp(-elapsed / timeConstant);
+
+    if (std::abs(remaining) < 0.5) {
+        write(m_endValue);
+        stop();
+    } else {
+        write(m_endValue - remaining);
+    }
+}
+
+void KineticScrollAnimation::write(qreal value)
+{
+    m_position = value;
+    m_property.write(m_target, value);
+}
+
 ///////////////////////////////
 
 WheelHandler::WheelHandler(QObject *parent)
@@ -93,6 +193,7 @@ WheelHandler::WheelHandler(QObject *parent)
     , m_filterItem(new WheelFilterItem(nullptr))
 {
     m_filterItem->installEventFilter(this);
+    connect(static_cast<WheelFilterItem *>(m_filterItem.data()), &WheelFilterItem::polishing, this, &WheelHandler::applyPendingScroll);
 
     m_wheelScrollingTimer.setSingleShot(true);
     m_wheelScrollingTimer.setInterval(m_wheelScrollingDuration);
@@ -100,8 +201,6 @@ WheelHandler::WheelHandler(QObject *parent)
         setScrolling(false);
     });
 
-    m_yScrollAnimation.setEasingCurve(QEasingCurve::OutCubic);
-
     connect(QGuiApplication::styleHints(), &QStyleHints::wheelScrollLinesChanged, this, [this](int scrollLines) {
         m_defaultPixelStepSize = 20 * scrollLines;
         if (!m_explicitVStepSize && m_verticalStepSize != m_defaultPixelStepSize) {
@@ -136,6 +235,9 @@ void WheelHandler::setTarget(QQuickItem *target)
         return;
     }
 
+    // Do not apply scrolling meant for the previous target to the new one.
+    m_pendingScroll = {};
+
     if (m_flickable) {
         m_flickable->removeEventFilter(this);
         disconnect(m_flickable, nullptr, m_filterItem, nullptr);
@@ -143,11 +245,25 @@ void WheelHandler::setTarget(QQuickItem *target)
     }
 
     m_flickable = target;
-    m_filterItem->setParentItem(target);
-    if (m_yScrollAnimation.targetObject()) {
-        m_yScrollAnimation.stop();
+    m_flickableProperties = {};
+    if (target) {
+        const QMetaObject *metaObject = target->metaObject();
+        auto property = [metaObject](const char *name) {
+            return metaObject->property(metaObject->indexOfProperty(name));
+        };
+        m_flickableProperties.contentWidth = property("contentWidth");
+        m_flickableProperties.contentHeight = property("contentHeight");
+        m_flickableProperties.contentX = property("contentX");
+        m_flickableProperties.contentY = property("contentY");
+        m_flickableProperties.topMargin = property("topMargin");
+        m_flickableProperties.bottomMargin = property("bottomMargin");
+        m_flickableProperties.leftMargin = property("leftMargin");
+        m_flickableProperties.rightMargin = property("rightMargin");
+        m_flickableProperties.originX = property("originX");
+        m_flickableProperties.originY = property("originY");
     }
-    m_yScrollAnimation.setTargetObject(target);
+    m_filterItem->setParentItem(target);
+    m_yScrollAnimation.setTarget(target, m_flickableProperties.contentY);
 
     if (target) {
         target->installEventFilter(this);
@@ -391,6 +507,7 @@ void WheelHandler::classBegin()
     initSmoothScrollDuration();
 
     connect(m_units, &Kirigami::Platform::Units::longDurationChanged, this, &WheelHandler::initSmoothScrollDuration);
+    connect(m_units, &Kirigami::Platform::Units::reducedMotionChanged, this, &WheelHandler::initSmoothScrollDuration);
     connect(m_settings, &Kirigami::Platform::Settings::smoothScrollChanged, this, &WheelHandler::initSmoothScrollDuration);
 }
 
@@ -400,10 +517,10 @@ void WheelHandler::componentComplete()
 
 void WheelHandler::initSmoothScrollDuration()
 {
-    if (m_settings->smoothScroll()) {
-        m_yScrollAnimation.setDuration(m_units->longDuration());
+    if (m_settings->smoothScroll() && !m_units->reducedMotion()) {
+        m_yScrollAnimation.setSettleDuration(m_units->longDuration());
     } else {
-        m_yScrollAnimation.setDuration(0);
+        m_yScrollAnimation.setSettleDuration(0);
     }
 }
 
@@ -427,16 +544,16 @@ bool WheelHandler::scrollFlickable(QPointF pixelDelta, QPointF angleDelta, Qt::K
 
     const qreal width = m_flickable->width();
     const qreal height = m_flickable->height();
-    const qreal contentWidth = m_flickable->property("contentWidth").toReal();
-    const qreal contentHeight = m_flickable->property("contentHeight").toReal();
-    const qreal contentX = m_flickable->property("contentX").toReal();
-    const qreal contentY = m_flickable->property("contentY").toReal();
-    const qreal topMargin = m_flickable->property("topMargin").toReal();
-    const qreal bottomMargin = m_flickable->property("bottomMargin").toReal();
-    const qreal leftMargin = m_flickable->property("leftMargin").toReal();
-    const qreal rightMargin = m_flickable->property("rightMargin").toReal();
-    const qreal originX = m_flickable->property("originX").toReal();
-    const qreal originY = m_flickable->property("originY").toReal();
+    const qreal contentWidth = m_flickableProperties.contentWidth.read(m_flickable).toReal();
+    const qreal contentHeight = m_flickableProperties.contentHeight.read(m_flickable).toReal();
+    const qreal contentX = m_flickableProperties.contentX.read(m_flickable).toReal();
+    const qreal contentY = m_flickableProperties.contentY.read(m_flickable).toReal();
+    const qreal topMargin = m_flickableProperties.topMargin.read(m_flickable).toReal();
+    const qreal bottomMargin = m_flickableProperties.bottomMargin.read(m_flickable).toReal();
+    const qreal leftMargin = m_flickableProperties.leftMargin.read(m_flickable).toReal();
+    const qreal rightMargin = m_flickableProperties.rightMargin.read(m_flickable).toReal();
+    const qreal originX = m_flickableProperties.originX.read(m_flickable).toReal();
+    const qreal originY = m_flickableProperties.originY.read(m_flickable).toReal();
     const qreal pageWidth = width - leftMargin - rightMargin;
     const qreal pageHeight = height - topMargin - bottomMargin;
     const auto window = m_flickable->window();
@@ -479,7 +596,7 @@ bool WheelHandler::scrollFlickable(QPointF pixelDelta, QPointF angleDelta, Qt::K
         newContentX = std::round(newContentX * devicePixelRatio) / devicePixelRatio;
         if (contentX != newContentX) {
             scrolled = true;
-            m_flickable->setProperty("contentX", newContentX);
+            m_flickableProperties.contentX.write(m_flickable, newContentX);
         }
     }
 
@@ -499,9 +616,9 @@ bool WheelHandler::scrollFlickable(QPointF pixelDelta, QPointF angleDelta, Qt::K
         qreal maxYExtent = height - (contentHeight + bottomMargin + originY);
 
         qreal newContentY;
-        if (m_yScrollAnimation.state() == QPropertyAnimation::Running) {
-            m_yScrollAnimation.stop();
-            newContentY = std::clamp(m_yScrollAnimation.endValue().toReal() + -yChange, -minYExtent, -maxYExtent);
+        if (m_yScrollAnimation.state() == QAbstractAnimation::Running) {
+            // Keep moving towards the previous end value, but further.
+            newContentY = std::clamp(m_yScrollAnimation.endValue() + -yChange, -minYExtent, -maxYExtent);
         } else {
             newContentY = std::clamp(contentY - yChange, -minYExtent, -maxYExtent);
         }
@@ -515,10 +632,10 @@ bool WheelHandler::scrollFlickable(QPointF pixelDelta, QPointF angleDelta, Qt::K
         if (contentY != newContentY) {
             scrolled = true;
             if (m_wasTouched || !m_engine) {
-                m_flickable->setProperty("contentY", newContentY);
+                m_yScrollAnimation.stop();
+                m_flickableProperties.contentY.write(m_flickable, newContentY);
             } else {
-                m_yScrollAnimation.setEndValue(newContentY);
-                m_yScrollAnimation.start(QAbstractAnimation::KeepWhenStopped);
+                m_yScrollAnimation.scrollTo(newContentY);
             }
         }
     }
@@ -526,6 +643,38 @@ bool WheelHandler::scrollFlickable(QPointF pixelDelta, QPointF angleDelta, Qt::K
     return scrolled;
 }
 
+void WheelHandler::addPendingScroll(QPointF pixelDelta, QPointF angleDelta, Qt::KeyboardModifiers modifiers)
+{
+    // The modifiers decide how the deltas are applied, so don't mix deltas with different ones.
+    if (m_pendingScroll.scheduled && m_pendingScroll.modifiers != modifiers) {
+        applyPendingScroll();
+    }
+
+    m_pendingScroll.pixelDelta += pixelDelta;
+    m_pendingScroll.angleDelta += angleDelta;
+    m_pendingScroll.modifiers = modifiers;
+
+    if (!m_pendingScroll.scheduled) {
+        m_pendingScroll.scheduled = true;
+        // Scrolling while the window polishes its items lets the Flickable
+        // lay out its new content in the same frame. After animating would
+        // be too late, the items are already polished by then.
+        m_filterItem->polish();
+    }
+}
+
+void WheelHandler::applyPendingScroll()
+{
+    if (!m_pendingScroll.scheduled || !m_flickable) {
+        return;
+    }
+
+    const PendingScroll pending = m_pendingScroll;
+    m_pendingScroll = {};
+
+    setScrolling(scrollFlickable(pending.pixelDelta, pending.angleDelta, pending.modifiers));
+}
+
 bool WheelHandler::scrollUp(qreal stepSize)
 {
     if (qFuzzyIsNull(stepSize)) {
@@ -582,10 +731,10 @@ bool WheelHandler::eventFilter(QObject *watched, QEvent *event)
     qreal pageWidth = 0;
     qreal pageHeight = 0;
     if (m_flickable) {
-        contentWidth = m_flickable->property("contentWidth").toReal();
-        contentHeight = m_flickable->property("contentHeight").toReal();
-        pageWidth = m_flickable->width() - m_flickable->property("leftMargin").toReal() - m_flickable->property("rightMargin").toReal();
-        pageHeight = m_flickable->height() - m_flickable->property("topMargin").toReal() - m_flickable->property("bottomMargin").toReal();
+        contentWidth = m_flickableProperties.contentWidth.read(m_flickable).toReal();
+        contentHeight = m_flickableProperties.contentHeight.read(m_flickable).toReal();
+        pageWidth = m_flickable->width() - m_flickableProperties.leftMargin.read(m_flickable).toReal() - m_flickableProperties.rightMargin.read(m_flickable).toReal();
+        pageHeight = m_flickable->height() - m_flickableProperties.topMargin.read(m_flickable).toReal() - m_flickableProperties.bottomMargin.read(m_flickable).toReal();
     }
 
     // The code handling touch, mouse and hover events is mostly copied/adapted from QQuickScrollView::childMouseEventFilter()
@@ -638,9 +787,18 @@ bool WheelHandler::eventFilter(QObject *watched, QEvent *event)
             // Don't use pixelDelta from the event unless angleDelta is not available
             // because scrolling by pixelDelta is too slow on Wayland with libinput.
             QPointF pixelDelta = m_kirigamiWheelEvent.angleDelta().isNull() ? m_kirigamiWheelEvent.pixelDelta() : QPoint(0, 0);
-            scrolled = scrollFlickable(pixelDelta, m_kirigamiWheelEvent.angleDelta(), Qt::KeyboardModifiers(m_kirigamiWheelEvent.modifiers()));
+            const auto modifiers = Qt::KeyboardModifiers(m_kirigamiWheelEvent.modifiers());
+            if (m_coalesceWheelEvents && m_flickable && m_flickable->window()) {
+                addPendingScroll(pixelDelta, m_kirigamiWheelEvent.angleDelta(), modifiers);
+                // Whether this actually scrolls is only known once the deltas are applied.
+                scrolled = contentHeight > pageHeight || contentWidth > pageWidth;
+            } else {
+                scrolled = scrollFlickable(pixelDelta, m_kirigamiWheelEvent.angleDelta(), modifiers);
+                setScrolling(scrolled);
+            }
+        } else {
+            setScrolling(false);
         }
-        setScrolling(scrolled);
 
         // NOTE: Wheel events created by touchpad gestures with pixel deltas will cause scrolling to jump back
         // to where scrolling started unless the event is always accepted before it reaches the Flickable.
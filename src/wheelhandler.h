@@ -5,10 +5,11 @@
 
 #pragma once
 
+#include <QAbstractAnimation>
 #include <QGuiApplication>
+#include <QMetaProperty>
 #include <QObject>
 #include <QPoint>
-#include <QPropertyAnimation>
 #include <QQmlParserStatus>
 #include <QQuickItem>
 #include <QStyleHints>
@@ -145,6 +146,60 @@ class WheelFilterItem : public QQuickItem
     Q_OBJECT
 public:
     WheelFilterItem(QQuickItem *parent = nullptr);
+
+Q_SIGNALS:
+    // Emitted when the window polishes its items after polish() was called,
+    // so that items polished in reaction are laid out for the same frame.
+    void polishing();
+
+protected:
+    void updatePolish() override;
+};
+
+/**
+ * Smoothly moves a property of an object towards a value that can change at
+ * any time.
+ *
+ * Instead of restarting an animation for every wheel event, new events only
+ * move the end value; the current velocity is kept and the remaining distance
+ * decays exponentially with every tick of the animation driver, so the motion
+ * settles within the configured duration.
+ *
+ * If something else changes the property while scrolling, for example when
+ * the Flickable is dragged, the animation stops.
+ */
+class KineticScrollAnimation : public QAbstractAnimation
+{
+    Q_OBJECT
+public:
+    explicit KineticScrollAnimation(QObject *parent = nullptr);
+
+    void setTarget(QObject *target, const QMetaProperty &property);
+
+    /**
+     * The time in milliseconds to settle after the last change of the end
+     * value. With a duration of 0, scrollTo() changes the property immediately.
+     */
+    void setSettleDuration(int duration);
+
+    qreal endValue() const;
+    void scrollTo(qreal value);
+
+    int duration() const override;
+
+protected:
+    void updateCurrentTime(int currentTime) override;
+    void updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState) override;
+
+private:
+    void write(qreal value);
+
+    QPointer<QObject> m_target;
+    QMetaProperty m_property;
+    int m_settleDuration = 0;
+    int m_lastTime = 0;
+    qreal m_position = 0;
+    qreal m_endValue = 0;
 };
 
 /**
@@ -274,6 +329,22 @@ class WheelHandler : public QObject, public QQmlParserStatus
      */
     Q_PROPERTY(bool scrollFlickableTarget MEMBER m_scrollFlickableTarget NOTIFY scrollFlickableTargetChanged FINAL)
 
+    /**
+     * @brief This property holds whether wheel events are combined and applied once per frame.
+     *
+     * When this is true, the deltas of all wheel events that arrive between two frames are added up and
+     * the Flickable is scrolled once, right before the next frame is rendered. This avoids repeated
+     * layouting and restarting the smooth scrolling animation with input devices that send wheel events
+     * faster than the display refreshes.
+     *
+     * The wheel signal is still emitted for every event.
+     *
+     * default: ``false``
+     *
+     * @since 6.12
+     */
+    Q_PROPERTY(bool coalesceWheelEvents MEMBER m_coalesceWheelEvents NOTIFY coalesceWheelEventsChanged FINAL)
+
 public:
     explicit WheelHandler(QObject *parent = nullptr);
     ~WheelHandler() override;
@@ -344,6 +415,7 @@ Q_SIGNALS:
     void keyNavigationEnabledChanged();
     void blockTargetWheelChanged();
     void scrollFlickableTargetChanged();
+    void coalesceWheelEventsChanged();
 
     /**
      * @brief This signal is emitted when a wheel event reaches the event filter, just before scrolling is handled.
@@ -365,10 +437,25 @@ private:
 
     void setScrolling(bool scrolling);
     bool scrollFlickable(QPointF pixelDelta, QPointF angleDelta = {}, Qt::KeyboardModifiers modifiers = Qt::NoModifier);
+    void addPendingScroll(QPointF pixelDelta, QPointF angleDelta, Qt::KeyboardModifiers modifiers);
+    void applyPendingScroll();
 
     Kirigami::Platform::Units *m_units = nullptr;
     Kirigami::Platform::Settings *m_settings = nullptr;
     QPointer<QQuickItem> m_flickable;
+    // Properties of m_flickable, resolved once when the target is set
+    struct FlickableProperties {
+        QMetaProperty contentWidth;
+        QMetaProperty contentHeight;
+        QMetaProperty contentX;
+        QMetaProperty contentY;
+        QMetaProperty topMargin;
+        QMetaProperty bottomMargin;
+        QMetaProperty leftMargin;
+        QMetaProperty rightMargin;
+        QMetaProperty originX;
+        QMetaProperty originY;
+    } m_flickableProperties;
     QPointer<QQuickItem> m_verticalScrollBar;
     QPointer<QQuickItem> m_horizontalScrollBar;
     QMetaObject::Connection m_verticalChangedConnection;
@@ -386,6 +473,7 @@ private:
     bool m_keyNavigationEnabled = false;
     bool m_blockTargetWheel = true;
     bool m_scrollFlickableTarget = true;
+    bool m_coalesceWheelEvents = false;
     // Same as QXcbWindow.
     constexpr static Qt::KeyboardModifiers m_defaultHorizontalScrollModifiers = Qt::AltModifier;
     // Same as QScrollBar/QAbstractSlider.
@@ -394,8 +482,16 @@ private:
     QTimer m_wheelScrollingTimer;
     KirigamiWheelEvent m_kirigamiWheelEvent;
 
+    // Wheel deltas waiting for the next frame when coalescing wheel events
+    struct PendingScroll {
+        QPointF pixelDelta;
+        QPointF angleDelta;
+        Qt::KeyboardModifiers modifiers;
+        bool scheduled = false;
+    } m_pendingScroll;
+
     // Smooth scrolling
     QQmlEngine *m_engine = nullptr;
-    QPropertyAnimation m_yScrollAnimation{nullptr, "contentY"};
+    KineticScrollAnimation m_yScrollAnimation;
     bool m_wasTouched = false;
 };
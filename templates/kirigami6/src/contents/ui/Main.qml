@@ -36,6 +36,13 @@ Kirigami.ApplicationWindow {
 
     property int counter: 0
 
+    // Secondary pages are loaded through this pool rather than with the
+    // window, so that they don't delay startup.
+    Kirigami.PagePool {
+        id: pagePool
+        asynchronous: true
+    }
+
     globalDrawer: Kirigami.GlobalDrawer {
         isMenu: !Kirigami.Settings.isMobile
         actions: [
@@ -44,10 +51,15 @@ Kirigami.ApplicationWindow {
                 icon.name: "list-add"
                 onTriggered: root.counter += 1
             },
-            Kirigami.Action {
+            Kirigami.PagePoolAction {
                 text: i18n("About %{APPNAME}")
                 icon.name: "help-about"
-                onTriggered: root.pageStack.pushDialogLayer("qrc:/qt/qml/org/kde/%{APPNAME}/contents/ui/About.qml")
+                pagePool: pagePool
+                page: Qt.resolvedUrl("About.qml")
+                useLayers: true
+                // Created in the background after startup, so that opening
+                // it later is instant without slowing down the first frame.
+                preload: true
             },
             Kirigami.Action {
                 text: i18n("Quit")
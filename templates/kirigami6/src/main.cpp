@@ -16,6 +16,8 @@
 #include <QQuickStyle>
 #include <QUrl>
 
+#include <Kirigami/Platform/ApplicationStartup>
+
 #include "app.h"
 #include "version-%{APPNAMELC}.h"
 #include <KAboutData>
@@ -81,12 +83,18 @@ int main(int argc, char *argv[])
 
     QQmlApplicationEngine engine;
 
+    // Keep the compiled graphics pipelines across runs, so that the window
+    // shows up faster after the first start.
+    Kirigami::Platform::ApplicationStartup::enablePipelineCache(&engine);
+
     auto config = %{APPNAME}Config::self();
 
     qmlRegisterSingletonInstance("org.kde.%{APPNAMELC}.private", 1, 0, "Config", config);
 
     engine.rootContext()->setContextObject(new KLocalizedContext(&engine));
-    engine.loadFromModule("org.kde.%{APPNAMELC}", u"Main");
+    // Compiles Main.qml in the background while Kirigami and its platform
+    // plugin are initialized.
+    Kirigami::Platform::ApplicationStartup::loadFromModule(&engine, "org.kde.%{APPNAMELC}", u"Main");
 
     if (engine.rootObjects().isEmpty()) {
         return -1;